@@ -36,6 +36,8 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/cmdparser/commandlineparser.h>
 #include <ghoul/cmdparser/singlecommand.h>
+#include <algorithm>
+#include <thread>
 
 #include <openspace/engine/configuration.h>
 #include <openspace/engine/globals.h>
@@ -47,6 +49,7 @@
 #include <openspace/util/progressbar.h>
 #include <openspace/engine/openspaceengine.h>
 #include <openspace/util/taskloader.h>
+#include <openspace/util/taskscheduler.h>
 #include <openspace/util/factorymanager.h>
 #include <openspace/util/resourcesynchronization.h>
 #include <openspace/util/task.h>
@@ -63,7 +66,9 @@ namespace {
     const std::string _loggerCat = "TaskRunner Main";
 }
 
-void performTasks(const std::string& path) {
+void performTasks(const std::string& path,
+                  openspace::TaskScheduler::Settings settings)
+{
     using namespace openspace;
 
     TaskLoader taskLoader;
@@ -77,17 +82,15 @@ void performTasks(const std::string& path) {
         LINFO(fmt::format("Task queue has {} items", tasks.size()));
     }
 
-    for (size_t i = 0; i < tasks.size(); i++) {
-        Task& task = *tasks[i].get();
-        LINFO(fmt::format(
-            "Performing task {} out of {}: {}", i + 1, tasks.size(), task.description()
-        ));
-        ProgressBar progressBar(100);
-        auto onProgress = [&progressBar](float progress) {
-            progressBar.print(static_cast<int>(progress * 100.f));
-        };
-        task.perform(onProgress);
+    // Changes to the task file itself should cause all of its tasks to run again
+    std::filesystem::path taskFile = absPath(path);
+    if (std::filesystem::is_regular_file(taskFile)) {
+        settings.commonInputs.push_back(taskFile);
     }
+
+    TaskScheduler scheduler(std::move(settings));
+    std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+    TaskScheduler::logSummary(results);
     std::cout << "Done performing tasks" << std::endl;
 }
 
@@ -152,13 +155,53 @@ int main(int argc, char** argv) {
         )
     );
 
+    std::optional<int> nThreads;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+            nThreads,
+            "--threads",
+            "-j",
+            "The number of threads that are used to perform independent tasks at the "
+            "same time. Defaults to the number of hardware threads"
+        )
+    );
+
+    std::optional<int> memoryBudget;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommand<int>>(
+            memoryBudget,
+            "--memory",
+            "-m",
+            "The maximum amount of memory in MB that tasks running at the same time are "
+            "estimated to use. By default, the memory usage is not limited"
+        )
+    );
+
+    std::optional<bool> forceRun;
+    commandlineParser.addCommand(
+        std::make_unique<ghoul::cmdparser::SingleCommandZeroArguments>(
+            forceRun,
+            "--force",
+            "-f",
+            "Performs all tasks, even the ones whose outputs are up to date"
+        )
+    );
+
     commandlineParser.setCommandLine({ argv, argv + argc });
     commandlineParser.execute();
 
     //FileSys.setCurrentDirectory(launchDirectory);
 
+    TaskScheduler::Settings settings;
+    settings.nThreads = static_cast<unsigned int>(
+        std::max(nThreads.value_or(std::thread::hardware_concurrency()), 1)
+    );
+    settings.memoryBudget = static_cast<size_t>(std::max(memoryBudget.value_or(0), 0)) *
+        1024 * 1024;
+    settings.forceRun = forceRun.value_or(false);
+
     if (tasksPath.has_value()) {
-        performTasks(*tasksPath);
+        performTasks(*tasksPath, settings);
         return 0;
     }
 
@@ -170,7 +213,7 @@ int main(int argc, char** argv) {
     std::cout << "TASK > ";
     std::string t;
     while (std::cin >> t) {
-        performTasks(t);
+        performTasks(t, settings);
         std::cout << "TASK > ";
     }
 
@@ -87,6 +87,7 @@ struct Configuration {
 
     std::string versionCheckUrl;
     bool useMultithreadedInitialization = false;
+    double assetInitializationBudget = 4.0;
 
     struct LoadingScreen {
         bool isShowingMessages = true;
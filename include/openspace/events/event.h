@@ -28,6 +28,8 @@
 #include <openspace/util/tstring.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/dictionary.h>
+#include <string>
+#include <vector>
 
 namespace openspace {
     namespace properties { class Property; }
@@ -53,9 +55,10 @@ struct Event {
     //     to see all events.
     //  4. Add a new case into the logAllEvents function that handles the new enum entry
     //  5. If the new event type has any parameters it takes in its constructor, go into
-    //     the `toParameter` function and add a case label for the new enum type and
-    //     return a dictionary with these parameters. This dictionary is passed to actions
-    //     if they are triggered by events
+    //     the `fields` function and add a case label for the new enum type that returns
+    //     the names and accessors of these parameters. They are used by `toParameter`
+    //     to create the dictionary that is passed to actions if they are triggered by
+    //     events and by `EventFilter` to check the events against filters
     //  6. Add the new enum entry into the `toString` and `fromString` methods
     enum class Type : uint8_t {
         SceneGraphNodeAdded,
@@ -104,6 +107,52 @@ Event::Type fromString(std::string_view str);
 
 ghoul::Dictionary toParameter(const Event& e);
 
+/**
+ * A filter that checks the parameters of events against a list of expected values. The
+ * filter is compiled from a dictionary for a specific event type, so that each key is
+ * resolved once into a typed accessor of the event's field. Checking an event against
+ * the filter is equivalent to checking that the filter dictionary is a subset of the
+ * dictionary returned by `toParameter`, but it does not require that dictionary to be
+ * created.
+ */
+class EventFilter {
+public:
+    /**
+     * Compiles the \p filter for events of the provided \p type. Keys that the events of
+     * this type do not have and values with a different type than the event's field
+     * result in a filter that no event passes.
+     *
+     * \param type The type of the events that will be checked against the filter
+     * \param filter The parameter names and their expected values
+     */
+    EventFilter(Event::Type type, const ghoul::Dictionary& filter);
+
+    /**
+     * Returns whether the event \p e passes this filter.
+     *
+     * \param e The event to check
+     * \return `true` if all of the event's fields in the filter have the expected value
+     *
+     * \pre e must have the type that this filter was compiled for
+     */
+    bool matches(const Event& e) const;
+
+private:
+    struct StringPredicate {
+        std::string_view (*field)(const Event&);
+        std::string value;
+    };
+    struct NumberPredicate {
+        double (*field)(const Event&);
+        double value;
+    };
+
+    Event::Type _type;
+    std::vector<StringPredicate> _stringPredicates;
+    std::vector<NumberPredicate> _numberPredicates;
+    bool _isUnsatisfiable = false;
+};
+
 void logAllEvents(const Event* e);
 
 //
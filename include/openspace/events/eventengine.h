@@ -28,7 +28,10 @@
 #include <openspace/events/event.h>
 #include <openspace/scripting/lualibrary.h>
 #include <ghoul/misc/memorypool.h>
+#include <array>
+#include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace openspace {
 
@@ -137,6 +140,19 @@ public:
     static scripting::LuaLibrary luaLibrary();
 
 private:
+    struct RegisteredAction {
+        ActionInfo info;
+        /// The filter of the action compiled for the action's event type
+        std::optional<events::EventFilter> compiledFilter;
+    };
+
+    /// The number of entries in the events::Event::Type enum
+    static constexpr size_t NumberOfEventTypes =
+        static_cast<size_t>(events::Event::Type::Custom) + 1;
+
+    /// Returns the registered action with the provided \p identifier or `nullptr`
+    RegisteredAction* findAction(uint32_t identifier);
+
     /// The storage space in which Events are stored
     ghoul::MemoryPool<4096> _memory;
     /// The first event in the chain of events stored in the memory pool
@@ -144,10 +160,12 @@ private:
     /// The last event in the chain of events stored in the memory pool
     events::Event* _lastEvent = nullptr;
 
-    /// The type is duplicated in the ActionInfo as well, but we want it in the ActionInfo
-    /// to be able to return them to a caller and we want it in this unordered_map to make
-    /// the lookup really fast. So having this extra wasted memory is probably worth it
-    std::unordered_map<events::Event::Type, std::vector<ActionInfo>> _eventActions;
+    /// The registered actions for each event type, indexed by the value of the type. The
+    /// identifiers are increasing, so the actions of each type are sorted by identifier
+    std::array<std::vector<RegisteredAction>, NumberOfEventTypes> _eventActions;
+
+    /// The event type of each registered action, indexed by the action's identifier
+    std::unordered_map<uint32_t, events::Event::Type> _actionTypes;
 
     static uint32_t nextRegisteredEventId;
 
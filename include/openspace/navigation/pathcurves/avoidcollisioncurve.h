@@ -27,7 +27,7 @@
 
 #include <openspace/navigation/pathcurve.h>
 
-namespace openspace { class SceneGraphNode; }
+namespace openspace { class SceneGraphNodeBvh; }
 
 namespace openspace::interaction {
 
@@ -40,7 +40,7 @@ public:
 private:
     void removeCollisions(int step = 0);
 
-    std::vector<SceneGraphNode*> _relevantNodes;
+    const SceneGraphNodeBvh* _relevantNodes = nullptr;
 };
 
 } // namespace openspace::interaction
@@ -33,8 +33,10 @@
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/doubleproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/scene/scenegraphnodebvh.h>
 #include <ghoul/glm.h>
 #include <memory>
+#include <optional>
 
 namespace openspace {
     class Camera;
@@ -83,6 +85,17 @@ public:
 
     const std::vector<SceneGraphNode*>& relevantNodes();
 
+    /**
+     * Returns a bounding volume hierarchy over the relevant nodes at their positions from
+     * the current frame's scene update. The hierarchy is refreshed on the first call in
+     * each frame and shared by all later calls in the same frame. The radius of each node
+     * is its valid bounding sphere, scaled so that it contains the bounding sphere when
+     * that is applied in the node's model coordinates.
+     *
+     * \return The hierarchy of the relevant nodes, in the same order as #relevantNodes
+     */
+    const SceneGraphNodeBvh& relevantNodesBvh();
+
     /**
      * Find a node close to the given node. Closeness is determined by a factor times
      * the bounding sphere of the object.
@@ -124,6 +137,8 @@ private:
 
     std::vector<SceneGraphNode*> _relevantNodes;
     bool _hasInitializedRelevantNodes = false;
+    SceneGraphNodeBvh _relevantNodesBvh;
+    std::optional<uint64_t> _relevantNodesBvhFrame;
 };
 
 } // namespace openspace::interaction
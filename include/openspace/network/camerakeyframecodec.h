@@ -0,0 +1,131 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___CAMERAKEYFRAMECODEC___H__
+#define __OPENSPACE_CORE___CAMERAKEYFRAMECODEC___H__
+
+#include <openspace/network/messagestructures.h>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace openspace::datamessagestructures {
+
+/**
+ * Encodes a stream of CameraKeyframe%s into a compact binary representation that is
+ * sent as Type::CompactCameraData. Only every `fullKeyframeInterval`-th keyframe, and
+ * every keyframe in which the anchor changes, is self-contained and carries the name of
+ * the anchor node. All other keyframes reference the anchor of the last full keyframe
+ * and store their timestamp and position as a difference to the previous keyframe.
+ *
+ * The anchor-relative position is quantized with a power-of-two step that adapts to the
+ * distance from the anchor, so that the relative precision stays constant regardless of
+ * whether the camera is close to a spacecraft or far outside the solar system. The
+ * rotation is stored with the "smallest three" encoding in which the largest component
+ * of the quaternion is dropped and recomputed by the decoder.
+ *
+ * The encoder and the CameraKeyframeDecoder are stateful and have to see the same
+ * sequence of keyframes, which the in-order delivery of the parallel connection
+ * guarantees. A decoder that misses a keyframe discards the following difference
+ * keyframes until the next full keyframe arrives.
+ */
+class CameraKeyframeEncoder {
+public:
+    struct Settings {
+        /// The position quantization step relative to the distance to the anchor
+        double relativePositionPrecision = 1.0 / (1 << 30);
+
+        /// The number of keyframes after which a self-contained keyframe is sent
+        int fullKeyframeInterval = 30;
+
+        /// The smallest rotation (in radians) that is considered a camera movement
+        double rotationThreshold = 5e-5;
+    };
+
+    CameraKeyframeEncoder() = default;
+    explicit CameraKeyframeEncoder(Settings settings);
+
+    /**
+     * Returns `true` if the camera described by \p kf has moved sufficiently compared to
+     * the last encoded keyframe that sending it would change the pose seen by the
+     * receivers. This is used to lower the send rate while the camera is stationary.
+     */
+    bool hasMoved(const CameraKeyframe& kf) const;
+
+    /**
+     * Appends the compact representation of \p kf to the \p buffer.
+     */
+    void encode(const CameraKeyframe& kf, std::vector<char>& buffer);
+
+    /**
+     * Resets the encoder so that the next keyframe is encoded as a full keyframe.
+     */
+    void reset();
+
+private:
+    Settings _settings;
+
+    bool _hasPrevious = false;
+    uint8_t _sequence = 0;
+    int _keyframesSinceFull = 0;
+    std::string _anchor;
+    bool _followNodeRotation = false;
+    int8_t _exponent = 0;
+    glm::i64vec3 _quantizedPosition = glm::i64vec3(0);
+    glm::dquat _rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+    float _scale = 0.f;
+    double _timestamp = 0.0;
+};
+
+/**
+ * Decodes the keyframes produced by a CameraKeyframeEncoder.
+ */
+class CameraKeyframeDecoder {
+public:
+    /**
+     * Decodes the next keyframe from the \p buffer. Returns `std::nullopt` if the buffer
+     * is a difference keyframe for which the preceding keyframe was not seen, or if the
+     * buffer is malformed.
+     */
+    std::optional<CameraKeyframe> decode(const std::vector<char>& buffer);
+
+    /**
+     * Discards the decoder state, the next decoded keyframe has to be a full keyframe.
+     */
+    void reset();
+
+private:
+    bool _hasPrevious = false;
+    uint8_t _sequence = 0;
+    std::string _anchor;
+    int8_t _exponent = 0;
+    glm::i64vec3 _quantizedPosition = glm::i64vec3(0);
+    float _scale = 0.f;
+    double _timestamp = 0.0;
+};
+
+} // namespace openspace::datamessagestructures
+
+#endif // __OPENSPACE_CORE___CAMERAKEYFRAMECODEC___H__
@@ -41,7 +41,8 @@ namespace openspace::datamessagestructures {
 enum class Type : uint32_t {
     CameraData = 0,
     TimelineData,
-    ScriptData
+    ScriptData,
+    CompactCameraData
 };
 
 struct CameraKeyframe {
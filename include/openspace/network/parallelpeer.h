@@ -27,8 +27,10 @@
 
 #include <openspace/properties/propertyowner.h>
 
+#include <openspace/network/camerakeyframecodec.h>
 #include <openspace/network/messagestructures.h>
 #include <openspace/network/parallelconnection.h>
+#include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/util/timemanager.h>
@@ -36,6 +38,7 @@
 #include <atomic>
 #include <deque>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <thread>
 #include <vector>
@@ -85,7 +88,9 @@ private:
     void connectionStatusMessageReceived(const std::vector<char>& message);
     void nConnectionsMessageReceived(const std::vector<char>& message);
 
-    void sendCameraKeyframe();
+    std::optional<datamessagestructures::CameraKeyframe> currentCameraKeyframe() const;
+    void sendCameraKeyframe(const datamessagestructures::CameraKeyframe& kf);
+    void addCameraKeyframe(const datamessagestructures::CameraKeyframe& kf);
     void sendTimeTimeline();
 
     void setStatus(ParallelConnection::Status status);
@@ -106,10 +111,17 @@ private:
     properties::FloatProperty _bufferTime;
     properties::FloatProperty _timeKeyframeInterval;
     properties::FloatProperty _cameraKeyframeInterval;
+    properties::BoolProperty _useCompactCameraKeyframes;
 
     double _lastTimeKeyframeTimestamp = 0.0;
     double _lastCameraKeyframeTimestamp = 0.0;
 
+    datamessagestructures::CameraKeyframeEncoder _cameraKeyframeEncoder;
+    datamessagestructures::CameraKeyframeDecoder _cameraKeyframeDecoder;
+    // The last keyframe that was not sent since the camera did not move
+    std::optional<datamessagestructures::CameraKeyframe> _skippedCameraKeyframe;
+    std::atomic_bool _resetCameraKeyframeCodec = false;
+
     std::atomic_bool _shouldDisconnect = false;
 
     std::atomic<size_t> _nConnections = 0;
@@ -28,9 +28,11 @@
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/misc/easing.h>
 #include <any>
+#include <atomic>
 #include <functional>
 #include <string>
 #include <string_view>
+#include <vector>
 
 struct lua_State;
 
@@ -493,6 +495,42 @@ public:
      */
     void resetToUnchanged();
 
+    /**
+     * Returns the number of properties that have notified their change listeners since
+     * the last call to #clearChangeJournal, which happens once per frame. Each property
+     * is only counted once.
+     */
+    static size_t changeJournalSize();
+
+    /**
+     * Clears the list of properties that have changed during this frame.
+     */
+    static void clearChangeJournal();
+
+    /**
+     * Returns all properties that might have been marked as changed, which is a superset
+     * of all properties for which #hasChanged returns `true`. A property that was reset
+     * through #resetToUnchanged stays in this list until #compactDirtyProperties or
+     * #resetAllToUnchanged is called.
+     *
+     * \return The list of properties that might have changed
+     */
+    static std::vector<Property*> dirtyProperties();
+
+    /**
+     * Removes the properties that are no longer marked as changed and the ones that have
+     * been deleted from the list returned by #dirtyProperties, so that the list only
+     * grows with the number of properties that are currently changed. This happens once
+     * per frame.
+     */
+    static void compactDirtyProperties();
+
+    /**
+     * Resets all properties that have changed to an unchanged state. This only touches
+     * the properties that actually changed, rather than all existing properties.
+     */
+    static void resetAllToUnchanged();
+
 protected:
     /**
      * This method must be called by all subclasses whenever the encapsulated value has
@@ -500,6 +538,12 @@ protected:
      */
     void notifyChangeListeners();
 
+    /**
+     * Marks the value of this property as changed so that #hasChanged returns `true`
+     * until the property is reset.
+     */
+    void markValueDirty();
+
     /// The PropetyOwner this Property belongs to, or `nullptr`
     PropertyOwner* _owner = nullptr;
 
@@ -527,6 +571,20 @@ protected:
 private:
     void notifyDeleteListeners();
 
+    /// Whether this property is counted by #changeJournalSize
+    std::atomic_bool _isInChangeJournal = false;
+
+    /// The position of this property in the change journal. Only valid while
+    /// #_isInChangeJournal is `true` and only accessed while the journal is locked
+    size_t _changeJournalIndex = 0;
+
+    /// Whether this property is in the list returned by #dirtyProperties
+    std::atomic_bool _isInDirtyList = false;
+
+    /// The position of this property in the dirty list. Only valid while #_isInDirtyList
+    /// is `true` and only accessed while the dirty list is locked
+    size_t _dirtyListIndex = 0;
+
     OnChangeHandle _currentHandleValue = 0;
 
 #ifdef _DEBUG
@@ -58,7 +58,7 @@ void openspace::properties::TemplateProperty<T>::setValue(T val) {
     if (val != _value) {
         _value = std::move(val);
         notifyChangeListeners();
-        _isValueDirty = true;
+        markValueDirty();
     }
 }
 
@@ -0,0 +1,185 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___LABELBATCH___H__
+#define __OPENSPACE_CORE___LABELBATCH___H__
+
+#include <ghoul/glm.h>
+#include <ghoul/opengl/ghoul_gl.h>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace ghoul::opengl { class Texture; }
+
+namespace openspace {
+
+namespace dataloader { struct Labelset; }
+
+/**
+ * Renders all labels of a labelset with a single buffer update and draw call. The glyph
+ * quads of all labels are laid out once in the label plane and cached until the font or
+ * the labels change. Each frame, the labels are culled against the view frustum and the
+ * minimum and maximum pixel size on the CPU, and the quads of the remaining labels are
+ * placed in the world and uploaded together.
+ */
+class LabelBatch {
+public:
+    /// The metrics of a single glyph, measured in font units
+    struct Glyph {
+        float width = 0.f;
+        float height = 0.f;
+        float leftBearing = 0.f;
+        float topBearing = 0.f;
+        float horizontalAdvance = 0.f;
+
+        glm::vec2 topLeft = glm::vec2(0.f);
+        glm::vec2 bottomRight = glm::vec2(0.f);
+        glm::vec2 outlineTopLeft = glm::vec2(0.f);
+        glm::vec2 outlineBottomRight = glm::vec2(0.f);
+    };
+    /// Returns the glyph for a character, or `std::nullopt` if it can not be rendered
+    using GlyphFunction = std::function<std::optional<Glyph>(wchar_t)>;
+    /// Returns the kerning between the previous and the current character
+    using KerningFunction = std::function<float(wchar_t previous, wchar_t current)>;
+
+    enum class Orientation {
+        FaceCamera = 0,
+        PositionNormal
+    };
+
+    struct CullSettings {
+        glm::dmat4 modelViewProjection = glm::dmat4(1.0);
+        glm::vec3 orthoRight = glm::vec3(1.f, 0.f, 0.f);
+        glm::vec3 orthoUp = glm::vec3(0.f, 1.f, 0.f);
+        glm::dvec3 cameraPosition = glm::dvec3(0.0);
+        glm::dvec3 cameraLookUp = glm::dvec3(0.0, 1.0, 0.0);
+        Orientation orientation = Orientation::FaceCamera;
+
+        /// The size of one font unit in world units
+        float scale = 1.f;
+        /// Labels whose height in pixels is outside of this range are not drawn
+        glm::vec2 minMaxSize = glm::vec2(0.f, std::numeric_limits<float>::max());
+        glm::vec2 viewportSize = glm::vec2(1.f);
+    };
+
+    struct Vertex {
+        glm::vec3 position;
+        glm::vec2 texCoords;
+        glm::vec2 outlineTexCoords;
+    };
+
+    void initializeGL();
+    void deinitializeGL();
+
+    /**
+     * Marks the cached layout as invalid, for example after the font or the labels have
+     * changed. The next call to #hasLayout will return `false`.
+     */
+    void invalidate();
+    bool hasLayout() const;
+
+    /**
+     * Lays out the glyph quads of all labels in \p labelset. The positions of the labels
+     * are transformed by \p transform and then multiplied by \p unitScale. Lines are
+     * separated by `\n` and are \p lineHeight font units apart.
+     *
+     * \param labelset The labels that should be laid out
+     * \param transform The transformation that is applied to the label positions
+     * \param unitScale The factor that converts the label positions into meters
+     * \param lineHeight The distance between two lines of text in font units
+     * \param glyph Provides the glyph metrics for each character
+     * \param kerning Provides the kerning between characters. If it is empty, no kerning
+     *        is applied
+     */
+    void layout(const dataloader::Labelset& labelset, const glm::dmat4& transform,
+        double unitScale, float lineHeight, const GlyphFunction& glyph,
+        const KerningFunction& kerning = KerningFunction());
+
+    /**
+     * Determines which of the laid out labels are visible with the provided
+     * \p settings and creates the vertices for all of their glyphs. The labels are split
+     * into blocks that are culled by up to \p nThreads threads, where 0 means to use the
+     * number of hardware threads. Apart from the calling thread, these are taken from a
+     * thread pool that is shared by all label batches.
+     *
+     * \return The number of visible labels
+     */
+    size_t cull(const CullSettings& settings, unsigned int nThreads = 0);
+
+    /**
+     * Uploads the vertices created by the last call to #cull and draws them in a single
+     * draw call, using the glyphs in \p atlas.
+     */
+    void render(const glm::dmat4& modelViewProjection, const glm::vec4& color,
+        const glm::vec4& outlineColor, ghoul::opengl::Texture& atlas);
+
+    size_t nLabels() const;
+    size_t nGlyphs() const;
+
+    /// The indices of the labels that were visible in the last call to #cull
+    const std::vector<unsigned int>& visibleLabels() const;
+
+    /// The vertices of the visible labels, four for each glyph
+    const std::vector<Vertex>& vertices() const;
+
+private:
+    struct Label {
+        // The index of the label in the labelset
+        unsigned int index;
+        glm::vec3 position;
+        unsigned int firstQuad;
+        unsigned int nQuads;
+        // The bounding box of the text in font units (minimum x, minimum y, maximum x,
+        // maximum y), relative to the label position
+        glm::vec4 bounds;
+    };
+
+    struct Quad {
+        // The corners of the glyph in font units (x0, y0, x1, y1)
+        glm::vec4 rect;
+        glm::vec4 texCoords;
+        glm::vec4 outlineTexCoords;
+    };
+
+    bool _hasLayout = false;
+    std::vector<Label> _labels;
+    std::vector<Quad> _quads;
+
+    std::vector<unsigned char> _isVisible;
+    std::vector<unsigned int> _visibleLabels;
+    std::vector<unsigned int> _firstVertex;
+    std::vector<Vertex> _vertices;
+
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
+    GLuint _ibo = 0;
+    // The number of quads for which the index buffer currently has indices
+    size_t _nIndexedQuads = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___LABELBATCH___H__
@@ -33,6 +33,7 @@
 #include <openspace/properties/scalar/floatproperty.h>
 #include <openspace/properties/vector/ivec2property.h>
 #include <openspace/properties/vector/vec3property.h>
+#include <openspace/rendering/labelbatch.h>
 #include <openspace/util/distanceconversion.h>
 #include <ghoul/glm.h>
 #include <filesystem>
@@ -49,10 +50,17 @@ public:
     explicit LabelsComponent(const ghoul::Dictionary& dictionary);
     ~LabelsComponent() override = default;
 
+    /**
+     * Returns the labelset for modification. As the labels might be changed through the
+     * returned reference, the laid out labels are recreated before they are rendered the
+     * next time.
+     */
     dataloader::Labelset& labelSet();
     const dataloader::Labelset& labelSet() const;
 
     void initialize();
+    void initializeGL();
+    void deinitializeGL();
 
     void loadLabels();
 
@@ -73,6 +81,7 @@ private:
     bool _useCache = true;
 
     std::shared_ptr<ghoul::fontrendering::Font> _font = nullptr;
+    LabelBatch _batch;
 
     glm::dmat4 _transformationMatrix = glm::dmat4(1.0);
 
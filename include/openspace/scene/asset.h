@@ -26,6 +26,7 @@
 #define __OPENSPACE_CORE___ASSET___H__
 
 #include <openspace/util/resourcesynchronization.h>
+#include <chrono>
 #include <filesystem>
 #include <optional>
 
@@ -190,6 +191,17 @@ public:
      */
     void initialize();
 
+    /**
+     * Returns the asset that has to be initialized next in order to initialize this
+     * asset, which is either one of its (indirectly) required assets whose requirements
+     * are all initialized already, or this asset itself. Initializing the returned asset
+     * does therefore not initialize any other asset.
+     *
+     * \return The next asset to initialize or `nullptr` if this Asset has already been
+     *         initialized, failed to initialize, or is not synchronized yet
+     */
+    Asset* nextAssetToInitialize();
+
     /**
      * Returns `true` if this Asset has been #initialize d successfully.
      *
@@ -266,6 +278,18 @@ public:
      */
     std::optional<MetaInformation> metaInformation() const;
 
+    /**
+     * Returns the time it took to execute the asset file, not including the time that
+     * was spent loading the assets it requires.
+     */
+    std::chrono::microseconds loadTime() const;
+
+    /**
+     * Returns the time it took to call the `onInitialize` functions of this asset, not
+     * including the time that was spent initializing the assets it requires.
+     */
+    std::chrono::microseconds initializationTime() const;
+
 private:
     /// All of the (internal) states that the Asset can move through. The externally
     /// visible states (Loaded, Synchronized, Initialized) are a subset of these states
@@ -335,6 +359,12 @@ private:
     /// The parameter that was passed into the original `require` call whether the
     /// contents of this asset should be enabled or disabled
     std::optional<bool> _explicitEnabled = std::nullopt;
+
+    /// The time that was spent executing the asset file
+    std::chrono::microseconds _loadTime = std::chrono::microseconds(0);
+
+    /// The time that was spent in the `onInitialize` functions of the asset
+    std::chrono::microseconds _initializationTime = std::chrono::microseconds(0);
 };
 
 } // namespace openspace
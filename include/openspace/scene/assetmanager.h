@@ -25,8 +25,12 @@
 #ifndef __OPENSPACE_CORE___ASSETMANAGER___H__
 #define __OPENSPACE_CORE___ASSETMANAGER___H__
 
+#include <openspace/util/threadpool.h>
 #include <ghoul/lua/luastate.h>
+#include <ghoul/misc/boolean.h>
+#include <chrono>
 #include <filesystem>
+#include <future>
 #include <optional>
 #include <unordered_map>
 #include <list>
@@ -48,6 +52,8 @@ class ResourceSynchronization;
  */
 class AssetManager {
 public:
+    BooleanType(UnlimitedBudget);
+
     AssetManager(ghoul::lua::LuaState* state, std::filesystem::path assetRootDirectory);
     ~AssetManager();
 
@@ -79,9 +85,21 @@ public:
 
     /**
      * Update function that should be called at least once per frame that will load all
-     * queued asset loads and asset removal.
+     * queued asset loads and asset removal. Assets that are ready are initialized until
+     * the initialization budget (see #setInitializationBudget) of this call is used up,
+     * but at least one asset is initialized per call.
+     *
+     * \param unlimitedBudget If this is `Yes`, all assets that are ready will be
+     *        initialized regardless of the budget, for example while the loading screen
+     *        is shown
+     */
+    void update(UnlimitedBudget unlimitedBudget = UnlimitedBudget::No);
+
+    /**
+     * Sets the amount of time that each call to #update can spend on initializing assets
+     * before the remaining assets are deferred to the next call.
      */
-    void update();
+    void setInitializationBudget(std::chrono::microseconds budget);
 
     scripting::LuaLibrary luaLibrary();
 
@@ -180,6 +198,12 @@ private:
     std::filesystem::path generateAssetPath(const std::filesystem::path& baseDirectory,
         const std::string& assetPath) const;
 
+    /**
+     * Starts reading and compiling the asset file at the provided \p path on a worker
+     * thread, unless that already happened or the asset has been loaded before.
+     */
+    void prefetchAsset(const std::filesystem::path& path);
+
     //
     // Assets
     //
@@ -203,6 +227,27 @@ private:
     /// This list contains all of the assets that will be deleted in the next update call
     std::vector<std::unique_ptr<Asset>> _toBeDeleted;
 
+    /// The time each update call may spend on initializing assets
+    std::chrono::microseconds _initializationBudget = std::chrono::milliseconds(4);
+
+    //
+    // Prefetching
+    //
+
+    /// The contents of an asset file that was read and compiled on a worker thread
+    struct PrefetchedAsset {
+        /// The compiled Lua chunk or an empty string if the file could not be compiled,
+        /// in which case the file is loaded normally to report the error
+        std::string bytecode;
+        /// The paths that the asset requires as they are written in the file
+        std::vector<std::string> requiredPaths;
+    };
+    /// The asset files that are currently being read or have been read, keyed by path
+    std::unordered_map<std::string, std::future<PrefetchedAsset>> _prefetchedAssets;
+
+    /// The worker threads that read and compile the asset files
+    ThreadPool _prefetchThreads;
+
     //
     // ResourceSynchronizations
     //
@@ -0,0 +1,129 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___SCENEGRAPHNODEBVH___H__
+#define __OPENSPACE_CORE___SCENEGRAPHNODEBVH___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <vector>
+
+namespace openspace {
+
+class SceneGraphNode;
+
+/**
+ * A bounding volume hierarchy over spheres that belong to scene graph nodes, used to
+ * find the nodes that are close to a point, a ray, or a line segment without having to
+ * check every node. Each tree node stores the bounds of the sphere centers in its subtree
+ * together with the largest sphere radius, so that the spheres can be scaled by the
+ * queries without rebuilding the tree.
+ *
+ * The hierarchy is meant to be updated with the current positions of the nodes whenever
+ * it is used. If the nodes are the same as in the previous update, the bounds of the
+ * existing tree are recomputed, which is cheaper than rebuilding the tree. The scene
+ * graph nodes themselves are never accessed by this class.
+ */
+class SceneGraphNodeBvh {
+public:
+    struct Entry {
+        SceneGraphNode* node = nullptr;
+        glm::dvec3 center = glm::dvec3(0.0);
+        double radius = 0.0;
+    };
+
+    /**
+     * Updates the hierarchy to contain the \p entries. If the entries refer to the same
+     * nodes in the same order as in the previous update, the existing tree is refitted
+     * to the new centers and radii, otherwise the tree is rebuilt.
+     *
+     * \param entries The spheres that should be stored in the hierarchy
+     */
+    void update(std::vector<Entry> entries);
+
+    /// Returns the entries in the order in which they were passed to #update
+    const std::vector<Entry>& entries() const;
+
+    /**
+     * Adds the indices of all entries whose sphere, with its radius multiplied by
+     * \p radiusScale, intersects the sphere at \p center with the \p radius to the
+     * \p result. The indices are added in increasing order.
+     */
+    void querySphere(const glm::dvec3& center, double radius,
+        std::vector<uint32_t>& result, double radiusScale = 1.0) const;
+
+    /**
+     * Adds the indices of all entries whose sphere, with its radius multiplied by
+     * \p radiusScale, intersects the line segment between \p start and \p end to the
+     * \p result. The indices are added in increasing order.
+     */
+    void querySegment(const glm::dvec3& start, const glm::dvec3& end,
+        std::vector<uint32_t>& result, double radiusScale = 1.0) const;
+
+    /**
+     * Adds the indices of all entries whose sphere, with its radius multiplied by
+     * \p radiusScale, intersects the ray that starts at \p origin and goes in the
+     * \p direction to the \p result. The indices are added in increasing order.
+     */
+    void queryRay(const glm::dvec3& origin, const glm::dvec3& direction,
+        std::vector<uint32_t>& result, double radiusScale = 1.0) const;
+
+    /**
+     * Adds the indices of the \p k entries whose centers are closest to the \p point to
+     * the \p result, sorted by increasing distance.
+     */
+    void queryNearest(const glm::dvec3& point, size_t k,
+        std::vector<uint32_t>& result) const;
+
+private:
+    struct Node {
+        /// The bounds of the centers of all entries in the subtree
+        glm::dvec3 min = glm::dvec3(0.0);
+        glm::dvec3 max = glm::dvec3(0.0);
+        /// The largest radius of all entries in the subtree
+        double maxRadius = 0.0;
+        /// The range in _order for a leaf, or the index of the second child of an inner
+        /// node in `first` and 0 in `count`. The first child follows the node directly
+        uint32_t first = 0;
+        uint32_t count = 0;
+    };
+
+    uint32_t build(uint32_t begin, uint32_t end);
+    void refit();
+
+    template <typename NodeTest, typename EntryTest>
+    void query(NodeTest nodeTest, EntryTest entryTest,
+        std::vector<uint32_t>& result) const;
+
+    std::vector<Entry> _entries;
+    std::vector<Node> _nodes;
+    /// The index of the entry for each position in the leaves
+    std::vector<uint32_t> _order;
+    /// The number of times the tree was refitted since it was last built
+    int _nRefits = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___SCENEGRAPHNODEBVH___H__
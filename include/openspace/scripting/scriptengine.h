@@ -30,11 +30,15 @@
 #include <openspace/json.h>
 #include <ghoul/lua/luastate.h>
 #include <ghoul/misc/boolean.h>
+#include <ghoul/misc/dictionary.h>
 #include <filesystem>
 #include <mutex>
 #include <optional>
 #include <queue>
 #include <functional>
+#include <list>
+#include <string_view>
+#include <unordered_map>
 
 namespace openspace { class SyncBuffer; }
 
@@ -59,6 +63,8 @@ public:
         ShouldBeSynchronized shouldBeSynchronized;
         ShouldSendToRemote shouldSendToRemote;
         ScriptCallback callback;
+        /// Passed to the script as the global variable `args` if it is not empty
+        ghoul::Dictionary arguments = ghoul::Dictionary();
     };
 
     static constexpr std::string_view OpenSpaceLibraryName = "openspace";
@@ -85,6 +91,14 @@ public:
     bool hasLibrary(const std::string& name);
 
     bool runScript(const std::string& script, ScriptCallback callback = ScriptCallback());
+
+    /**
+     * Runs the \p script with the \p arguments available as the global variable `args`
+     * and as the parameter of the chunk (`...`). The previous value of `args` is restored
+     * after the script has run. The compiled script is cached, so running the same script
+     * again with different arguments does not parse and compile it again.
+     */
+    bool runScript(const std::string& script, const ghoul::Dictionary& arguments);
     bool runScriptFile(const std::filesystem::path& filename);
 
     virtual void preSync(bool isMaster) override;
@@ -95,6 +109,15 @@ public:
     void queueScript(std::string script, ShouldBeSynchronized shouldBeSynchronized,
         ShouldSendToRemote shouldSendToRemote, ScriptCallback cb = ScriptCallback());
 
+    /**
+     * Queues the \p script, which will be run with the \p arguments available as the
+     * global variable `args`. If the script is synchronized, sent to remote peers, or
+     * recorded, the arguments are assigned to `args` in a line that is added in front of
+     * the script text instead.
+     */
+    void queueScript(std::string script, ghoul::Dictionary arguments,
+        ShouldBeSynchronized shouldBeSynchronized, ShouldSendToRemote shouldSendToRemote);
+
     std::vector<std::string> allLuaFunctions() const;
 
     nlohmann::json generateJson() const;
@@ -104,6 +127,25 @@ private:
 
     void writeLog(const std::string& script);
 
+    /**
+     * Returns the registry reference to the function that is the result of compiling
+     * the \p script. Compiled functions are cached and only the least recently used
+     * ones are evicted.
+     *
+     * \throw LuaLoadingException If the \p script could not be compiled
+     */
+    int compiledChunk(const std::string& script);
+
+    /**
+     * Runs the compiled version of the \p script. If \p arguments is not `nullptr`, they
+     * are passed to the script as described in `runScript`.
+     *
+     * \throw LuaLoadingException If the \p script could not be compiled
+     * \throw LuaExecutionException If an error occurred while running the \p script
+     */
+    void runCompiledChunk(const std::string& script, const ghoul::Dictionary* arguments);
+    void clearCompiledChunks();
+
     bool registerLuaLibrary(lua_State* state, LuaLibrary& library);
     void addLibraryFunctions(lua_State* state, LuaLibrary& library, Replace replace);
 
@@ -124,6 +166,13 @@ private:
 
     std::vector<std::string> _scriptsToSync;
 
+    // The scripts and the registry references of their compiled functions, ordered from
+    // the most to the least recently used one
+    using CompiledChunks = std::list<std::pair<std::string, int>>;
+    CompiledChunks _compiledChunks;
+    // The keys point into the scripts that are stored in _compiledChunks
+    std::unordered_map<std::string_view, CompiledChunks::iterator> _compiledChunkMap;
+
     // Logging variables
     bool _logFileExists = false;
     bool _logScripts = true;
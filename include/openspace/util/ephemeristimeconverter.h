@@ -0,0 +1,169 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___EPHEMERISTIMECONVERTER___H__
+#define __OPENSPACE_CORE___EPHEMERISTIMECONVERTER___H__
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Converts between UTC date strings and ephemeris time, that is the number of TDB seconds
+ * past the J2000 epoch, without calling SPICE. The conversion uses the same leap seconds
+ * and the same model for the difference between TDB and TDT as the SPICE functions
+ * `str2et_c` and `timout_c`. All conversion functions are re-entrant and can be called
+ * from any thread.
+ *
+ * Only a subset of the date strings and format pictures that SPICE supports are handled.
+ * Everything else, including dates before the year 1583 where SPICE switches to the
+ * Julian calendar, results in an empty optional. Callers should then fall back to the
+ * SpiceManager on the main thread.
+ *
+ * Supported date strings start with a date in the form `YYYY-MM-DD`, `YYYY-DDD`,
+ * `YYYY MON DD`, or `YYYY-MON-DD`. The date can be followed by a `T` or by spaces and
+ * then a time in the form `HR`, `HR:MN`, or `HR:MN:SC.###`. The string can end in `Z` or
+ * in one of the labels `UTC`, `TDB`, or `TDT`. Month names are case-insensitive and can
+ * be abbreviated to three letters.
+ *
+ * Supported format pictures consist of the tokens `YYYY`, `MM`, `MON`, `Mon`, `mon`,
+ * `MONTH`, `Month`, `month`, `DD`, `DOY`, `HR`, `MN`, and `SC`, where the seconds can be
+ * followed by a fraction `.###`, and the modifiers `::RND`, `::TRNC`, `::UTC`, `::TDB`,
+ * and `::TDT`. All other characters are copied to the output.
+ */
+class EphemerisTimeConverter {
+public:
+    struct LeapSecond {
+        /// The UTC date from which on #deltaAT applies, as the number of seconds past the
+        /// J2000 epoch without counting leap seconds
+        double date = 0.0;
+        /// The difference between TAI and UTC in seconds
+        double deltaAT = 0.0;
+    };
+
+    /// The parameters of the model of TDB - TDT, named as the DELTET variables in a leap
+    /// seconds kernel
+    struct Parameters {
+        double deltaTA = 32.184;
+        double k = 1.657e-3;
+        double eb = 1.671e-2;
+        double m0 = 6.239996;
+        double m1 = 1.99096871e-7;
+    };
+
+    /**
+     * Creates a converter with the parameters and leap seconds of the `naif0012.tls`
+     * kernel that is loaded by the SpiceManager on startup.
+     */
+    EphemerisTimeConverter();
+
+    /**
+     * Creates a converter with the provided \p parameters and \p leapSeconds.
+     *
+     * \pre \p leapSeconds must not be empty and must be sorted by their date
+     */
+    EphemerisTimeConverter(Parameters parameters, std::vector<LeapSecond> leapSeconds);
+
+    /**
+     * Creates a converter from the `DELTET` variables in the \p source of a leap seconds
+     * kernel.
+     *
+     * \throw ghoul::RuntimeError If the kernel does not contain all `DELTET` variables
+     *        or if they could not be parsed
+     */
+    static EphemerisTimeConverter createFromLeapSecondsKernel(std::string_view source);
+
+    /**
+     * Returns the converter for the most recently loaded leap seconds kernel. The
+     * returned reference stays valid for the lifetime of the application.
+     */
+    static const EphemerisTimeConverter& ref();
+
+    /**
+     * Replaces the converter that is returned by #ref. An empty optional resets it to
+     * the default leap seconds. This should only be called from the main thread.
+     */
+    static void setCurrent(std::optional<EphemerisTimeConverter> converter);
+
+    /**
+     * Converts the \p date into ephemeris time. Returns an empty optional if the date is
+     * not in one of the supported forms or not a valid date.
+     */
+    std::optional<double> ephemerisTimeFromDate(std::string_view date) const;
+
+    /**
+     * Converts a UTC date given by the \p year, the \p dayOfYear (starting at 1), and the
+     * number of \p seconds that have passed since the beginning of that day into
+     * ephemeris time.
+     */
+    double ephemerisTimeFromUtc(int year, int dayOfYear, double seconds) const;
+
+    /**
+     * Converts a UTC date given by the \p year, \p month, \p day, and the number of
+     * \p seconds that have passed since the beginning of that day into ephemeris time.
+     */
+    double ephemerisTimeFromUtc(int year, int month, int day, double seconds) const;
+
+    /**
+     * Formats the \p ephemerisTime according to the \p format picture and writes the
+     * null-terminated result into the \p buffer. Returns the length of the result, or
+     * an empty optional if the format is not supported, the date is outside the
+     * supported range, or the \p bufferSize is too small.
+     */
+    std::optional<int> dateFromEphemerisTime(double ephemerisTime,
+        std::string_view format, char* buffer, int bufferSize) const;
+
+    /**
+     * Formats the \p ephemerisTime according to the \p format picture. Returns an empty
+     * optional if the format is not supported or the date is outside the supported
+     * range.
+     */
+    std::optional<std::string> dateFromEphemerisTime(double ephemerisTime,
+        std::string_view format) const;
+
+private:
+    /// A UTC date as the number of days since 2000-01-01 and the seconds into that day
+    struct UtcDate {
+        long long day = 0;
+        double seconds = 0.0;
+        /// The length of the day in seconds, which is longer on days with leap seconds
+        double dayLength = 0.0;
+    };
+
+    double ephemerisTimeFromUtc(long long day, double seconds) const;
+    UtcDate utcFromEphemerisTime(double ephemerisTime) const;
+
+    double tdbFromTdt(double tdt) const;
+    double tdtFromTdb(double tdb) const;
+
+    Parameters _parameters;
+    std::vector<LeapSecond> _leapSeconds;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___EPHEMERISTIMECONVERTER___H__
@@ -0,0 +1,143 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___FRAMEARENA___H__
+#define __OPENSPACE_CORE___FRAMEARENA___H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+#if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
+#include <experimental/memory_resource>
+namespace std {
+    using namespace experimental;
+} // namespace std
+#else
+#include <memory_resource>
+#endif
+
+namespace openspace {
+
+/**
+ * A memory resource for temporary allocations that only have to survive until the end of
+ * the current frame. Every thread that allocates from the arena is handed its own block
+ * of memory from which allocations are served by bumping a pointer, so no lock is taken
+ * unless a new block is needed. Allocations that are too large to fit into a regular
+ * block are served from separate overflow blocks.
+ *
+ * Deallocating memory is a no-op, and instead all memory is reclaimed at once when
+ * #reset is called. The blocks are kept around between frames, so once the arena has
+ * grown to the size that a frame needs, no further memory is requested from the global
+ * heap. Allocating from the arena is safe from multiple threads at the same time. The
+ * statistics of the last completed frame, as well as the largest amount of memory that
+ * was used in any frame, are available through #lastFrame and #highWaterMark.
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+    /// The memory statistics collected for a single frame
+    struct FrameStatistics {
+        /// The number of bytes that were requested from the arena
+        size_t usedBytes = 0;
+        /// The number of bytes that were too large to fit into a regular block
+        size_t overflowBytes = 0;
+        /// The number of times that memory had to be requested from the global heap
+        int nHeapAllocations = 0;
+    };
+
+    /**
+     * Creates an arena whose regular blocks are \p blockSize bytes large. No memory is
+     * allocated until the first allocation request.
+     *
+     * \pre \p blockSize must be bigger than 0
+     */
+    explicit FrameArena(size_t blockSize = 64 * 1024);
+    ~FrameArena() override;
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    /**
+     * Reclaims all memory that has been allocated since the last call and stores the
+     * statistics of the frame that has ended. This function must not be called while
+     * other threads are allocating from the arena.
+     */
+    void reset();
+
+    /**
+     * Returns the statistics of the last frame, that is the memory that was used between
+     * the last two calls to #reset.
+     */
+    FrameStatistics lastFrame() const;
+
+    /**
+     * Returns the largest number of bytes that were used in a single frame.
+     */
+    size_t highWaterMark() const;
+
+    /**
+     * Returns the total number of bytes that the arena currently holds, including the
+     * parts of the blocks that are not used.
+     */
+    size_t capacity() const;
+
+private:
+    struct Block {
+        std::byte* data = nullptr;
+        size_t size = 0;
+        bool isUsed = false;
+    };
+
+    void* do_allocate(size_t bytes, size_t alignment) override;
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override;
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+    /// Returns the next unused regular block, allocating a new one if necessary
+    Block nextBlock();
+
+    /// Returns the smallest unused overflow block that has room for \p bytes
+    Block overflowBlock(size_t bytes);
+
+    const size_t _blockSize;
+
+    mutable std::mutex _mutex;
+    std::vector<Block> _blocks;
+    size_t _nUsedBlocks = 0;
+    std::vector<Block> _overflowBlocks;
+
+    /// Identifies the current frame; thread-local blocks from other frames are stale
+    std::atomic<uint64_t> _generation;
+    std::atomic<size_t> _usedBytes = 0;
+    std::atomic<size_t> _overflowBytes = 0;
+    std::atomic<int> _nHeapAllocations = 0;
+
+    FrameStatistics _lastFrame;
+    size_t _highWaterMark = 0;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___FRAMEARENA___H__
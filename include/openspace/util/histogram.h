@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_CORE___HISTOGRAM___H__
 #define __OPENSPACE_CORE___HISTOGRAM___H__
 
+#include <span>
 #include <vector>
 
 namespace openspace {
@@ -55,6 +56,51 @@ public:
     bool add(const Histogram& histogram);
     bool addRectangle(float lowBin, float highBin, float value);
 
+    /**
+     * Enters all \p values into the histogram. The result is the same as calling #add for
+     * each value, but the bin indices are computed in blocks by a loop that the compiler
+     * can vectorize. Values outside of the histogram's range are ignored.
+     *
+     * \param values The values to insert into the histogram
+     * \return The number of values that were inside the histogram's range
+     */
+    size_t add(std::span<const float> values);
+
+    /**
+     * Enters all \p values into the histogram, where each value increments its bin by the
+     * corresponding entry in \p weights. Values outside of the histogram's range are
+     * ignored.
+     *
+     * \param values The values to insert into the histogram
+     * \param weights The weight for each of the values, must be as long as \p values
+     * \return The number of values that were inside the histogram's range
+     */
+    size_t add(std::span<const float> values, std::span<const float> weights);
+
+    /**
+     * Enters all \p values into the histogram using \p nThreads threads. Each thread
+     * fills its own partial histogram from a part of the values, and the partial
+     * histograms are then merged into this histogram in parallel, with each thread
+     * merging a range of bins. The bins can differ from #add in the last digits, as the
+     * additions happen in a different order.
+     *
+     * \param values The values to insert into the histogram
+     * \param nThreads The maximum number of threads to use
+     * \return The number of values that were inside the histogram's range
+     */
+    size_t addParallel(std::span<const float> values, unsigned int nThreads);
+
+    /**
+     * Adds many rectangles at the same time. The result is the same as calling
+     * #addRectangle for each triplet of \p lowBins, \p highBins, and \p values, up to
+     * rounding, but the runtime no longer depends on the width of the rectangles, as the
+     * rectangles are accumulated as differences that are summed up once at the end.
+     *
+     * \return The number of rectangles that were inside the histogram's range
+     */
+    size_t addRectangles(std::span<const float> lowBins, std::span<const float> highBins,
+        std::span<const float> values);
+
     float interpolate(float bin) const;
     float sample(int binIndex) const;
     const float* data() const;
@@ -25,17 +25,37 @@
 #ifndef __OPENSPACE_CORE___MEMORYMANAGER___H__
 #define __OPENSPACE_CORE___MEMORYMANAGER___H__
 
+#include <openspace/properties/propertyowner.h>
+
+#include <openspace/properties/scalar/intproperty.h>
+#include <openspace/properties/scalar/ulongproperty.h>
+#include <openspace/util/framearena.h>
 #include <ghoul/misc/memorypool.h>
 
 namespace openspace {
 
-class MemoryManager {
+class MemoryManager : public properties::PropertyOwner {
 public:
+    MemoryManager();
+
+    /**
+     * Reclaims all memory that was allocated from the #TemporaryMemory in the last frame
+     * and updates the properties with the memory usage of that frame. This function must
+     * only be called from the main thread between two frames.
+     */
+    void resetTemporaryMemory();
+
     ghoul::MemoryPool<8 * 1024 * 1024> PersistentMemory;
 
-    // This should be replaced with a std::pmr::memory_resource wrapper around our own
-    // Memory pool so that we can get a high-water mark out of it
-    ghoul::MemoryPool<100 * 4096, false, true> TemporaryMemory;
+    /// Memory for allocations that only have to live until the end of the current frame
+    FrameArena TemporaryMemory;
+
+private:
+    properties::ULongProperty _frameUsage;
+    properties::ULongProperty _highWaterMark;
+    properties::ULongProperty _frameOverflow;
+    properties::IntProperty _frameHeapAllocations;
+    properties::ULongProperty _temporaryCapacity;
 };
 
 } // namespace openspace
@@ -0,0 +1,80 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___MEMORYMAPPEDFILE___H__
+#define __OPENSPACE_CORE___MEMORYMAPPEDFILE___H__
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace openspace {
+
+/**
+ * A read-only view of the contents of a file that is mapped into memory. The operating
+ * system pages in the parts of the file that are accessed, so random access into large
+ * data files does not require reading the entire file, or seeking and copying through a
+ * stream. The mapping is released when the object is destroyed, which invalidates all
+ * spans returned from #data.
+ */
+class MemoryMappedFile {
+public:
+    /**
+     * Maps the file at \p path into memory.
+     *
+     * \throw ghoul::RuntimeError If the file cannot be opened or mapped
+     */
+    explicit MemoryMappedFile(const std::filesystem::path& path);
+    ~MemoryMappedFile();
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    /**
+     * Returns the contents of the file.
+     */
+    std::span<const std::byte> data() const;
+
+    /**
+     * Returns the size of the file in bytes.
+     */
+    size_t size() const;
+
+private:
+    void unmap();
+
+    const std::byte* _data = nullptr;
+    size_t _size = 0;
+
+#ifdef WIN32
+    void* _file = nullptr;
+    void* _mapping = nullptr;
+#endif // WIN32
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___MEMORYMAPPEDFILE___H__
@@ -1065,6 +1065,13 @@ private:
      */
     void findSpkCoverage(const std::string& path);
 
+    /**
+     * Updates the EphemerisTimeConverter with the leap seconds of the most recently
+     * loaded leap seconds kernel, or resets it to the default leap seconds if no such
+     * kernel is loaded.
+     */
+    void updateEphemerisTimeConverter();
+
     /**
      * If a position is requested for an uncovered time in the SPK kernels, this function
      * will return an estimated position. If the coverage has not yet started, the first
@@ -25,8 +25,11 @@
 #ifndef __OPENSPACE_CORE___TASK___H__
 #define __OPENSPACE_CORE___TASK___H__
 
+#include <filesystem>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace ghoul { class Dictionary; }
 
@@ -42,11 +45,68 @@ public:
     virtual void perform(const ProgressCallback& onProgress) = 0;
     virtual std::string description() = 0;
 
+    /**
+     * Returns the files that are read by this task. A task that reads a file that is
+     * produced by another task implicitly depends on that task. The default
+     * implementation does not declare any inputs.
+     */
+    virtual std::vector<std::filesystem::path> inputs() const;
+
+    /**
+     * Returns the files that are written by this task. If all of the outputs exist and
+     * are newer than all inputs, the task is considered up to date and can be skipped.
+     * The default implementation does not declare any outputs, which means that the task
+     * is never considered to be up to date.
+     */
+    virtual std::vector<std::filesystem::path> outputs() const;
+
+    /**
+     * Returns an estimate of the peak memory usage of this task in bytes, which is used
+     * to respect the memory budget when running tasks concurrently. A value of 0 means
+     * that the memory usage is unknown or negligible.
+     */
+    virtual size_t memoryEstimate() const;
+
+    /**
+     * Returns the number of worker threads that this task is able to make use of. The
+     * number of threads that are actually granted is available through #numThreads
+     * while the task is performed.
+     */
+    virtual unsigned int requestedThreads() const;
+
+    /**
+     * Returns whether this task can be performed at the same time as other tasks. Tasks
+     * that use global state that is not thread-safe, such as the SpiceManager, should
+     * return `false`.
+     */
+    virtual bool canRunConcurrently() const;
+
+    /**
+     * The identifier used by other tasks to refer to this task in their dependencies.
+     * Can be empty.
+     */
+    const std::string& identifier() const;
+
+    /**
+     * The identifiers of the tasks that have to be finished before this task can run. If
+     * any of these tasks is performed, this task is performed as well, even if its
+     * outputs are up to date.
+     */
+    const std::vector<std::string>& dependencies() const;
+
+    void setNumThreads(unsigned int nThreads);
+    unsigned int numThreads() const;
+
     static std::unique_ptr<Task> createFromDictionary(
         const ghoul::Dictionary& dictionary
     );
 
     static documentation::Documentation documentation();
+
+private:
+    std::string _identifier;
+    std::vector<std::string> _dependencies;
+    unsigned int _nThreads = 1;
 };
 
 } // namespace openspace
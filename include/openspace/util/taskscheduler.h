@@ -0,0 +1,100 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_CORE___TASKSCHEDULER___H__
+#define __OPENSPACE_CORE___TASKSCHEDULER___H__
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace openspace {
+
+class Task;
+
+/**
+ * Performs a list of tasks while respecting the dependencies between them. Tasks whose
+ * dependencies have been fulfilled are run concurrently as long as the number of threads
+ * and the memory budget allows it. Dependencies are either declared explicitly through
+ * the identifiers of other tasks, or implicitly if a task reads one of the outputs of an
+ * earlier task. Tasks whose outputs are newer than all of their inputs are skipped,
+ * unless one of their dependencies has been performed.
+ */
+class TaskScheduler {
+public:
+    struct Settings {
+        /// The total number of threads that can be used by tasks at the same time
+        unsigned int nThreads = 1;
+
+        /// The maximum sum of the memory estimates of all running tasks in bytes. A
+        /// value of 0 means that the memory usage is not limited. A single task whose
+        /// estimate exceeds the budget is still run, but only on its own
+        size_t memoryBudget = 0;
+
+        /// If this is `true`, tasks are always performed, even if they are up to date
+        bool forceRun = false;
+
+        /// Additional files that are treated as inputs of every task, for example the
+        /// file that the tasks were loaded from
+        std::vector<std::filesystem::path> commonInputs;
+    };
+
+    enum class Status {
+        Performed,
+        UpToDate,
+        Failed,
+        DependencyFailed
+    };
+
+    struct Result {
+        std::string description;
+        Status status = Status::Failed;
+        std::chrono::duration<double> duration = std::chrono::duration<double>(0.0);
+        unsigned int nThreads = 0;
+    };
+
+    explicit TaskScheduler(Settings settings);
+
+    /**
+     * Performs all \p tasks and blocks until they are finished. The returned results are
+     * in the same order as the \p tasks.
+     */
+    std::vector<Result> performTasks(const std::vector<std::unique_ptr<Task>>& tasks);
+
+    /**
+     * Logs a summary of the \p results with the status and duration of every task.
+     */
+    static void logSummary(const std::vector<Result>& results);
+
+private:
+    bool isUpToDate(const Task& task) const;
+
+    Settings _settings;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_CORE___TASKSCHEDULER___H__
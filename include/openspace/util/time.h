@@ -50,7 +50,8 @@ public:
     /**
      * Converts the \p timeString representing a date to a double precision value
      * representing the ephemeris time; that is the number of TDB seconds past the J2000
-     * epoch.
+     * epoch. Dates in the forms supported by the EphemerisTimeConverter are converted
+     * without calling SPICE and this function can be called from any thread for those.
      *
      * \param time A string representing the time to be converted
      * \return The converted time; the number of TDB seconds past the J2000 epoch,
@@ -25,9 +25,11 @@
 #include <modules/atmosphere/atmospheremodule.h>
 
 #include <modules/atmosphere/rendering/renderableatmosphere.h>
+#include <modules/atmosphere/tasks/atmospheretablestask.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/rendering/renderable.h>
 #include <openspace/util/factorymanager.h>
+#include <openspace/util/task.h>
 #include <ghoul/misc/assert.h>
 #include <ghoul/misc/templatefactory.h>
 
@@ -41,11 +43,16 @@ void AtmosphereModule::internalInitialize(const ghoul::Dictionary&) {
     ghoul_assert(fRenderable, "No renderable factory existed");
 
     fRenderable->registerClass<RenderableAtmosphere>("RenderableAtmosphere");
+
+    ghoul::TemplateFactory<Task>* fTask = FactoryManager::ref().factory<Task>();
+    ghoul_assert(fTask, "No task factory existed");
+    fTask->registerClass<atmosphere::AtmosphereTablesTask>("AtmosphereTablesTask");
 }
 
 std::vector<documentation::Documentation> AtmosphereModule::documentations() const {
     return {
-        RenderableAtmosphere::Documentation()
+        RenderableAtmosphere::Documentation(),
+        atmosphere::AtmosphereTablesTask::Documentation()
     };
 }
 } // namespace openspace
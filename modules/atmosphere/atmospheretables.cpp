@@ -0,0 +1,930 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+ /***************************************************************************************
+ * Modified part of the code (4D texture mechanism) from Eric Bruneton is used in the
+ * following code.
+ ****************************************************************************************/
+
+/**
+ * Precomputed Atmospheric Scattering
+ * Copyright (c) 2008 INRIA
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification, are
+ * permitted provided that the following conditions are met:
+ * 1. Redistributions of source code must retain the above copyright notice, this list of
+ *    conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright notice, this list
+ *    of conditions and the following disclaimer in the documentation and/or other
+ *    materials provided with the distribution.
+ * 3. Neither the name of the copyright holders nor the names of its contributors may be
+ *    used to endorse or promote products derived from this software without specific
+ *    prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ * THE COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF
+ * THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <modules/atmosphere/atmospheretables.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/crc32.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "AtmosphereTables";
+
+    // This version has to be increased whenever the precomputation or the file format
+    // changes, which invalidates all previously cached tables
+    constexpr int8_t CurrentCacheVersion = 1;
+
+    // The following constants have to match the values in the shaders
+    constexpr float Pi = 3.141592657f;
+    constexpr float AtmosphereEpsilon = 1.f;
+    constexpr int TransmittanceSteps = 500;
+    constexpr int InscatterIntegralSamples = 50;
+    constexpr int InscatterSphericalIntegralSamples = 16;
+    constexpr int IrradianceIntegralSamples = 32;
+
+    // The number of steps that are reported through the progress callback. One step for
+    // each of the first three lines of algorithm 4.1 and three steps for each of the
+    // three higher scattering orders
+    constexpr int NProgressSteps = 12;
+
+    using openspace::atmosphere::LookupTables;
+    using openspace::atmosphere::TableParameters;
+    using openspace::atmosphere::TableSizes;
+
+    constexpr int NParameterValues = 21;
+    std::array<float, NParameterValues> serialize(const TableParameters& p) {
+        return {
+            p.planetRadius, p.atmosphereRadius, p.averageGroundReflectance,
+            p.rayleighHeightScale, p.rayleighScatteringCoeff.x,
+            p.rayleighScatteringCoeff.y, p.rayleighScatteringCoeff.z,
+            p.ozoneEnabled ? 1.f : 0.f, p.ozoneHeightScale, p.ozoneExtinctionCoeff.x,
+            p.ozoneExtinctionCoeff.y, p.ozoneExtinctionCoeff.z, p.mieHeightScale,
+            p.mieScatteringCoeff.x, p.mieScatteringCoeff.y, p.mieScatteringCoeff.z,
+            p.mieExtinctionCoeff.x, p.mieExtinctionCoeff.y, p.mieExtinctionCoeff.z,
+            p.miePhaseConstant, p.textureScale
+        };
+    }
+
+    template <typename Func>
+    void parallelFor(int n, unsigned int nThreads, Func&& func) {
+        std::atomic<int> next = 0;
+        auto work = [&]() {
+            for (int i = next++; i < n; i = next++) {
+                func(i);
+            }
+        };
+
+        const unsigned int nWorkers = std::min(nThreads, static_cast<unsigned int>(n));
+        std::vector<std::thread> threads;
+        for (unsigned int i = 1; i < nWorkers; i++) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+    }
+
+    // Unlike glm::min, this returns the non-NaN argument, which matches the behavior of
+    // the GPU when a transmittance ratio is 0/0
+    glm::vec3 minimum(const glm::vec3& v, float m) {
+        return glm::vec3(std::fmin(v.x, m), std::fmin(v.y, m), std::fmin(v.z, m));
+    }
+
+    struct TexelRange {
+        int first;
+        int second;
+        float fraction;
+    };
+
+    // Computes the two texels and the interpolation factor that a linearly filtered
+    // texture lookup with GL_CLAMP_TO_EDGE wrapping uses for the coordinate u
+    TexelRange texelRange(float u, int size) {
+        // Non-finite coordinates only occur in degenerate cases for which the result on
+        // the GPU is undefined as well
+        if (!std::isfinite(u)) {
+            u = 0.f;
+        }
+        const float x = std::clamp(u * size - 0.5f, -1.f, static_cast<float>(size));
+        const float base = std::floor(x);
+        const int i = static_cast<int>(base);
+        return {
+            std::clamp(i, 0, size - 1),
+            std::clamp(i + 1, 0, size - 1),
+            x - base
+        };
+    }
+
+    glm::vec3 texel(const std::vector<float>& table, size_t index, int nComponents) {
+        const float* t = &table[index * nComponents];
+        return glm::vec3(t[0], t[1], t[2]);
+    }
+
+    glm::vec3 sample2D(const std::vector<float>& table, const glm::ivec2& size,
+                       float u, float v)
+    {
+        const TexelRange x = texelRange(u, size.x);
+        const TexelRange y = texelRange(v, size.y);
+        auto t = [&](int i, int j) { return texel(table, j * size.x + i, 3); };
+
+        return glm::mix(
+            glm::mix(t(x.first, y.first), t(x.second, y.first), x.fraction),
+            glm::mix(t(x.first, y.second), t(x.second, y.second), x.fraction),
+            y.fraction
+        );
+    }
+
+    glm::vec3 sample3D(const std::vector<float>& table, const glm::ivec3& size,
+                       float u, float v, float w)
+    {
+        const TexelRange x = texelRange(u, size.x);
+        const TexelRange y = texelRange(v, size.y);
+        const TexelRange z = texelRange(w, size.z);
+        auto t = [&](int i, int j, int k) {
+            return texel(table, (static_cast<size_t>(k) * size.y + j) * size.x + i, 3);
+        };
+
+        auto bilinear = [&](int k) {
+            return glm::mix(
+                glm::mix(t(x.first, y.first, k), t(x.second, y.first, k), x.fraction),
+                glm::mix(t(x.first, y.second, k), t(x.second, y.second, k), x.fraction),
+                y.fraction
+            );
+        };
+        return glm::mix(bilinear(z.first), bilinear(z.second), z.fraction);
+    }
+
+    float rayleighPhaseFunction(float mu) {
+        return 0.0596831036f * (1.f + mu * mu);
+    }
+
+    float miePhaseFunction(float mu, float mieG) {
+        const float mieG2 = mieG * mieG;
+        return 0.1193662072f * (1.f - mieG2) *
+            std::pow(1.f + mieG2 - 2.f * mieG * mu, -1.5f) * (1.f + mu * mu) /
+            (2.f + mieG2);
+    }
+
+    // The texture coordinates of the two lookups in the 3D texture that make up a single
+    // lookup in the 4D table
+    struct Lookup4D {
+        float xFirst;
+        float xSecond;
+        float y;
+        float z;
+        float t;
+    };
+
+    // The intermediate tables of the calculation. The 3D tables only store the RGB
+    // components
+    struct Workspace {
+        std::vector<float> transmittance;
+        std::vector<float> deltaE;
+        std::vector<float> deltaSRayleigh;
+        std::vector<float> deltaSMie;
+        std::vector<float> deltaJ;
+    };
+
+    // The geometry of a single layer in the 3D textures. See
+    // AtmosphereDeferredcaster::step3DTexture
+    struct Layer {
+        float r;
+        glm::vec4 dhdH;
+    };
+
+    struct Angles {
+        float mu;
+        float muSun;
+        float nu;
+    };
+
+    struct Calculation {
+        Calculation(const TableParameters& parameters, const TableSizes& sizes)
+            : p(parameters)
+            , sizes(sizes)
+            , size3D(sizes.inScattering())
+            , Rg(parameters.planetRadius)
+            , Rt(parameters.atmosphereRadius)
+        {}
+
+        float rayDistance(float r, float mu) const;
+        glm::vec3 transmittance(float r, float mu) const;
+        glm::vec3 transmittance(float r, float mu, float d) const;
+        Lookup4D lookup4D(float r, float mu, float muSun, float nu) const;
+        glm::vec3 sample4D(const std::vector<float>& table, const Lookup4D& l) const;
+        Layer layer(int index) const;
+        Angles unmapMuMuSunNu(const Layer& layer, int x, int y) const;
+
+        float opticalDepth(float r, float mu, float H) const;
+        glm::vec3 transmittanceTexel(int x, int y) const;
+        glm::vec3 irradianceTexel(int x, int y) const;
+        std::pair<glm::vec3, glm::vec3> singleInscatter(float r, const Angles& a) const;
+        glm::vec3 radianceJ(float r, Angles a, bool firstIteration) const;
+        glm::vec3 irradianceSup(int x, int y, bool firstIteration) const;
+        glm::vec3 inscatterSup(float r, const Angles& a) const;
+
+        const TableParameters& p;
+        const TableSizes& sizes;
+        const glm::ivec3 size3D;
+        const float Rg;
+        const float Rt;
+        Workspace w;
+    };
+
+    float Calculation::rayDistance(float r, float mu) const {
+        const float atmRadiusEps2 = (Rt + AtmosphereEpsilon) * (Rt + AtmosphereEpsilon);
+        const float mu2 = mu * mu;
+        const float r2 = r * r;
+        const float rayDistanceAtmosphere =
+            -r * mu + std::sqrt(r2 * (mu2 - 1.f) + atmRadiusEps2);
+        const float delta = r2 * (mu2 - 1.f) + Rg * Rg;
+        if (delta >= 0.f) {
+            const float rayDistanceGround = -r * mu - std::sqrt(delta);
+            if (rayDistanceGround >= 0.f) {
+                return std::min(rayDistanceAtmosphere, rayDistanceGround);
+            }
+        }
+        return rayDistanceAtmosphere;
+    }
+
+    glm::vec3 Calculation::transmittance(float r, float mu) const {
+        const float uR = std::sqrt((r - Rg) / (Rt - Rg));
+        const float uMu = std::atan((mu + 0.15f) / 1.15f * std::tan(1.5f)) / 1.5f;
+        return sample2D(w.transmittance, sizes.transmittance, uMu, uR);
+    }
+
+    glm::vec3 Calculation::transmittance(float r, float mu, float d) const {
+        const float ri = std::sqrt(d * d + r * r + 2.f * r * d * mu);
+        const float mui = (d + r * mu) / ri;
+        glm::vec3 res;
+        if (mu > 0.f) {
+            res = transmittance(r, mu) / transmittance(ri, mui);
+        }
+        else {
+            res = transmittance(ri, -mui) / transmittance(r, -mu);
+        }
+        return minimum(res, 1.f);
+    }
+
+    Lookup4D Calculation::lookup4D(float r, float mu, float muSun, float nu) const {
+        const float samplesR = static_cast<float>(sizes.rSamples);
+        const float samplesMu = static_cast<float>(sizes.muSamples);
+        const float samplesMuS = static_cast<float>(sizes.muSSamples);
+        const float samplesNu = static_cast<float>(sizes.nuSamples);
+
+        const float r2 = r * r;
+        const float Rg2 = Rg * Rg;
+        const float Rt2 = Rt * Rt;
+        const float rho = std::sqrt(r2 - Rg2);
+        const float rmu = r * mu;
+        const float delta = rmu * rmu - r2 + Rg2;
+        const glm::vec4 cst = (rmu < 0.f && delta > 0.f) ?
+            glm::vec4(1.f, 0.f, 0.f, 0.5f - 0.5f / samplesMu) :
+            glm::vec4(-1.f, Rt2 - Rg2, std::sqrt(Rt2 - Rg2), 0.5f + 0.5f / samplesMu);
+        const float uR =
+            0.5f / samplesR + rho / std::sqrt(Rt2 - Rg2) * (1.f - 1.f / samplesR);
+        const float uMu = cst.w + (rmu * cst.x + std::sqrt(delta + cst.y)) /
+            (rho + cst.z) * (0.5f - 1.f / samplesMu);
+        const float uMuS = 0.5f / samplesMuS +
+            (std::atan(std::max(muSun, -0.1975f) * std::tan(1.386f)) *
+            0.9090909090909090f + 0.74f) * 0.5f * (1.f - 1.f / samplesMuS);
+        float t = (nu + 1.f) / 2.f * (samplesNu - 1.f);
+        const float uNu = std::floor(t);
+        t = t - uNu;
+
+        return {
+            (uNu + uMuS) / samplesNu,
+            (uNu + uMuS + 1.f) / samplesNu,
+            uMu,
+            uR,
+            t
+        };
+    }
+
+    glm::vec3 Calculation::sample4D(const std::vector<float>& table,
+                                    const Lookup4D& l) const
+    {
+        return glm::mix(
+            sample3D(table, size3D, l.xFirst, l.y, l.z),
+            sample3D(table, size3D, l.xSecond, l.y, l.z),
+            l.t
+        );
+    }
+
+    Layer Calculation::layer(int index) const {
+        const float planet2 = Rg * Rg;
+        const float diff = Rt * Rt - planet2;
+        const float ri =
+            static_cast<float>(index) / static_cast<float>(sizes.rSamples - 1);
+        float eps = 0.01f;
+        if (index > 0) {
+            eps = (index == sizes.rSamples - 1) ? -0.001f : 0.f;
+        }
+        const float r = std::sqrt(planet2 + ri * ri * diff) + eps;
+        const float dminG = r - Rg;
+        const float dminT = Rt - r;
+        const float dh = std::sqrt(r * r - planet2);
+        const float dH = dh + std::sqrt(diff);
+        return { r, glm::vec4(dminT, dH, dminG, dh) };
+    }
+
+    Angles Calculation::unmapMuMuSunNu(const Layer& layer, int x, int y) const {
+        const float r = layer.r;
+        const glm::vec4& dhdH = layer.dhdH;
+        const float fragmentX = static_cast<float>(x);
+        const float fragmentY = static_cast<float>(y);
+
+        const float r2 = r * r;
+        const float Rg2 = Rg * Rg;
+        const float halfSampleMu = static_cast<float>(sizes.muSamples) / 2.f;
+
+        Angles res;
+        if (fragmentY < halfSampleMu) {
+            const float ud = 1.f - (fragmentY / (halfSampleMu - 1.f));
+            const float d = std::min(std::max(dhdH.z, ud * dhdH.w), dhdH.w * 0.999f);
+            res.mu = (Rg2 - r2 - d * d) / (2.f * r * d);
+            res.mu = std::min(res.mu, -std::sqrt(1.f - (Rg2 / r2)) - 0.001f);
+        }
+        else {
+            float d = (fragmentY - halfSampleMu) / (halfSampleMu - 1.f);
+            d = std::min(std::max(dhdH.x, d * dhdH.y), dhdH.y * 0.999f);
+            res.mu = (Rt * Rt - r2 - d * d) / (2.f * r * d);
+        }
+
+        const float samplesMuS = static_cast<float>(sizes.muSSamples);
+        const float modValueMuSun =
+            static_cast<float>(x % sizes.muSSamples) / (samplesMuS - 1.f);
+        res.muSun = std::tan((2.f * modValueMuSun - 1.f + 0.26f) * 1.1f) /
+            std::tan(1.26f * 1.1f);
+        res.nu = -1.f + std::floor(fragmentX / samplesMuS) /
+            (static_cast<float>(sizes.nuSamples) - 1.f) * 2.f;
+        return res;
+    }
+
+    // transmittance_calc_fs.glsl
+    float Calculation::opticalDepth(float r, float mu, float H) const {
+        const float r2 = r * r;
+        const float cosZenithHorizon = -std::sqrt(1.f - ((Rg * Rg) / r2));
+        if (mu < cosZenithHorizon) {
+            return 1e9f;
+        }
+
+        const float bA = rayDistance(r, mu);
+        const float deltaStep = bA / static_cast<float>(TransmittanceSteps);
+        float yI = std::exp(-(r - Rg) / H);
+        float accumulation = 0.f;
+        for (int i = 1; i <= TransmittanceSteps; i++) {
+            const float xI = static_cast<float>(i) * deltaStep;
+            const float yII =
+                std::exp(-(std::sqrt(r2 + xI * xI + 2.f * xI * r * mu) - Rg) / H);
+            accumulation += (yII + yI);
+            yI = yII;
+        }
+        return accumulation * (bA / (2.f * TransmittanceSteps));
+    }
+
+    glm::vec3 Calculation::transmittanceTexel(int x, int y) const {
+        const float uMu = (x + 0.5f) / static_cast<float>(sizes.transmittance.x);
+        const float uR = (y + 0.5f) / static_cast<float>(sizes.transmittance.y);
+        const float r = Rg + (uR * uR) * (Rt - Rg);
+        const float muSun = -0.15f + std::tan(1.5f * uMu) / std::tan(1.5f) * 1.15f;
+
+        glm::vec3 ozoneContribution = glm::vec3(0.f);
+        if (p.ozoneEnabled) {
+            ozoneContribution = p.ozoneExtinctionCoeff * 0.0000006f *
+                opticalDepth(r, muSun, p.ozoneHeightScale);
+        }
+        const glm::vec3 opDepth = ozoneContribution +
+            p.mieExtinctionCoeff * opticalDepth(r, muSun, p.mieHeightScale) +
+            p.rayleighScatteringCoeff * opticalDepth(r, muSun, p.rayleighHeightScale);
+        return glm::exp(-opDepth);
+    }
+
+    // irradiance_calc_fs.glsl
+    glm::vec3 Calculation::irradianceTexel(int x, int y) const {
+        const float muSun =
+            -0.2f + x / (static_cast<float>(sizes.irradiance.x) - 1.f) * 1.2f;
+        const float r = Rg + y / static_cast<float>(sizes.irradiance.y) * (Rt - Rg);
+        return transmittance(r, muSun) * std::max(muSun, 0.f);
+    }
+
+    // inScattering_calc_fs.glsl
+    std::pair<glm::vec3, glm::vec3> Calculation::singleInscatter(float r,
+                                                                 const Angles& a) const
+    {
+        auto integrand = [&](float y) -> std::pair<glm::vec3, glm::vec3> {
+            const float ri = std::max(std::sqrt(r * r + y * y + 2.f * r * a.mu * y), Rg);
+            const float muSunI = (a.nu * y + a.muSun * r) / ri;
+            if (muSunI < -std::sqrt(1.f - Rg * Rg / (ri * ri))) {
+                return { glm::vec3(0.f), glm::vec3(0.f) };
+            }
+
+            const glm::vec3 transmittanceY =
+                transmittance(r, a.mu, y) * transmittance(ri, muSunI);
+            const float rayleigh = p.ozoneEnabled ?
+                std::exp(-(ri - Rg) / p.ozoneHeightScale) +
+                    std::exp(-(ri - Rg) / p.rayleighHeightScale) :
+                std::exp(-(ri - Rg) / p.rayleighHeightScale);
+            return {
+                rayleigh * transmittanceY,
+                std::exp(-(ri - Rg) / p.mieHeightScale) * transmittanceY
+            };
+        };
+
+        glm::vec3 sR = glm::vec3(0.f);
+        glm::vec3 sM = glm::vec3(0.f);
+        const float rayDist = rayDistance(r, a.mu);
+        const float dy = rayDist / static_cast<float>(InscatterIntegralSamples);
+        auto [sRi, sMi] = integrand(0.f);
+        for (int i = 1; i <= InscatterIntegralSamples; i++) {
+            const float yj = static_cast<float>(i) * dy;
+            const auto [sRj, sMj] = integrand(yj);
+            sR += (sRi + sRj);
+            sM += (sMi + sMj);
+            sRi = sRj;
+            sMi = sMj;
+        }
+        const float factor =
+            rayDist / (2.f * static_cast<float>(InscatterIntegralSamples));
+        return {
+            sR * (p.rayleighScatteringCoeff * factor),
+            sM * (p.mieScatteringCoeff * factor)
+        };
+    }
+
+    // deltaJ_calc_fs.glsl
+    glm::vec3 Calculation::radianceJ(float r, Angles a, bool firstIteration) const {
+        constexpr float StepPhi = (2.f * Pi) / InscatterSphericalIntegralSamples;
+        constexpr float StepTheta = Pi / InscatterSphericalIntegralSamples;
+
+        r = std::clamp(r, Rg, Rt);
+        a.mu = std::clamp(a.mu, -1.f, 1.f);
+        a.muSun = std::clamp(a.muSun, -1.f, 1.f);
+
+        const float mu2 = a.mu * a.mu;
+        const float muSun2 = a.muSun * a.muSun;
+        const float sinThetaSinSigma = std::sqrt(1.f - mu2) * std::sqrt(1.f - muSun2);
+        a.nu = std::clamp(
+            a.nu,
+            a.muSun * a.mu - sinThetaSinSigma,
+            a.muSun * a.mu + sinThetaSinSigma
+        );
+
+        const float Rg2 = Rg * Rg;
+        const float r2 = r * r;
+        const float cosHorizon = -std::sqrt(r2 - Rg2) / r;
+        const glm::vec3 v = glm::vec3(std::sqrt(1.f - mu2), 0.f, a.mu);
+        const float sx = (v.x == 0.f) ? 0.f : (a.nu - a.muSun * a.mu) / v.x;
+        const glm::vec3 s = glm::vec3(
+            sx,
+            std::sqrt(std::max(0.f, 1.f - sx * sx - muSun2)),
+            a.muSun
+        );
+
+        // The density terms only depend on the height, so they are constant for the
+        // entire integral
+        const glm::vec3 rayleighDensity =
+            p.rayleighScatteringCoeff * std::exp(-(r - Rg) / p.rayleighHeightScale);
+        const glm::vec3 mieDensity =
+            p.mieScatteringCoeff * std::exp(-(r - Rg) / p.mieHeightScale);
+
+        glm::vec3 radianceJAcc = glm::vec3(0.f);
+        for (int thetaI = 0; thetaI < InscatterSphericalIntegralSamples; thetaI++) {
+            const float theta = (static_cast<float>(thetaI) + 0.5f) * StepTheta;
+            const float cosTheta = std::cos(theta);
+            const float sinTheta = std::sin(theta);
+            const float cosTheta2 = cosTheta * cosTheta;
+            const float dw = StepTheta * StepPhi * sinTheta;
+
+            const bool hitsGround = cosTheta < cosHorizon;
+            float distanceToGround = 0.f;
+            glm::vec3 groundTransmittance = glm::vec3(0.f);
+            if (hitsGround) {
+                distanceToGround =
+                    -r * cosTheta - std::sqrt(r2 * (cosTheta2 - 1.f) + Rg2);
+                const float muGround = -(r * cosTheta + distanceToGround) / Rg;
+                groundTransmittance = transmittance(Rg, muGround, distanceToGround);
+            }
+            const float groundReflectance = p.averageGroundReflectance / Pi;
+
+            for (int phiI = 0; phiI < InscatterSphericalIntegralSamples; phiI++) {
+                const float phi = (static_cast<float>(phiI) + 0.5f) * StepPhi;
+                const glm::vec3 wv = glm::vec3(
+                    sinTheta * std::cos(phi),
+                    sinTheta * std::sin(phi),
+                    cosTheta
+                );
+
+                const float nuWV = glm::dot(v, wv);
+                const float phaseRayleighWV = rayleighPhaseFunction(nuWV);
+                const float phaseMieWV = miePhaseFunction(nuWV, p.miePhaseConstant);
+
+                // The radiance of the light that is reflected from the ground, if the
+                // ray hits the ground
+                glm::vec3 radianceJ1 = glm::vec3(0.f);
+                if (hitsGround) {
+                    const glm::vec3 groundNormal =
+                        (glm::vec3(0.f, 0.f, r) + distanceToGround * wv) / Rg;
+                    const float muSunGround = glm::dot(groundNormal, s);
+                    const glm::vec3 groundIrradiance = sample2D(
+                        w.deltaE,
+                        sizes.irradiance,
+                        (muSunGround + 0.2f) / 1.2f,
+                        0.f
+                    );
+                    radianceJ1 = groundTransmittance * groundReflectance *
+                        groundIrradiance;
+                }
+
+                const float nuSW = glm::dot(s, wv);
+                const Lookup4D l = lookup4D(r, wv.z, a.muSun, nuSW);
+                if (firstIteration) {
+                    const float phaseRaySW = rayleighPhaseFunction(nuSW);
+                    const float phaseMieSW = miePhaseFunction(nuSW, p.miePhaseConstant);
+                    radianceJ1 += sample4D(w.deltaSRayleigh, l) * phaseRaySW +
+                        sample4D(w.deltaSMie, l) * phaseMieSW;
+                }
+                else {
+                    radianceJ1 += sample4D(w.deltaSRayleigh, l);
+                }
+
+                radianceJAcc += radianceJ1 *
+                    (rayleighDensity * phaseRayleighWV + mieDensity * phaseMieWV) * dw;
+            }
+        }
+        return radianceJAcc;
+    }
+
+    // irradiance_sup_calc_fs.glsl
+    glm::vec3 Calculation::irradianceSup(int x, int y, bool firstIteration) const {
+        constexpr float StepPhi = (2.f * Pi) / IrradianceIntegralSamples;
+        constexpr float StepTheta = Pi / (2.f * IrradianceIntegralSamples);
+
+        const float muSun =
+            -0.2f + x / (static_cast<float>(sizes.irradiance.x) - 1.f) * 1.2f;
+        const float r =
+            Rg + y / (static_cast<float>(sizes.irradiance.y) - 1.f) * (Rt - Rg);
+        const glm::vec3 s =
+            glm::vec3(std::max(std::sqrt(1.f - muSun * muSun), 0.f), 0.f, muSun);
+
+        glm::vec3 irradianceE = glm::vec3(0.f);
+        for (int iPhi = 0; iPhi < IrradianceIntegralSamples; iPhi++) {
+            const float phi = (static_cast<float>(iPhi) + 0.5f) * StepPhi;
+            for (int iTheta = 0; iTheta < IrradianceIntegralSamples; iTheta++) {
+                const float theta = (static_cast<float>(iTheta) + 0.5f) * StepTheta;
+                const float dw = StepTheta * StepPhi * std::sin(theta);
+                const glm::vec3 wv = glm::vec3(
+                    std::cos(phi) * std::sin(theta),
+                    std::sin(phi) * std::sin(theta),
+                    std::cos(theta)
+                );
+                const float nu = glm::dot(s, wv);
+
+                const Lookup4D l = lookup4D(r, wv.z, muSun, nu);
+                if (firstIteration) {
+                    const float phaseRay = rayleighPhaseFunction(nu);
+                    const float phaseMie = miePhaseFunction(nu, p.miePhaseConstant);
+                    irradianceE += (sample4D(w.deltaSRayleigh, l) * phaseRay +
+                        sample4D(w.deltaSMie, l) * phaseMie) * wv.z * dw;
+                }
+                else {
+                    irradianceE += sample4D(w.deltaSRayleigh, l) * wv.z * dw;
+                }
+            }
+        }
+        return irradianceE;
+    }
+
+    // inScattering_sup_calc_fs.glsl
+    glm::vec3 Calculation::inscatterSup(float r, const Angles& a) const {
+        auto integrand = [&](float dist) {
+            const float rI = std::sqrt(r * r + dist * dist + 2.f * r * dist * a.mu);
+            const float muI = (r * a.mu + dist) / rI;
+            const float muSunI = (r * a.muSun + dist * a.nu) / rI;
+            return transmittance(r, a.mu, dist) *
+                sample4D(w.deltaJ, lookup4D(rI, muI, muSunI, a.nu));
+        };
+
+        glm::vec3 inScatteringRadiance = glm::vec3(0.f);
+        const float dy =
+            rayDistance(r, a.mu) / static_cast<float>(InscatterIntegralSamples);
+        glm::vec3 inScatteringRadianceI = integrand(0.f);
+        for (int i = 1; i <= InscatterIntegralSamples; i++) {
+            const float yJ = static_cast<float>(i) * dy;
+            const glm::vec3 inScatteringRadianceJ = integrand(yJ);
+            inScatteringRadiance +=
+                (inScatteringRadianceI + inScatteringRadianceJ) / 2.f * dy;
+            inScatteringRadianceI = inScatteringRadianceJ;
+        }
+        return inScatteringRadiance;
+    }
+
+    void store(std::vector<float>& table, size_t index, const glm::vec3& value) {
+        table[index * 3] = value.x;
+        table[index * 3 + 1] = value.y;
+        table[index * 3 + 2] = value.z;
+    }
+} // namespace
+
+namespace openspace::atmosphere {
+
+TableSizes::TableSizes(float textureScale)
+    : transmittance(
+        static_cast<int>(256 * textureScale),
+        static_cast<int>(64 * textureScale)
+    )
+    , irradiance(static_cast<int>(64 * textureScale), static_cast<int>(16 * textureScale))
+    , muSSamples(static_cast<int>(32 * textureScale))
+    , nuSamples(static_cast<int>(8 * textureScale))
+    , muSamples(static_cast<int>(128 * textureScale))
+    , rSamples(static_cast<int>(32 * textureScale))
+{}
+
+glm::ivec3 TableSizes::inScattering() const {
+    return glm::ivec3(muSSamples * nuSamples, muSamples, rSamples);
+}
+
+unsigned int cacheKey(const TableParameters& parameters) {
+    const std::array<float, NParameterValues> values = serialize(parameters);
+    std::string buffer;
+    buffer.push_back(static_cast<char>(CurrentCacheVersion));
+    buffer.append(reinterpret_cast<const char*>(values.data()), sizeof(values));
+    return ghoul::hashCRC32(buffer);
+}
+
+std::filesystem::path cachedTablesPath(const TableParameters& parameters) {
+    return FileSys.cacheManager()->cachedFilename(
+        fmt::format("atmosphere_{:08x}.tables", cacheKey(parameters)),
+        ""
+    );
+}
+
+LookupTables computeLookupTables(const TableParameters& parameters,
+                                 unsigned int nThreads,
+                                 const std::function<void(float)>& progress)
+{
+    ZoneScoped;
+
+    if (nThreads == 0) {
+        nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    int step = 0;
+    auto reportProgress = [&]() {
+        step++;
+        if (progress) {
+            progress(static_cast<float>(step) / NProgressSteps);
+        }
+    };
+
+    LookupTables res;
+    res.sizes = TableSizes(parameters.textureScale);
+    const TableSizes& sizes = res.sizes;
+    const glm::ivec3 size3D = sizes.inScattering();
+    const size_t nTransmittance =
+        static_cast<size_t>(sizes.transmittance.x) * sizes.transmittance.y;
+    const size_t nIrradiance =
+        static_cast<size_t>(sizes.irradiance.x) * sizes.irradiance.y;
+    const size_t n3D = static_cast<size_t>(size3D.x) * size3D.y * size3D.z;
+
+    Calculation calc(parameters, sizes);
+    Workspace& w = calc.w;
+    w.transmittance.resize(nTransmittance * 3);
+    w.deltaE.resize(nIrradiance * 3);
+    w.deltaSRayleigh.resize(n3D * 3);
+    w.deltaSMie.resize(n3D * 3);
+    w.deltaJ.resize(n3D * 3);
+
+    // Runs the function for every texel of a 3D table, parallelized over the rows of
+    // all layers
+    auto forEachTexel3D = [&](auto&& func) {
+        parallelFor(size3D.y * size3D.z, nThreads, [&](int row) {
+            const int z = row / size3D.y;
+            const int y = row % size3D.y;
+            const Layer layer = calc.layer(z);
+            for (int x = 0; x < size3D.x; x++) {
+                const size_t index =
+                    (static_cast<size_t>(z) * size3D.y + y) * size3D.x + x;
+                func(index, x, layer, calc.unmapMuMuSunNu(layer, x, y));
+            }
+        });
+    };
+
+    // line 1 in algorithm 4.1
+    parallelFor(sizes.transmittance.y, nThreads, [&](int y) {
+        for (int x = 0; x < sizes.transmittance.x; x++) {
+            store(
+                w.transmittance,
+                static_cast<size_t>(y) * sizes.transmittance.x + x,
+                calc.transmittanceTexel(x, y)
+            );
+        }
+    });
+    reportProgress();
+
+    // line 2 in algorithm 4.1
+    parallelFor(sizes.irradiance.y, nThreads, [&](int y) {
+        for (int x = 0; x < sizes.irradiance.x; x++) {
+            store(
+                w.deltaE,
+                static_cast<size_t>(y) * sizes.irradiance.x + x,
+                calc.irradianceTexel(x, y)
+            );
+        }
+    });
+    reportProgress();
+
+    // line 3 in algorithm 4.1
+    forEachTexel3D([&](size_t index, int, const Layer& layer, const Angles& a) {
+        const auto [rayleigh, mie] = calc.singleInscatter(layer.r, a);
+        store(w.deltaSRayleigh, index, rayleigh);
+        store(w.deltaSMie, index, mie);
+    });
+    reportProgress();
+
+    // line 4 in algorithm 4.1
+    std::vector<float> irradiance(nIrradiance * 3, 0.f);
+
+    // line 5 in algorithm 4.1. Only the red component of the Mie scattering is stored
+    std::vector<float> inScattering(n3D * 4);
+    for (size_t i = 0; i < n3D; i++) {
+        inScattering[i * 4] = w.deltaSRayleigh[i * 3];
+        inScattering[i * 4 + 1] = w.deltaSRayleigh[i * 3 + 1];
+        inScattering[i * 4 + 2] = w.deltaSRayleigh[i * 3 + 2];
+        inScattering[i * 4 + 3] = w.deltaSMie[i * 3];
+    }
+
+    // loop in line 6 in algorithm 4.1
+    for (int scatteringOrder = 2; scatteringOrder <= 4; scatteringOrder++) {
+        const bool firstIteration = (scatteringOrder == 2);
+
+        // line 7 in algorithm 4.1
+        forEachTexel3D([&](size_t index, int, const Layer& layer, const Angles& a) {
+            store(w.deltaJ, index, calc.radianceJ(layer.r, a, firstIteration));
+        });
+        reportProgress();
+
+        // line 8 in algorithm 4.1
+        parallelFor(sizes.irradiance.y, nThreads, [&](int y) {
+            for (int x = 0; x < sizes.irradiance.x; x++) {
+                store(
+                    w.deltaE,
+                    static_cast<size_t>(y) * sizes.irradiance.x + x,
+                    calc.irradianceSup(x, y, firstIteration)
+                );
+            }
+        });
+        reportProgress();
+
+        // line 9 in algorithm 4.1
+        forEachTexel3D([&](size_t index, int, const Layer& layer, const Angles& a) {
+            store(w.deltaSRayleigh, index, calc.inscatterSup(layer.r, a));
+        });
+        reportProgress();
+
+        // line 10 in algorithm 4.1
+        for (size_t i = 0; i < nIrradiance * 3; i++) {
+            irradiance[i] += w.deltaE[i];
+        }
+
+        // line 11 in algorithm 4.1. The Rayleigh phase function is divided out of the
+        // higher order scattering; see the "Angular precision" paragraph of the paper
+        forEachTexel3D([&](size_t index, int, const Layer&, const Angles& a) {
+            const float phase = rayleighPhaseFunction(a.nu);
+            inScattering[index * 4] += w.deltaSRayleigh[index * 3] / phase;
+            inScattering[index * 4 + 1] += w.deltaSRayleigh[index * 3 + 1] / phase;
+            inScattering[index * 4 + 2] += w.deltaSRayleigh[index * 3 + 2] / phase;
+        });
+    }
+
+    res.transmittance = std::move(w.transmittance);
+    res.irradiance = std::move(irradiance);
+    res.inScattering = std::move(inScattering);
+    return res;
+}
+
+std::optional<LookupTables> loadLookupTables(const std::filesystem::path& file,
+                                             const TableParameters& parameters)
+{
+    ZoneScoped;
+
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        return std::nullopt;
+    }
+
+    int8_t version = 0;
+    stream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    std::array<float, NParameterValues> values;
+    stream.read(reinterpret_cast<char*>(values.data()), sizeof(values));
+    if (!stream.good() || version != CurrentCacheVersion ||
+        values != serialize(parameters))
+    {
+        return std::nullopt;
+    }
+
+    LookupTables res;
+    res.sizes = TableSizes(parameters.textureScale);
+    const glm::ivec3 size3D = res.sizes.inScattering();
+    res.transmittance.resize(
+        static_cast<size_t>(res.sizes.transmittance.x) * res.sizes.transmittance.y * 3
+    );
+    res.irradiance.resize(
+        static_cast<size_t>(res.sizes.irradiance.x) * res.sizes.irradiance.y * 3
+    );
+    res.inScattering.resize(static_cast<size_t>(size3D.x) * size3D.y * size3D.z * 4);
+
+    for (std::vector<float>* table :
+         { &res.transmittance, &res.irradiance, &res.inScattering })
+    {
+        uint64_t nValues = 0;
+        stream.read(reinterpret_cast<char*>(&nValues), sizeof(uint64_t));
+        if (!stream.good() || nValues != table->size()) {
+            LWARNING(fmt::format("Atmosphere table cache {} is corrupted", file));
+            return std::nullopt;
+        }
+        stream.read(reinterpret_cast<char*>(table->data()), nValues * sizeof(float));
+    }
+
+    if (!stream.good()) {
+        LWARNING(fmt::format("Could not read atmosphere table cache {}", file));
+        return std::nullopt;
+    }
+    return res;
+}
+
+bool saveLookupTables(const std::filesystem::path& file,
+                      const TableParameters& parameters, const LookupTables& tables)
+{
+    ZoneScoped;
+
+    std::ofstream stream(file, std::ofstream::binary);
+    if (!stream.good()) {
+        LERROR(fmt::format("Error opening file {} for saving atmosphere tables", file));
+        return false;
+    }
+
+    stream.write(reinterpret_cast<const char*>(&CurrentCacheVersion), sizeof(int8_t));
+    const std::array<float, NParameterValues> values = serialize(parameters);
+    stream.write(reinterpret_cast<const char*>(values.data()), sizeof(values));
+    for (const std::vector<float>* table :
+         { &tables.transmittance, &tables.irradiance, &tables.inScattering })
+    {
+        const uint64_t nValues = table->size();
+        stream.write(reinterpret_cast<const char*>(&nValues), sizeof(uint64_t));
+        stream.write(
+            reinterpret_cast<const char*>(table->data()),
+            nValues * sizeof(float)
+        );
+    }
+
+    if (!stream.good()) {
+        LERROR(fmt::format("Error writing atmosphere tables {}", file));
+        return false;
+    }
+    return true;
+}
+
+} // namespace openspace::atmosphere
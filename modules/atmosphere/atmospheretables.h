@@ -0,0 +1,134 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_ATMOSPHERE___ATMOSPHERETABLES___H__
+#define __OPENSPACE_MODULE_ATMOSPHERE___ATMOSPHERETABLES___H__
+
+#include <ghoul/glm.h>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace openspace::atmosphere {
+
+/**
+ * All parameters that influence the precomputed scattering tables. Parameters that are
+ * only used while rendering, such as the sun intensity, are not part of this struct as
+ * changing them does not require the tables to be recomputed.
+ */
+struct TableParameters {
+    float planetRadius = 0.f;
+    float atmosphereRadius = 0.f;
+    float averageGroundReflectance = 0.f;
+    float rayleighHeightScale = 0.f;
+    glm::vec3 rayleighScatteringCoeff = glm::vec3(0.f);
+    bool ozoneEnabled = false;
+    float ozoneHeightScale = 0.f;
+    glm::vec3 ozoneExtinctionCoeff = glm::vec3(0.f);
+    float mieHeightScale = 0.f;
+    glm::vec3 mieScatteringCoeff = glm::vec3(0.f);
+    glm::vec3 mieExtinctionCoeff = glm::vec3(0.f);
+    float miePhaseConstant = 0.f;
+    float textureScale = 1.f;
+};
+
+/**
+ * The dimensions of the precomputed tables for a specific texture scale. The
+ * inscattering table is a 4D table that is stored as a 3D texture with the sun zenith
+ * angle and the view-sun angle packed into the first dimension.
+ */
+struct TableSizes {
+    explicit TableSizes(float textureScale = 1.f);
+
+    glm::ivec3 inScattering() const;
+
+    glm::ivec2 transmittance;
+    glm::ivec2 irradiance;
+    int muSSamples;
+    int nuSamples;
+    int muSamples;
+    int rSamples;
+};
+
+/**
+ * The result of the precomputation. The transmittance and irradiance tables store
+ * three floats per texel, the inscattering table stores four floats per texel, with the
+ * first dimension varying fastest. This is the same layout that is used for the OpenGL
+ * textures, so the tables can be uploaded without any conversion.
+ */
+struct LookupTables {
+    TableSizes sizes;
+    std::vector<float> transmittance;
+    std::vector<float> irradiance;
+    std::vector<float> inScattering;
+};
+
+/**
+ * Returns a hash of all parameters that influence the content of the lookup tables,
+ * including the version of the algorithm that produces them. Two sets of parameters
+ * with the same key will produce the same tables.
+ */
+unsigned int cacheKey(const TableParameters& parameters);
+
+/**
+ * Returns the path in the cache directory in which the lookup tables for the provided
+ * \p parameters are stored.
+ */
+std::filesystem::path cachedTablesPath(const TableParameters& parameters);
+
+/**
+ * Computes the transmittance, irradiance, and inscattering tables on the CPU, following
+ * algorithm 4.1 of Bruneton and Neyret's Precomputed Atmospheric Scattering. This is a
+ * direct port of the shaders that are used by the AtmosphereDeferredcaster, so it
+ * produces the same tables as the GPU without requiring an OpenGL context.
+ *
+ * \param parameters The physical parameters and the texture scale of the atmosphere
+ * \param nThreads The number of threads that are used for the calculation. If this
+ *        value is 0, the number of hardware threads is used
+ * \param progress If this callback is provided, it is called with the fraction of the
+ *        calculation that has been finished after each step of the algorithm
+ * \return The precomputed lookup tables
+ */
+LookupTables computeLookupTables(const TableParameters& parameters,
+    unsigned int nThreads = 0,
+    const std::function<void(float)>& progress = std::function<void(float)>());
+
+/**
+ * Loads the lookup tables from the provided \p file. The tables are only returned if
+ * the file was created for the same \p parameters, otherwise `std::nullopt` is returned.
+ */
+std::optional<LookupTables> loadLookupTables(const std::filesystem::path& file,
+    const TableParameters& parameters);
+
+/**
+ * Saves the \p tables that were calculated for the \p parameters into the provided
+ * \p file. Returns `true` if the file was written successfully.
+ */
+bool saveLookupTables(const std::filesystem::path& file,
+    const TableParameters& parameters, const LookupTables& tables);
+
+} // namespace openspace::atmosphere
+
+#endif // __OPENSPACE_MODULE_ATMOSPHERE___ATMOSPHERETABLES___H__
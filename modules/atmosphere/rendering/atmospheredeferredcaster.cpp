@@ -64,6 +64,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/opengl/openglstatecache.h>
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 
@@ -235,7 +236,8 @@ namespace openspace {
 AtmosphereDeferredcaster::AtmosphereDeferredcaster(float textureScale,
                                        std::vector<ShadowConfiguration> shadowConfigArray,
                                                               bool saveCalculatedTextures)
-    : _transmittanceTableSize(glm::ivec2(256 * textureScale, 64 * textureScale))
+    : _textureScale(textureScale)
+    , _transmittanceTableSize(glm::ivec2(256 * textureScale, 64 * textureScale))
     , _irradianceTableSize(glm::ivec2(64 * textureScale, 16 * textureScale))
     , _deltaETableSize(glm::ivec2(64 * textureScale, 16 * textureScale))
     , _muSSamples(static_cast<int>(32 * textureScale))
@@ -257,7 +259,15 @@ void AtmosphereDeferredcaster::initialize() {
     _transmittanceTableTexture = createTexture(_transmittanceTableSize, "Transmittance");
     _irradianceTableTexture = createTexture(_irradianceTableSize, "Irradiance");
     _inScatteringTableTexture = createTexture(_textureSize, "InScattering", 4);
-    calculateAtmosphereParameters();
+
+    // The tables only depend on the parameters of the atmosphere, so they are stored in
+    // the cache the first time they are calculated and subsequent start-ups with the
+    // same atmosphere can skip the precalculation entirely
+    const atmosphere::TableParameters parameters = tableParameters();
+    if (!loadCachedTables(parameters)) {
+        calculateTables();
+        saveCachedTables(parameters);
+    }
 }
 
 void AtmosphereDeferredcaster::deinitialize() {
@@ -989,6 +999,171 @@ void AtmosphereDeferredcaster::calculateInscattering(int scatteringOrder,
 void AtmosphereDeferredcaster::calculateAtmosphereParameters() {
     ZoneScoped;
 
+    // Tables for parameters that were changed interactively are not stored in the cache
+    // as they are most likely only used once. We still check the cache, as the user
+    // might change the parameters back to the values that were used at start-up
+    if (!loadCachedTables(tableParameters())) {
+        calculateTables();
+    }
+}
+
+atmosphere::TableParameters AtmosphereDeferredcaster::tableParameters() const {
+    atmosphere::TableParameters parameters;
+    parameters.planetRadius = _atmospherePlanetRadius;
+    parameters.atmosphereRadius = _atmosphereRadius;
+    parameters.averageGroundReflectance = _averageGroundReflectance;
+    parameters.rayleighHeightScale = _rayleighHeightScale;
+    parameters.rayleighScatteringCoeff = _rayleighScatteringCoeff;
+    parameters.ozoneEnabled = _ozoneEnabled;
+    parameters.ozoneHeightScale = _ozoneHeightScale;
+    parameters.ozoneExtinctionCoeff = _ozoneExtinctionCoeff;
+    parameters.mieHeightScale = _mieHeightScale;
+    parameters.mieScatteringCoeff = _mieScatteringCoeff;
+    parameters.mieExtinctionCoeff = _mieExtinctionCoeff;
+    parameters.miePhaseConstant = _miePhaseConstant;
+    parameters.textureScale = _textureScale;
+    return parameters;
+}
+
+bool AtmosphereDeferredcaster::loadCachedTables(
+                                            const atmosphere::TableParameters& parameters)
+{
+    ZoneScoped;
+
+    if (_saveCalculationTextures) {
+        // The intermediate textures are only written when the tables are calculated
+        return false;
+    }
+
+    const std::filesystem::path file = atmosphere::cachedTablesPath(parameters);
+    std::optional<atmosphere::LookupTables> tables =
+        atmosphere::loadLookupTables(file, parameters);
+    if (!tables.has_value()) {
+        return false;
+    }
+
+    LDEBUG(fmt::format("Loaded precalculated atmosphere tables from {}", file));
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        _transmittanceTableSize.x,
+        _transmittanceTableSize.y,
+        GL_RGB,
+        GL_FLOAT,
+        tables->transmittance.data()
+    );
+    glBindTexture(GL_TEXTURE_2D, _irradianceTableTexture);
+    glTexSubImage2D(
+        GL_TEXTURE_2D,
+        0,
+        0,
+        0,
+        _irradianceTableSize.x,
+        _irradianceTableSize.y,
+        GL_RGB,
+        GL_FLOAT,
+        tables->irradiance.data()
+    );
+    glBindTexture(GL_TEXTURE_3D, _inScatteringTableTexture);
+    glTexSubImage3D(
+        GL_TEXTURE_3D,
+        0,
+        0,
+        0,
+        0,
+        _textureSize.x,
+        _textureSize.y,
+        _textureSize.z,
+        GL_RGBA,
+        GL_FLOAT,
+        tables->inScattering.data()
+    );
+    return true;
+}
+
+void AtmosphereDeferredcaster::saveCachedTables(
+                                      const atmosphere::TableParameters& parameters) const
+{
+    ZoneScoped;
+
+    const std::filesystem::path file = atmosphere::cachedTablesPath(parameters);
+    if (atmosphere::saveLookupTables(file, parameters, downloadTables())) {
+        LDEBUG(fmt::format("Stored precalculated atmosphere tables in {}", file));
+    }
+}
+
+atmosphere::LookupTables AtmosphereDeferredcaster::downloadTables() const {
+    ZoneScoped;
+
+    atmosphere::LookupTables tables;
+    tables.sizes = atmosphere::TableSizes(_textureScale);
+    tables.transmittance.resize(
+        static_cast<size_t>(_transmittanceTableSize.x) * _transmittanceTableSize.y * 3
+    );
+    tables.irradiance.resize(
+        static_cast<size_t>(_irradianceTableSize.x) * _irradianceTableSize.y * 3
+    );
+    tables.inScattering.resize(
+        static_cast<size_t>(_textureSize.x) * _textureSize.y * _textureSize.z * 4
+    );
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    glBindTexture(GL_TEXTURE_2D, _transmittanceTableTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_FLOAT, tables.transmittance.data());
+    glBindTexture(GL_TEXTURE_2D, _irradianceTableTexture);
+    glGetTexImage(GL_TEXTURE_2D, 0, GL_RGB, GL_FLOAT, tables.irradiance.data());
+    glBindTexture(GL_TEXTURE_3D, _inScatteringTableTexture);
+    glGetTexImage(GL_TEXTURE_3D, 0, GL_RGBA, GL_FLOAT, tables.inScattering.data());
+    return tables;
+}
+
+void AtmosphereDeferredcaster::validateTables(
+                                            const atmosphere::LookupTables& tables) const
+{
+    ZoneScoped;
+
+    // Compares the tables that were calculated on the GPU against the CPU
+    // implementation. The differences are expressed relative to the largest value of
+    // each table, as the relative difference of values close to 0 is meaningless
+    LINFO("Validating atmosphere tables against the CPU implementation");
+    const atmosphere::LookupTables reference =
+        atmosphere::computeLookupTables(tableParameters());
+
+    auto compare = [](std::string_view name, const std::vector<float>& gpu,
+                      const std::vector<float>& cpu)
+    {
+        float maxValue = 0.f;
+        for (float v : cpu) {
+            maxValue = std::max(maxValue, std::abs(v));
+        }
+        if (maxValue == 0.f || gpu.size() != cpu.size()) {
+            return;
+        }
+
+        float maxDifference = 0.f;
+        double sumDifference = 0.0;
+        for (size_t i = 0; i < cpu.size(); i++) {
+            const float diff = std::abs(gpu[i] - cpu[i]) / maxValue;
+            maxDifference = std::max(maxDifference, diff);
+            sumDifference += diff;
+        }
+        LINFO(fmt::format(
+            "{} table: maximum difference {:.4f}%, mean difference {:.4f}%",
+            name, 100.f * maxDifference, 100.0 * sumDifference / cpu.size()
+        ));
+    };
+    compare("Transmittance", tables.transmittance, reference.transmittance);
+    compare("Irradiance", tables.irradiance, reference.irradiance);
+    compare("Inscattering", tables.inScattering, reference.inScattering);
+}
+
+void AtmosphereDeferredcaster::calculateTables() {
+    ZoneScoped;
+
     using ProgramObject = ghoul::opengl::ProgramObject;
     std::unique_ptr<ProgramObject> deltaJProgram = ProgramObject::Build(
         "DeltaJ Program",
@@ -1144,6 +1319,10 @@ void AtmosphereDeferredcaster::calculateAtmosphereParameters() {
     glBindVertexArray(0);
 
     LDEBUG("Ended precalculations for Atmosphere effects");
+
+    if (_saveCalculationTextures) {
+        validateTables(downloadTables());
+    }
 }
 
 void AtmosphereDeferredcaster::step3DTexture(ghoul::opengl::ProgramObject& prg, int layer)
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/deferredcaster.h>
 
+#include <modules/atmosphere/atmospheretables.h>
 #include <modules/atmosphere/rendering/renderableatmosphere.h>
 #include <ghoul/glm.h>
 #include <ghoul/opengl/textureunit.h>
@@ -93,6 +94,13 @@ public:
     void setHardShadows(bool enabled);
 
 private:
+    atmosphere::TableParameters tableParameters() const;
+    bool loadCachedTables(const atmosphere::TableParameters& parameters);
+    void saveCachedTables(const atmosphere::TableParameters& parameters) const;
+    atmosphere::LookupTables downloadTables() const;
+    void validateTables(const atmosphere::LookupTables& tables) const;
+
+    void calculateTables();
     void step3DTexture(ghoul::opengl::ProgramObject& prg, int layer);
 
     void calculateTransmittance();
@@ -149,6 +157,7 @@ private:
     glm::vec3 _mieExtinctionCoeff = glm::vec3(0.f);
 
     // Atmosphere Textures Dimmensions
+    const float _textureScale;
     const glm::ivec2 _transmittanceTableSize;
     const glm::ivec2 _irradianceTableSize;
     const glm::ivec2 _deltaETableSize;
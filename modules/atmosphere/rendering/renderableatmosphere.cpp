@@ -281,6 +281,41 @@ documentation::Documentation RenderableAtmosphere::Documentation() {
     return codegen::doc<Parameters>("atmosphere_renderable_atmosphere");
 }
 
+atmosphere::TableParameters RenderableAtmosphere::lookupTableParameters(
+                                                      const ghoul::Dictionary& dictionary)
+{
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    // This has to compute the values in the same way as the constructor and
+    // updateAtmosphereParameters, otherwise the tables end up with a different key
+    atmosphere::TableParameters res;
+    res.planetRadius = p.planetRadius;
+    res.atmosphereRadius = p.planetRadius + p.atmosphereHeight;
+    res.averageGroundReflectance = p.planetAverageGroundReflectance;
+    res.rayleighHeightScale = p.rayleigh.heightScale;
+    res.rayleighScatteringCoeff = glm::vec3(p.rayleigh.coefficients.scattering);
+    if (p.ozone.has_value()) {
+        res.ozoneEnabled = p.ozone->heightScale.has_value();
+        res.ozoneHeightScale = p.ozone->heightScale.value_or(res.ozoneHeightScale);
+        if (p.ozone->coefficients.has_value()) {
+            res.ozoneExtinctionCoeff =
+                p.ozone->coefficients->extinction.value_or(res.ozoneExtinctionCoeff);
+        }
+    }
+    res.mieHeightScale = p.mie.heightScale;
+    res.mieScatteringCoeff = glm::vec3(p.mie.coefficients.scattering);
+    const float propCoeff = p.mieScatteringExtinctionPropCoefficient.value_or(1.f);
+    const float mieScatteringExtinctionPropCoeff = propCoeff != 1.f ?
+        propCoeff :
+        res.mieScatteringCoeff.x / glm::vec3(p.mie.coefficients.extinction).x;
+    res.mieExtinctionCoeff = res.mieScatteringCoeff / mieScatteringExtinctionPropCoeff;
+    res.miePhaseConstant = p.mie.phaseConstant;
+    if (p.debug.has_value()) {
+        res.textureScale = p.debug->preCalculatedTextureScale.value_or(1.f);
+    }
+    return res;
+}
+
 RenderableAtmosphere::RenderableAtmosphere(const ghoul::Dictionary& dictionary)
     : Renderable(dictionary)
     , _atmosphereHeight(AtmosphereHeightInfo, 60.f, 0.1f, 99.f)
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/atmosphere/atmospheretables.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/intproperty.h>
@@ -76,6 +77,15 @@ public:
 
     static documentation::Documentation Documentation();
 
+    /**
+     * Returns the parameters that determine the precalculated tables of an atmosphere
+     * that is created from the provided \p dictionary. These are the same parameters
+     * that the atmosphere uses at start-up, so tables that are calculated for them ahead
+     * of time will be used instead of calculating the tables at start-up.
+     */
+    static atmosphere::TableParameters lookupTableParameters(
+        const ghoul::Dictionary& dictionary);
+
 private:
     glm::dmat4 computeModelTransformMatrix(const openspace::TransformData& data);
     void updateAtmosphereParameters();
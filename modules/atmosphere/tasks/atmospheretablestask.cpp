@@ -0,0 +1,108 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/atmosphere/tasks/atmospheretablestask.h>
+
+#include <modules/atmosphere/rendering/renderableatmosphere.h>
+#include <openspace/documentation/documentation.h>
+#include <openspace/documentation/verifier.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/dictionary.h>
+#include <algorithm>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "AtmosphereTablesTask";
+
+    // This task precomputes the lookup tables of an atmosphere on the CPU and stores
+    // them in the cache. These are the same tables that the RenderableAtmosphere
+    // otherwise computes on the graphics card at start-up, so running this task for an
+    // atmosphere makes subsequent start-ups of OpenSpace skip the precalculation
+    // entirely. As the task does not require an OpenGL context, it can be run on
+    // headless machines, for example to prepare the cache for a cluster setup.
+    //
+    // Only the parameters that influence the precalculation have to match those of the
+    // atmosphere that is rendered, but it is easiest to copy the entire Renderable table
+    // of the atmosphere asset.
+    struct [[codegen::Dictionary(AtmosphereTablesTask)]] Parameters {
+        // The specification of the atmosphere, using the same parameters as the
+        // RenderableAtmosphere
+        ghoul::Dictionary atmosphere
+            [[codegen::reference("atmosphere_renderable_atmosphere")]];
+    };
+#include "atmospheretablestask_codegen.cpp"
+} // namespace
+
+namespace openspace::atmosphere {
+
+documentation::Documentation AtmosphereTablesTask::Documentation() {
+    return codegen::doc<Parameters>("atmosphere_tables_task");
+}
+
+AtmosphereTablesTask::AtmosphereTablesTask(const ghoul::Dictionary& dictionary) {
+    const Parameters p = codegen::bake<Parameters>(dictionary);
+
+    _parameters = RenderableAtmosphere::lookupTableParameters(p.atmosphere);
+    _outputPath = cachedTablesPath(_parameters);
+}
+
+std::string AtmosphereTablesTask::description() {
+    return fmt::format(
+        "Precompute the scattering tables for an atmosphere with a planet radius of {} "
+        "km and an atmosphere radius of {} km and store them in {}",
+        _parameters.planetRadius, _parameters.atmosphereRadius, _outputPath
+    );
+}
+
+std::vector<std::filesystem::path> AtmosphereTablesTask::outputs() const {
+    return { _outputPath };
+}
+
+size_t AtmosphereTablesTask::memoryEstimate() const {
+    // The inscattering table with four components plus three intermediate 3D tables
+    // with three components each. The 2D tables are negligible in comparison
+    const glm::ivec3 size = TableSizes(_parameters.textureScale).inScattering();
+    return static_cast<size_t>(size.x) * size.y * size.z * (4 + 3 * 3) * sizeof(float);
+}
+
+unsigned int AtmosphereTablesTask::requestedThreads() const {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void AtmosphereTablesTask::perform(const Task::ProgressCallback& progressCallback) {
+    // The last few percent are reserved for writing the file
+    const LookupTables tables = computeLookupTables(
+        _parameters,
+        numThreads(),
+        [&progressCallback](float progress) { progressCallback(0.95f * progress); }
+    );
+
+    if (saveLookupTables(_outputPath, _parameters, tables)) {
+        LINFO(fmt::format("Stored atmosphere tables in {}", _outputPath));
+    }
+    progressCallback(1.f);
+}
+
+} // namespace openspace::atmosphere
@@ -27,6 +27,7 @@
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/engine/globals.h>
+#include <openspace/util/ephemeristimeconverter.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/timemanager.h>
 #include <ghoul/font/font.h>
@@ -88,16 +89,23 @@ DashboardItemDate::DashboardItemDate(const ghoul::Dictionary& dictionary)
 void DashboardItemDate::render(glm::vec2& penPosition) {
     ZoneScoped;
 
-    std::string time = SpiceManager::ref().dateFromEphemerisTime(
-        global::timeManager->time().j2000Seconds(),
-        _timeFormat.value().c_str()
+    const double j2000Seconds = global::timeManager->time().j2000Seconds();
+    std::optional<std::string> time = EphemerisTimeConverter::ref().dateFromEphemerisTime(
+        j2000Seconds,
+        _timeFormat.value()
     );
+    if (!time.has_value()) {
+        time = SpiceManager::ref().dateFromEphemerisTime(
+            j2000Seconds,
+            _timeFormat.value().c_str()
+        );
+    }
 
     try {
         RenderFont(
             *_font,
             penPosition,
-            fmt::format(fmt::runtime(_formatString.value()), time)
+            fmt::format(fmt::runtime(_formatString.value()), *time)
         );
     }
     catch (const fmt::format_error&) {
@@ -147,9 +147,17 @@ void RenderableBoxGrid::initializeGL() {
     glBindBuffer(GL_ARRAY_BUFFER, _vBufferID);
     glEnableVertexAttribArray(0);
     glBindVertexArray(0);
+
+    if (_hasLabels) {
+        _labels->initializeGL();
+    }
 }
 
 void RenderableBoxGrid::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     glDeleteVertexArrays(1, &_vaoID);
     _vaoID = 0;
 
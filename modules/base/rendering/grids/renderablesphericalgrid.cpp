@@ -161,9 +161,17 @@ void RenderableSphericalGrid::initializeGL() {
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _iBufferID);
     glEnableVertexAttribArray(0);
     glBindVertexArray(0);
+
+    if (_hasLabels) {
+        _labels->initializeGL();
+    }
 }
 
 void RenderableSphericalGrid::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     glDeleteVertexArrays(1, &_vaoID);
     _vaoID = 0;
 
@@ -0,0 +1,339 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/base/rendering/pointcloud/pointcloudoctree.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+
+namespace {
+    constexpr std::string_view _loggerCat = "PointCloudOctree";
+
+    constexpr int8_t CurrentCacheVersion = 1;
+
+    // Nodes at this depth are not split further, which guards against datasets that
+    // contain many points at the same position
+    constexpr int MaxDepth = 21;
+
+    const double Sqrt3 = std::sqrt(3.0);
+} // namespace
+
+namespace openspace {
+
+PointCloudOctree::PointCloudOctree(const std::vector<glm::vec3>& positions,
+                                   unsigned int maxPointsPerNode)
+    : _maxPointsPerNode(std::max(maxPointsPerNode, 1u))
+{
+    ZoneScoped;
+
+    if (positions.empty()) {
+        return;
+    }
+
+    _order.resize(positions.size());
+    std::iota(_order.begin(), _order.end(), 0);
+
+    glm::vec3 minimum = positions.front();
+    glm::vec3 maximum = positions.front();
+    for (const glm::vec3& p : positions) {
+        minimum = glm::min(minimum, p);
+        maximum = glm::max(maximum, p);
+    }
+    const glm::vec3 extent = maximum - minimum;
+
+    Node root;
+    root.center = 0.5f * (minimum + maximum);
+    root.halfSize = 0.5f * std::max({ extent.x, extent.y, extent.z });
+    _nodes.push_back(root);
+
+    // Moves the points in [begin, end) that are below the center of node along the axis
+    // to the front and returns the index of the first point that is not
+    auto partition = [&](uint32_t begin, uint32_t end, const glm::vec3& center,
+                         int axis)
+    {
+        auto it = std::partition(
+            _order.begin() + begin,
+            _order.begin() + end,
+            [&](uint32_t i) { return positions[i][axis] < center[axis]; }
+        );
+        return static_cast<uint32_t>(std::distance(_order.begin(), it));
+    };
+
+    struct Region {
+        uint32_t node;
+        uint32_t begin;
+        uint32_t end;
+        int depth;
+    };
+    std::vector<Region> regions = {
+        { 0, 0, static_cast<uint32_t>(positions.size()), 0 }
+    };
+    while (!regions.empty()) {
+        const Region region = regions.back();
+        regions.pop_back();
+
+        const uint32_t nPointsInRegion = region.end - region.begin;
+        _nodes[region.node].firstPoint = region.begin;
+        if (nPointsInRegion <= _maxPointsPerNode || region.depth == MaxDepth) {
+            _nodes[region.node].nPoints = nPointsInRegion;
+            continue;
+        }
+
+        // Move an evenly spaced subset of the points to the front of the region. These
+        // points represent the node when it is too small on screen to be refined
+        for (uint32_t i = 0; i < _maxPointsPerNode; i++) {
+            const uint64_t offset =
+                static_cast<uint64_t>(i) * nPointsInRegion / _maxPointsPerNode;
+            std::swap(
+                _order[region.begin + i],
+                _order[region.begin + static_cast<uint32_t>(offset)]
+            );
+        }
+        _nodes[region.node].nPoints = _maxPointsPerNode;
+
+        // Sort the remaining points into the octants, with the x axis as the most
+        // significant bit of the octant index and the z axis as the least significant
+        const glm::vec3 center = _nodes[region.node].center;
+        std::array<uint32_t, 9> bounds;
+        bounds[0] = region.begin + _maxPointsPerNode;
+        bounds[8] = region.end;
+        bounds[4] = partition(bounds[0], bounds[8], center, 0);
+        bounds[2] = partition(bounds[0], bounds[4], center, 1);
+        bounds[6] = partition(bounds[4], bounds[8], center, 1);
+        for (int i = 1; i < 8; i += 2) {
+            bounds[i] = partition(bounds[i - 1], bounds[i + 1], center, 2);
+        }
+
+        const float childHalfSize = 0.5f * _nodes[region.node].halfSize;
+        const uint32_t firstChild = static_cast<uint32_t>(_nodes.size());
+        uint32_t nChildren = 0;
+        for (int octant = 0; octant < 8; octant++) {
+            if (bounds[octant] == bounds[octant + 1]) {
+                continue;
+            }
+
+            const glm::vec3 direction = glm::vec3(
+                (octant & 4) ? 1.f : -1.f,
+                (octant & 2) ? 1.f : -1.f,
+                (octant & 1) ? 1.f : -1.f
+            );
+            Node child;
+            child.center = center + childHalfSize * direction;
+            child.halfSize = childHalfSize;
+            _nodes.push_back(child);
+
+            regions.push_back({
+                firstChild + nChildren,
+                bounds[octant],
+                bounds[octant + 1],
+                region.depth + 1
+            });
+            nChildren++;
+        }
+        _nodes[region.node].firstChild = firstChild;
+        _nodes[region.node].nChildren = nChildren;
+    }
+}
+
+std::optional<PointCloudOctree> PointCloudOctree::loadCachedFile(
+                                                        const std::filesystem::path& file,
+                                                                           size_t nPoints,
+                                                            unsigned int maxPointsPerNode)
+{
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        return std::nullopt;
+    }
+
+    int8_t version = 0;
+    stream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    uint32_t cachedMaxPointsPerNode = 0;
+    stream.read(reinterpret_cast<char*>(&cachedMaxPointsPerNode), sizeof(uint32_t));
+    uint64_t nCachedPoints = 0;
+    stream.read(reinterpret_cast<char*>(&nCachedPoints), sizeof(uint64_t));
+    uint64_t nNodes = 0;
+    stream.read(reinterpret_cast<char*>(&nNodes), sizeof(uint64_t));
+    if (!stream.good() || version != CurrentCacheVersion ||
+        cachedMaxPointsPerNode != std::max(maxPointsPerNode, 1u) ||
+        nCachedPoints != nPoints || nNodes > nPoints)
+    {
+        return std::nullopt;
+    }
+
+    PointCloudOctree octree;
+    octree._maxPointsPerNode = cachedMaxPointsPerNode;
+    octree._nodes.resize(nNodes);
+    stream.read(
+        reinterpret_cast<char*>(octree._nodes.data()),
+        nNodes * sizeof(Node)
+    );
+    octree._order.resize(nPoints);
+    stream.read(
+        reinterpret_cast<char*>(octree._order.data()),
+        nPoints * sizeof(uint32_t)
+    );
+
+    if (!stream.good()) {
+        LWARNING(fmt::format("Could not read octree cache {}", file));
+        return std::nullopt;
+    }
+    return octree;
+}
+
+void PointCloudOctree::saveCachedFile(const std::filesystem::path& file) const {
+    std::ofstream stream(file, std::ofstream::binary);
+    if (!stream.good()) {
+        LERROR(fmt::format("Error opening file {} for saving octree cache", file));
+        return;
+    }
+
+    stream.write(reinterpret_cast<const char*>(&CurrentCacheVersion), sizeof(int8_t));
+    const uint32_t maxPointsPerNode = _maxPointsPerNode;
+    stream.write(reinterpret_cast<const char*>(&maxPointsPerNode), sizeof(uint32_t));
+    const uint64_t nPoints = _order.size();
+    stream.write(reinterpret_cast<const char*>(&nPoints), sizeof(uint64_t));
+    const uint64_t nNodes = _nodes.size();
+    stream.write(reinterpret_cast<const char*>(&nNodes), sizeof(uint64_t));
+    stream.write(
+        reinterpret_cast<const char*>(_nodes.data()),
+        _nodes.size() * sizeof(Node)
+    );
+    stream.write(
+        reinterpret_cast<const char*>(_order.data()),
+        _order.size() * sizeof(uint32_t)
+    );
+
+    if (!stream.good()) {
+        LERROR(fmt::format("Error writing octree cache {}", file));
+    }
+}
+
+void PointCloudOctree::select(const glm::dmat4& datasetToWorld,
+                              const glm::dmat4& viewProjection,
+                              const glm::dvec3& cameraPosition, double pixelsPerRadian,
+                              double pixelThreshold, Selection& selection) const
+{
+    ZoneScoped;
+
+    selection.firsts.clear();
+    selection.counts.clear();
+    selection.nPoints = 0;
+
+    if (_nodes.empty()) {
+        return;
+    }
+
+    // Extract the six planes of the view frustum from the rows of the view-projection
+    // matrix. The normals point into the frustum
+    auto row = [&viewProjection](int i) {
+        return glm::dvec4(
+            viewProjection[0][i],
+            viewProjection[1][i],
+            viewProjection[2][i],
+            viewProjection[3][i]
+        );
+    };
+    std::array<glm::dvec4, 6> planes;
+    for (int i = 0; i < 3; i++) {
+        planes[2 * i] = row(3) + row(i);
+        planes[2 * i + 1] = row(3) - row(i);
+    }
+    for (glm::dvec4& plane : planes) {
+        plane /= glm::length(glm::dvec3(plane));
+    }
+
+    // The bounding spheres of the nodes are scaled by the largest scaling of the
+    // transformation so that they still contain the node for non-uniform scaling
+    const double radiusScale = std::max({
+        glm::length(glm::dvec3(datasetToWorld[0])),
+        glm::length(glm::dvec3(datasetToWorld[1])),
+        glm::length(glm::dvec3(datasetToWorld[2]))
+    });
+
+    // The nodes are visited depth-first in the same order as their points are stored,
+    // so that ranges of neighboring nodes can be merged into a single draw range
+    std::vector<uint32_t> stack = { 0 };
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+
+        const glm::dvec3 center = glm::dvec3(
+            datasetToWorld * glm::dvec4(glm::dvec3(node.center), 1.0)
+        );
+        const double radius = Sqrt3 * node.halfSize * radiusScale;
+
+        const bool isVisible = std::all_of(
+            planes.begin(),
+            planes.end(),
+            [&](const glm::dvec4& plane) {
+                return glm::dot(glm::dvec3(plane), center) + plane.w >= -radius;
+            }
+        );
+        if (!isVisible) {
+            continue;
+        }
+
+        if (node.nPoints > 0) {
+            const int first = static_cast<int>(node.firstPoint);
+            const int count = static_cast<int>(node.nPoints);
+            if (!selection.firsts.empty() &&
+                selection.firsts.back() + selection.counts.back() == first)
+            {
+                selection.counts.back() += count;
+            }
+            else {
+                selection.firsts.push_back(first);
+                selection.counts.push_back(count);
+            }
+            selection.nPoints += node.nPoints;
+        }
+
+        // The projected size is approximated by the angle that the bounding sphere
+        // covers, which is always refined if the camera is inside the sphere
+        const double distance = glm::length(center - cameraPosition);
+        const bool shouldRefine = distance <= radius ||
+            2.0 * radius / distance * pixelsPerRadian > pixelThreshold;
+        if (shouldRefine) {
+            for (uint32_t i = node.nChildren; i > 0; i--) {
+                stack.push_back(node.firstChild + i - 1);
+            }
+        }
+    }
+}
+
+const std::vector<uint32_t>& PointCloudOctree::order() const {
+    return _order;
+}
+
+const std::vector<PointCloudOctree::Node>& PointCloudOctree::nodes() const {
+    return _nodes;
+}
+
+} // namespace openspace
@@ -0,0 +1,122 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_BASE___POINTCLOUDOCTREE___H__
+#define __OPENSPACE_MODULE_BASE___POINTCLOUDOCTREE___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * An octree over the positions of a point cloud that is used to only draw the parts of
+ * the point cloud that are visible and large enough on screen. Each inner node of the
+ * tree is represented by an evenly sampled subset of the points in its region, and the
+ * remaining points are distributed to the children. The points are reordered so that
+ * the representatives of a node come first, followed by the points of each child in
+ * turn. This means that every node, as well as every complete subtree, covers a
+ * contiguous range of the reordered points, so that a selection of nodes can be drawn
+ * with a small number of draw ranges from a single vertex buffer.
+ */
+class PointCloudOctree {
+public:
+    struct Node {
+        glm::vec3 center = glm::vec3(0.f);
+        float halfSize = 0.f;
+        /// The index of the first point of this node in the reordered points
+        uint32_t firstPoint = 0;
+        /// The number of points that represent this node
+        uint32_t nPoints = 0;
+        /// The index of the first child node. The children are stored consecutively
+        uint32_t firstChild = 0;
+        uint32_t nChildren = 0;
+    };
+
+    /// The ranges of reordered points that should be drawn, in a form that can be
+    /// passed directly to glMultiDrawArrays
+    struct Selection {
+        std::vector<int> firsts;
+        std::vector<int> counts;
+        size_t nPoints = 0;
+    };
+
+    static constexpr unsigned int DefaultMaxPointsPerNode = 4096;
+
+    PointCloudOctree() = default;
+
+    /**
+     * Builds the octree for the provided \p positions. Inner nodes are represented by
+     * \p maxPointsPerNode points and nodes with at most that many points are leaves.
+     */
+    explicit PointCloudOctree(const std::vector<glm::vec3>& positions,
+        unsigned int maxPointsPerNode = DefaultMaxPointsPerNode);
+
+    /**
+     * Loads an octree that was previously saved with #saveCachedFile. Returns an empty
+     * optional if the file does not exist or if it was built for a different number of
+     * points or a different number of points per node.
+     */
+    static std::optional<PointCloudOctree> loadCachedFile(
+        const std::filesystem::path& file, size_t nPoints,
+        unsigned int maxPointsPerNode = DefaultMaxPointsPerNode);
+
+    void saveCachedFile(const std::filesystem::path& file) const;
+
+    /**
+     * Selects the ranges of reordered points that should be drawn this frame. Nodes whose
+     * bounding sphere is outside the view frustum are skipped together with their
+     * children. The points of all other nodes are drawn, and a node is refined into its
+     * children if its projected diameter is larger than \p pixelThreshold.
+     *
+     * \param datasetToWorld The transformation from the space of the positions that the
+     *        tree was built from to world space
+     * \param viewProjection The combined view and projection matrix of the camera
+     * \param cameraPosition The position of the camera in world space
+     * \param pixelsPerRadian The number of pixels covered by one radian at the center
+     *        of the screen
+     * \param pixelThreshold The projected size, in pixels, above which nodes are refined
+     * \param selection Is filled with the ranges that should be drawn. Passing the same
+     *        object each frame avoids repeated allocations
+     */
+    void select(const glm::dmat4& datasetToWorld, const glm::dmat4& viewProjection,
+        const glm::dvec3& cameraPosition, double pixelsPerRadian, double pixelThreshold,
+        Selection& selection) const;
+
+    /// Returns the index in the original positions of each reordered point
+    const std::vector<uint32_t>& order() const;
+    const std::vector<Node>& nodes() const;
+
+private:
+    unsigned int _maxPointsPerNode = DefaultMaxPointsPerNode;
+    std::vector<Node> _nodes;
+    std::vector<uint32_t> _order;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_BASE___POINTCLOUDOCTREE___H__
@@ -31,6 +31,7 @@
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/util/updatestructures.h>
 #include <openspace/rendering/renderengine.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/glm.h>
 #include <ghoul/io/texture/texturereader.h>
@@ -43,6 +44,7 @@
 #include <ghoul/opengl/texture.h>
 #include <ghoul/opengl/textureunit.h>
 #include <glm/gtx/string_cast.hpp>
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstdint>
@@ -51,10 +53,36 @@
 #include <locale>
 #include <optional>
 #include <string>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "RenderablePointCloud";
 
+    // Each thread that creates buffer data should at least get this many points to make
+    // up for the cost of starting the thread
+    constexpr size_t MinPointsPerThread = 65536;
+
+    // Calls func(thread, begin, end) for consecutive ranges of [0, n) on multiple threads
+    // and returns the number of threads that were used
+    template <typename Func>
+    size_t parallelForRanges(size_t n, const Func& func) {
+        const size_t nThreads = std::clamp<size_t>(
+            n / MinPointsPerThread,
+            1,
+            std::max(std::thread::hardware_concurrency(), 1u)
+        );
+
+        std::vector<std::thread> threads;
+        for (size_t t = 1; t < nThreads; t++) {
+            threads.emplace_back(func, t, n * t / nThreads, n * (t + 1) / nThreads);
+        }
+        func(size_t(0), size_t(0), n / nThreads);
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        return nThreads;
+    }
+
     constexpr std::array<const char*, 29> UniformNames = {
         "cameraViewProjectionMatrix", "modelMatrix", "cameraPosition", "cameraLookUp",
         "renderOption", "maxBillboardSize", "color", "opacity", "scaleExponent",
@@ -165,6 +193,26 @@ namespace {
         openspace::properties::Property::Visibility::User
     };
 
+    constexpr openspace::properties::Property::PropertyInfo UseLevelOfDetailInfo = {
+        "UseLevelOfDetail",
+        "Use Level of Detail",
+        "If true, the points are organized in an octree when the dataset is loaded and "
+        "only the regions that are inside the view are drawn. Regions that are small on "
+        "screen are only drawn using a subset of their points. This makes the rendering "
+        "of large datasets faster, at the cost of a longer first load. The octree is "
+        "cached together with the dataset",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo LevelOfDetailPixelSizeInfo = {
+        "LevelOfDetailPixelSize",
+        "Level of Detail Pixel Size",
+        "The projected size, in pixels, above which a region of the octree is drawn "
+        "using all of its points instead of a subset. Larger values lead to fewer "
+        "points being drawn. Only used if level of detail is enabled",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     constexpr openspace::properties::Property::PropertyInfo ScaleExponentInfo = {
         "ScaleExponent",
         "Scale Exponent",
@@ -265,6 +313,12 @@ namespace {
         std::optional<ghoul::Dictionary> dataMapping
             [[codegen::reference("dataloader_datamapping")]];
 
+        // [[codegen::verbatim(UseLevelOfDetailInfo.description)]]
+        std::optional<bool> useLevelOfDetail;
+
+        // [[codegen::verbatim(LevelOfDetailPixelSizeInfo.description)]]
+        std::optional<float> levelOfDetailPixelSize;
+
         // [[codegen::verbatim(SpriteTextureInfo.description)]]
         std::optional<std::string> texture;
 
@@ -471,6 +525,8 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
     , _useAdditiveBlending(UseAdditiveBlendingInfo, true)
     , _renderOption(RenderOptionInfo, properties::OptionProperty::DisplayType::Dropdown)
     , _nDataPoints(NumShownDataPointsInfo, 0)
+    , _useLevelOfDetail(UseLevelOfDetailInfo, true)
+    , _levelOfDetailPixelSize(LevelOfDetailPixelSizeInfo, 256.f, 1.f, 4096.f)
     , _fading(dictionary)
     , _colorSettings(dictionary)
     , _sizeSettings(dictionary)
@@ -536,7 +592,7 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
 
     if (p.sizeSettings.has_value() && p.sizeSettings->sizeMapping.has_value()) {
         _sizeSettings.sizeMapping.parameterOption.onChange(
-            [this]() { _dataIsDirty = true; }
+            [this]() { _sizeParameterIsDirty = true; }
         );
         _hasDatavarSize = true;
     }
@@ -552,7 +608,7 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
         _hasColorMapFile = true;
 
         _colorSettings.colorMapping->dataColumn.onChange(
-            [this]() { _dataIsDirty = true; }
+            [this]() { _colorParameterIsDirty = true; }
         );
 
         _colorSettings.colorMapping->setRangeFromData.onChange([this]() {
@@ -573,6 +629,19 @@ RenderablePointCloud::RenderablePointCloud(const ghoul::Dictionary& dictionary)
         }
         _nDataPoints = static_cast<unsigned int>(_dataset.entries.size());
 
+        if (p.useLevelOfDetail.value_or(false) && !_dataset.entries.empty()) {
+            createOctree(useCaching);
+
+            // Without level of detail all points are drawn again
+            _useLevelOfDetail.onChange([this]() {
+                _nDataPoints = static_cast<unsigned int>(_dataset.entries.size());
+            });
+            _levelOfDetailPixelSize =
+                p.levelOfDetailPixelSize.value_or(_levelOfDetailPixelSize);
+            addProperty(_useLevelOfDetail);
+            addProperty(_levelOfDetailPixelSize);
+        }
+
         // If no scale exponent was specified, compute one that will at least show the
         // points based on the scale of the positions in the dataset
         if (!p.sizeSettings.has_value() || !p.sizeSettings->scaleExponent.has_value()) {
@@ -633,11 +702,23 @@ void RenderablePointCloud::initializeGL() {
     if (_hasColorMapFile) {
         _colorSettings.colorMapping->initializeTexture();
     }
+
+    if (_hasLabels) {
+        _labels->initializeGL();
+    }
 }
 
 void RenderablePointCloud::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
+    glDeleteBuffers(1, &_colorParameterVbo);
+    _colorParameterVbo = 0;
+    glDeleteBuffers(1, &_sizeParameterVbo);
+    _sizeParameterVbo = 0;
     glDeleteVertexArrays(1, &_vao);
     _vao = 0;
 
@@ -697,6 +778,37 @@ void RenderablePointCloud::renderBillboards(const RenderData& data,
         return;
     }
 
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    const glm::dmat4 viewProjectionMatrix =
+        glm::dmat4(data.camera.projectionMatrix()) * data.camera.combinedViewMatrix();
+
+    const bool useLevelOfDetail = _octree.has_value() && _useLevelOfDetail;
+    if (useLevelOfDetail) {
+        const glm::dmat4 datasetToWorld = modelMatrix * _transformationMatrix *
+            glm::scale(glm::dmat4(1.0), glm::dvec3(toMeter(_unit)));
+        const double pixelsPerRadian =
+            0.5 * viewport[3] * data.camera.projectionMatrix()[1][1];
+
+        _octree->select(
+            datasetToWorld,
+            viewProjectionMatrix,
+            data.camera.positionVec3(),
+            pixelsPerRadian,
+            _levelOfDetailPixelSize,
+            _octreeSelection
+        );
+
+        const unsigned int nPoints = static_cast<unsigned int>(_octreeSelection.nPoints);
+        if (_nDataPoints != nPoints) {
+            _nDataPoints = nPoints;
+        }
+        if (_octreeSelection.firsts.empty()) {
+            return;
+        }
+    }
+
     glEnablei(GL_BLEND, 0);
 
     if (_useAdditiveBlending) {
@@ -723,10 +835,7 @@ void RenderablePointCloud::renderBillboards(const RenderData& data,
     );
     _program->setUniform(_uniformCache.renderOption, _renderOption.value());
     _program->setUniform(_uniformCache.modelMatrix, modelMatrix);
-    _program->setUniform(
-        _uniformCache.cameraViewProjectionMatrix,
-        glm::dmat4(data.camera.projectionMatrix()) * data.camera.combinedViewMatrix()
-    );
+    _program->setUniform(_uniformCache.cameraViewProjectionMatrix, viewProjectionMatrix);
 
     _program->setUniform(_uniformCache.up, glm::vec3(orthoUp));
     _program->setUniform(_uniformCache.right, glm::vec3(orthoRight));
@@ -739,8 +848,6 @@ void RenderablePointCloud::renderBillboards(const RenderData& data,
     _program->setUniform(_uniformCache.maxBillboardSize, _sizeSettings.maxPixelSize);
     _program->setUniform(_uniformCache.hasDvarScaling, _sizeSettings.sizeMapping.enabled);
 
-    GLint viewport[4];
-    glGetIntegerv(GL_VIEWPORT, viewport);
     _program->setUniform(_uniformCache.screenSize, glm::vec2(viewport[2], viewport[3]));
 
     bool useTexture = _hasSpriteTexture && _useSpriteTexture;
@@ -804,7 +911,18 @@ void RenderablePointCloud::renderBillboards(const RenderData& data,
     }
 
     glBindVertexArray(_vao);
-    glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_dataset.entries.size()));
+    if (useLevelOfDetail) {
+        // The selected nodes are stored as ranges of the reordered points
+        glMultiDrawArrays(
+            GL_POINTS,
+            _octreeSelection.firsts.data(),
+            _octreeSelection.counts.data(),
+            static_cast<GLsizei>(_octreeSelection.firsts.size())
+        );
+    }
+    else {
+        glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(_dataset.entries.size()));
+    }
     glBindVertexArray(0);
     _program->deactivate();
 
@@ -850,7 +968,7 @@ void RenderablePointCloud::render(const RenderData& data, RendererTasks&) {
 void RenderablePointCloud::update(const UpdateData&) {
     ZoneScoped;
 
-    if (_dataIsDirty) {
+    if (_dataIsDirty || _colorParameterIsDirty || _sizeParameterIsDirty) {
         updateBufferData();
     }
 
@@ -859,13 +977,6 @@ void RenderablePointCloud::update(const UpdateData&) {
     }
 }
 
-int RenderablePointCloud::nAttributesPerPoint() const {
-    int n = 4; // position
-    n += _hasColorMapFile ? 1 : 0;
-    n += _hasDatavarSize ? 1 : 0;
-    return n;
-}
-
 void RenderablePointCloud::updateBufferData() {
     if (!_hasDataFile || _dataset.entries.empty()) {
         return;
@@ -873,71 +984,81 @@ void RenderablePointCloud::updateBufferData() {
 
     ZoneScopedN("Data dirty");
     TracyGpuZone("Data dirty");
-    LDEBUG("Regenerating data");
-
-    std::vector<float> slice = createDataSlice();
-
-    int size = static_cast<int>(slice.size());
 
     if (_vao == 0) {
         glGenVertexArrays(1, &_vao);
         LDEBUG(fmt::format("Generating Vertex Array id '{}'", _vao));
     }
-    if (_vbo == 0) {
-        glGenBuffers(1, &_vbo);
-        LDEBUG(fmt::format("Generating Vertex Buffer Object id '{}'", _vbo));
-    }
-
     glBindVertexArray(_vao);
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(GL_ARRAY_BUFFER, size * sizeof(float), slice.data(), GL_STATIC_DRAW);
-
-    const int attibutesPerPoint = nAttributesPerPoint();
-    int attributeOffset = 0;
-
-    GLint positionAttrib = _program->attributeLocation("in_position");
-    glEnableVertexAttribArray(positionAttrib);
-    glVertexAttribPointer(
-        positionAttrib,
-        4,
-        GL_FLOAT,
-        GL_FALSE,
-        attibutesPerPoint * sizeof(float),
-        nullptr
-    );
-    attributeOffset += 4;
 
-    if (_hasColorMapFile) {
-        GLint colorParamAttrib = _program->attributeLocation("in_colorParameter");
-        glEnableVertexAttribArray(colorParamAttrib);
-        glVertexAttribPointer(
-            colorParamAttrib,
-            1,
-            GL_FLOAT,
-            GL_FALSE,
-            attibutesPerPoint * sizeof(float),
-            reinterpret_cast<void*>(attributeOffset * sizeof(float))
+    // The positions and the color and size parameters are stored in separate buffers, so
+    // that changing the data column of one of the parameters only requires that column
+    // to be created and uploaded again
+    if (_dataIsDirty) {
+        LDEBUG("Regenerating position data");
+        std::vector<float> positions = createPositionData();
+
+        if (_vbo == 0) {
+            glGenBuffers(1, &_vbo);
+            LDEBUG(fmt::format("Generating Vertex Buffer Object id '{}'", _vbo));
+        }
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            positions.size() * sizeof(float),
+            positions.data(),
+            GL_STATIC_DRAW
+        );
+
+        GLint positionAttrib = _program->attributeLocation("in_position");
+        glEnableVertexAttribArray(positionAttrib);
+        glVertexAttribPointer(positionAttrib, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+    }
+
+    if (_hasColorMapFile && (_dataIsDirty || _colorParameterIsDirty)) {
+        uploadParameterData(
+            _colorParameterVbo,
+            "in_colorParameter",
+            currentColorParameterIndex()
         );
-        attributeOffset += 1;
     }
 
-    if (_hasDatavarSize) {
-        GLint scalingAttrib = _program->attributeLocation("in_scalingParameter");
-        glEnableVertexAttribArray(scalingAttrib);
-        glVertexAttribPointer(
-            scalingAttrib,
-            1,
-            GL_FLOAT,
-            GL_FALSE,
-            attibutesPerPoint * sizeof(float),
-            reinterpret_cast<void*>(attributeOffset * sizeof(float))
+    if (_hasDatavarSize && (_dataIsDirty || _sizeParameterIsDirty)) {
+        uploadParameterData(
+            _sizeParameterVbo,
+            "in_scalingParameter",
+            currentSizeParameterIndex()
         );
-        attributeOffset += 1;
     }
 
     glBindVertexArray(0);
 
     _dataIsDirty = false;
+    _colorParameterIsDirty = false;
+    _sizeParameterIsDirty = false;
+}
+
+void RenderablePointCloud::uploadParameterData(GLuint& vbo, const char* attributeName,
+                                               int parameterIndex)
+{
+    LDEBUG(fmt::format("Regenerating data for '{}'", attributeName));
+    std::vector<float> values = createParameterData(parameterIndex);
+
+    if (vbo == 0) {
+        glGenBuffers(1, &vbo);
+        LDEBUG(fmt::format("Generating Vertex Buffer Object id '{}'", vbo));
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        values.size() * sizeof(float),
+        values.data(),
+        GL_STATIC_DRAW
+    );
+
+    GLint attrib = _program->attributeLocation(attributeName);
+    glEnableVertexAttribArray(attrib);
+    glVertexAttribPointer(attrib, 1, GL_FLOAT, GL_FALSE, 0, nullptr);
 }
 
 void RenderablePointCloud::updateSpriteTexture() {
@@ -973,6 +1094,40 @@ void RenderablePointCloud::updateSpriteTexture() {
     _spriteTextureIsDirty = false;
 }
 
+void RenderablePointCloud::createOctree(bool useCaching) {
+    ZoneScoped;
+
+    // The octree only depends on the positions in the dataset, so it is cached next to
+    // the dataset with the same data mapping
+    const std::filesystem::path cacheFile = FileSys.cacheManager()->cachedFilename(
+        _dataFile,
+        "PointCloudOctree|" + dataloader::generateHashString(_dataMapping)
+    );
+
+    if (useCaching) {
+        _octree = PointCloudOctree::loadCachedFile(cacheFile, _dataset.entries.size());
+        if (_octree.has_value()) {
+            LDEBUG(fmt::format("Loaded octree from cache {}", cacheFile));
+            return;
+        }
+    }
+
+    std::vector<glm::vec3> positions;
+    positions.reserve(_dataset.entries.size());
+    for (const dataloader::Dataset::Entry& e : _dataset.entries) {
+        positions.push_back(e.position);
+    }
+    _octree = PointCloudOctree(positions);
+    LDEBUG(fmt::format(
+        "Created octree with {} nodes for {} points",
+        _octree->nodes().size(), positions.size()
+    ));
+
+    if (useCaching) {
+        _octree->saveCachedFile(cacheFile);
+    }
+}
+
 int RenderablePointCloud::currentColorParameterIndex() const {
     const properties::OptionProperty& property =
         _colorSettings.colorMapping->dataColumn;
@@ -995,53 +1150,57 @@ int RenderablePointCloud::currentSizeParameterIndex() const {
     return _dataset.index(property.option().description);
 }
 
-std::vector<float> RenderablePointCloud::createDataSlice() {
+std::vector<float> RenderablePointCloud::createPositionData() {
     ZoneScoped;
 
-    if (_dataset.entries.empty()) {
-        return std::vector<float>();
-    }
-
-    std::vector<float> result;
-    result.reserve(nAttributesPerPoint() * _dataset.entries.size());
-
-    // What datavar is in use for the index color
-    int colorParamIndex = currentColorParameterIndex();
-
-    // What datavar is in use for the size scaling (if present)
-    int sizeParamIndex = currentSizeParameterIndex();
-
-    double maxRadius = 0.0;
-    double biggestCoord = -1.0;
-
-    for (const dataloader::Dataset::Entry& e : _dataset.entries) {
-        const double unitMeter = toMeter(_unit);
-        glm::dvec4 position = glm::dvec4(glm::dvec3(e.position) * unitMeter, 1.0);
-        position = _transformationMatrix * position;
-
-        const double r = glm::length(position);
-        maxRadius = std::max(maxRadius, r);
-
-        // Positions
-        for (int j = 0; j < 4; ++j) {
-            result.push_back(static_cast<float>(position[j]));
+    const std::vector<dataloader::Dataset::Entry>& entries = _dataset.entries;
+    const uint32_t* order = _octree.has_value() ? _octree->order().data() : nullptr;
+    std::vector<float> result(4 * entries.size());
+    std::vector<double> maxRadius(std::max(std::thread::hardware_concurrency(), 1u));
+
+    const double unitMeter = toMeter(_unit);
+    const size_t nThreads = parallelForRanges(
+        entries.size(),
+        [&](size_t thread, size_t begin, size_t end) {
+            double radius = 0.0;
+            for (size_t i = begin; i < end; i++) {
+                const dataloader::Dataset::Entry& e = entries[order ? order[i] : i];
+                glm::dvec4 position = glm::dvec4(glm::dvec3(e.position) * unitMeter, 1.0);
+                position = _transformationMatrix * position;
+
+                radius = std::max(radius, glm::length(position));
+
+                result[4 * i] = static_cast<float>(position.x);
+                result[4 * i + 1] = static_cast<float>(position.y);
+                result[4 * i + 2] = static_cast<float>(position.z);
+                result[4 * i + 3] = static_cast<float>(position.w);
+            }
+            maxRadius[thread] = radius;
         }
+    );
 
-        // Colors
-        if (_hasColorMapFile) {
-            biggestCoord = std::max(biggestCoord, glm::compMax(position));
-            result.push_back(e.data[colorParamIndex]);
-        }
+    setBoundingSphere(*std::max_element(maxRadius.begin(), maxRadius.begin() + nThreads));
+    return result;
+}
+
+std::vector<float> RenderablePointCloud::createParameterData(int parameterIndex) const {
+    ZoneScoped;
 
-        // Size data
-        if (_hasDatavarSize) {
-            // @TODO: Consider more detailed control over the scaling. Currently the value
-            // is multiplied with the value as is. Should have similar mapping properties
-            // as the color mapping
-            result.push_back(e.data[sizeParamIndex]);
+    const std::vector<dataloader::Dataset::Entry>& entries = _dataset.entries;
+    const uint32_t* order = _octree.has_value() ? _octree->order().data() : nullptr;
+    std::vector<float> result(entries.size());
+
+    parallelForRanges(
+        entries.size(),
+        [&](size_t, size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                // @TODO: Consider more detailed control over the scaling. Currently the
+                // value is used as is. Should have similar mapping properties as the
+                // color mapping
+                result[i] = entries[order ? order[i] : i].data[parameterIndex];
+            }
         }
-    }
-    setBoundingSphere(maxRadius);
+    );
     return result;
 }
 
@@ -27,6 +27,7 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/base/rendering/pointcloud/pointcloudoctree.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/triggerproperty.h>
@@ -42,6 +43,7 @@
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/opengl/uniformcache.h>
 #include <functional>
+#include <optional>
 
 namespace ghoul::opengl {
     class ProgramObject;
@@ -74,16 +76,25 @@ public:
     static documentation::Documentation Documentation();
 
 protected:
-    int nAttributesPerPoint() const;
     void updateBufferData();
     void updateSpriteTexture();
 
+    /// Loads the octree for the dataset from the cache or builds it if necessary
+    void createOctree(bool useCaching);
+
     /// Find the index of the currently chosen color parameter in the dataset
     int currentColorParameterIndex() const;
     /// Find the index of the currently chosen size parameter in the dataset
     int currentSizeParameterIndex() const;
 
-    std::vector<float> createDataSlice();
+    /// Creates the transformed positions of all points, with four values per point. If
+    /// level of detail is used, the points are stored in the order of the octree
+    std::vector<float> createPositionData();
+    /// Creates the value of the data column \p parameterIndex for all points
+    std::vector<float> createParameterData(int parameterIndex) const;
+
+    void uploadParameterData(GLuint& vbo, const char* attributeName,
+        int parameterIndex);
 
     virtual void bindTextureForRendering() const;
 
@@ -93,6 +104,8 @@ protected:
         const glm::dvec3& orthoRight, const glm::dvec3& orthoUp, float fadeInVariable);
 
     bool _dataIsDirty = true;
+    bool _colorParameterIsDirty = true;
+    bool _sizeParameterIsDirty = true;
     bool _spriteTextureIsDirty = true;
 
     bool _hasSpriteTexture = false;
@@ -144,6 +157,9 @@ protected:
 
     properties::UIntProperty _nDataPoints;
 
+    properties::BoolProperty _useLevelOfDetail;
+    properties::FloatProperty _levelOfDetailPixelSize;
+
     ghoul::opengl::Texture* _spriteTexture = nullptr;
     ghoul::opengl::ProgramObject* _program = nullptr;
 
@@ -165,10 +181,15 @@ protected:
 
     std::unique_ptr<LabelsComponent> _labels;
 
+    std::optional<PointCloudOctree> _octree;
+    PointCloudOctree::Selection _octreeSelection;
+
     glm::dmat4 _transformationMatrix = glm::dmat4(1.0);
 
     GLuint _vao = 0;
     GLuint _vbo = 0;
+    GLuint _colorParameterVbo = 0;
+    GLuint _sizeParameterVbo = 0;
 };
 
 } // namespace openspace
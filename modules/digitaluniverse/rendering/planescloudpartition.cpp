@@ -0,0 +1,256 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/digitaluniverse/rendering/planescloudpartition.h>
+
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <numeric>
+
+namespace openspace {
+
+PlanesCloudPartition::PlanesCloudPartition(const std::vector<Plane>& planes,
+                                           unsigned int maxPlanesPerBatch)
+{
+    ZoneScoped;
+
+    maxPlanesPerBatch = std::max(maxPlanesPerBatch, 1u);
+
+    _order.resize(planes.size());
+    std::iota(_order.begin(), _order.end(), 0);
+
+    struct Region {
+        uint32_t begin;
+        uint32_t end;
+    };
+    std::vector<Region> regions;
+    if (!planes.empty()) {
+        regions.push_back({ 0, static_cast<uint32_t>(planes.size()) });
+    }
+    while (!regions.empty()) {
+        const Region region = regions.back();
+        regions.pop_back();
+
+        if (region.end - region.begin > maxPlanesPerBatch) {
+            // Split the region at the median of the longest axis. The median split
+            // guarantees progress even if many planes share the same center
+            glm::vec3 minimum = planes[_order[region.begin]].center;
+            glm::vec3 maximum = minimum;
+            for (uint32_t i = region.begin; i < region.end; i++) {
+                minimum = glm::min(minimum, planes[_order[i]].center);
+                maximum = glm::max(maximum, planes[_order[i]].center);
+            }
+            const glm::vec3 extent = maximum - minimum;
+            int axis = 0;
+            if (extent.y > extent[axis]) {
+                axis = 1;
+            }
+            if (extent.z > extent[axis]) {
+                axis = 2;
+            }
+
+            const uint32_t middle = region.begin + (region.end - region.begin) / 2;
+            std::nth_element(
+                _order.begin() + region.begin,
+                _order.begin() + middle,
+                _order.begin() + region.end,
+                [&](uint32_t lhs, uint32_t rhs) {
+                    return planes[lhs].center[axis] < planes[rhs].center[axis];
+                }
+            );
+
+            // The lower half is pushed last so that the batches are created in the
+            // order of their planes
+            regions.push_back({ middle, region.end });
+            regions.push_back({ region.begin, middle });
+            continue;
+        }
+
+        // Sort the planes of the batch by texture so that they can be drawn with one
+        // range per texture
+        std::sort(
+            _order.begin() + region.begin,
+            _order.begin() + region.end,
+            [&](uint32_t lhs, uint32_t rhs) {
+                return std::pair(planes[lhs].textureIndex, lhs) <
+                       std::pair(planes[rhs].textureIndex, rhs);
+            }
+        );
+
+        Batch batch;
+        batch.firstPlane = region.begin;
+        batch.nPlanes = region.end - region.begin;
+        batch.firstRange = static_cast<uint32_t>(_ranges.size());
+
+        glm::vec3 minimum = glm::vec3(std::numeric_limits<float>::max());
+        glm::vec3 maximum = glm::vec3(-std::numeric_limits<float>::max());
+        for (uint32_t i = region.begin; i < region.end; i++) {
+            const Plane& p = planes[_order[i]];
+            minimum = glm::min(minimum, p.center - glm::vec3(p.radius));
+            maximum = glm::max(maximum, p.center + glm::vec3(p.radius));
+            batch.maxPlaneRadius = std::max(batch.maxPlaneRadius, p.radius);
+
+            if (_ranges.size() > batch.firstRange &&
+                _ranges.back().textureIndex == p.textureIndex)
+            {
+                _ranges.back().nPlanes++;
+            }
+            else {
+                _ranges.push_back({ p.textureIndex, i, 1 });
+            }
+        }
+        batch.nRanges = static_cast<uint32_t>(_ranges.size()) - batch.firstRange;
+
+        batch.center = 0.5f * (minimum + maximum);
+        for (uint32_t i = region.begin; i < region.end; i++) {
+            const Plane& p = planes[_order[i]];
+            batch.radius = std::max(
+                batch.radius,
+                glm::length(p.center - batch.center) + p.radius
+            );
+        }
+        _batches.push_back(batch);
+    }
+}
+
+void PlanesCloudPartition::select(const glm::dmat4& planesToWorld,
+                                  const glm::dmat4& viewProjection,
+                                  const glm::dvec3& cameraPosition,
+                                  double pixelsPerRadian, double minPixelSize,
+                                  Selection& selection) const
+{
+    ZoneScoped;
+
+    selection.batches.clear();
+    selection.ranges.clear();
+    selection.nPlanes = 0;
+
+    // Extract the six planes of the view frustum from the rows of the view-projection
+    // matrix. The normals point into the frustum
+    auto row = [&viewProjection](int i) {
+        return glm::dvec4(
+            viewProjection[0][i],
+            viewProjection[1][i],
+            viewProjection[2][i],
+            viewProjection[3][i]
+        );
+    };
+    std::array<glm::dvec4, 6> frustum;
+    for (int i = 0; i < 3; i++) {
+        frustum[2 * i] = row(3) + row(i);
+        frustum[2 * i + 1] = row(3) - row(i);
+    }
+    for (glm::dvec4& plane : frustum) {
+        plane /= glm::length(glm::dvec3(plane));
+    }
+
+    // The bounding spheres are scaled by the largest scaling of the transformation so
+    // that they still contain the batch for non-uniform scaling
+    const double radiusScale = std::max({
+        glm::length(glm::dvec3(planesToWorld[0])),
+        glm::length(glm::dvec3(planesToWorld[1])),
+        glm::length(glm::dvec3(planesToWorld[2]))
+    });
+
+    for (uint32_t i = 0; i < _batches.size(); i++) {
+        const Batch& batch = _batches[i];
+        const glm::dvec3 center = glm::dvec3(
+            planesToWorld * glm::dvec4(glm::dvec3(batch.center), 1.0)
+        );
+        const double radius = batch.radius * radiusScale;
+
+        const bool isVisible = std::all_of(
+            frustum.begin(),
+            frustum.end(),
+            [&](const glm::dvec4& plane) {
+                return glm::dot(glm::dvec3(plane), center) + plane.w >= -radius;
+            }
+        );
+        if (!isVisible) {
+            continue;
+        }
+
+        // If the camera is inside the bounding sphere, the planes can be arbitrarily
+        // close and the batch is always drawn
+        const double distance = glm::length(center - cameraPosition) - radius;
+        if (distance > 0.0) {
+            const double size =
+                2.0 * batch.maxPlaneRadius * radiusScale / distance * pixelsPerRadian;
+            if (size < minPixelSize) {
+                continue;
+            }
+        }
+
+        selection.batches.push_back(i);
+        selection.ranges.insert(
+            selection.ranges.end(),
+            _ranges.begin() + batch.firstRange,
+            _ranges.begin() + batch.firstRange + batch.nRanges
+        );
+        selection.nPlanes += batch.nPlanes;
+    }
+
+    // Group the ranges by texture so that each texture only has to be bound once. The
+    // sort is stable, so ranges of the same texture stay in the order of their planes
+    // and neighboring ranges can be merged
+    std::stable_sort(
+        selection.ranges.begin(),
+        selection.ranges.end(),
+        [](const Range& lhs, const Range& rhs) {
+            return lhs.textureIndex < rhs.textureIndex;
+        }
+    );
+    size_t nMerged = 0;
+    for (size_t i = 0; i < selection.ranges.size(); i++) {
+        const Range& range = selection.ranges[i];
+        if (nMerged > 0) {
+            Range& previous = selection.ranges[nMerged - 1];
+            if (previous.textureIndex == range.textureIndex &&
+                previous.firstPlane + previous.nPlanes == range.firstPlane)
+            {
+                previous.nPlanes += range.nPlanes;
+                continue;
+            }
+        }
+        selection.ranges[nMerged] = range;
+        nMerged++;
+    }
+    selection.ranges.resize(nMerged);
+}
+
+const std::vector<uint32_t>& PlanesCloudPartition::order() const {
+    return _order;
+}
+
+const std::vector<PlanesCloudPartition::Batch>& PlanesCloudPartition::batches() const {
+    return _batches;
+}
+
+const std::vector<PlanesCloudPartition::Range>& PlanesCloudPartition::ranges() const {
+    return _ranges;
+}
+
+} // namespace openspace
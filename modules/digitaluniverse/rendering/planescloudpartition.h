@@ -0,0 +1,121 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_DIGITALUNIVERSE___PLANESCLOUDPARTITION___H__
+#define __OPENSPACE_MODULE_DIGITALUNIVERSE___PLANESCLOUDPARTITION___H__
+
+#include <ghoul/glm.h>
+#include <cstdint>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Partitions the planes of a planes cloud into spatially compact batches, so that only
+ * the batches that are visible and large enough on screen have to be drawn and only
+ * their textures have to be loaded. The batches are the leaves of a kd-tree that splits
+ * the planes at the median of the longest axis of their centers. The planes are
+ * reordered so that each batch covers a contiguous range, and inside each batch the
+ * planes are sorted by texture, so that a batch is drawn with one range per texture.
+ */
+class PlanesCloudPartition {
+public:
+    struct Plane {
+        glm::vec3 center = glm::vec3(0.f);
+        /// The radius of the sphere around the center that contains the whole plane
+        float radius = 0.f;
+        int textureIndex = 0;
+    };
+
+    /// A contiguous range of reordered planes that all use the same texture
+    struct Range {
+        int textureIndex = 0;
+        uint32_t firstPlane = 0;
+        uint32_t nPlanes = 0;
+    };
+
+    struct Batch {
+        /// The bounding sphere of all planes in the batch
+        glm::vec3 center = glm::vec3(0.f);
+        float radius = 0.f;
+        /// The radius of the largest plane in the batch
+        float maxPlaneRadius = 0.f;
+        uint32_t firstPlane = 0;
+        uint32_t nPlanes = 0;
+        uint32_t firstRange = 0;
+        uint32_t nRanges = 0;
+    };
+
+    /// The ranges of reordered planes that should be drawn, sorted by texture
+    struct Selection {
+        std::vector<uint32_t> batches;
+        std::vector<Range> ranges;
+        size_t nPlanes = 0;
+    };
+
+    static constexpr unsigned int DefaultMaxPlanesPerBatch = 256;
+
+    PlanesCloudPartition() = default;
+
+    /**
+     * Partitions the \p planes into batches of at most \p maxPlanesPerBatch planes.
+     */
+    explicit PlanesCloudPartition(const std::vector<Plane>& planes,
+        unsigned int maxPlanesPerBatch = DefaultMaxPlanesPerBatch);
+
+    /**
+     * Selects the batches that should be drawn this frame. A batch is skipped if its
+     * bounding sphere is outside the view frustum, or if its largest plane, placed at the
+     * point of the batch that is closest to the camera, would be smaller than
+     * \p minPixelSize on screen. The ranges of the selected batches are grouped by
+     * texture.
+     *
+     * \param planesToWorld The transformation from the space of the planes that the
+     *        partition was built from to world space
+     * \param viewProjection The combined view and projection matrix of the camera
+     * \param cameraPosition The position of the camera in world space
+     * \param pixelsPerRadian The number of pixels covered by one radian at the center
+     *        of the screen
+     * \param minPixelSize The projected size, in pixels, below which planes are skipped
+     * \param selection Is filled with the batches and ranges that should be drawn.
+     *        Passing the same object each frame avoids repeated allocations
+     */
+    void select(const glm::dmat4& planesToWorld, const glm::dmat4& viewProjection,
+        const glm::dvec3& cameraPosition, double pixelsPerRadian, double minPixelSize,
+        Selection& selection) const;
+
+    /// Returns the index in the original planes of each reordered plane
+    const std::vector<uint32_t>& order() const;
+    const std::vector<Batch>& batches() const;
+    const std::vector<Range>& ranges() const;
+
+private:
+    std::vector<Batch> _batches;
+    std::vector<Range> _ranges;
+    std::vector<uint32_t> _order;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_DIGITALUNIVERSE___PLANESCLOUDPARTITION___H__
@@ -49,6 +49,13 @@ namespace {
 
     constexpr int PlanesVertexDataSize = 36;
 
+    // Planes with this texture index have an undefined texture and are not drawn
+    constexpr int UndefinedTextureIndex = 30;
+
+    // Loading a texture stalls the rendering, so only a few of the textures that become
+    // visible are loaded each frame
+    constexpr int MaxTextureLoadsPerFrame = 4;
+
     constexpr std::array<const char*, 4> UniformNames = {
         "modelViewProjectionTransform", "alphaValue", "fadeInValue", "galaxyTexture"
     };
@@ -146,6 +153,16 @@ namespace {
         openspace::properties::Property::Visibility::AdvancedUser
     };
 
+    constexpr openspace::properties::Property::PropertyInfo MaxLoadedTexturesInfo = {
+        "MaxLoadedTextures",
+        "Max Loaded Textures",
+        "The maximum number of textures that are kept in memory. Textures are only "
+        "loaded when planes that use them become visible, and the textures that have "
+        "not been used for the longest time are unloaded when this number is exceeded. "
+        "The textures of all planes that are visible at the same time are always kept",
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
     struct [[codegen::Dictionary(RenderablePlanesCloud)]] Parameters {
         // The path to the SPECK file that contains information about the astronomical
         // object being rendered
@@ -197,6 +214,9 @@ namespace {
 
         // [[codegen::verbatim(PlaneMinSizeInfo.description)]]
         std::optional<float> planeMinSize;
+
+        // [[codegen::verbatim(MaxLoadedTexturesInfo.description)]]
+        std::optional<int> maxLoadedTextures [[codegen::greater(0)]];
     };
 #include "renderableplanescloud_codegen.cpp"
 }  // namespace
@@ -221,6 +241,7 @@ RenderablePlanesCloud::RenderablePlanesCloud(const ghoul::Dictionary& dictionary
     , _disableFadeInDistance(DisableFadeInInfo, true)
     , _planeMinSize(PlaneMinSizeInfo, 0.5, 0.0, 500.0)
     , _renderOption(RenderOptionInfo, properties::OptionProperty::DisplayType::Dropdown)
+    , _maxLoadedTextures(MaxLoadedTexturesInfo, 128, 1, 4096)
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -306,6 +327,9 @@ RenderablePlanesCloud::RenderablePlanesCloud(const ghoul::Dictionary& dictionary
     if (p.planeMinSize.has_value()) {
         addProperty(_planeMinSize);
     }
+
+    _maxLoadedTextures = p.maxLoadedTextures.value_or(_maxLoadedTextures);
+    addProperty(_maxLoadedTextures);
 }
 
 bool RenderablePlanesCloud::isReady() const {
@@ -326,6 +350,7 @@ void RenderablePlanesCloud::initialize() {
         if (_dataset.entries.empty()) {
             throw ghoul::RuntimeError("Error loading data");
         }
+        findTextureFiles();
     }
 
     if (_hasLabels) {
@@ -351,20 +376,29 @@ void RenderablePlanesCloud::initializeGL() {
     ghoul::opengl::updateUniformLocations(*_program, _uniformCache, UniformNames);
 
     createPlanes();
-    loadTextures();
+
+    if (_hasLabels) {
+        _labels->initializeGL();
+    }
 }
 
 void RenderablePlanesCloud::deleteDataGPUAndCPU() {
-    for (std::unordered_map<int, PlaneAggregate>::reference pAMapItem : _planesMap) {
-        glDeleteBuffers(1, &pAMapItem.second.vbo);
-        glDeleteVertexArrays(1, &pAMapItem.second.vao);
-        pAMapItem.second.planesCoordinates.clear();
-    }
-    _planesMap.clear();
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+    _partition = PlanesCloudPartition();
+    _selection = PlanesCloudPartition::Selection();
 }
 
 void RenderablePlanesCloud::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+
     deleteDataGPUAndCPU();
+    _textureMap.clear();
+    _textureUsage.clear();
 
     DigitalUniverseModule::ProgramObjectManager.release(
         "RenderablePlanesCloud",
@@ -374,11 +408,32 @@ void RenderablePlanesCloud::deinitializeGL() {
     );
 }
 
-void RenderablePlanesCloud::renderPlanes(const RenderData&,
+void RenderablePlanesCloud::renderPlanes(const RenderData& data,
+                                         const glm::dmat4& modelTransform,
                                          const glm::dmat4& modelViewTransform,
                                          const glm::dmat4& projectionTransform,
                                          const float fadeInVariable)
 {
+    GLint viewport[4];
+    global::renderEngine->openglStateCache().viewport(viewport);
+
+    // Only the batches of planes that are visible and large enough on screen are drawn
+    const glm::dmat4 viewProjectionTransform =
+        projectionTransform * data.camera.combinedViewMatrix();
+    const double pixelsPerRadian = 0.5 * viewport[3] * projectionTransform[1][1];
+    _partition.select(
+        modelTransform,
+        viewProjectionTransform,
+        data.camera.positionVec3(),
+        pixelsPerRadian,
+        _planeMinSize,
+        _selection
+    );
+    if (_selection.ranges.empty()) {
+        return;
+    }
+    updateTextures();
+
     glEnablei(GL_BLEND, 0);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE);
     //glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -397,27 +452,42 @@ void RenderablePlanesCloud::renderPlanes(const RenderData&,
 
     glDisable(GL_CULL_FACE);
 
-    GLint viewport[4];
-    global::renderEngine->openglStateCache().viewport(viewport);
-
     ghoul::opengl::TextureUnit unit;
     unit.activate();
     _program->setUniform(_uniformCache.galaxyTexture, unit);
-    int currentTextureIndex = -1;
 
-    for (std::unordered_map<int, PlaneAggregate>::reference pAMapItem : _planesMap) {
-        // For planes with undefined textures references
-        if (pAMapItem.first == 30) {
-            continue;
+    glBindVertexArray(_vao);
+
+    // The selected ranges are sorted by texture, so each texture is bound once and all
+    // of its ranges are drawn together
+    std::vector<GLint> firsts;
+    std::vector<GLsizei> counts;
+    size_t i = 0;
+    while (i < _selection.ranges.size()) {
+        const int textureIndex = _selection.ranges[i].textureIndex;
+        firsts.clear();
+        counts.clear();
+        for (; i < _selection.ranges.size(); i++) {
+            const PlanesCloudPartition::Range& range = _selection.ranges[i];
+            if (range.textureIndex != textureIndex) {
+                break;
+            }
+            firsts.push_back(static_cast<GLint>(6 * range.firstPlane));
+            counts.push_back(static_cast<GLsizei>(6 * range.nPlanes));
         }
 
-        // We only bind a new texture when it is needed
-        if (currentTextureIndex != pAMapItem.first) {
-            _textureMap[pAMapItem.first]->bind();
-            currentTextureIndex = pAMapItem.first;
+        // Textures that have not been loaded yet are skipped until they are available
+        auto it = _textureMap.find(textureIndex);
+        if (it == _textureMap.end()) {
+            continue;
         }
-        glBindVertexArray(pAMapItem.second.vao);
-        glDrawArrays(GL_TRIANGLES, 0, 6 * pAMapItem.second.numberOfPlanes);
+        it->second.texture->bind();
+        glMultiDrawArrays(
+            GL_TRIANGLES,
+            firsts.data(),
+            counts.data(),
+            static_cast<GLsizei>(firsts.size())
+        );
     }
 
     glBindVertexArray(0);
@@ -453,7 +523,13 @@ void RenderablePlanesCloud::render(const RenderData& data, RendererTasks&) {
     const glm::mat4 projectionTransform = data.camera.projectionMatrix();
 
     if (_hasSpeckFile) {
-        renderPlanes(data, modelViewTransform, projectionTransform, fadeInVariable);
+        renderPlanes(
+            data,
+            modelTransform,
+            modelViewTransform,
+            projectionTransform,
+            fadeInVariable
+        );
     }
 
     if (_hasLabels) {
@@ -487,18 +563,17 @@ void RenderablePlanesCloud::update(const UpdateData&) {
     }
 }
 
-void RenderablePlanesCloud::loadTextures() {
+void RenderablePlanesCloud::findTextureFiles() {
     for (const dataloader::Dataset::Texture& tex : _dataset.textures) {
         std::filesystem::path fullPath = absPath(_texturesPath.string() + '/' + tex.file);
         std::filesystem::path pngPath = fullPath;
         pngPath.replace_extension(".png");
 
-        std::filesystem::path path;
         if (std::filesystem::is_regular_file(fullPath)) {
-            path = fullPath;
+            _textureFileMap[tex.index] = fullPath;
         }
         else if (std::filesystem::is_regular_file(pngPath)) {
-            path = pngPath;
+            _textureFileMap[tex.index] = pngPath;
         }
         else {
             // We can't really recover from this as it would crash during rendering anyway
@@ -506,24 +581,76 @@ void RenderablePlanesCloud::loadTextures() {
                 "Could not find image file '{}'", tex.file
             ));
         }
+    }
+}
+
+void RenderablePlanesCloud::loadTexture(int textureIndex) {
+    ZoneScoped;
+
+    auto it = _textureFileMap.find(textureIndex);
+    if (it == _textureFileMap.end()) {
+        return;
+    }
+
+    std::unique_ptr<ghoul::opengl::Texture> t =
+        ghoul::io::TextureReader::ref().loadTexture(it->second.string(), 2);
+    if (!t) {
+        // The file existed during initialization, so something is wrong with it. We
+        // don't try to load it again, which means that its planes are not drawn
+        LERROR(fmt::format("Could not load image file {}", it->second));
+        _textureFileMap.erase(it);
+        return;
+    }
+
+    LDEBUG(fmt::format("Loaded texture {}", it->second));
+    t->uploadTexture();
+    t->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
+    t->purgeFromRAM();
+
+    _textureUsage.push_front(textureIndex);
+    _textureMap[textureIndex] = { std::move(t), _textureUsage.begin() };
+}
 
-        std::unique_ptr<ghoul::opengl::Texture> t =
-            ghoul::io::TextureReader::ref().loadTexture(path.string(), 2);
+void RenderablePlanesCloud::updateTextures() {
+    ZoneScoped;
 
-        if (t) {
-            LINFOC("RenderablePlanesCloud", fmt::format("Loaded texture {}", path));
-            t->uploadTexture();
-            t->setFilter(ghoul::opengl::Texture::FilterMode::LinearMipMap);
-            t->purgeFromRAM();
+    // Move the textures that are used this frame to the front of the usage list and
+    // load the missing ones. The ranges are sorted by texture, so each texture is only
+    // handled once
+    size_t nUsed = 0;
+    int nLoaded = 0;
+    int previousTextureIndex = -1;
+    for (const PlanesCloudPartition::Range& range : _selection.ranges) {
+        if (range.textureIndex == previousTextureIndex) {
+            continue;
         }
-        else {
-            // Same here, we won't be able to recover from this nullptr
-            throw ghoul::RuntimeError(fmt::format(
-                "Could not find image file '{}'", tex.file
-            ));
+        previousTextureIndex = range.textureIndex;
+
+        auto it = _textureMap.find(range.textureIndex);
+        if (it != _textureMap.end()) {
+            _textureUsage.splice(
+                _textureUsage.begin(),
+                _textureUsage,
+                it->second.usage
+            );
+            nUsed++;
+        }
+        else if (nLoaded < MaxTextureLoadsPerFrame) {
+            const size_t nTextures = _textureMap.size();
+            loadTexture(range.textureIndex);
+            nLoaded++;
+            nUsed += _textureMap.size() - nTextures;
         }
+    }
 
-        _textureMap.insert(std::pair(tex.index, std::move(t)));
+    // Unload the least recently used textures, but never one that is used this frame
+    const size_t maxTextures = std::max(
+        static_cast<size_t>(_maxLoadedTextures.value()),
+        nUsed
+    );
+    while (_textureUsage.size() > maxTextures) {
+        _textureMap.erase(_textureUsage.back());
+        _textureUsage.pop_back();
     }
 }
 
@@ -535,7 +662,18 @@ void RenderablePlanesCloud::createPlanes() {
         LDEBUG("Creating planes...");
         float maxSize = 0.f;
         double maxRadius = 0.0;
+        std::vector<PlanesCloudPartition::Plane> planes;
+        planes.reserve(_dataset.entries.size());
+        std::vector<GLfloat> vertexData;
+        vertexData.reserve(_dataset.entries.size() * PlanesVertexDataSize);
         for (const dataloader::Dataset::Entry& e : _dataset.entries) {
+            const int textureIndex = static_cast<int>(e.data[_dataset.textureDataIndex]);
+            if (textureIndex == UndefinedTextureIndex ||
+                !_textureFileMap.contains(textureIndex))
+            {
+                continue;
+            }
+
             const glm::vec4 transformedPos = glm::vec4(
                 _transformationMatrix * glm::dvec4(e.position, 1.0)
             );
@@ -589,12 +727,21 @@ void RenderablePlanesCloud::createPlanes() {
                 maxSize = std::max(maxSize, vertex4[i]);
             }
 
+            PlanesCloudPartition::Plane plane;
+            plane.center = glm::vec3(glm::dvec3(transformedPos) * scale);
+            plane.radius = static_cast<float>(
+                std::max(glm::length(glm::dvec4(u + v)), glm::length(glm::dvec4(u - v))) *
+                scale
+            );
+            plane.textureIndex = textureIndex;
+            planes.push_back(plane);
+
             vertex0 = glm::vec4(glm::dvec4(vertex0) * scale);
             vertex1 = glm::vec4(glm::dvec4(vertex1) * scale);
             vertex2 = glm::vec4(glm::dvec4(vertex2) * scale);
             vertex4 = glm::vec4(glm::dvec4(vertex4) * scale);
 
-            const std::array<GLfloat, 36> VertexData = {
+            const std::array<GLfloat, PlanesVertexDataSize> VertexData = {
                 //  x          y          z       w    s    t
                 vertex0.x, vertex0.y, vertex0.z, 1.f, 0.f, 0.f,
                 vertex1.x, vertex1.y, vertex1.z, 1.f, 1.f, 1.f,
@@ -603,56 +750,55 @@ void RenderablePlanesCloud::createPlanes() {
                 vertex4.x, vertex4.y, vertex4.z, 1.f, 1.f, 0.f,
                 vertex1.x, vertex1.y, vertex1.z, 1.f, 1.f, 1.f,
             };
-
-            int textureIndex = static_cast<int>(e.data[_dataset.textureDataIndex]);
-            std::unordered_map<int, PlaneAggregate>::iterator found =
-                _planesMap.find(textureIndex);
-            if (found != _planesMap.end()) {
-                for (int i = 0; i < PlanesVertexDataSize; ++i) {
-                    found->second.planesCoordinates.push_back(VertexData[i]);
-                }
-                found->second.numberOfPlanes++;
-            }
-            else {
-                PlaneAggregate pA;
-                pA.textureIndex = textureIndex;
-                glGenVertexArrays(1, &pA.vao);
-                glGenBuffers(1, &pA.vbo);
-                pA.numberOfPlanes = 1;
-                for (int i = 0; i < PlanesVertexDataSize; ++i) {
-                    pA.planesCoordinates.push_back(VertexData[i]);
-                }
-                _planesMap.insert(std::pair(textureIndex, pA));
-            }
+            vertexData.insert(vertexData.end(), VertexData.begin(), VertexData.end());
         }
 
-        // Send data to GPU
-        for (const std::pair<const int, PlaneAggregate>& pAMapItem : _planesMap) {
-            glBindVertexArray(pAMapItem.second.vao);
-            glBindBuffer(GL_ARRAY_BUFFER, pAMapItem.second.vbo);
-            glBufferData(
-                GL_ARRAY_BUFFER,
-                sizeof(GLfloat) * PlanesVertexDataSize * pAMapItem.second.numberOfPlanes,
-                pAMapItem.second.planesCoordinates.data(),
-                GL_STATIC_DRAW
-            );
-            // in_position
-            glEnableVertexAttribArray(0);
-            glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), nullptr);
-
-            // texture coords
-            glEnableVertexAttribArray(1);
-            glVertexAttribPointer(
-                1,
-                2,
-                GL_FLOAT,
-                GL_FALSE,
-                6 * sizeof(GLfloat),
-                reinterpret_cast<GLvoid*>(4 * sizeof(GLfloat))
+        // The planes are stored in the order of the partition, so that each batch and
+        // each of its texture ranges covers a contiguous range of the vertex buffer
+        _partition = PlanesCloudPartition(planes);
+        std::vector<GLfloat> orderedVertexData(vertexData.size());
+        for (size_t i = 0; i < _partition.order().size(); i++) {
+            const size_t plane = _partition.order()[i];
+            std::copy_n(
+                vertexData.begin() + plane * PlanesVertexDataSize,
+                PlanesVertexDataSize,
+                orderedVertexData.begin() + i * PlanesVertexDataSize
             );
+        }
+        LDEBUG(fmt::format(
+            "Partitioned {} planes into {} batches",
+            planes.size(), _partition.batches().size()
+        ));
 
-            glBindVertexArray(0);
+        // Send data to GPU
+        if (_vao == 0) {
+            glGenVertexArrays(1, &_vao);
+            glGenBuffers(1, &_vbo);
         }
+        glBindVertexArray(_vao);
+        glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+        glBufferData(
+            GL_ARRAY_BUFFER,
+            sizeof(GLfloat) * orderedVertexData.size(),
+            orderedVertexData.data(),
+            GL_STATIC_DRAW
+        );
+        // in_position
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat), nullptr);
+
+        // texture coords
+        glEnableVertexAttribArray(1);
+        glVertexAttribPointer(
+            1,
+            2,
+            GL_FLOAT,
+            GL_FALSE,
+            6 * sizeof(GLfloat),
+            reinterpret_cast<GLvoid*>(4 * sizeof(GLfloat))
+        );
+
+        glBindVertexArray(0);
 
         _dataIsDirty = false;
 
@@ -27,11 +27,13 @@
 
 #include <openspace/rendering/renderable.h>
 
+#include <modules/digitaluniverse/rendering/planescloudpartition.h>
 #include <openspace/data/dataloader.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/stringproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
+#include <openspace/properties/scalar/intproperty.h>
 #include <openspace/properties/vector/vec2property.h>
 #include <openspace/properties/vector/vec3property.h>
 #include <openspace/rendering/labelscomponent.h>
@@ -40,6 +42,7 @@
 #include <ghoul/opengl/uniformcache.h>
 #include <filesystem>
 #include <functional>
+#include <list>
 #include <unordered_map>
 
 namespace ghoul::filesystem { class File; }
@@ -71,20 +74,23 @@ public:
     static documentation::Documentation Documentation();
 
 private:
-    struct PlaneAggregate {
-        int textureIndex;
-        int numberOfPlanes;
-        GLuint vao;
-        GLuint vbo;
-        std::vector<GLfloat> planesCoordinates;
+    struct LoadedTexture {
+        std::unique_ptr<ghoul::opengl::Texture> texture;
+        // The position of the texture in _textureUsage
+        std::list<int>::iterator usage;
     };
 
     void deleteDataGPUAndCPU();
     void createPlanes();
-    void renderPlanes(const RenderData& data, const glm::dmat4& modelViewTransform,
-        const glm::dmat4& projectionTransform, float fadeInVariable);
+    void renderPlanes(const RenderData& data, const glm::dmat4& modelTransform,
+        const glm::dmat4& modelViewTransform, const glm::dmat4& projectionTransform,
+        float fadeInVariable);
 
-    void loadTextures();
+    void findTextureFiles();
+    void loadTexture(int textureIndex);
+    /// Makes sure that the textures of the selected planes are loaded, loading at most a
+    /// few missing textures per frame, and unloads the least recently used textures
+    void updateTextures();
 
     bool _hasSpeckFile = false;
     bool _dataIsDirty = true;
@@ -97,14 +103,21 @@ private:
     properties::BoolProperty _disableFadeInDistance;
     properties::FloatProperty _planeMinSize;
     properties::OptionProperty _renderOption;
+    properties::IntProperty _maxLoadedTextures;
 
     ghoul::opengl::ProgramObject* _program = nullptr;
     UniformCache(
         modelViewProjectionTransform, alphaValue, fadeInValue, galaxyTexture
     ) _uniformCache;
-    std::unordered_map<int, std::unique_ptr<ghoul::opengl::Texture>> _textureMap;
-    std::unordered_map<int, std::string> _textureFileMap;
-    std::unordered_map<int, PlaneAggregate> _planesMap;
+    std::unordered_map<int, LoadedTexture> _textureMap;
+    // The indices of the loaded textures, with the most recently used texture first
+    std::list<int> _textureUsage;
+    std::unordered_map<int, std::filesystem::path> _textureFileMap;
+
+    PlanesCloudPartition _partition;
+    PlanesCloudPartition::Selection _selection;
+    GLuint _vao = 0;
+    GLuint _vbo = 0;
 
     std::filesystem::path _speckFile;
     std::filesystem::path _texturesPath;
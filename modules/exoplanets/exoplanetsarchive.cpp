@@ -0,0 +1,426 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/exoplanets/exoplanetsarchive.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <sstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "ExoplanetsArchive";
+
+    constexpr std::array<char, 8> Magic = { 'O', 'S', 'E', 'X', 'O', 'I', 'D', 'X' };
+    constexpr uint32_t CurrentVersion = 2;
+
+    // FNV-1a
+    uint64_t hash(std::string_view s) {
+        uint64_t h = 14695981039346656037ull;
+        for (char c : s) {
+            h ^= static_cast<uint8_t>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    template <typename T>
+    void append(std::vector<std::byte>& buffer, const T& value) {
+        const std::byte* p = reinterpret_cast<const std::byte*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    std::string_view hostName(std::string_view planetName) {
+        // Remove the last two characters, that specify the planet
+        return planetName.substr(0, planetName.size() >= 2 ? planetName.size() - 2 : 0);
+    }
+
+    std::string readLookUpTable(const std::filesystem::path& lookUpTable) {
+        // The file is read in binary mode so that the hash of the contents does not
+        // depend on the platform's line endings
+        std::ifstream lut(lookUpTable, std::ios::binary);
+        if (!lut.good()) {
+            throw ghoul::RuntimeError(fmt::format(
+                "Failed to open exoplanets look-up table '{}'", lookUpTable
+            ));
+        }
+        return std::string(
+            std::istreambuf_iterator<char>(lut),
+            std::istreambuf_iterator<char>()
+        );
+    }
+
+    openspace::exoplanets::ExoplanetsIndex::LookUpTableInfo contentsInfo(
+                                                              std::string_view contents)
+    {
+        return { .size = contents.size(), .hash = hash(contents) };
+    }
+} // namespace
+
+namespace openspace::exoplanets {
+
+ExoplanetsIndex::LookUpTableInfo ExoplanetsIndex::lookUpTableInfo(
+                                                 const std::filesystem::path& lookUpTable)
+{
+    return contentsInfo(readLookUpTable(lookUpTable));
+}
+
+std::vector<std::byte> ExoplanetsIndex::create(
+                             const std::vector<std::pair<std::string, uint64_t>>& planets,
+                                                                    uint64_t dataFileSize,
+                                                             LookUpTableInfo lookUpTable)
+{
+    // Group the planets by their host star, retaining the order of the planets
+    std::map<std::string_view, std::vector<size_t>> hosts;
+    for (size_t i = 0; i < planets.size(); i++) {
+        hosts[hostName(planets[i].first)].push_back(i);
+    }
+
+    std::string strings;
+    std::vector<HostRecord> hostRecords;
+    hostRecords.reserve(hosts.size());
+    std::vector<PlanetRecord> planetRecords;
+    planetRecords.reserve(planets.size());
+    for (const auto& [name, planetIndices] : hosts) {
+        HostRecord host = {
+            .nameOffset = static_cast<uint32_t>(strings.size()),
+            .nameLength = static_cast<uint32_t>(name.size()),
+            .firstPlanet = static_cast<uint32_t>(planetRecords.size()),
+            .nPlanets = static_cast<uint32_t>(planetIndices.size())
+        };
+        strings += name;
+        hostRecords.push_back(host);
+
+        for (size_t i : planetIndices) {
+            const std::string& planetName = planets[i].first;
+            PlanetRecord planet = {
+                .dataOffset = planets[i].second,
+                .nameOffset = static_cast<uint32_t>(strings.size()),
+                .nameLength = static_cast<uint32_t>(planetName.size())
+            };
+            strings += planetName;
+            planetRecords.push_back(planet);
+        }
+    }
+
+    // Open addressing with linear probing, with at most half of the slots used. A slot
+    // stores the index of the host record + 1, so that 0 marks an empty slot
+    uint32_t hashTableSize = 1;
+    while (hashTableSize < 2 * hostRecords.size()) {
+        hashTableSize *= 2;
+    }
+    std::vector<uint32_t> hashTable(hashTableSize, 0);
+    for (size_t i = 0; i < hostRecords.size(); i++) {
+        const HostRecord& host = hostRecords[i];
+        const std::string_view name = std::string_view(strings).substr(
+            host.nameOffset,
+            host.nameLength
+        );
+        uint64_t slot = hash(name) & (hashTableSize - 1);
+        while (hashTable[slot] != 0) {
+            slot = (slot + 1) & (hashTableSize - 1);
+        }
+        hashTable[slot] = static_cast<uint32_t>(i + 1);
+    }
+
+    Header header = {
+        .magic = Magic,
+        .version = CurrentVersion,
+        .nHosts = static_cast<uint32_t>(hostRecords.size()),
+        .nPlanets = static_cast<uint32_t>(planetRecords.size()),
+        .hashTableSize = hashTableSize,
+        .dataFileSize = dataFileSize,
+        .lookUpTableSize = lookUpTable.size,
+        .lookUpTableHash = lookUpTable.hash,
+        .stringsSize = strings.size()
+    };
+
+    std::vector<std::byte> buffer;
+    buffer.reserve(
+        sizeof(Header) + hostRecords.size() * sizeof(HostRecord) +
+        planetRecords.size() * sizeof(PlanetRecord) + hashTableSize * sizeof(uint32_t) +
+        strings.size()
+    );
+    append(buffer, header);
+    for (const HostRecord& host : hostRecords) {
+        append(buffer, host);
+    }
+    for (const PlanetRecord& planet : planetRecords) {
+        append(buffer, planet);
+    }
+    for (uint32_t slot : hashTable) {
+        append(buffer, slot);
+    }
+    const std::byte* s = reinterpret_cast<const std::byte*>(strings.data());
+    buffer.insert(buffer.end(), s, s + strings.size());
+    return buffer;
+}
+
+std::vector<std::byte> ExoplanetsIndex::createFromLookUpTable(
+                                                 const std::filesystem::path& lookUpTable,
+                                                                   uint64_t dataFileSize)
+{
+    const std::string contents = readLookUpTable(lookUpTable);
+
+    std::vector<std::pair<std::string, uint64_t>> planets;
+    std::istringstream lut(contents);
+    std::string line;
+    while (std::getline(lut, line)) {
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        const size_t comma = line.rfind(',');
+        if (comma == std::string::npos) {
+            continue;
+        }
+        planets.emplace_back(
+            line.substr(0, comma),
+            std::stoull(line.substr(comma + 1))
+        );
+    }
+    return create(planets, dataFileSize, contentsInfo(contents));
+}
+
+ExoplanetsIndex::ExoplanetsIndex(std::span<const std::byte> data) {
+    if (data.size() < sizeof(Header)) {
+        throw ghoul::RuntimeError("Exoplanets index is too small");
+    }
+    _header = reinterpret_cast<const Header*>(data.data());
+    if (_header->magic != Magic || _header->version != CurrentVersion) {
+        throw ghoul::RuntimeError("Exoplanets index has an unsupported format");
+    }
+
+    const size_t hostsOffset = sizeof(Header);
+    const size_t planetsOffset = hostsOffset + _header->nHosts * sizeof(HostRecord);
+    const size_t hashOffset = planetsOffset + _header->nPlanets * sizeof(PlanetRecord);
+    const size_t stringsOffset = hashOffset + _header->hashTableSize * sizeof(uint32_t);
+    if (stringsOffset + _header->stringsSize != data.size() ||
+        !std::has_single_bit(_header->hashTableSize))
+    {
+        throw ghoul::RuntimeError("Exoplanets index is corrupted");
+    }
+
+    _hosts = std::span<const HostRecord>(
+        reinterpret_cast<const HostRecord*>(data.data() + hostsOffset),
+        _header->nHosts
+    );
+    _planets = std::span<const PlanetRecord>(
+        reinterpret_cast<const PlanetRecord*>(data.data() + planetsOffset),
+        _header->nPlanets
+    );
+    _hashTable = std::span<const uint32_t>(
+        reinterpret_cast<const uint32_t*>(data.data() + hashOffset),
+        _header->hashTableSize
+    );
+    _strings = std::string_view(
+        reinterpret_cast<const char*>(data.data() + stringsOffset),
+        _header->stringsSize
+    );
+
+    for (const HostRecord& host : _hosts) {
+        if (host.nameOffset + static_cast<uint64_t>(host.nameLength) > _strings.size() ||
+            host.firstPlanet + static_cast<uint64_t>(host.nPlanets) > _planets.size())
+        {
+            throw ghoul::RuntimeError("Exoplanets index is corrupted");
+        }
+    }
+    for (const PlanetRecord& planet : _planets) {
+        if (planet.nameOffset + static_cast<uint64_t>(planet.nameLength) >
+            _strings.size())
+        {
+            throw ghoul::RuntimeError("Exoplanets index is corrupted");
+        }
+    }
+}
+
+uint64_t ExoplanetsIndex::dataFileSize() const {
+    return _header ? _header->dataFileSize : 0;
+}
+
+ExoplanetsIndex::LookUpTableInfo ExoplanetsIndex::lookUpTable() const {
+    if (!_header) {
+        return LookUpTableInfo();
+    }
+    return { .size = _header->lookUpTableSize, .hash = _header->lookUpTableHash };
+}
+
+std::vector<ExoplanetsIndex::Planet> ExoplanetsIndex::planets(
+                                                         std::string_view hostStar) const
+{
+    if (_hashTable.empty()) {
+        return {};
+    }
+
+    const uint64_t mask = _hashTable.size() - 1;
+    for (uint64_t slot = hash(hostStar) & mask; _hashTable[slot] != 0;
+         slot = (slot + 1) & mask)
+    {
+        const HostRecord& host = _hosts[_hashTable[slot] - 1];
+        if (string(host.nameOffset, host.nameLength) != hostStar) {
+            continue;
+        }
+
+        std::vector<Planet> res;
+        res.reserve(host.nPlanets);
+        for (uint32_t i = 0; i < host.nPlanets; i++) {
+            const PlanetRecord& planet = _planets[host.firstPlanet + i];
+            res.push_back({
+                .name = string(planet.nameOffset, planet.nameLength),
+                .dataOffset = planet.dataOffset
+            });
+        }
+        return res;
+    }
+    return {};
+}
+
+std::vector<std::string_view> ExoplanetsIndex::hostStars(std::string_view prefix) const {
+    auto it = std::lower_bound(
+        _hosts.begin(),
+        _hosts.end(),
+        prefix,
+        [this](const HostRecord& host, std::string_view p) {
+            return string(host.nameOffset, host.nameLength) < p;
+        }
+    );
+
+    std::vector<std::string_view> res;
+    for (; it != _hosts.end(); it++) {
+        const std::string_view name = string(it->nameOffset, it->nameLength);
+        if (!name.starts_with(prefix)) {
+            break;
+        }
+        res.push_back(name);
+    }
+    return res;
+}
+
+std::string_view ExoplanetsIndex::string(uint32_t offset, uint32_t length) const {
+    return _strings.substr(offset, length);
+}
+
+ExoplanetsArchive::ExoplanetsArchive(const std::filesystem::path& dataFile,
+                                     const std::filesystem::path& lookUpTable,
+                                     const std::filesystem::path& indexFile)
+    : _data(dataFile)
+{
+    if (std::filesystem::is_regular_file(indexFile)) {
+        try {
+            _indexFile = MemoryMappedFile(indexFile);
+            _index = ExoplanetsIndex(_indexFile->data());
+            const bool isStale =
+                _index.dataFileSize() != _data.size() ||
+                _index.lookUpTable() != ExoplanetsIndex::lookUpTableInfo(lookUpTable);
+            if (isStale) {
+                LINFO(fmt::format(
+                    "Exoplanets index '{}' does not match the data file", indexFile
+                ));
+                _indexFile = std::nullopt;
+                _index = ExoplanetsIndex();
+            }
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LWARNING(fmt::format(
+                "Could not read exoplanets index '{}': {}", indexFile, e.message
+            ));
+            _indexFile = std::nullopt;
+            _index = ExoplanetsIndex();
+        }
+    }
+
+    if (!_indexFile.has_value()) {
+        // Without an index file, we create the index in memory once
+        _indexBuffer = ExoplanetsIndex::createFromLookUpTable(lookUpTable, _data.size());
+        _index = ExoplanetsIndex(_indexBuffer);
+    }
+}
+
+ExoplanetSystem ExoplanetsArchive::system(std::string_view starName) const {
+    ExoplanetSystem system;
+    system.starName = starName;
+
+    for (const ExoplanetsIndex::Planet& planet : _index.planets(starName)) {
+        std::string name = std::string(planet.name);
+        sanitizeNameString(name);
+
+        std::optional<ExoplanetDataEntry> p = planetData(planet.dataOffset);
+        if (!p.has_value() || !hasSufficientData(*p)) {
+            LWARNING(fmt::format("Insufficient data for exoplanet: '{}'", name));
+            continue;
+        }
+
+        system.planetNames.push_back(std::move(name));
+        system.planetsData.push_back(*p);
+        updateStarDataFromNewPlanet(system.starData, *p);
+    }
+    return system;
+}
+
+std::vector<ExoplanetSystem> ExoplanetsArchive::systems(
+                                          const std::vector<std::string>& starNames) const
+{
+    std::vector<ExoplanetSystem> res;
+    res.reserve(starNames.size());
+    for (const std::string& starName : starNames) {
+        res.push_back(system(starName));
+    }
+    return res;
+}
+
+std::vector<std::string> ExoplanetsArchive::hostStarsWithSufficientData(
+                                                            std::string_view prefix) const
+{
+    std::vector<std::string> res;
+    for (std::string_view host : _index.hostStars(prefix)) {
+        // Don't want to list systems where there is not enough data to visualize
+        for (const ExoplanetsIndex::Planet& planet : _index.planets(host)) {
+            std::optional<ExoplanetDataEntry> p = planetData(planet.dataOffset);
+            if (p.has_value() && hasSufficientData(*p)) {
+                res.emplace_back(host);
+                break;
+            }
+        }
+    }
+    return res;
+}
+
+std::optional<ExoplanetDataEntry> ExoplanetsArchive::planetData(uint64_t offset) const {
+    const std::span<const std::byte> data = _data.data();
+    if (offset + sizeof(ExoplanetDataEntry) > data.size()) {
+        return std::nullopt;
+    }
+
+    // The entries in the data file are not necessarily aligned
+    ExoplanetDataEntry p;
+    std::memcpy(&p, data.data() + offset, sizeof(ExoplanetDataEntry));
+    return p;
+}
+
+} // namespace openspace::exoplanets
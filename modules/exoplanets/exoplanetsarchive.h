@@ -0,0 +1,208 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_EXOPLANETS___EXOPLANETSARCHIVE___H__
+#define __OPENSPACE_MODULE_EXOPLANETS___EXOPLANETSARCHIVE___H__
+
+#include <modules/exoplanets/exoplanetshelper.h>
+#include <openspace/util/memorymappedfile.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace openspace::exoplanets {
+
+/**
+ * A binary index into the exoplanets data file that is created by the
+ * ExoplanetsDataPreparationTask. It maps the name of a host star through a hash table to
+ * the names of its planets and their offsets in the data file, and it contains the host
+ * star names in sorted order for prefix searches. The index is designed to be used
+ * directly from a memory-mapped file without any parsing.
+ */
+class ExoplanetsIndex {
+public:
+    struct Planet {
+        std::string_view name;
+        uint64_t dataOffset = 0;
+    };
+
+    /**
+     * Identifies the contents of the textual look-up table that an index was created
+     * for. A content hash is used instead of the modification time, as the latter
+     * changes whenever the files are copied or downloaded.
+     */
+    struct LookUpTableInfo {
+        uint64_t size = 0;
+        uint64_t hash = 0;
+
+        bool operator==(const LookUpTableInfo& rhs) const = default;
+    };
+
+    /**
+     * Returns the LookUpTableInfo for the look-up table at \p lookUpTable.
+     *
+     * \throw ghoul::RuntimeError If the look-up table cannot be read
+     */
+    static LookUpTableInfo lookUpTableInfo(const std::filesystem::path& lookUpTable);
+
+    /**
+     * Serializes the index for the provided list of planet names and their offsets into
+     * the data file. As in the look-up table, the name of the host star is the name of
+     * the planet without the last two characters (for example 'HD 10180' for
+     * 'HD 10180 c'). The \p dataFileSize and the \p lookUpTable information are stored
+     * to detect a stale index.
+     */
+    static std::vector<std::byte> create(
+        const std::vector<std::pair<std::string, uint64_t>>& planets,
+        uint64_t dataFileSize, LookUpTableInfo lookUpTable);
+
+    /**
+     * Serializes the index for the textual look-up table at \p lookUpTable, in which
+     * each line has the format `<planet name>,<offset>`.
+     *
+     * \throw ghoul::RuntimeError If the look-up table cannot be read
+     */
+    static std::vector<std::byte> createFromLookUpTable(
+        const std::filesystem::path& lookUpTable, uint64_t dataFileSize);
+
+    ExoplanetsIndex() = default;
+
+    /**
+     * Creates a view of the serialized index in \p data, which has to outlive this
+     * object.
+     *
+     * \throw ghoul::RuntimeError If \p data does not contain a valid index
+     */
+    explicit ExoplanetsIndex(std::span<const std::byte> data);
+
+    /**
+     * Returns the size of the data file that this index was created for.
+     */
+    uint64_t dataFileSize() const;
+
+    /**
+     * Returns the information about the look-up table that this index was created for.
+     */
+    LookUpTableInfo lookUpTable() const;
+
+    /**
+     * Returns the planets of the host star \p hostStar, or an empty list if the host star
+     * is not part of the index.
+     */
+    std::vector<Planet> planets(std::string_view hostStar) const;
+
+    /**
+     * Returns the names of all host stars that start with \p prefix in sorted order.
+     */
+    std::vector<std::string_view> hostStars(std::string_view prefix = "") const;
+
+private:
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t nHosts;
+        uint32_t nPlanets;
+        uint32_t hashTableSize;
+        uint64_t dataFileSize;
+        uint64_t lookUpTableSize;
+        uint64_t lookUpTableHash;
+        uint64_t stringsSize;
+    };
+
+    // The host records are sorted by name and refer to a consecutive range of planets
+    struct HostRecord {
+        uint32_t nameOffset;
+        uint32_t nameLength;
+        uint32_t firstPlanet;
+        uint32_t nPlanets;
+    };
+
+    struct PlanetRecord {
+        uint64_t dataOffset;
+        uint32_t nameOffset;
+        uint32_t nameLength;
+    };
+
+    std::string_view string(uint32_t offset, uint32_t length) const;
+
+    const Header* _header = nullptr;
+    std::span<const HostRecord> _hosts;
+    std::span<const PlanetRecord> _planets;
+    std::span<const uint32_t> _hashTable;
+    std::string_view _strings;
+};
+
+/**
+ * Provides access to the exoplanets data file through an ExoplanetsIndex. The data file
+ * is memory-mapped, and the index is memory-mapped as well if an up-to-date index file
+ * exists. The index file is up-to-date if it was created for a data file of the same
+ * size and for a look-up table with the same contents. Otherwise the index is created
+ * once from the textual look-up table.
+ */
+class ExoplanetsArchive {
+public:
+    /**
+     * \throw ghoul::RuntimeError If the data file or the look-up table cannot be read
+     */
+    ExoplanetsArchive(const std::filesystem::path& dataFile,
+        const std::filesystem::path& lookUpTable, const std::filesystem::path& indexFile);
+
+    /**
+     * Returns the system with the host star \p starName. Planets with insufficient data
+     * for a visualization are not included, so the system has no planets if the host
+     * star is not part of the data.
+     */
+    ExoplanetSystem system(std::string_view starName) const;
+
+    /**
+     * Returns the systems for all \p starNames in the same order.
+     */
+    std::vector<ExoplanetSystem> systems(const std::vector<std::string>& starNames) const;
+
+    /**
+     * Returns the names of the host stars that start with \p prefix and that have at
+     * least one planet with sufficient data for a visualization, in sorted order.
+     */
+    std::vector<std::string> hostStarsWithSufficientData(
+        std::string_view prefix = "") const;
+
+private:
+    std::optional<ExoplanetDataEntry> planetData(uint64_t offset) const;
+
+    MemoryMappedFile _data;
+    std::optional<MemoryMappedFile> _indexFile;
+    std::vector<std::byte> _indexBuffer;
+    ExoplanetsIndex _index;
+};
+
+} // namespace openspace::exoplanets
+
+#endif // __OPENSPACE_MODULE_EXOPLANETS___EXOPLANETSARCHIVE___H__
@@ -43,6 +43,7 @@
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
 #include <filesystem>
 #include <fstream>
 #include <sstream>
@@ -164,6 +165,7 @@ namespace {
 
     constexpr std::string_view ExoplanetsDataFileName = "exoplanets_data.bin";
     constexpr std::string_view LookupTableFileName = "lookup.txt";
+    constexpr std::string_view IndexFileName = "lookup.idx";
     constexpr std::string_view TeffToBvConversionFileName = "teff_bv.txt";
 
     struct [[codegen::Dictionary(ExoplanetsModule)]] Parameters {
@@ -239,6 +241,7 @@ ExoplanetsModule::ExoplanetsModule()
     , _habitableZoneOpacity(HabitableZoneOpacityInfo, 0.1f, 0.f, 1.f)
 {
     _exoplanetsDataFolder.setReadOnly(true);
+    _exoplanetsDataFolder.onChange([this]() { _archive = nullptr; });
 
     addProperty(_enabled);
 
@@ -280,6 +283,32 @@ std::string ExoplanetsModule::lookUpTablePath() const {
     ).string();
 }
 
+std::string ExoplanetsModule::indexPath() const {
+    ghoul_assert(hasDataFiles(), "Data files not loaded");
+
+    return absPath(
+        fmt::format("{}/{}", _exoplanetsDataFolder.value(), IndexFileName)
+    ).string();
+}
+
+const exoplanets::ExoplanetsArchive* ExoplanetsModule::archive() const {
+    if (_archive || !hasDataFiles()) {
+        return _archive.get();
+    }
+
+    try {
+        _archive = std::make_unique<exoplanets::ExoplanetsArchive>(
+            exoplanetsDataPath(),
+            lookUpTablePath(),
+            indexPath()
+        );
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERROR(fmt::format("Failed to open exoplanets data: {}", e.message));
+    }
+    return _archive.get();
+}
+
 std::string ExoplanetsModule::teffToBvConversionFilePath() const {
     ghoul_assert(hasDataFiles(), "Data files not loaded");
 
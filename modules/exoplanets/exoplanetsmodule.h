@@ -27,6 +27,7 @@
 
 #include <openspace/util/openspacemodule.h>
 
+#include <modules/exoplanets/exoplanetsarchive.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/floatproperty.h>
@@ -45,6 +46,7 @@ public:
     bool hasDataFiles() const;
     std::string exoplanetsDataPath() const;
     std::string lookUpTablePath() const;
+    std::string indexPath() const;
     std::string teffToBvConversionFilePath() const;
     std::string bvColormapPath() const;
     std::string starTexturePath() const;
@@ -59,6 +61,12 @@ public:
     bool useOptimisticZone() const;
     float habitableZoneOpacity() const;
 
+    /**
+     * Returns the archive of the exoplanet data files, which is opened on the first call.
+     * Returns `nullptr` if no data files are configured or they could not be opened.
+     */
+    const exoplanets::ExoplanetsArchive* archive() const;
+
     scripting::LuaLibrary luaLibrary() const override;
     std::vector<documentation::Documentation> documentations() const override;
 
@@ -81,6 +89,8 @@ protected:
     properties::BoolProperty _useOptimisticZone;
 
     properties::FloatProperty _habitableZoneOpacity;
+
+    mutable std::unique_ptr<exoplanets::ExoplanetsArchive> _archive;
 };
 
 } // namespace openspace
@@ -26,6 +26,7 @@
 #include <ghoul/misc/csvreader.h>
 #include <algorithm>
 #include <map>
+#include <optional>
 #include <string>
 #include <string_view>
 
@@ -42,68 +43,6 @@ std::string formatPathToLua(const std::string& path) {
     return resPath;
 }
 
-openspace::exoplanets::ExoplanetSystem findExoplanetSystemInData(
-                                                                std::string_view starName)
-{
-    using namespace openspace;
-    using namespace exoplanets;
-
-    const ExoplanetsModule* module = global::moduleEngine->module<ExoplanetsModule>();
-
-    const std::string binPath = module->exoplanetsDataPath();
-    std::ifstream data(absPath(binPath), std::ios::in | std::ios::binary);
-    if (!data.good()) {
-        LERROR(fmt::format("Failed to open exoplanets data file: '{}'", binPath));
-        return ExoplanetSystem();
-    }
-
-    const std::string lutPath = module->lookUpTablePath();
-    std::ifstream lut(absPath(lutPath));
-    if (!lut.good()) {
-        LERROR(fmt::format("Failed to open exoplanets look-up table: '{}'", lutPath));
-        return ExoplanetSystem();
-    }
-
-    ExoplanetSystem system;
-
-    // 1. search lut for the starname and return the corresponding location
-    // 2. go to that location in the data file
-    // 3. read sizeof(exoplanet) bytes into an exoplanet object.
-    ExoplanetDataEntry p;
-    std::string line;
-    while (std::getline(lut, line)) {
-        std::istringstream ss(line);
-        std::string name;
-        std::getline(ss, name, ',');
-
-        if (name.substr(0, name.length() - 2) != starName) {
-            continue;
-        }
-
-        std::string location_s;
-        std::getline(ss, location_s);
-        long location = std::stol(location_s.c_str());
-
-        data.seekg(location);
-        data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
-
-        sanitizeNameString(name);
-
-        if (!hasSufficientData(p)) {
-            LWARNING(fmt::format("Insufficient data for exoplanet: '{}'", name));
-            continue;
-        }
-
-        system.planetNames.push_back(name);
-        system.planetsData.push_back(p);
-
-        updateStarDataFromNewPlanet(system.starData, p);
-    }
-
-    system.starName = starName;
-    return system;
-}
-
 void createExoplanetSystem(const std::string& starName,
                            openspace::exoplanets::ExoplanetSystem system)
 {
@@ -546,9 +485,8 @@ void createExoplanetSystem(const std::string& starName,
     }
 }
 
-std::vector<std::string> hostStarsWithSufficientData() {
+std::vector<std::string> hostStarsWithSufficientData(std::string_view prefix = "") {
     using namespace openspace;
-    using namespace exoplanets;
     const ExoplanetsModule* module = global::moduleEngine->module<ExoplanetsModule>();
 
     if (!module->hasDataFiles()) {
@@ -557,58 +495,11 @@ std::vector<std::string> hostStarsWithSufficientData() {
         return {};
     }
 
-    const std::string lutPath = module->lookUpTablePath();
-    std::ifstream lookupTableFile(absPath(lutPath));
-    if (!lookupTableFile.good()) {
-        LERROR(fmt::format("Failed to open lookup table file '{}'", lutPath));
+    const exoplanets::ExoplanetsArchive* archive = module->archive();
+    if (!archive) {
         return {};
     }
-
-    const std::string binPath = module->exoplanetsDataPath();
-    std::ifstream data(absPath(binPath), std::ios::in | std::ios::binary);
-    if (!data.good()) {
-        LERROR(fmt::format("Failed to open data file '{}'", binPath));
-        return {};
-    }
-
-    std::vector<std::string> names;
-    std::string line;
-
-    // Read number of lines
-    int nExoplanets = 0;
-    while (std::getline(lookupTableFile, line)) {
-        ++nExoplanets;
-    }
-    lookupTableFile.clear();
-    lookupTableFile.seekg(0);
-    names.reserve(nExoplanets);
-
-    ExoplanetDataEntry p;
-    while (std::getline(lookupTableFile, line)) {
-        std::stringstream ss(line);
-        std::string name;
-        std::getline(ss, name, ',');
-        // Remove the last two characters, that specify the planet
-        name = name.substr(0, name.size() - 2);
-
-        // Don't want to list systems where there is not enough data to visualize.
-        // So, test if there is before adding the name to the list.
-        std::string location_s;
-        std::getline(ss, location_s);
-        long location = std::stol(location_s.c_str());
-
-        data.seekg(location);
-        data.read(reinterpret_cast<char*>(&p), sizeof(ExoplanetDataEntry));
-
-        if (hasSufficientData(p)) {
-            names.push_back(name);
-        }
-    }
-
-    // For easier read, sort by names and remove duplicates
-    std::sort(names.begin(), names.end());
-    names.erase(std::unique(names.begin(), names.end()), names.end());
-    return names;
+    return archive->hostStarsWithSufficientData(prefix);
 }
 
 /**
@@ -629,18 +520,26 @@ std::vector<std::string> hostStarsWithSufficientData() {
         starsToAdd = std::get<std::vector<std::string>>(starNames);
     }
 
-    for (const std::string& starName : starsToAdd) {
-        openspace::exoplanets::ExoplanetSystem systemData =
-            findExoplanetSystemInData(starName);
+    using namespace openspace;
+    const ExoplanetsModule* module = global::moduleEngine->module<ExoplanetsModule>();
+    const exoplanets::ExoplanetsArchive* archive = module->archive();
+    if (!archive) {
+        LERROR("No exoplanets data is available");
+        return;
+    }
 
-        if (systemData.planetsData.empty()) {
-            LERROR(fmt::format("Exoplanet system '{}' could not be found", starName));
-            return;
+    // Look up all systems in one pass through the index
+    std::vector<exoplanets::ExoplanetSystem> systems = archive->systems(starsToAdd);
+    for (size_t i = 0; i < starsToAdd.size(); i++) {
+        if (systems[i].planetsData.empty()) {
+            LERROR(fmt::format(
+                "Exoplanet system '{}' could not be found", starsToAdd[i]
+            ));
+            continue;
         }
 
-        createExoplanetSystem(starName, systemData);
+        createExoplanetSystem(starsToAdd[i], std::move(systems[i]));
     }
-
 }
 
 [[codegen::luawrap]] void removeExoplanetSystem(std::string starName) {
@@ -660,10 +559,13 @@ std::vector<std::string> hostStarsWithSufficientData() {
 /**
  * Returns a list with names of the host star of all the exoplanet systems
  * that have sufficient data for generating a visualization, based on the
- * module's loaded data file.
+ * module's loaded data file. If a prefix is provided, only the host stars whose names
+ * start with the prefix are returned.
  */
-[[codegen::luawrap]] std::vector<std::string> listOfExoplanets() {
-    std::vector<std::string> names = hostStarsWithSufficientData();
+[[codegen::luawrap]] std::vector<std::string> listOfExoplanets(
+                                                      std::optional<std::string> prefix)
+{
+    std::vector<std::string> names = hostStarsWithSufficientData(prefix.value_or(""));
     return names;
 }
 
@@ -678,7 +580,7 @@ listOfExoplanetsDeprecated()
         "'getListOfExoplanets' function is deprecated and should be replaced with "
         "'listOfExoplanets'"
     );
-    return listOfExoplanets();
+    return listOfExoplanets(std::nullopt);
 }
 
 [[codegen::luawrap]] void listAvailableExoplanetSystems() {
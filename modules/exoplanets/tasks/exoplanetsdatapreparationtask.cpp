@@ -24,6 +24,7 @@
 
 #include <modules/exoplanets/tasks/exoplanetsdatapreparationtask.h>
 
+#include <modules/exoplanets/exoplanetsarchive.h>
 #include <modules/exoplanets/exoplanetshelper.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/documentation/verifier.h>
@@ -74,6 +75,12 @@ namespace {
         // The txt file to write look-up table into
         std::string outputLUT [[codegen::annotation("A valid filepath")]];
 
+        // The binary index file for fast look-ups of exoplanet systems. If this value
+        // is not specified, the index is written next to the look-up table with the
+        // extension '.idx'
+        std::optional<std::string> outputIndex
+            [[codegen::annotation("A valid filepath")]];
+
         // The path to a teff to bv conversion file. Should be a txt file where each line
         // has the format 'teff,bv'
         std::string teffToBvFile;
@@ -96,6 +103,9 @@ ExoplanetsDataPreparationTask::ExoplanetsDataPreparationTask(
     _inputSpeckPath = absPath(p.inputSPECK);
     _outputBinPath = absPath(p.outputBIN);
     _outputLutPath = absPath(p.outputLUT);
+    _outputIndexPath = p.outputIndex.has_value() ?
+        absPath(*p.outputIndex) :
+        std::filesystem::path(_outputLutPath).replace_extension(".idx");
     _teffToBvFilePath = absPath(p.teffToBvFile);
 }
 
@@ -108,6 +118,14 @@ std::string ExoplanetsDataPreparationTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> ExoplanetsDataPreparationTask::inputs() const {
+    return { _inputDataPath, _inputSpeckPath, _teffToBvFilePath };
+}
+
+std::vector<std::filesystem::path> ExoplanetsDataPreparationTask::outputs() const {
+    return { _outputBinPath, _outputLutPath, _outputIndexPath };
+}
+
 void ExoplanetsDataPreparationTask::perform(
                                            const Task::ProgressCallback& progressCallback)
 {
@@ -158,6 +176,7 @@ void ExoplanetsDataPreparationTask::perform(
 
     LINFO(fmt::format("Loading {} exoplanets", total));
 
+    std::vector<std::pair<std::string, uint64_t>> indexEntries;
     int exoplanetCount = 0;
     while (std::getline(inputDataFile, row)) {
         ++exoplanetCount;
@@ -174,6 +193,7 @@ void ExoplanetsDataPreparationTask::perform(
         long pos = static_cast<long>(binFile.tellp());
         std::string planetName = planetData.host + " " + planetData.component;
         lutFile << planetName << "," << pos << std::endl;
+        indexEntries.emplace_back(std::move(planetName), static_cast<uint64_t>(pos));
 
         binFile.write(
             reinterpret_cast<char*>(&planetData.dataEntry),
@@ -181,6 +201,22 @@ void ExoplanetsDataPreparationTask::perform(
         );
     }
 
+    // Write the index that lets the module find a system without parsing the look-up
+    // table. The look-up table has to be complete on disk before its contents are hashed
+    lutFile.close();
+    const uint64_t dataFileSize = static_cast<uint64_t>(binFile.tellp());
+    const std::vector<std::byte> index = ExoplanetsIndex::create(
+        indexEntries,
+        dataFileSize,
+        ExoplanetsIndex::lookUpTableInfo(_outputLutPath)
+    );
+    std::ofstream indexFile(_outputIndexPath, std::ios::out | std::ios::binary);
+    if (!indexFile.good()) {
+        LERROR(fmt::format("Error when writing to {}", _outputIndexPath));
+        return;
+    }
+    indexFile.write(reinterpret_cast<const char*>(index.data()), index.size());
+
     progressCallback(1.f);
 }
 
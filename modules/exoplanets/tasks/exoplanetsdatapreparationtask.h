@@ -46,6 +46,8 @@ public:
 
     ExoplanetsDataPreparationTask(const ghoul::Dictionary& dictionary);
     std::string description() override;
+    std::vector<std::filesystem::path> inputs() const override;
+    std::vector<std::filesystem::path> outputs() const override;
     void perform(const Task::ProgressCallback& progressCallback) override;
     static documentation::Documentation documentation();
 
@@ -87,6 +89,7 @@ private:
     std::filesystem::path _inputSpeckPath;
     std::filesystem::path _outputBinPath;
     std::filesystem::path _outputLutPath;
+    std::filesystem::path _outputIndexPath;
     std::filesystem::path _teffToBvFilePath;
 
     /**
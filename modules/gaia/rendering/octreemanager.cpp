@@ -25,15 +25,35 @@
 #include <modules/gaia/rendering/octreemanager.h>
 
 #include <modules/gaia/rendering/octreeculler.h>
+#include <openspace/engine/globals.h>
 #include <openspace/util/distanceconstants.h>
+#include <openspace/util/memorymanager.h>
 #include <ghoul/fmt.h>
 #include <ghoul/glm.h>
 #include <ghoul/logging/logmanager.h>
+#include <array>
 #include <fstream>
+#include <iterator>
 #include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "OctreeManager";
+
+    openspace::OctreeManager::StreamingData temporaryStreamingData() {
+        using namespace openspace;
+        return OctreeManager::StreamingData(&global::memoryManager->TemporaryMemory);
+    }
+
+    void mergeStreamingData(openspace::OctreeManager::StreamingData& data,
+                            openspace::OctreeManager::StreamingData&& other)
+    {
+        // Keys that already exist in data are ignored, so the first data for each index
+        // wins. As both maps use the temporary memory, the vectors are moved
+        data.insert(
+            std::make_move_iterator(other.begin()),
+            std::make_move_iterator(other.end())
+        );
+    }
 } // namespace
 
 namespace openspace {
@@ -392,13 +412,13 @@ void OctreeManager::findAndFetchNeighborNode(unsigned long long firstParentId, i
     }).detach();
 }
 
-std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4& mvp,
-                                                              const glm::vec2& screenSize,
-                                                              int& deltaStars,
-                                                              gaia::RenderMode mode,
-                                                              float lodPixelThreshold)
+OctreeManager::StreamingData OctreeManager::traverseData(const glm::dmat4& mvp,
+                                                         const glm::vec2& screenSize,
+                                                         int& deltaStars,
+                                                         gaia::RenderMode mode,
+                                                         float lodPixelThreshold)
 {
-    std::map<int, std::vector<float>> renderData;
+    StreamingData renderData = temporaryStreamingData();
     bool innerRebuild = false;
     _minTotalPixelsLod = lodPixelThreshold;
 
@@ -435,7 +455,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
     }
 
     // Check if entire tree is too small to see, and if so remove it.
-    std::vector<glm::dvec4> corners(8);
+    std::array<glm::dvec4, 8> corners;
     float fMaxDist = static_cast<float>(MAX_DIST);
     for (int i = 0; i < 8; ++i) {
         float x = (i % 2 == 0) ? fMaxDist : -fMaxDist;
@@ -452,11 +472,10 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
     if (totalPixels < _minTotalPixelsLod * 2) {
         // Remove LOD from first layer of children.
         for (int i = 0; i < 8; ++i) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *_root->Children[i],
-                deltaStars
+            mergeStreamingData(
+                renderData,
+                removeNodeFromCache(*_root->Children[i], deltaStars)
             );
-            renderData.insert(tmpData.begin(), tmpData.end());
         }
         return renderData;
     }
@@ -466,7 +485,7 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
             continue;
         }
 
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
+        StreamingData tmpData = checkNodeIntersection(
             *_root->Children[i],
             mvp,
             screenSize,
@@ -484,20 +503,17 @@ std::map<int, std::vector<float>> OctreeManager::traverseData(const glm::dmat4&
 
         // Observe that if there exists identical keys in renderData then those values in
         // tmpData will be ignored! Thus we store the removed keys until next render call!
-        renderData.insert(tmpData.begin(), tmpData.end());
+        mergeStreamingData(renderData, std::move(tmpData));
     }
 
     if (_rebuildBuffer) {
         if (_useVBO) {
             // We need to overwrite bigger indices that had data before! No need for SSBO.
-            std::map<int, std::vector<float>> idxToRemove;
-            for (int idx : _removedKeysInPrevCall) {
-                idxToRemove[idx] = std::vector<float>();
-            }
-
             // This will only insert indices that doesn't already exist in map
             // (i.e. > biggestIdx).
-            renderData.insert(idxToRemove.begin(), idxToRemove.end());
+            for (int idx : _removedKeysInPrevCall) {
+                renderData.try_emplace(idx);
+            }
         }
         if (innerRebuild) {
             deltaStars = 0;
@@ -1098,16 +1114,16 @@ std::string OctreeManager::printStarsPerNode(const OctreeNode& node,
     }
 }
 
-std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNode& node,
-                                                                    const glm::dmat4& mvp,
+OctreeManager::StreamingData OctreeManager::checkNodeIntersection(OctreeNode& node,
+                                                                  const glm::dmat4& mvp,
                                                               const glm::vec2& screenSize,
-                                                                          int& deltaStars,
-                                                                    gaia::RenderMode mode)
+                                                                  int& deltaStars,
+                                                                  gaia::RenderMode mode)
 {
-    std::map<int, std::vector<float>> fetchedData;
+    StreamingData fetchedData = temporaryStreamingData();
 
     // Calculate the corners of the node.
-    std::vector<glm::dvec4> corners(8);
+    std::array<glm::dvec4, 8> corners;
     for (int i = 0; i < 8; ++i) {
         const float x = (i % 2 == 0) ?
             node.originX + node.halfDimension :
@@ -1161,11 +1177,10 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
 
                 // We're in an inner node, remove indices from potential children in cache
                 for (int i = 0; i < 8; ++i) {
-                    std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                        *node.Children[i],
-                        deltaStars
+                    mergeStreamingData(
+                        fetchedData,
+                        removeNodeFromCache(*node.Children[i], deltaStars)
                     );
-                    fetchedData.insert(tmpData.begin(), tmpData.end());
                 }
 
                 // Insert data and adjust stars added in this frame.
@@ -1205,23 +1220,19 @@ std::map<int, std::vector<float>> OctreeManager::checkNodeIntersection(OctreeNod
     for (size_t i = 0; i < 8; ++i) {
         // Observe that if there exists identical keys in fetchedData then those values in
         // tmpData will be ignored! Thus we store the removed keys until next render call!
-        std::map<int, std::vector<float>> tmpData = checkNodeIntersection(
-            *node.Children[i],
-            mvp,
-            screenSize,
-            deltaStars,
-            mode
+        mergeStreamingData(
+            fetchedData,
+            checkNodeIntersection(*node.Children[i], mvp, screenSize, deltaStars, mode)
         );
-        fetchedData.insert(tmpData.begin(), tmpData.end());
     }
     return fetchedData;
 }
 
-std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode& node,
-                                                                     int& deltaStars,
-                                                                     bool recursive)
+OctreeManager::StreamingData OctreeManager::removeNodeFromCache(OctreeNode& node,
+                                                                int& deltaStars,
+                                                                bool recursive)
 {
-    std::map<int, std::vector<float>> keysToRemove;
+    StreamingData keysToRemove = temporaryStreamingData();
 
     // If we're in rebuilding mode then there is no need to remove any nodes.
     //if (_rebuildBuffer) return keysToRemove;
@@ -1233,7 +1244,7 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
         _removedKeysInPrevCall.insert(node.bufferIndex);
 
         // Insert dummy node at offset index that should be removed from render.
-        keysToRemove[node.bufferIndex] = std::vector<float>();
+        keysToRemove[node.bufferIndex].clear();
 
         // Reset index and adjust stars removed this frame.
         node.bufferIndex = DEFAULT_INDEX;
@@ -1243,11 +1254,10 @@ std::map<int, std::vector<float>> OctreeManager::removeNodeFromCache(OctreeNode&
     // Check children recursively if we're in an inner node.
     if (!(node.isLeaf) && recursive) {
         for (int i = 0; i < 8; ++i) {
-            std::map<int, std::vector<float>> tmpData = removeNodeFromCache(
-                *node.Children[i],
-                deltaStars
+            mergeStreamingData(
+                keysToRemove,
+                removeNodeFromCache(*node.Children[i], deltaStars)
             );
-            keysToRemove.insert(tmpData.begin(), tmpData.end());
         }
     }
     return keysToRemove;
@@ -1259,7 +1269,8 @@ std::vector<float> OctreeManager::getNodeData(const OctreeNode& node,
     // Return node data if node is a leaf.
     if (node.isLeaf) {
         int dStars = 0;
-        return constructInsertData(node, mode, dStars);
+        const std::pmr::vector<float> data = constructInsertData(node, mode, dStars);
+        return std::vector<float>(data.begin(), data.end());
     }
 
     // If we're not in a leaf, get data from all children recursively.
@@ -1360,18 +1371,43 @@ bool OctreeManager::updateBufferIndex(OctreeNode& node) {
     return true;
 }
 
-std::vector<float> OctreeManager::constructInsertData(const OctreeNode& node,
-                                                      gaia::RenderMode mode,
-                                                      int& deltaStars)
+std::pmr::vector<float> OctreeManager::constructInsertData(const OctreeNode& node,
+                                                           gaia::RenderMode mode,
+                                                           int& deltaStars)
 {
+    std::pmr::vector<float> insertData(&global::memoryManager->TemporaryMemory);
+
     // Return early if node doesn't contain any stars!
     if (node.numStars == 0) {
-        return std::vector<float>();
+        return insertData;
+    }
+
+    // Reserve the final size up front as growing the vector would leave the previous
+    // allocations unused in the temporary memory
+    if (_useVBO) {
+        size_t valuesPerStar = POS_SIZE;
+        if (mode != gaia::RenderMode::Static) {
+            valuesPerStar += COL_SIZE;
+        }
+        if (mode == gaia::RenderMode::Motion) {
+            valuesPerStar += VEL_SIZE;
+        }
+        insertData.reserve(valuesPerStar * MAX_STARS_PER_NODE);
+    }
+    else {
+        size_t nValues = node.posData.size();
+        if (mode != gaia::RenderMode::Static) {
+            nValues += node.colData.size();
+        }
+        if (mode == gaia::RenderMode::Motion) {
+            nValues += node.velData.size();
+        }
+        insertData.reserve(nValues);
     }
 
     // Fill chunk by appending zeroes to data so we overwrite possible earlier values.
     // And more importantly so our attribute pointers knows where to read!
-    auto insertData = std::vector<float>(node.posData.begin(), node.posData.end());
+    insertData.assign(node.posData.begin(), node.posData.end());
     if (_useVBO) {
         insertData.resize(POS_SIZE * MAX_STARS_PER_NODE, 0.f);
     }
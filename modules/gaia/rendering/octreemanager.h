@@ -34,12 +34,28 @@
 #include <stack>
 #include <vector>
 
+#if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
+#include <experimental/memory_resource>
+namespace std {
+    using namespace experimental;
+} // namespace std
+#else
+#include <memory_resource>
+#endif
+
 namespace openspace {
 
 class OctreeCuller;
 
 class OctreeManager {
 public:
+    /**
+     * The data for the nodes that should be updated in the streaming buffer, keyed by
+     * the index of the chunk in the buffer. The data is allocated from the temporary
+     * memory and is only valid until the end of the frame.
+     */
+    using StreamingData = std::pmr::map<int, std::pmr::vector<float>>;
+
     struct OctreeNode {
         std::shared_ptr<OctreeNode> Children[8];
         std::vector<float> posData;
@@ -113,9 +129,8 @@ public:
      * streaming buffer. Calls #checkNodeIntersection for every branch. \p deltaStars
      * keeps track of how many stars that were added/removed this render call.
      */
-    std::map<int, std::vector<float>> traverseData(const glm::dmat4& mvp,
-        const glm::vec2& screenSize, int& deltaStars, gaia::RenderMode mode,
-        float lodPixelThreshold);
+    StreamingData traverseData(const glm::dmat4& mvp, const glm::vec2& screenSize,
+        int& deltaStars, gaia::RenderMode mode, float lodPixelThreshold);
 
     /**
      * Builds full render data structure by traversing all leaves in the Octree.
@@ -253,9 +268,8 @@ private:
      *        call
      * \param mode the render mode that should be used
      */
-    std::map<int, std::vector<float>> checkNodeIntersection(OctreeNode& node,
-        const glm::dmat4& mvp, const glm::vec2& screenSize, int& deltaStars,
-        gaia::RenderMode mode);
+    StreamingData checkNodeIntersection(OctreeNode& node, const glm::dmat4& mvp,
+        const glm::vec2& screenSize, int& deltaStars, gaia::RenderMode mode);
 
     /**
      * Checks if specified node existed in cache, and removes it if that's the case.
@@ -266,8 +280,8 @@ private:
      * \param deltaStars keeps track of how many stars that were removed.
      * \param recursive defines if decentents should be removed as well
      */
-    std::map<int, std::vector<float>> removeNodeFromCache(OctreeNode& node,
-        int& deltaStars, bool recursive = true);
+    StreamingData removeNodeFromCache(OctreeNode& node, int& deltaStars,
+        bool recursive = true);
 
     /**
      * Get data in node and its descendants regardless if they are visible or not.
@@ -300,7 +314,7 @@ private:
      * \param deltaStars keeps track of how many stars that were added.
      * \return the data to be inserted
      */
-    std::vector<float> constructInsertData(const OctreeNode& node,
+    std::pmr::vector<float> constructInsertData(const OctreeNode& node,
         gaia::RenderMode mode, int& deltaStars);
 
     /**
@@ -996,7 +996,7 @@ void RenderableGaiaStars::render(const RenderData& data, RendererTasks&) {
     // Traverse Octree and build a map with new nodes to render, uses mvp matrix to decide
     const int renderOption = _renderMode;
     int deltaStars = 0;
-    std::map<int, std::vector<float>> updateData = _octreeManager.traverseData(
+    OctreeManager::StreamingData updateData = _octreeManager.traverseData(
         modelViewProjMat,
         screenSize,
         deltaStars,
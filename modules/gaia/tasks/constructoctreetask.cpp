@@ -301,6 +301,14 @@ std::string ConstructOctreeTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> ConstructOctreeTask::inputs() const {
+    return { _inFileOrFolderPath };
+}
+
+std::vector<std::filesystem::path> ConstructOctreeTask::outputs() const {
+    return { _outFileOrFolderPath };
+}
+
 void ConstructOctreeTask::perform(const Task::ProgressCallback& onProgress) {
     onProgress(0.f);
 
@@ -41,6 +41,8 @@ public:
     ~ConstructOctreeTask() override = default;
 
     std::string description() override;
+    std::vector<std::filesystem::path> inputs() const override;
+    std::vector<std::filesystem::path> outputs() const override;
     void perform(const Task::ProgressCallback& onProgress) override;
     static documentation::Documentation Documentation();
 
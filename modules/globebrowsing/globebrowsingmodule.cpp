@@ -73,6 +73,8 @@
 #include <ghoul/misc/templatefactory.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/systemcapabilities/generalcapabilitiescomponent.h>
+#include <algorithm>
+#include <thread>
 #include <vector>
 
 #include <gdal.h>
@@ -243,6 +245,10 @@ void GlobeBrowsingModule::internalInitialize(const ghoul::Dictionary& dict) {
     _mrfCacheEnabled = p.mrfCacheEnabled.value_or(_mrfCacheEnabled);
     _mrfCacheLocation = p.mrfCacheLocation.value_or(_mrfCacheLocation);
 
+    _workerThreadPool = std::make_unique<ThreadPool>(
+        std::max(std::thread::hardware_concurrency() / 2, 1u)
+    );
+
     // Initialize
     global::callback::initializeGL->emplace_back([this]() {
         ZoneScopedN("GlobeBrowsingModule");
@@ -323,6 +329,11 @@ globebrowsing::cache::MemoryAwareTileCache* GlobeBrowsingModule::tileCache() {
     return _tileCache.get();
 }
 
+ThreadPool& GlobeBrowsingModule::workerThreadPool() {
+    ghoul_assert(_workerThreadPool, "The module has not been initialized");
+    return *_workerThreadPool;
+}
+
 std::vector<documentation::Documentation> GlobeBrowsingModule::documentations() const {
     return {
         globebrowsing::Layer::Documentation(),
@@ -29,6 +29,7 @@
 #include <openspace/properties/scalar/boolproperty.h>
 #include <openspace/properties/scalar/uintproperty.h>
 #include <openspace/util/openspacemodule.h>
+#include <openspace/util/threadpool.h>
 
 #include <ghoul/glm.h>
 #include <memory>
@@ -66,6 +67,13 @@ public:
     glm::dvec3 geoPosition() const;
 
     globebrowsing::cache::MemoryAwareTileCache* tileCache();
+
+    /**
+     * Returns the thread pool that is shared by all components of this module that
+     * create data in the background, for example the geometry of GeoJSON files.
+     */
+    ThreadPool& workerThreadPool();
+
     scripting::LuaLibrary luaLibrary() const override;
     std::vector<documentation::Documentation> documentations() const override;
 
@@ -118,6 +126,7 @@ private:
     properties::StringProperty _mrfCacheLocation;
 
     std::unique_ptr<globebrowsing::cache::MemoryAwareTileCache> _tileCache;
+    std::unique_ptr<ThreadPool> _workerThreadPool;
 
     // name -> capabilities
     std::map<std::string, std::future<Capabilities>> _inFlightCapabilitiesMap;
@@ -54,6 +54,11 @@ const RawTileDataReader& AsyncTileDataProvider::rawTileDataReader() const {
     return *_rawTileDataReader;
 }
 
+std::shared_ptr<RawTileDataReader> AsyncTileDataProvider::sharedRawTileDataReader() const
+{
+    return _rawTileDataReader;
+}
+
 bool AsyncTileDataProvider::enqueueTileIO(const TileIndex& tileIndex) {
     ZoneScoped;
 
@@ -68,6 +68,13 @@ public:
     bool shouldBeDeleted();
 
     const RawTileDataReader& rawTileDataReader() const;
+
+    /**
+     * Returns shared ownership of the reader used by this provider so that it can be used
+     * for reading tiles independently of the asynchronous loading, for example by the
+     * HeightQueryService. The reader is thread-safe.
+     */
+    std::shared_ptr<RawTileDataReader> sharedRawTileDataReader() const;
     float noDataValueAsFloat() const;
 
 protected:
@@ -101,7 +108,7 @@ protected:
 private:
     const std::string _name;
     /// The reader used for asynchronous reading
-    std::unique_ptr<RawTileDataReader> _rawTileDataReader;
+    std::shared_ptr<RawTileDataReader> _rawTileDataReader;
 
     PrioritizingConcurrentJobManager<RawTile, TileIndex::TileHashKey>
         _concurrentJobManager;
@@ -24,10 +24,12 @@
 
 #include <modules/globebrowsing/src/geojson/geojsoncomponent.h>
 
+#include <modules/globebrowsing/globebrowsingmodule.h>
 #include <modules/globebrowsing/src/geojson/globegeometryhelper.h>
 #include <modules/globebrowsing/src/renderableglobe.h>
 #include <openspace/documentation/documentation.h>
 #include <openspace/engine/globals.h>
+#include <openspace/engine/moduleengine.h>
 #include <openspace/json.h>
 #include <openspace/query/query.h>
 #include <openspace/rendering/renderengine.h>
@@ -58,6 +60,9 @@ namespace {
     constexpr std::string_view KeyName = "Name";
     constexpr std::string_view KeyDesc = "Description";
 
+    // The maximum time per frame that is spent on uploading finished feature geometry
+    constexpr std::chrono::milliseconds GeometryUploadBudget(4);
+
     constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
         "Enabled",
         "Enabled",
@@ -317,6 +322,7 @@ GeoJsonComponent::GeoJsonComponent(const ghoul::Dictionary& dictionary,
     , _deletePropertyOwner({ "Deletion", "Deletion" })
     , _lightSourcePropertyOwner({ "LightSources", "Light Sources" })
     , _featuresPropertyOwner({ "Features", "Features" })
+    , _geometryJobState(std::make_shared<GeometryJobState>())
 {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
@@ -448,7 +454,9 @@ GeoJsonComponent::GeoJsonComponent(const ghoul::Dictionary& dictionary,
     addPropertySubOwner(_featuresPropertyOwner);
 }
 
-GeoJsonComponent::~GeoJsonComponent() {}
+GeoJsonComponent::~GeoJsonComponent() {
+    discardGeometryJobs(true);
+}
 
 bool GeoJsonComponent::enabled() const {
     return _enabled;
@@ -484,6 +492,8 @@ void GeoJsonComponent::initializeGL() {
 }
 
 void GeoJsonComponent::deinitializeGL() {
+    discardGeometryJobs(true);
+
     for (GlobeGeometryFeature& g : _geometryFeatures) {
         g.deinitializeGL();
     }
@@ -562,12 +572,19 @@ void GeoJsonComponent::render(const RenderData& data) {
 }
 
 void GeoJsonComponent::update() {
+    ZoneScoped;
+
     if (!_enabled || !isVisible()) {
         return;
     }
 
     glm::vec3 offsets = glm::vec3(_latLongOffset.value(), _heightOffset);
 
+    if (_dataIsDirty) {
+        // Any job that has not started yet would produce outdated geometry
+        discardGeometryJobs(false);
+    }
+
     for (size_t i = 0; i < _geometryFeatures.size(); ++i) {
         if (!_features[i]->enabled) {
             continue;
@@ -582,13 +599,98 @@ void GeoJsonComponent::update() {
             g.updateTexture();
         }
 
-        g.update(_dataIsDirty, _preventUpdatesFromHeightMap);
+        // The previous geometry is kept for rendering until the new one is uploaded
+        if (_requestedGeometryGeneration[i] != _geometryGeneration) {
+            enqueueGeometryJob(i);
+            _requestedGeometryGeneration[i] = _geometryGeneration;
+        }
+
+        g.update(_preventUpdatesFromHeightMap);
     }
 
+    uploadFinishedGeometry();
+
     _textureIsDirty = false;
     _dataIsDirty = false;
 }
 
+void GeoJsonComponent::enqueueGeometryJob(size_t featureIndex) {
+    GlobeGeometryFeature& g = _geometryFeatures[featureIndex];
+    auto job = std::make_shared<GeometryFeatureJob>(
+        g,
+        featureIndex,
+        _geometryGeneration,
+        g.geometrySettings()
+    );
+
+    GlobeBrowsingModule* module = global::moduleEngine->module<GlobeBrowsingModule>();
+    module->workerThreadPool().enqueue(
+        [state = _geometryJobState, job, generation = _geometryGeneration]() {
+            {
+                std::lock_guard lock(state->mutex);
+                if (state->generation != generation) {
+                    // The job was discarded, so the feature might not exist anymore
+                    return;
+                }
+                state->nRunningJobs++;
+            }
+
+            job->execute();
+
+            {
+                std::lock_guard lock(state->mutex);
+                state->nRunningJobs--;
+                state->finishedJobs.push_back(job->product());
+            }
+            state->jobFinished.notify_all();
+        }
+    );
+}
+
+void GeoJsonComponent::discardGeometryJobs(bool waitForRunningJobs) {
+    std::unique_lock lock(_geometryJobState->mutex);
+    _geometryGeneration++;
+    _geometryJobState->generation = _geometryGeneration;
+
+    if (waitForRunningJobs) {
+        GeometryJobState* state = _geometryJobState.get();
+        state->jobFinished.wait(lock, [state]() { return state->nRunningJobs == 0; });
+        state->finishedJobs.clear();
+    }
+}
+
+void GeoJsonComponent::uploadFinishedGeometry() {
+    ZoneScoped;
+
+    using namespace std::chrono;
+    const steady_clock::time_point start = steady_clock::now();
+
+    while (true) {
+        GeometryFeatureResult result;
+        {
+            std::lock_guard lock(_geometryJobState->mutex);
+            if (_geometryJobState->finishedJobs.empty()) {
+                break;
+            }
+            result = std::move(_geometryJobState->finishedJobs.front());
+            _geometryJobState->finishedJobs.pop_front();
+        }
+
+        if (result.generation != _requestedGeometryGeneration[result.featureIndex]) {
+            // A newer job for the same feature has been requested in the meantime
+            continue;
+        }
+
+        _geometryFeatures[result.featureIndex].uploadGeometry(
+            std::move(result.renderFeatures)
+        );
+
+        if (steady_clock::now() - start > GeometryUploadBudget) {
+            break;
+        }
+    }
+}
+
 void GeoJsonComponent::readFile() {
     std::ifstream file(_geoJsonFile);
 
@@ -633,6 +735,11 @@ void GeoJsonComponent::readFile() {
     }
 
     computeMainFeatureMetaPropeties();
+
+    _requestedGeometryGeneration = std::vector<unsigned int>(
+        _geometryFeatures.size(),
+        0
+    );
 }
 
 void GeoJsonComponent::parseSingleFeature(const geos::io::GeoJSONFeature& feature,
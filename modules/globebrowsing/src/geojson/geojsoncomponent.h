@@ -30,6 +30,7 @@
 
 #include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/geojson/geojsonproperties.h>
+#include <modules/globebrowsing/src/geojson/geometryfeaturejob.h>
 #include <modules/globebrowsing/src/geojson/globegeometryfeature.h>
 #include <openspace/properties/optionproperty.h>
 #include <openspace/properties/scalar/boolproperty.h>
@@ -42,6 +43,10 @@
 #include <openspace/rendering/helper.h>
 #include <ghoul/opengl/ghoul_gl.h>
 #include <ghoul/glm.h>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <vector>
 
@@ -109,6 +114,28 @@ private:
 
     void computeMainFeatureMetaPropeties();
 
+    /**
+     * Enqueue a job on the worker threads of the GlobeBrowsing module that creates the
+     * geometry for the feature with the provided \p featureIndex.
+     */
+    void enqueueGeometryJob(size_t featureIndex);
+
+    /**
+     * Make sure that none of the geometry jobs that have not started yet will be
+     * executed. If \p waitForRunningJobs is true, this function also waits for the jobs
+     * that are currently running to finish, which is required before the features that
+     * they are referencing can be destroyed.
+     */
+    void discardGeometryJobs(bool waitForRunningJobs);
+
+    /**
+     * Upload the geometry of the features whose tessellation jobs have finished. Results
+     * that have been superseded by a newer request are discarded. The upload stops once
+     * the time budget for a single frame has been used up and the remaining results are
+     * uploaded in the following frames.
+     */
+    void uploadFinishedGeometry();
+
     /**
      * Trigger a flight to a feature in the collection. No index means to fly to an
      * overview of all features in the collection.
@@ -162,6 +189,25 @@ private:
 
     std::unique_ptr<ghoul::opengl::ProgramObject> _linesAndPolygonsProgram = nullptr;
     std::unique_ptr<ghoul::opengl::ProgramObject> _pointsProgram = nullptr;
+
+    /// Incremented every time the geometry of all features has to be recreated
+    unsigned int _geometryGeneration = 0;
+    /// The generation of the last geometry job that was enqueued for each feature
+    std::vector<unsigned int> _requestedGeometryGeneration;
+
+    /**
+     * The state that is shared with the geometry jobs. As the worker threads are shared
+     * with other components, the jobs only keep this state alive and not the component.
+     */
+    struct GeometryJobState {
+        std::mutex mutex;
+        std::condition_variable jobFinished;
+        /// Jobs of any other generation are skipped instead of being executed
+        unsigned int generation = 0;
+        int nRunningJobs = 0;
+        std::deque<GeometryFeatureResult> finishedJobs;
+    };
+    std::shared_ptr<GeometryJobState> _geometryJobState;
 };
 
 } // namespace openspace::globebrowsing
@@ -0,0 +1,67 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/geojson/geometryfeaturejob.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
+#include <exception>
+
+namespace {
+    constexpr std::string_view _loggerCat = "GeometryFeatureJob";
+} // namespace
+
+namespace openspace::globebrowsing {
+
+GeometryFeatureJob::GeometryFeatureJob(const GlobeGeometryFeature& feature,
+                                       size_t featureIndex, unsigned int generation,
+                                  GlobeGeometryFeature::GeometrySettings settings)
+    : _feature(feature)
+    , _settings(std::move(settings))
+{
+    _result.featureIndex = featureIndex;
+    _result.generation = generation;
+}
+
+void GeometryFeatureJob::execute() {
+    ZoneScoped;
+
+    try {
+        _result.renderFeatures = _feature.createGeometry(_settings);
+    }
+    catch (const std::exception& e) {
+        // An exception must not escape the worker thread
+        LERROR(fmt::format(
+            "Error creating geometry for feature '{}': {}", _feature.key(), e.what()
+        ));
+        _result.renderFeatures.clear();
+    }
+}
+
+GeometryFeatureResult GeometryFeatureJob::product() {
+    return std::move(_result);
+}
+
+} // namespace openspace::globebrowsing
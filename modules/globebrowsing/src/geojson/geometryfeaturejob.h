@@ -0,0 +1,69 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___GEOMETRYFEATUREJOB___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___GEOMETRYFEATUREJOB___H__
+
+#include <openspace/util/job.h>
+
+#include <modules/globebrowsing/src/geojson/globegeometryfeature.h>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+/**
+ * The result of a GeometryFeatureJob. The \p generation is used to discard results that
+ * have been superseded by a later change of the settings while the job was running.
+ */
+struct GeometryFeatureResult {
+    size_t featureIndex = 0;
+    unsigned int generation = 0;
+    std::vector<GlobeGeometryFeature::RenderFeatureData> renderFeatures;
+};
+
+/**
+ * A job that creates the (potentially tessellated) vertex data for a single
+ * GlobeGeometryFeature on a worker thread. The upload to the GPU is done on the main
+ * thread once the job has finished.
+ */
+struct GeometryFeatureJob : public Job<GeometryFeatureResult> {
+    /**
+     * The \p feature must stay alive and must not be moved until the job has finished.
+     */
+    GeometryFeatureJob(const GlobeGeometryFeature& feature, size_t featureIndex,
+        unsigned int generation, GlobeGeometryFeature::GeometrySettings settings);
+    ~GeometryFeatureJob() override = default;
+
+    void execute() override;
+    GeometryFeatureResult product() override;
+
+private:
+    const GlobeGeometryFeature& _feature;
+    const GlobeGeometryFeature::GeometrySettings _settings;
+    GeometryFeatureResult _result;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___GEOMETRYFEATUREJOB___H__
@@ -37,6 +37,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/openglstatecache.h>
 #include <ghoul/opengl/programobject.h>
 #include <geos/util/GEOSException.h>
@@ -508,13 +509,10 @@ bool GlobeGeometryFeature::shouldUpdateDueToHeightMapChange() const {
     return false;
 }
 
-void GlobeGeometryFeature::update(bool dataIsDirty, bool preventHeightUpdates) {
+void GlobeGeometryFeature::update(bool preventHeightUpdates) {
     if (!preventHeightUpdates && shouldUpdateDueToHeightMapChange()) {
         updateHeightsFromHeightMap();
     }
-    else if (dataIsDirty) {
-        updateGeometry();
-    }
 
     if (_pointTexture) {
         _pointTexture->update();
@@ -522,28 +520,17 @@ void GlobeGeometryFeature::update(bool dataIsDirty, bool preventHeightUpdates) {
 }
 
 void GlobeGeometryFeature::updateGeometry() {
-    // Update vertex data and compute model coordinates based on globe
-    _renderFeatures.clear();
-
-    if (_type == GeometryType::Point) {
-        createPointGeometry();
-    }
-    else {
-        std::vector<std::vector<glm::vec3>> edgeVertices = createLineGeometry();
-        createExtrudedGeometry(edgeVertices);
-        createPolygonGeometry();
-    }
-
-    // Compute new heights - to see if height map changed
-    _lastControlHeights = getCurrentReferencePointsHeights();
+    uploadGeometry(createGeometry(geometrySettings()));
 }
 
 void GlobeGeometryFeature::updateHeightsFromHeightMap() {
     // @TODO: do the updating piece by piece, not all in one frame
+    const double accuracy = heightMapAccuracy(tessellationStepSize());
     for (RenderFeature& f : _renderFeatures) {
         f.heights = geometryhelper::heightMapHeightsFromGeodetic2List(
             _globe,
-            f.vertices
+            f.vertices,
+            accuracy
         );
         bufferDynamicHeightData(f);
     }
@@ -551,7 +538,65 @@ void GlobeGeometryFeature::updateHeightsFromHeightMap() {
     _lastHeightUpdateTime = std::chrono::system_clock::now();
 }
 
-std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
+GlobeGeometryFeature::GeometrySettings GlobeGeometryFeature::geometrySettings() const {
+    GeometrySettings settings;
+    settings.offsets = _offsets;
+    settings.tessellationEnabled = _properties.tessellationEnabled();
+    settings.tessellationStepSize = tessellationStepSize();
+    return settings;
+}
+
+std::vector<GlobeGeometryFeature::RenderFeatureData>
+GlobeGeometryFeature::createGeometry(const GeometrySettings& settings) const
+{
+    ZoneScoped;
+
+    std::vector<RenderFeatureData> result;
+    if (_type == GeometryType::Point) {
+        createPointGeometry(settings, result);
+    }
+    else {
+        std::vector<std::vector<glm::vec3>> edgeVertices =
+            createLineGeometry(settings, result);
+        createExtrudedGeometry(settings, edgeVertices, result);
+        createPolygonGeometry(settings, result);
+    }
+    return result;
+}
+
+void GlobeGeometryFeature::uploadGeometry(std::vector<RenderFeatureData> data) {
+    ZoneScoped;
+
+    // Release the buffers of the previous geometry before replacing it
+    for (const RenderFeature& r : _renderFeatures) {
+        glDeleteVertexArrays(1, &r.vaoId);
+        glDeleteBuffers(1, &r.vboId);
+    }
+    _renderFeatures.clear();
+    _renderFeatures.reserve(data.size());
+
+    for (RenderFeatureData& d : data) {
+        RenderFeature feature;
+        feature.type = d.type;
+        feature.isExtrusionFeature = d.isExtrusionFeature;
+        feature.nVertices = d.vertexData.size();
+        feature.vertices = std::move(d.vertices);
+        feature.heights = _globe.heightQueryService().completeHeights(
+            feature.vertices,
+            std::move(d.heights)
+        );
+        initializeRenderFeature(feature, d.vertexData);
+        _renderFeatures.push_back(std::move(feature));
+    }
+
+    // Compute new heights - to see if height map changed
+    _lastControlHeights = getCurrentReferencePointsHeights();
+}
+
+std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry(
+                                                   const GeometrySettings& settings,
+                                          std::vector<RenderFeatureData>& result) const
+{
     std::vector<std::vector<glm::vec3>> resultPositions;
     resultPositions.reserve(_geoCoordinates.size());
 
@@ -571,8 +616,8 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
             glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
                 geodetic,
                 _globe,
-                _offsets.x,
-                _offsets.y
+                settings.offsets.x,
+                settings.offsets.y
             );
 
             auto addLinePos = [&vertices, &positions](glm::vec3 pos) {
@@ -588,19 +633,15 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
                 continue;
             }
 
-            if (_properties.tessellationEnabled()) {
-                // Tessellate.
-                // But first, determine the step size for the tessellation (larger
-                // features will not be tesselated)
-                float stepSize = tessellationStepSize();
-
+            if (settings.tessellationEnabled) {
+                // Tessellate. Larger features will not be tesselated
                 std::vector<geometryhelper::PosHeightPair> subdividedPositions =
                     geometryhelper::subdivideLine(
                         lastPos,
                         v,
                         lastHeightValue,
                         geodetic.height,
-                        stepSize
+                        settings.tessellationStepSize
                     );
 
                 // Don't add the first position. Has been added as last in previous step
@@ -620,11 +661,12 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
 
         vertices.shrink_to_fit();
 
-        RenderFeature feature;
-        feature.nVertices = vertices.size();
-        feature.type = RenderType::Lines;
-        initializeRenderFeature(feature, vertices);
-        _renderFeatures.push_back(std::move(feature));
+        result.push_back(createRenderFeatureData(
+            settings,
+            RenderType::Lines,
+            false,
+            std::move(vertices)
+        ));
 
         positions.shrink_to_fit();
         resultPositions.push_back(std::move(positions));
@@ -634,7 +676,9 @@ std::vector<std::vector<glm::vec3>> GlobeGeometryFeature::createLineGeometry() {
     return resultPositions;
 }
 
-void GlobeGeometryFeature::createPointGeometry() {
+void GlobeGeometryFeature::createPointGeometry(const GeometrySettings& settings,
+                                           std::vector<RenderFeatureData>& result) const
+{
     if (_type != GeometryType::Point) {
         return;
     }
@@ -650,8 +694,8 @@ void GlobeGeometryFeature::createPointGeometry() {
             glm::dvec3 v = geometryhelper::computeOffsetedModelCoordinate(
                 geodetic,
                 _globe,
-                _offsets.x,
-                _offsets.y
+                settings.offsets.x,
+                settings.offsets.y
             );
 
             glm::vec3 vf = static_cast<glm::vec3>(v);
@@ -668,24 +712,26 @@ void GlobeGeometryFeature::createPointGeometry() {
         vertices.shrink_to_fit();
         extrudedLineVertices.shrink_to_fit();
 
-        RenderFeature feature;
-        feature.nVertices = vertices.size();
-        feature.type = RenderType::Points;
-        initializeRenderFeature(feature, vertices);
-        _renderFeatures.push_back(std::move(feature));
+        result.push_back(createRenderFeatureData(
+            settings,
+            RenderType::Points,
+            false,
+            std::move(vertices)
+        ));
 
         // Create extrusion feature
-        RenderFeature extrudeFeature;
-        extrudeFeature.nVertices = extrudedLineVertices.size();
-        extrudeFeature.type = RenderType::Lines;
-        extrudeFeature.isExtrusionFeature = true;
-        initializeRenderFeature(extrudeFeature, extrudedLineVertices);
-        _renderFeatures.push_back(std::move(extrudeFeature));
+        result.push_back(createRenderFeatureData(
+            settings,
+            RenderType::Lines,
+            true,
+            std::move(extrudedLineVertices)
+        ));
     }
 }
 
-void GlobeGeometryFeature::createExtrudedGeometry(
-                                 const std::vector<std::vector<glm::vec3>>& edgeVertices)
+void GlobeGeometryFeature::createExtrudedGeometry(const GeometrySettings& settings,
+                                 const std::vector<std::vector<glm::vec3>>& edgeVertices,
+                                           std::vector<RenderFeatureData>& result) const
 {
     if (edgeVertices.empty()) {
         return;
@@ -694,15 +740,14 @@ void GlobeGeometryFeature::createExtrudedGeometry(
     std::vector<Vertex> vertices =
         geometryhelper::createExtrudedGeometryVertices(edgeVertices);
 
-    RenderFeature feature;
-    feature.type = RenderType::Polygon;
-    feature.nVertices = vertices.size();
-    feature.isExtrusionFeature = true;
-    initializeRenderFeature(feature, vertices);
-    _renderFeatures.push_back(std::move(feature));
+    result.push_back(
+        createRenderFeatureData(settings, RenderType::Polygon, true, std::move(vertices))
+    );
 }
 
-void GlobeGeometryFeature::createPolygonGeometry() {
+void GlobeGeometryFeature::createPolygonGeometry(const GeometrySettings& settings,
+                                           std::vector<RenderFeatureData>& result) const
+{
     if (_triangleCoordinates.empty()) {
         return;
     }
@@ -717,8 +762,8 @@ void GlobeGeometryFeature::createPolygonGeometry() {
         const glm::vec3 vert = geometryhelper::computeOffsetedModelCoordinate(
             geodetic,
             _globe,
-            _offsets.x,
-            _offsets.y
+            settings.offsets.x,
+            settings.offsets.y
         );
         triPositions[triIndex] = vert;
         triHeights[triIndex] = geodetic.height;
@@ -736,15 +781,12 @@ void GlobeGeometryFeature::createPolygonGeometry() {
             double h1 = triHeights[1];
             double h2 = triHeights[2];
 
-            if (_properties.tessellationEnabled()) {
-                // First determine the step size for the tessellation (larger features
-                // will not be tesselated)
-                float stepSize = tessellationStepSize();
-
+            if (settings.tessellationEnabled) {
+                // Larger features will not be tesselated
                 std::vector<Vertex> verts = geometryhelper::subdivideTriangle(
                     v0, v1, v2,
                     h0, h1, h2,
-                    stepSize,
+                    settings.tessellationStepSize,
                     _globe
                 );
                 polyVertices.insert(polyVertices.end(), verts.begin(), verts.end());
@@ -759,23 +801,39 @@ void GlobeGeometryFeature::createPolygonGeometry() {
         }
     }
 
-    RenderFeature triFeature;
-    triFeature.type = RenderType::Polygon;
-    triFeature.nVertices = polyVertices.size();
-    initializeRenderFeature(triFeature, polyVertices);
-    _renderFeatures.push_back(std::move(triFeature));
+    result.push_back(createRenderFeatureData(
+        settings,
+        RenderType::Polygon,
+        false,
+        std::move(polyVertices)
+    ));
 }
 
-void GlobeGeometryFeature::initializeRenderFeature(RenderFeature& feature,
-                                                   const std::vector<Vertex>& vertices)
+GlobeGeometryFeature::RenderFeatureData GlobeGeometryFeature::createRenderFeatureData(
+                                                         const GeometrySettings& settings,
+                                                                          RenderType type,
+                                                                  bool isExtrusionFeature,
+                                                     std::vector<Vertex> vertices) const
 {
-    // Get height map heights
-    feature.vertices = geometryhelper::geodetic2FromVertexList(_globe, vertices);
-    feature.heights = geometryhelper::heightMapHeightsFromGeodetic2List(
+    RenderFeatureData data;
+    data.type = type;
+    data.isExtrusionFeature = isExtrusionFeature;
+
+    // Get height map heights. This might run on a worker thread, so only the heights
+    // that can be sampled from any thread are computed here
+    data.vertices = geometryhelper::geodetic2FromVertexList(_globe, vertices);
+    data.heights = geometryhelper::partialHeightMapHeightsFromGeodetic2List(
         _globe,
-        feature.vertices
+        data.vertices,
+        heightMapAccuracy(settings.tessellationStepSize)
     );
+    data.vertexData = std::move(vertices);
+    return data;
+}
 
+void GlobeGeometryFeature::initializeRenderFeature(RenderFeature& feature,
+                                                   const std::vector<Vertex>& vertices)
+{
     // Generate buffers and buffer data
     feature.initializeBuffers();
     bufferVertexData(feature, vertices);
@@ -793,20 +851,29 @@ float GlobeGeometryFeature::tessellationStepSize() const {
     return distance;
 }
 
+double GlobeGeometryFeature::heightMapAccuracy(float stepSize) {
+    // The geometry linearly interpolates the heights between the vertices, so sampling
+    // the height map at a finer resolution than the vertex spacing would only introduce
+    // aliasing
+    return static_cast<double>(stepSize);
+}
+
 std::vector<double> GlobeGeometryFeature::getCurrentReferencePointsHeights() const {
-    std::vector<double> newHeights;
-    newHeights.reserve(_heightUpdateReferencePoints.size());
+    std::vector<Geodetic2> positions;
+    positions.reserve(_heightUpdateReferencePoints.size());
     for (const Geodetic3& geo : _heightUpdateReferencePoints) {
-        const glm::dvec3 p = geometryhelper::computeOffsetedModelCoordinate(
-            geo,
-            _globe,
-            _offsets.x,
-            _offsets.y
-        );
-        const SurfacePositionHandle handle = _globe.calculateSurfacePositionHandle(p);
-        newHeights.push_back(handle.heightToSurface);
+        positions.push_back({
+            .lat = geo.geodetic2.lat + glm::radians(static_cast<double>(_offsets.x)),
+            .lon = geo.geodetic2.lon + glm::radians(static_cast<double>(_offsets.y))
+        });
     }
-    return newHeights;
+
+    const std::vector<float> heights = geometryhelper::heightMapHeightsFromGeodetic2List(
+        _globe,
+        positions,
+        heightMapAccuracy(tessellationStepSize())
+    );
+    return std::vector<double>(heights.begin(), heights.end());
 }
 
 void GlobeGeometryFeature::bufferVertexData(const RenderFeature& feature,
@@ -29,6 +29,7 @@
 
 #include <modules/globebrowsing/src/basictypes.h>
 #include <modules/globebrowsing/src/geojson/geojsonproperties.h>
+#include <modules/globebrowsing/src/heightqueryservice.h>
 #include <openspace/rendering/helper.h>
 #include <openspace/rendering/texturecomponent.h>
 #include <ghoul/glm.h>
@@ -107,6 +108,31 @@ public:
         std::vector<float> heights;
     };
 
+    /**
+     * The CPU-side data for a render feature, as produced by `createGeometry`. This data
+     * can be created on any thread and is then uploaded to the GPU with
+     * `uploadGeometry` on the main thread. The heights from the height layers that can
+     * only be sampled on the main thread are added during the upload.
+     */
+    struct RenderFeatureData {
+        RenderType type = RenderType::Uninitialized;
+        bool isExtrusionFeature = false;
+        std::vector<Vertex> vertexData;
+        std::vector<Geodetic2> vertices;
+        HeightQueryService::PartialHeights heights;
+    };
+
+    /**
+     * A snapshot of all settings that affect the creation of the geometry. It is
+     * collected on the main thread so that the geometry can be created without accessing
+     * any properties.
+     */
+    struct GeometrySettings {
+        glm::vec3 offsets = glm::vec3(0.f);
+        bool tessellationEnabled = false;
+        float tessellationStepSize = 0.f;
+    };
+
     /**
      * Some extra data that we need for doing the rendering.
      */
@@ -139,10 +165,34 @@ public:
 
     bool shouldUpdateDueToHeightMapChange() const;
 
-    void update(bool dataIsDirty, bool preventHeightUpdates);
+    void update(bool preventHeightUpdates);
+
+    /**
+     * Creates and uploads the geometry synchronously on the calling thread, which has to
+     * be the main thread.
+     */
     void updateGeometry();
     void updateHeightsFromHeightMap();
 
+    /**
+     * Collect the current settings that affect the geometry. Has to be called on the
+     * main thread.
+     */
+    GeometrySettings geometrySettings() const;
+
+    /**
+     * Create the vertex data for all parts of this feature. This function does not
+     * access any properties or OpenGL state and is safe to call from a worker thread
+     * while the main thread keeps rendering the previous geometry.
+     */
+    std::vector<RenderFeatureData> createGeometry(const GeometrySettings& settings) const;
+
+    /**
+     * Replace the current render features with the provided \p data and upload it to the
+     * GPU. Has to be called on the main thread.
+     */
+    void uploadGeometry(std::vector<RenderFeatureData> data);
+
 private:
     void renderPoints(const RenderFeature& feature, const RenderData& renderData,
         const PointRenderMode& renderMode, float sizeScale) const;
@@ -156,24 +206,36 @@ private:
      * Create the vertex information for any line parts of the feature. Returns the
      * resulting vertex positions, so we can use them for extrusion.
      */
-    std::vector<std::vector<glm::vec3>> createLineGeometry();
+    std::vector<std::vector<glm::vec3>> createLineGeometry(
+        const GeometrySettings& settings, std::vector<RenderFeatureData>& result) const;
 
     /**
      * Create the vertex information for any point parts of the feature. Also creates the
      * features for extruded lines for the points.
      */
-    void createPointGeometry();
+    void createPointGeometry(const GeometrySettings& settings,
+        std::vector<RenderFeatureData>& result) const;
 
     /**
      * Create the triangle geometry for the extruded edges of lines/polygons.
      */
-    void createExtrudedGeometry(const std::vector<std::vector<glm::vec3>>& edgeVertices);
+    void createExtrudedGeometry(const GeometrySettings& settings,
+        const std::vector<std::vector<glm::vec3>>& edgeVertices,
+        std::vector<RenderFeatureData>& result) const;
 
     /**
      * Create the triangle geometry for the polygon part of the feature (the area
      * contained by the shape).
      */
-    void createPolygonGeometry();
+    void createPolygonGeometry(const GeometrySettings& settings,
+        std::vector<RenderFeatureData>& result) const;
+
+    /**
+     * Create the data for a render feature from the \p vertices, including the heights
+     * from the height map.
+     */
+    RenderFeatureData createRenderFeatureData(const GeometrySettings& settings,
+        RenderType type, bool isExtrusionFeature, std::vector<Vertex> vertices) const;
 
     void initializeRenderFeature(RenderFeature& feature,
         const std::vector<Vertex>& vertices);
@@ -183,6 +245,12 @@ private:
      */
     float tessellationStepSize() const;
 
+    /**
+     * Get the accuracy (in meters) with which the height map should be sampled for the
+     * vertices of this feature, given the tessellation \p stepSize.
+     */
+    static double heightMapAccuracy(float stepSize);
+
     /**
      * Compute the heights to the surface at the reference points.
      */
@@ -80,15 +80,20 @@ std::vector<Geodetic2> geodetic2FromVertexList(const RenderableGlobe& globe,
 }
 
 std::vector<float> heightMapHeightsFromGeodetic2List(const RenderableGlobe& globe,
-                                                     const std::vector<Geodetic2>& list)
+                                                     const std::vector<Geodetic2>& list,
+                                                     double accuracy)
 {
-    std::vector<float> res;
-    res.reserve(list.size());
-    for (const Geodetic2& geo : list) {
-        float h = static_cast<float>(getHeightToReferenceSurface(geo, globe));
-        res.push_back(h);
-    }
-    return res;
+    HeightQueryService& service = globe.heightQueryService();
+    return service.heights(list, service.levelForAccuracy(accuracy));
+}
+
+HeightQueryService::PartialHeights partialHeightMapHeightsFromGeodetic2List(
+                                                             const RenderableGlobe& globe,
+                                                       const std::vector<Geodetic2>& list,
+                                                                          double accuracy)
+{
+    HeightQueryService& service = globe.heightQueryService();
+    return service.datasetHeights(list, service.levelForAccuracy(accuracy));
 }
 
 std::vector<rendering::helper::VertexXYZNormal>
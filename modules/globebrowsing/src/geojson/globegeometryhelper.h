@@ -25,6 +25,7 @@
 #ifndef __OPENSPACE_MODULE_GLOBEBROWSING___GLOBEGEOMETRYHELPER___H__
 #define __OPENSPACE_MODULE_GLOBEBROWSING___GLOBEGEOMETRYHELPER___H__
 
+#include <modules/globebrowsing/src/heightqueryservice.h>
 #include <ghoul/glm.h>
 #include <vector>
 
@@ -57,8 +58,21 @@ std::vector<Geodetic3> geometryCoordsAsGeoVector(const geos::geom::Geometry* geo
 std::vector<Geodetic2> geodetic2FromVertexList(const RenderableGlobe& globe,
     const std::vector<rendering::helper::VertexXYZNormal>& verts);
 
+/**
+ * Get the heights from the height map of the \p globe for all positions in the \p list.
+ * The height map is sampled with the provided \p accuracy (in meters) using only the
+ * height data that is already available. Missing data is loaded in the background.
+ */
 std::vector<float> heightMapHeightsFromGeodetic2List(const RenderableGlobe& globe,
-    const std::vector<Geodetic2>& list);
+    const std::vector<Geodetic2>& list, double accuracy);
+
+/**
+ * Same as heightMapHeightsFromGeodetic2List, but only samples the height layers that can
+ * be accessed from any thread. The result has to be completed on the main thread with
+ * HeightQueryService::completeHeights.
+ */
+HeightQueryService::PartialHeights partialHeightMapHeightsFromGeodetic2List(
+    const RenderableGlobe& globe, const std::vector<Geodetic2>& list, double accuracy);
 
 /**
  * Create triangle geometry for the extruded edge, given the provided edge vertices.
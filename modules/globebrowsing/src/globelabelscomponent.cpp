@@ -32,6 +32,7 @@
 #include <openspace/engine/globals.h>
 #include <openspace/engine/moduleengine.h>
 #include <openspace/engine/windowdelegate.h>
+#include <openspace/util/memorymanager.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
@@ -41,10 +42,15 @@
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/opengl/programobject.h>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <cstdlib>
 #include <filesystem>
 #include <fstream>
+#include <limits>
 #include <locale>
+#include <numeric>
 #include <optional>
 
 namespace {
@@ -53,12 +59,22 @@ namespace {
     constexpr double LabelFadeOutLimitAltitudeMeters = 25000.0;
     constexpr float MinOpacityValueConst = 0.009f;
 
+    // The accuracy (in meters) with which the terrain height below the labels is sampled
+    constexpr double LabelHeightAccuracy = 1000.0;
+
     enum LabelRenderingAlignmentType {
         Horizontally = 0,
         Circularly
     };
 
-    constexpr int8_t CurrentCacheVersion = 1;
+    constexpr int8_t CurrentCacheVersion = 2;
+
+    // Nodes of the label index with fewer labels than this are not subdivided further
+    constexpr size_t LabelIndexLeafSize = 64;
+    constexpr int LabelIndexMaxDepth = 16;
+
+    // The radius (in meters) of a single label that is used for the frustum culling
+    constexpr double LabelCullingRadius = 1.0;
 
     constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
         "Enabled",
@@ -339,6 +355,7 @@ bool GlobeLabelsComponent::loadLabelsData(const std::filesystem::path& file) {
 
     bool success = readLabelsFile(file);
     if (success) {
+        buildLabelIndex();
         saveCachedFile(cachedFile);
     }
     return success;
@@ -459,6 +476,9 @@ bool GlobeLabelsComponent::loadCachedFile(const std::filesystem::path& file) {
 
     int32_t nValues = 0;
     fileStream.read(reinterpret_cast<char*>(&nValues), sizeof(int32_t));
+    if (!fileStream.good() || nValues < 0) {
+        return false;
+    }
     _labels.labelsArray.resize(nValues);
 
     fileStream.read(
@@ -466,6 +486,19 @@ bool GlobeLabelsComponent::loadCachedFile(const std::filesystem::path& file) {
         nValues * sizeof(LabelEntry)
     );
 
+    // An empty index is valid, for example if there are no labels at all
+    int32_t nNodes = 0;
+    fileStream.read(reinterpret_cast<char*>(&nNodes), sizeof(int32_t));
+    if (!fileStream.good() || nNodes < 0) {
+        return false;
+    }
+    _labels.indexNodes.resize(nNodes);
+
+    fileStream.read(
+        reinterpret_cast<char*>(_labels.indexNodes.data()),
+        nNodes * sizeof(LabelIndexNode)
+    );
+
     return fileStream.good();
 }
 
@@ -487,6 +520,15 @@ bool GlobeLabelsComponent::saveCachedFile(const std::filesystem::path& file) con
     size_t nBytes = nValues * sizeof(LabelEntry);
     fileStream.write(reinterpret_cast<const char*>(_labels.labelsArray.data()), nBytes);
 
+    int32_t nNodes = static_cast<int32_t>(_labels.indexNodes.size());
+    fileStream.write(reinterpret_cast<const char*>(&nNodes), sizeof(int32_t));
+
+    size_t nNodeBytes = nNodes * sizeof(LabelIndexNode);
+    fileStream.write(
+        reinterpret_cast<const char*>(_labels.indexNodes.data()),
+        nNodeBytes
+    );
+
     return fileStream.good();
 }
 
@@ -495,6 +537,8 @@ void GlobeLabelsComponent::draw(const RenderData& data) {
         return;
     }
 
+    requestLabelHeights();
+
     // Calculate the MVP matrix
     glm::dmat4 viewTransform = glm::dmat4(data.camera.combinedViewMatrix());
     glm::dmat4 vp = glm::dmat4(data.camera.sgctInternal.projectionMatrix()) *
@@ -575,8 +619,19 @@ void GlobeLabelsComponent::renderLabels(const RenderData& data,
     }
     glm::dvec3 orthoUp = glm::normalize(glm::cross(orthoRight, cameraViewDirectionObj));
 
-    for (const LabelEntry& lEntry : _labels.labelsArray) {
+    const std::pmr::vector<uint32_t> visibleLabels = collectVisibleLabels(
+        VP,
+        data.camera.positionVec3(),
+        distToCamera
+    );
+
+    const bool hasHeights = _labelHeights.size() == _labels.labelsArray.size();
+    for (uint32_t i : visibleLabels) {
+        const LabelEntry& lEntry = _labels.labelsArray[i];
         glm::vec3 position = lEntry.geoPosition;
+        if (hasHeights) {
+            position += _labelHeights[i] * glm::normalize(position);
+        }
         glm::dvec3 locationPositionWorld =
             glm::dvec3(_globe->modelTransform() * glm::dvec4(position, 1.0));
         double distanceCameraToLabelWorld =
@@ -584,7 +639,7 @@ void GlobeLabelsComponent::renderLabels(const RenderData& data,
 
         if (_disableCulling ||
             ((distToCamera > (distanceCameraToLabelWorld + _distanceEPS)) &&
-            isLabelInFrustum(VP, locationPositionWorld)))
+            isLabelInFrustum(VP, locationPositionWorld, LabelCullingRadius)))
         {
             if (_alignmentOption == Circularly) {
                 glm::dvec3 labelNormalObj = glm::dvec3(
@@ -643,8 +698,208 @@ void GlobeLabelsComponent::renderLabels(const RenderData& data,
     }
 }
 
+void GlobeLabelsComponent::requestLabelHeights() {
+    using namespace globebrowsing;
+
+    HeightQueryService& service = _globe->heightQueryService();
+    const unsigned int generation = service.generation();
+    const size_t nLabels = _labels.labelsArray.size();
+    const bool isUpToDate =
+        _labelHeightsGeneration == generation && _labelHeightsCount == nLabels;
+    if (!service.hasSources() || isUpToDate) {
+        return;
+    }
+    _labelHeightsGeneration = generation;
+    _labelHeightsCount = nLabels;
+
+    std::vector<Geodetic2> positions;
+    positions.reserve(_labels.labelsArray.size());
+    for (const LabelEntry& lEntry : _labels.labelsArray) {
+        positions.push_back({
+            .lat = glm::radians(static_cast<double>(lEntry.latitude)),
+            .lon = glm::radians(static_cast<double>(lEntry.longitude))
+        });
+    }
+
+    service.requestHeights(
+        std::move(positions),
+        service.levelForAccuracy(LabelHeightAccuracy),
+        [this, generation, nLabels](std::vector<float> heights) {
+            // Ignore results from queries that were issued for an older set of layers or
+            // labels
+            if (_labelHeightsGeneration == generation && _labelHeightsCount == nLabels) {
+                _labelHeights = std::move(heights);
+                _maxLabelHeight = 0.f;
+                for (float h : _labelHeights) {
+                    _maxLabelHeight = std::max(_maxLabelHeight, std::abs(h));
+                }
+            }
+        }
+    );
+}
+
+void GlobeLabelsComponent::buildLabelIndex() {
+    ZoneScoped;
+
+    _labels.indexNodes.clear();
+    if (_labels.labelsArray.empty()) {
+        return;
+    }
+
+    glm::vec2 minLatLon = glm::vec2(std::numeric_limits<float>::max());
+    glm::vec2 maxLatLon = glm::vec2(std::numeric_limits<float>::lowest());
+    for (const LabelEntry& lEntry : _labels.labelsArray) {
+        const glm::vec2 latLon = glm::vec2(lEntry.latitude, lEntry.longitude);
+        minLatLon = glm::min(minLatLon, latLon);
+        maxLatLon = glm::max(maxLatLon, latLon);
+    }
+
+    LabelIndexNode root;
+    root.begin = 0;
+    root.end = static_cast<uint32_t>(_labels.labelsArray.size());
+    _labels.indexNodes.push_back(root);
+    buildLabelIndexNode(0, minLatLon, maxLatLon, 0);
+}
+
+void GlobeLabelsComponent::buildLabelIndexNode(size_t nodeIndex, glm::vec2 minLatLon,
+                                               glm::vec2 maxLatLon, int depth)
+{
+    std::vector<LabelEntry>& labels = _labels.labelsArray;
+
+    // Note that the node vector might be reallocated further down, so no reference to
+    // the node is kept around
+    const uint32_t begin = _labels.indexNodes[nodeIndex].begin;
+    const uint32_t end = _labels.indexNodes[nodeIndex].end;
+
+    // Bounding sphere of all label positions in this node
+    glm::dvec3 center = glm::dvec3(0.0);
+    for (uint32_t i = begin; i < end; ++i) {
+        center += glm::dvec3(labels[i].geoPosition);
+    }
+    center /= static_cast<double>(end - begin);
+    double radius = 0.0;
+    for (uint32_t i = begin; i < end; ++i) {
+        const glm::dvec3 position = glm::dvec3(labels[i].geoPosition);
+        radius = std::max(radius, glm::distance(center, position));
+    }
+    _labels.indexNodes[nodeIndex].center = glm::vec3(center);
+    // Round up to make sure that the float sphere still encloses all labels
+    _labels.indexNodes[nodeIndex].radius = static_cast<float>(radius) + 1.f;
+
+    if (end - begin <= LabelIndexLeafSize || depth == LabelIndexMaxDepth) {
+        return;
+    }
+
+    // Split the labels into the four quadrants: south-west, south-east, north-west, and
+    // north-east
+    const glm::vec2 mid = (minLatLon + maxLatLon) / 2.f;
+    auto isSouth = [&mid](const LabelEntry& e) { return e.latitude < mid.x; };
+    auto isWest = [&mid](const LabelEntry& e) { return e.longitude < mid.y; };
+
+    auto itBegin = labels.begin() + begin;
+    auto itEnd = labels.begin() + end;
+    auto itNorth = std::partition(itBegin, itEnd, isSouth);
+    auto itSouthEast = std::partition(itBegin, itNorth, isWest);
+    auto itNorthEast = std::partition(itNorth, itEnd, isWest);
+
+    const std::array<uint32_t, 5> bounds = {
+        begin,
+        static_cast<uint32_t>(std::distance(labels.begin(), itSouthEast)),
+        static_cast<uint32_t>(std::distance(labels.begin(), itNorth)),
+        static_cast<uint32_t>(std::distance(labels.begin(), itNorthEast)),
+        end
+    };
+    const std::array<std::pair<glm::vec2, glm::vec2>, 4> quadrants = {
+        std::pair(minLatLon, mid),
+        std::pair(glm::vec2(minLatLon.x, mid.y), glm::vec2(mid.x, maxLatLon.y)),
+        std::pair(glm::vec2(mid.x, minLatLon.y), glm::vec2(maxLatLon.x, mid.y)),
+        std::pair(mid, maxLatLon)
+    };
+
+    const size_t firstChild = _labels.indexNodes.size();
+    _labels.indexNodes[nodeIndex].firstChild = static_cast<int32_t>(firstChild);
+    _labels.indexNodes.resize(firstChild + 4);
+    for (size_t c = 0; c < 4; ++c) {
+        _labels.indexNodes[firstChild + c].begin = bounds[c];
+        _labels.indexNodes[firstChild + c].end = bounds[c + 1];
+        if (bounds[c] != bounds[c + 1]) {
+            buildLabelIndexNode(
+                firstChild + c,
+                quadrants[c].first,
+                quadrants[c].second,
+                depth + 1
+            );
+        }
+    }
+}
+
+std::pmr::vector<uint32_t> GlobeLabelsComponent::collectVisibleLabels(
+                                                                 const glm::dmat4& VP,
+                                                          const glm::dvec3& cameraPos,
+                                                            float distToCamera) const
+{
+    ZoneScoped;
+
+    std::pmr::memory_resource* memory = &global::memoryManager->TemporaryMemory;
+    std::pmr::vector<uint32_t> visibleLabels(memory);
+    if (_disableCulling || _labels.indexNodes.empty()) {
+        visibleLabels.resize(_labels.labelsArray.size());
+        std::iota(visibleLabels.begin(), visibleLabels.end(), 0);
+        return visibleLabels;
+    }
+
+    const glm::dmat4& modelTransform = _globe->modelTransform();
+    const double scale = std::max({
+        glm::length(glm::dvec3(modelTransform[0])),
+        glm::length(glm::dvec3(modelTransform[1])),
+        glm::length(glm::dvec3(modelTransform[2]))
+    });
+    // The labels are moved along the normal by the terrain height and the height offset,
+    // which has to be accounted for in the bounding spheres
+    const double margin = std::abs(_heightOffset.value()) + _maxLabelHeight;
+
+    std::pmr::vector<int32_t> stack(memory);
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const LabelIndexNode& node = _labels.indexNodes[stack.back()];
+        stack.pop_back();
+
+        if (node.begin == node.end) {
+            continue;
+        }
+
+        const glm::dvec3 centerWorld =
+            glm::dvec3(modelTransform * glm::dvec4(glm::dvec3(node.center), 1.0));
+        const double radiusWorld = (node.radius + margin) * scale;
+
+        if (!isLabelInFrustum(VP, centerWorld, radiusWorld)) {
+            continue;
+        }
+
+        // If even the closest possible label in the node is farther away than the globe,
+        // all of the labels are hidden behind it
+        const double minDistance = glm::distance(centerWorld, cameraPos) - radiusWorld;
+        if (distToCamera <= minDistance + _distanceEPS) {
+            continue;
+        }
+
+        if (node.firstChild == -1) {
+            for (uint32_t i = node.begin; i < node.end; ++i) {
+                visibleLabels.push_back(i);
+            }
+        }
+        else {
+            for (int32_t c = 0; c < 4; ++c) {
+                stack.push_back(node.firstChild + c);
+            }
+        }
+    }
+    return visibleLabels;
+}
+
 bool GlobeLabelsComponent::isLabelInFrustum(const glm::dmat4& MVMatrix,
-                                            const glm::dvec3& position) const
+                                            const glm::dvec3& position,
+                                            double radius) const
 {
     // Frustum Planes
     glm::dvec3 col1(MVMatrix[0][0], MVMatrix[1][0], MVMatrix[2][0]);
@@ -692,20 +947,19 @@ bool GlobeLabelsComponent::isLabelInFrustum(const glm::dmat4& MVMatrix,
     farNormal *= invMagFar;
     // farDistance *= invMagFar;
 
-    constexpr float Radius = 1.0;
-    if ((glm::dot(leftNormal, position) + leftDistance) < -Radius) {
+    if ((glm::dot(leftNormal, position) + leftDistance) < -radius) {
         return false;
     }
-    else if ((glm::dot(rightNormal, position) + rightDistance) < -Radius) {
+    else if ((glm::dot(rightNormal, position) + rightDistance) < -radius) {
         return false;
     }
-    else if ((glm::dot(bottomNormal, position) + bottomDistance) < -Radius) {
+    else if ((glm::dot(bottomNormal, position) + bottomDistance) < -radius) {
         return false;
     }
-    else if ((glm::dot(topNormal, position) + topDistance) < -Radius) {
+    else if ((glm::dot(topNormal, position) + topDistance) < -radius) {
         return false;
     }
-    else if ((glm::dot(nearNormal, position) + nearDistance) < -Radius) {
+    else if ((glm::dot(nearNormal, position) + nearDistance) < -radius) {
         return false;
     }
 
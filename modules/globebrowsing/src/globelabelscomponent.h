@@ -37,6 +37,18 @@
 #include <openspace/properties/vector/vec3property.h>
 #include <ghoul/font/fontrenderer.h>
 #include <ghoul/glm.h>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
+#include <experimental/memory_resource>
+namespace std {
+    using namespace experimental;
+} // namespace std
+#else
+#include <memory_resource>
+#endif
 
 namespace ghoul { class Dictionary; }
 namespace ghoul::opengl { class ProgramObject; }
@@ -69,7 +81,25 @@ private:
     bool saveCachedFile(const std::filesystem::path& file) const;
     void renderLabels(const RenderData& data, const glm::dmat4& modelViewProjectionMatrix,
         float distToCamera, float fadeInVariable);
-    bool isLabelInFrustum(const glm::dmat4& MVMatrix, const glm::dvec3& position) const;
+    bool isLabelInFrustum(const glm::dmat4& MVMatrix, const glm::dvec3& position,
+        double radius) const;
+    void requestLabelHeights();
+
+    /**
+     * Sorts the labels into a geodetic quadtree. Afterwards, every node of the tree
+     * covers a contiguous range of the labels array.
+     */
+    void buildLabelIndex();
+    void buildLabelIndexNode(size_t nodeIndex, glm::vec2 minLatLon, glm::vec2 maxLatLon,
+        int depth);
+
+    /**
+     * Returns the indices of all labels in the nodes of the label index that intersect
+     * the view frustum and that are not hidden behind the globe. The list is allocated
+     * from the temporary memory and is only valid until the end of the frame.
+     */
+    std::pmr::vector<uint32_t> collectVisibleLabels(const glm::dmat4& VP,
+        const glm::dvec3& cameraPos, float distToCamera) const;
 
     // Labels Structures
     struct LabelEntry {
@@ -80,9 +110,21 @@ private:
         glm::vec3 geoPosition = glm::vec3(0.f);
     };
 
+    // A node in the spatial index over the labels. The bounding sphere is given in model
+    // space and encloses the geoPosition of all labels in the node
+    struct LabelIndexNode {
+        glm::vec3 center = glm::vec3(0.f);
+        float radius = 0.f;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+        // The index of the first of four consecutive children, or -1 for a leaf node
+        int32_t firstChild = -1;
+    };
+
     struct Labels {
         std::string filename;
         std::vector<LabelEntry> labelsArray;
+        std::vector<LabelIndexNode> indexNodes;
     };
 
     properties::BoolProperty _enabled;
@@ -100,6 +142,14 @@ private:
 
     Labels _labels;
 
+    // Height of the terrain below each label, sampled from the globe's height map. Empty
+    // until the first height query has finished
+    std::vector<float> _labelHeights;
+    // The height source generation and number of labels of the last height request
+    std::optional<unsigned int> _labelHeightsGeneration;
+    size_t _labelHeightsCount = 0;
+    float _maxLabelHeight = 0.f;
+
     // Font
     std::shared_ptr<ghoul::fontrendering::Font> _font;
 
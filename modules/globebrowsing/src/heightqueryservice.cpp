@@ -0,0 +1,706 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/globebrowsing/src/heightqueryservice.h>
+
+#include <modules/globebrowsing/src/geodeticpatch.h>
+#include <modules/globebrowsing/src/layer.h>
+#include <modules/globebrowsing/src/layergroup.h>
+#include <modules/globebrowsing/src/layermanager.h>
+#include <modules/globebrowsing/src/rawtile.h>
+#include <modules/globebrowsing/src/rawtiledatareader.h>
+#include <modules/globebrowsing/src/tileprovider/tileprovider.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/opengl/texture.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <optional>
+
+namespace {
+    constexpr std::string_view _loggerCat = "HeightQueryService";
+
+    // Same cut-off as is used in the shader and in RenderableGlobe. If the sample is
+    // actually a no-data-value (min_float) the interpolated value might not be
+    constexpr float NoDataCutOff = -100000.f;
+
+    struct TileSample {
+        openspace::globebrowsing::TileIndex tileIndex;
+        glm::vec2 patchUv;
+    };
+
+    // Bilinear interpolation between four neighboring height samples. Returns nothing if
+    // any of the samples does not contain valid height data
+    std::optional<float> interpolate(float s00, float s10, float s01, float s11,
+                                     const glm::vec2& fract, float noDataValue)
+    {
+        const bool anySampleIsNaN =
+            std::isnan(s00) || std::isnan(s01) || std::isnan(s10) || std::isnan(s11);
+        const bool anySampleIsNoData =
+            s00 == noDataValue || s01 == noDataValue ||
+            s10 == noDataValue || s11 == noDataValue;
+        if (anySampleIsNaN || anySampleIsNoData) {
+            return std::nullopt;
+        }
+
+        const float s0 = s00 * (1.f - fract.x) + s10 * fract.x;
+        const float s1 = s01 * (1.f - fract.x) + s11 * fract.x;
+        const float s = s0 * (1.f - fract.y) + s1 * fract.y;
+        if (s <= NoDataCutOff) {
+            return std::nullopt;
+        }
+        return s;
+    }
+
+    TileSample tileSample(const openspace::globebrowsing::Geodetic2& position, int level)
+    {
+        using namespace openspace::globebrowsing;
+
+        // Wrap the longitude into [-pi, pi] as some datasets use [0, 2pi] instead
+        const double lon = std::remainder(position.lon, glm::two_pi<double>());
+
+        const int numIndicesAtLevel = 1 << level;
+        const double u = 0.5 + lon / glm::two_pi<double>();
+        const double v = 0.25 - position.lat / glm::two_pi<double>();
+
+        // The latitude only covers half of the index space in the y direction
+        const int x = std::clamp(
+            static_cast<int>(std::floor(u * numIndicesAtLevel)),
+            0,
+            numIndicesAtLevel - 1
+        );
+        const int y = std::clamp(
+            static_cast<int>(std::floor(v * numIndicesAtLevel)),
+            0,
+            std::max(numIndicesAtLevel / 2 - 1, 0)
+        );
+
+        const TileIndex tileIndex = TileIndex(x, y, static_cast<uint8_t>(level));
+        const GeodeticPatch patch = GeodeticPatch(tileIndex);
+        const Geodetic2 northEast = patch.corner(Quad::NORTH_EAST);
+        const Geodetic2 southWest = patch.corner(Quad::SOUTH_WEST);
+
+        const glm::vec2 patchUv = glm::vec2(
+            (lon - southWest.lon) / (northEast.lon - southWest.lon),
+            (position.lat - southWest.lat) / (northEast.lat - southWest.lat)
+        );
+        return { tileIndex, patchUv };
+    }
+} // namespace
+
+namespace openspace::globebrowsing {
+
+struct HeightQueryService::HeightTile {
+    glm::ivec2 dimensions = glm::ivec2(0);
+    std::vector<float> data;
+    bool isValid = false;
+
+    std::optional<float> sample(const glm::vec2& uv, float noDataValue) const;
+};
+
+struct HeightQueryService::Source {
+    uint16_t id = 0;
+    std::shared_ptr<RawTileDataReader> reader;
+
+    // The tiles that are used for rendering are sampled if there is no reader or if
+    // none of the tiles of the reader are cached yet. They can only be accessed from
+    // the main thread
+    TileProvider* tileProvider = nullptr;
+    Layer* layer = nullptr;
+
+    int maxLevel = 0;
+    float noDataValue = 0.f;
+    TileDepthTransform depthTransform;
+
+    // A copy of the render settings of the layer
+    float gamma = 1.f;
+    float multiplier = 1.f;
+    float offset = 0.f;
+
+    bool hasSameSettings(const Source& rhs) const;
+    float applySettings(float sample) const;
+};
+
+std::optional<float> HeightQueryService::HeightTile::sample(const glm::vec2& uv,
+                                                            float noDataValue) const
+{
+    if (!isValid) {
+        return std::nullopt;
+    }
+
+    // This sampling mirrors the one in RenderableGlobe::getHeight, including the 0.5
+    // texel offset, so that both produce the same results for the same tile
+    const glm::vec2 samplePos = uv * glm::vec2(dimensions) - glm::vec2(0.5f);
+    const glm::ivec2 maxPos = dimensions - glm::ivec2(1);
+    const glm::ivec2 p00 = glm::clamp(glm::ivec2(samplePos), glm::ivec2(0), maxPos);
+    const glm::vec2 fract = samplePos - glm::vec2(p00);
+    const glm::ivec2 p11 = glm::min(p00 + glm::ivec2(1), maxPos);
+
+    auto texel = [this](int x, int y) { return data[y * dimensions.x + x]; };
+    return interpolate(
+        texel(p00.x, p00.y),
+        texel(p11.x, p00.y),
+        texel(p00.x, p11.y),
+        texel(p11.x, p11.y),
+        fract,
+        noDataValue
+    );
+}
+
+bool HeightQueryService::Source::hasSameSettings(const Source& rhs) const {
+    return reader == rhs.reader && tileProvider == rhs.tileProvider &&
+        depthTransform.scale == rhs.depthTransform.scale &&
+        depthTransform.offset == rhs.depthTransform.offset && gamma == rhs.gamma &&
+        multiplier == rhs.multiplier && offset == rhs.offset;
+}
+
+float HeightQueryService::Source::applySettings(float sample) const {
+    // Depth transform to get the value in meters and then the same transformation as
+    // LayerRenderSettings::performLayerSettings
+    const float v = depthTransform.offset + depthTransform.scale * sample;
+    return glm::sign(v) * glm::pow(glm::abs(v), gamma) * multiplier + offset;
+}
+
+unsigned long long HeightQueryService::KeyHasher::operator()(const Key& key) const {
+    // The TileHashKey only uses the lower 64 - 5 bits in practice, but mixing in the
+    // source id this way is sufficient to separate the sources in the hash map
+    return key.tileHashKey ^ (static_cast<unsigned long long>(key.sourceId) << 59);
+}
+
+HeightQueryService::HeightQueryService(Ellipsoid ellipsoid, size_t maxCachedTiles,
+                                       size_t nThreads)
+    : _ellipsoid(std::move(ellipsoid))
+    , _sources(std::make_shared<const Sources>())
+    , _tileCache(maxCachedTiles)
+    , _threadPool(nThreads)
+{}
+
+HeightQueryService::~HeightQueryService() {
+    _threadPool.clearTasks();
+}
+
+void HeightQueryService::updateSources(const LayerManager& layerManager) {
+    ZoneScoped;
+
+    const std::vector<Layer*>& layers =
+        layerManager.layerGroup(layers::Group::ID::HeightLayers).activeLayers();
+
+    std::shared_ptr<const Sources> current = sources();
+
+    Sources newSources;
+    newSources.reserve(layers.size());
+    for (Layer* layer : layers) {
+        TileProvider* tileProvider = layer->tileProvider();
+        if (!tileProvider) {
+            continue;
+        }
+
+        auto s = std::make_shared<Source>();
+        s->reader = tileProvider->rawTileDataReader();
+        s->tileProvider = tileProvider;
+        s->layer = layer;
+        if (s->reader) {
+            s->maxLevel = s->reader->maxChunkLevel();
+            s->noDataValue = s->reader->noDataValueAsFloat();
+            s->depthTransform = s->reader->depthTransform();
+        }
+        else {
+            s->maxLevel = tileProvider->maxLevel();
+            s->noDataValue = tileProvider->noDataValueAsFloat();
+            s->depthTransform = tileProvider->depthTransform();
+        }
+        s->gamma = layer->renderSettings().gamma;
+        s->multiplier = layer->renderSettings().multiplier;
+        s->offset = layer->renderSettings().offset;
+
+        auto it = std::find_if(
+            current->begin(),
+            current->end(),
+            [&s](const std::shared_ptr<const Source>& c) {
+                return c->reader == s->reader && c->tileProvider == s->tileProvider;
+            }
+        );
+        if (it != current->end() && (*it)->hasSameSettings(*s)) {
+            newSources.push_back(*it);
+            continue;
+        }
+
+        s->id = (it != current->end()) ? (*it)->id : _nextSourceId++;
+        newSources.push_back(std::move(s));
+    }
+
+    // Unchanged sources are reused, so comparing the pointers is sufficient
+    if (newSources == *current) {
+        return;
+    }
+
+    std::lock_guard lock(_mutex);
+    const bool removedAnySource = std::any_of(
+        current->begin(),
+        current->end(),
+        [&newSources](const std::shared_ptr<const Source>& c) {
+            // Only the sources with a reader have tiles in the cache
+            return c->reader && std::none_of(
+                newSources.begin(),
+                newSources.end(),
+                [&c](const std::shared_ptr<const Source>& n) { return n->id == c->id; }
+            );
+        }
+    );
+    if (removedAnySource) {
+        // The cache does not support removing individual entries, but changes to the
+        // height layers are rare enough that it is fine to start over
+        _tileCache.clear();
+    }
+    _sources = std::make_shared<const Sources>(std::move(newSources));
+    _generation++;
+}
+
+void HeightQueryService::update() {
+    std::vector<FinishedRequest> finished;
+    {
+        std::lock_guard lock(_finishedRequestsMutex);
+        finished = std::move(_finishedRequests);
+        _finishedRequests.clear();
+    }
+
+    if (finished.empty()) {
+        return;
+    }
+
+    for (FinishedRequest& request : finished) {
+        request.callback(
+            completeHeights(*request.positions, std::move(request.heights))
+        );
+    }
+}
+
+bool HeightQueryService::hasSources() const {
+    return !sources()->empty();
+}
+
+unsigned int HeightQueryService::generation() const {
+    std::lock_guard lock(_mutex);
+    return _generation;
+}
+
+int HeightQueryService::levelForAccuracy(double accuracy) const {
+    // A tile on level L covers 2*pi / 2^L radians, which is distributed over the pixels
+    // of the tile. We pick the lowest level for which a single pixel is smaller than the
+    // requested accuracy. The tile size is the default size used for height layers
+    constexpr double TileSize = 512.0;
+    const double circumference = glm::two_pi<double>() * _ellipsoid.maximumRadius();
+    const double nTiles = circumference / (TileSize * std::max(accuracy, 1e-3));
+    const int level = static_cast<int>(std::ceil(std::log2(std::max(nTiles, 1.0))));
+    return std::clamp(level, 1, MaxLevel);
+}
+
+std::vector<float> HeightQueryService::heights(const std::vector<Geodetic2>& positions,
+                                               int level)
+{
+    ZoneScoped;
+
+    return completeHeights(positions, datasetHeights(positions, level));
+}
+
+std::vector<float> HeightQueryService::heightsBlocking(
+                                                  const std::vector<Geodetic2>& positions,
+                                                                                int level)
+{
+    ZoneScoped;
+
+    PartialHeights partial = {
+        .heights = std::vector<float>(positions.size(), 0.f),
+        .sources = sources(),
+        .level = level,
+        .heightSources = std::vector<int>(positions.size(), -1)
+    };
+    if (partial.sources->empty()) {
+        return std::move(partial.heights);
+    }
+
+    loadAndSampleTiles(
+        *partial.sources,
+        positions,
+        level,
+        partial.heights,
+        partial.heightSources
+    );
+    return completeHeights(positions, std::move(partial));
+}
+
+HeightQueryService::PartialHeights HeightQueryService::datasetHeights(
+                                                  const std::vector<Geodetic2>& positions,
+                                                                                int level)
+{
+    ZoneScoped;
+
+    PartialHeights partial = {
+        .heights = std::vector<float>(positions.size(), 0.f),
+        .sources = sources(),
+        .level = level,
+        .heightSources = std::vector<int>(positions.size(), -1)
+    };
+    for (size_t i = 0; i < positions.size(); ++i) {
+        partial.heights[i] = sampleHeight(
+            *partial.sources,
+            positions[i],
+            level,
+            false,
+            partial.heightSources[i]
+        );
+    }
+    return partial;
+}
+
+std::vector<float> HeightQueryService::completeHeights(
+                                                  const std::vector<Geodetic2>& positions,
+                                                             PartialHeights partial) const
+{
+    ZoneScoped;
+
+    ghoul_assert(
+        partial.heights.size() == positions.size(),
+        "The partial heights have to belong to the positions"
+    );
+    if (!partial.sources) {
+        return std::move(partial.heights);
+    }
+
+    // The rendered tiles are sampled for the sources without a reader and for the
+    // positions for which a source with a reader did not have a cached tile yet. The
+    // layers might have changed or been removed since the partial heights were created,
+    // so the sources are replaced by their current version, if there is one
+    std::shared_ptr<const Sources> current = sources();
+    Sources partialSources = *partial.sources;
+    bool hasRenderedSources = false;
+    for (std::shared_ptr<const Source>& source : partialSources) {
+        auto it = std::find_if(
+            current->begin(),
+            current->end(),
+            [&source](const std::shared_ptr<const Source>& c) {
+                return c->tileProvider == source->tileProvider;
+            }
+        );
+        source = (it != current->end()) ? *it : nullptr;
+        hasRenderedSources |= (source != nullptr);
+    }
+
+    if (hasRenderedSources) {
+        sampleRenderedTiles(
+            partialSources,
+            positions,
+            partial.level,
+            partial.heights,
+            partial.heightSources
+        );
+    }
+    return std::move(partial.heights);
+}
+
+void HeightQueryService::requestHeights(std::vector<Geodetic2> positions, int level,
+                                        Callback callback)
+{
+    auto shared = std::make_shared<const std::vector<Geodetic2>>(std::move(positions));
+    _threadPool.enqueue([this, shared, level, callback = std::move(callback)]() {
+        FinishedRequest request = {
+            .callback = callback,
+            .positions = shared,
+            .heights = {
+                .heights = std::vector<float>(shared->size(), 0.f),
+                .sources = sources(),
+                .level = level,
+                .heightSources = std::vector<int>(shared->size(), -1)
+            }
+        };
+
+        // The sources without a reader are sampled on the main thread in `update`
+        loadAndSampleTiles(
+            *request.heights.sources,
+            *shared,
+            level,
+            request.heights.heights,
+            request.heights.heightSources
+        );
+
+        std::lock_guard lock(_finishedRequestsMutex);
+        _finishedRequests.push_back(std::move(request));
+    });
+}
+
+std::shared_ptr<const HeightQueryService::Sources> HeightQueryService::sources() const {
+    std::lock_guard lock(_mutex);
+    return _sources;
+}
+
+std::shared_ptr<const HeightQueryService::HeightTile> HeightQueryService::cachedTile(
+                                                                           const Key& key)
+{
+    std::lock_guard lock(_mutex);
+    if (_tileCache.exist(key)) {
+        return _tileCache.get(key);
+    }
+    return nullptr;
+}
+
+std::shared_ptr<const HeightQueryService::HeightTile> HeightQueryService::loadTile(
+                                                                     const Source& source,
+                                                               const TileIndex& tileIndex)
+{
+    ZoneScoped;
+
+    const Key key = { .sourceId = source.id, .tileHashKey = tileIndex.hashKey() };
+
+    std::promise<std::shared_ptr<const HeightTile>> promise;
+    {
+        std::unique_lock lock(_mutex);
+        if (_tileCache.exist(key)) {
+            return _tileCache.get(key);
+        }
+
+        auto it = _tilesInFlight.find(key);
+        if (it != _tilesInFlight.end()) {
+            // Another thread is already reading this tile, so we wait for it instead
+            std::shared_future<std::shared_ptr<const HeightTile>> f = it->second;
+            lock.unlock();
+            return f.get();
+        }
+        _tilesInFlight[key] = promise.get_future().share();
+    }
+
+    auto tile = std::make_shared<HeightTile>();
+    try {
+        RawTile rawTile = source.reader->readTileData(tileIndex);
+
+        if (rawTile.error < RawTile::ReadError::Failure && rawTile.imageData &&
+            rawTile.textureInitData.has_value() &&
+            rawTile.textureInitData->glType == GL_FLOAT)
+        {
+            const TileTextureInitData& init = *rawTile.textureInitData;
+            tile->dimensions = glm::ivec2(init.dimensions);
+            tile->data.resize(
+                static_cast<size_t>(tile->dimensions.x) * tile->dimensions.y
+            );
+
+            // Only the first raster carries the height values
+            const std::byte* src = rawTile.imageData.get();
+            for (int y = 0; y < tile->dimensions.y; ++y) {
+                const std::byte* line = src + y * init.bytesPerLine;
+                for (int x = 0; x < tile->dimensions.x; ++x) {
+                    std::memcpy(
+                        &tile->data[y * tile->dimensions.x + x],
+                        line + x * init.bytesPerPixel,
+                        sizeof(float)
+                    );
+                }
+            }
+            tile->isValid = true;
+        }
+    }
+    catch (...) {
+        // The tile is not cached so that it can be requested again later. Threads that
+        // are waiting for this tile receive the same exception
+        {
+            std::lock_guard lock(_mutex);
+            _tilesInFlight.erase(key);
+            _tilesQueued.erase(key);
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _tileCache.put(key, tile);
+        _tilesInFlight.erase(key);
+        _tilesQueued.erase(key);
+    }
+    promise.set_value(tile);
+    return tile;
+}
+
+void HeightQueryService::loadAndSampleTiles(const Sources& sources,
+                                            const std::vector<Geodetic2>& positions,
+                                            int level, std::vector<float>& heights,
+                                            std::vector<int>& heightSources)
+{
+    // Process the positions sorted by the tile they fall into so that each tile has to
+    // be loaded only once, regardless of the order of the positions and the cache size
+    std::vector<std::pair<TileIndex::TileHashKey, size_t>> order;
+    order.reserve(positions.size());
+    for (size_t i = 0; i < positions.size(); ++i) {
+        order.emplace_back(tileSample(positions[i], level).tileIndex.hashKey(), i);
+    }
+    std::sort(order.begin(), order.end());
+
+    for (const std::pair<TileIndex::TileHashKey, size_t>& o : order) {
+        const size_t i = o.second;
+        heights[i] = sampleHeight(sources, positions[i], level, true, heightSources[i]);
+    }
+}
+
+void HeightQueryService::enqueueTileLoad(std::shared_ptr<const Source> source,
+                                         TileIndex tileIndex)
+{
+    const Key key = { .sourceId = source->id, .tileHashKey = tileIndex.hashKey() };
+    {
+        std::lock_guard lock(_mutex);
+        if (_tilesQueued.find(key) != _tilesQueued.end() ||
+            _tilesInFlight.find(key) != _tilesInFlight.end())
+        {
+            return;
+        }
+        _tilesQueued.insert(key);
+    }
+
+    _threadPool.enqueue([this, source = std::move(source), tileIndex]() {
+        try {
+            loadTile(*source, tileIndex);
+        }
+        catch (const std::exception& e) {
+            LERROR(fmt::format(
+                "Error loading height tile {}: {}", tileIndex.hashKey(), e.what()
+            ));
+        }
+    });
+}
+
+float HeightQueryService::sampleHeight(const Sources& sources,
+                                       const Geodetic2& position, int level,
+                                       bool loadMissingTiles, int& heightSource)
+{
+    float height = 0.f;
+    for (size_t i = 0; i < sources.size(); ++i) {
+        const std::shared_ptr<const Source>& source = sources[i];
+        if (!source->reader) {
+            // Sampled from the rendered tiles in `sampleRenderedTiles` instead
+            continue;
+        }
+
+        const int sourceLevel = std::clamp(level, 1, std::max(source->maxLevel, 1));
+
+        std::optional<float> sample;
+        if (loadMissingTiles) {
+            const TileSample ts = tileSample(position, sourceLevel);
+            try {
+                std::shared_ptr<const HeightTile> tile = loadTile(*source, ts.tileIndex);
+                sample = tile->sample(ts.patchUv, source->noDataValue);
+            }
+            catch (const std::exception& e) {
+                LERROR(fmt::format(
+                    "Error loading height tile {}: {}", ts.tileIndex.hashKey(), e.what()
+                ));
+            }
+        }
+        else {
+            // Use the best tile that is already available and request the missing one
+            for (int l = sourceLevel; l >= 1 && !sample.has_value(); --l) {
+                const TileSample ts = tileSample(position, l);
+                const Key key = {
+                    .sourceId = source->id,
+                    .tileHashKey = ts.tileIndex.hashKey()
+                };
+                std::shared_ptr<const HeightTile> tile = cachedTile(key);
+                if (tile) {
+                    sample = tile->sample(ts.patchUv, source->noDataValue);
+                }
+                else if (l == sourceLevel) {
+                    enqueueTileLoad(source, ts.tileIndex);
+                }
+            }
+        }
+
+        // Later layers take precedence, just as in the rendering
+        if (sample.has_value()) {
+            height = source->applySettings(*sample);
+            heightSource = static_cast<int>(i);
+        }
+    }
+    return height;
+}
+
+void HeightQueryService::sampleRenderedTiles(const Sources& sources,
+                                             const std::vector<Geodetic2>& positions,
+                                             int level, std::vector<float>& heights,
+                                             const std::vector<int>& heightSources) const
+{
+    ZoneScoped;
+
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (!sources[i] || !sources[i]->tileProvider) {
+            continue;
+        }
+        const Source& source = *sources[i];
+
+        const int sourceLevel = std::clamp(level, 1, std::max(source.maxLevel, 1));
+        for (size_t j = 0; j < positions.size(); ++j) {
+            if (heightSources[j] >= static_cast<int>(i)) {
+                // This source already provided the height from its dataset or a later
+                // layer did, which takes precedence
+                continue;
+            }
+
+            // Same as the sampling in RenderableGlobe::getHeight before the heights
+            // were read from the datasets directly, using the best available tile
+            const TileSample ts = tileSample(positions[j], sourceLevel);
+            const ChunkTile chunkTile = source.tileProvider->chunkTile(ts.tileIndex);
+            const Tile& tile = chunkTile.tile;
+            if (tile.status != Tile::Status::OK || !tile.texture) {
+                continue;
+            }
+
+            const glm::uvec3 dimensions = tile.texture->dimensions();
+            const glm::vec2 uv = source.layer->tileUvToTextureSamplePosition(
+                chunkTile.uvTransform,
+                ts.patchUv,
+                glm::uvec2(dimensions)
+            );
+
+            const glm::vec2 samplePos = uv * glm::vec2(dimensions) - glm::vec2(0.5f);
+            const glm::ivec2 maxPos = glm::ivec2(dimensions) - glm::ivec2(1);
+            const glm::uvec2 p00 = glm::uvec2(
+                glm::clamp(glm::ivec2(samplePos), glm::ivec2(0), maxPos)
+            );
+            const glm::vec2 fract = samplePos - glm::vec2(p00);
+            const glm::uvec2 p11 = glm::min(p00 + glm::uvec2(1), glm::uvec2(maxPos));
+
+            std::optional<float> sample = interpolate(
+                tile.texture->texelAsFloat(p00).x,
+                tile.texture->texelAsFloat(glm::uvec2(p11.x, p00.y)).x,
+                tile.texture->texelAsFloat(glm::uvec2(p00.x, p11.y)).x,
+                tile.texture->texelAsFloat(p11).x,
+                fract,
+                source.noDataValue
+            );
+            if (sample.has_value()) {
+                heights[j] = source.applySettings(*sample);
+            }
+        }
+    }
+}
+
+} // namespace openspace::globebrowsing
@@ -0,0 +1,231 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_GLOBEBROWSING___HEIGHTQUERYSERVICE___H__
+#define __OPENSPACE_MODULE_GLOBEBROWSING___HEIGHTQUERYSERVICE___H__
+
+#include <modules/globebrowsing/src/basictypes.h>
+#include <modules/globebrowsing/src/ellipsoid.h>
+#include <modules/globebrowsing/src/lrucache.h>
+#include <modules/globebrowsing/src/tileindex.h>
+#include <openspace/util/threadpool.h>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace openspace::globebrowsing {
+
+class LayerManager;
+class RawTileDataReader;
+
+/**
+ * This class answers height map queries for a globe on the CPU. The height data is read
+ * directly from the datasets that back the active height layers and is kept in a cache of
+ * decoded height tiles that is independent of the tiles that are currently used for
+ * rendering. This means that the result of a query does not depend on which chunks of the
+ * globe happen to be rendered at the time of the query.
+ *
+ * Height layers whose tile provider does not expose a raw tile data reader fall back to
+ * sampling the tiles that are currently used for rendering. As these tiles can only be
+ * accessed from the main thread, the `heights` and `heightsBlocking` functions have to be
+ * called from the main thread while such a layer is active. Asynchronous queries sample
+ * these layers in the `update` function before their callback is invoked. Worker threads
+ * can use `datasetHeights` instead and pass the result to `completeHeights` on the main
+ * thread.
+ *
+ * The `updateSources` and `update` functions have to be called from the main thread.
+ */
+class HeightQueryService {
+public:
+    using Callback = std::function<void(std::vector<float> heights)>;
+
+    struct Source;
+    using Sources = std::vector<std::shared_ptr<const Source>>;
+
+    /**
+     * The heights for a list of positions that only contain the contributions of the
+     * height layers that are backed by a dataset. The contributions of the remaining
+     * layers are added by `completeHeights`.
+     */
+    struct PartialHeights {
+        std::vector<float> heights;
+
+        // The sources and level that were used for the query
+        std::shared_ptr<const Sources> sources;
+        int level = 0;
+        // The index of the source that provided each height or -1 if there was none
+        std::vector<int> heightSources;
+    };
+
+    /// The highest tile level that can be requested, same as the maximum split depth of
+    /// the RenderableGlobe
+    static constexpr int MaxLevel = 22;
+
+    /**
+     * \param ellipsoid The ellipsoid of the globe, used to convert an accuracy given in
+     *        meters to a tile level
+     * \param maxCachedTiles The maximum number of decoded height tiles that are kept in
+     *        the cache
+     * \param nThreads The number of worker threads used for asynchronous queries
+     */
+    HeightQueryService(Ellipsoid ellipsoid, size_t maxCachedTiles = 256,
+        size_t nThreads = 2);
+    ~HeightQueryService();
+
+    /**
+     * Synchronizes the list of height sources with the active height layers in the
+     * provided \p layerManager. Cached tiles belonging to sources that are no longer
+     * active are discarded. Has to be called from the main thread.
+     */
+    void updateSources(const LayerManager& layerManager);
+
+    /**
+     * Invokes the callbacks of all asynchronous queries that have finished since the last
+     * call. Has to be called from the main thread.
+     */
+    void update();
+
+    /**
+     * Returns whether there are any height layers that can be queried at the moment.
+     */
+    bool hasSources() const;
+
+    /**
+     * Returns a number that is increased every time the set of height sources changes.
+     * This can be used to detect when previously queried heights have become outdated.
+     */
+    unsigned int generation() const;
+
+    /**
+     * Returns the height level that has to be used to sample the height map with a
+     * sample distance of at most \p accuracy meters.
+     */
+    int levelForAccuracy(double accuracy) const;
+
+    /**
+     * Returns the heights for the provided \p positions using only the tiles that are
+     * currently cached. If a tile at the requested \p level is not cached, the closest
+     * cached lower resolution tile is used instead and the missing tile is loaded in the
+     * background. If no tile is cached for a position at all, for example right after
+     * startup or after the camera jumped to a new location, the tiles that are currently
+     * used for rendering are sampled instead. Positions for which no height data is
+     * available at all return 0.
+     */
+    std::vector<float> heights(const std::vector<Geodetic2>& positions, int level);
+
+    /**
+     * Returns the heights for the provided \p positions at the requested \p level. Any
+     * tile that is not already cached is read from the dataset before this function
+     * returns, so `requestHeights` should be preferred for large requests.
+     */
+    std::vector<float> heightsBlocking(const std::vector<Geodetic2>& positions,
+        int level);
+
+    /**
+     * Returns the heights for the provided \p positions in the same way as `heights`,
+     * but only samples the height layers that are backed by a dataset. Contrary to
+     * `heights`, this function can be called from any thread. The result has to be
+     * passed to `completeHeights` on the main thread to get the final heights.
+     */
+    PartialHeights datasetHeights(const std::vector<Geodetic2>& positions, int level);
+
+    /**
+     * Adds the contributions of the height layers that are sampled from the rendered
+     * tiles to the \p partial heights for the \p positions that were passed to
+     * `datasetHeights`. Has to be called from the main thread.
+     */
+    std::vector<float> completeHeights(const std::vector<Geodetic2>& positions,
+        PartialHeights partial) const;
+
+    /**
+     * Asynchronously computes the heights for the provided \p positions at the
+     * requested \p level. The \p callback is invoked from within the `update` function
+     * once all required tiles have been loaded.
+     */
+    void requestHeights(std::vector<Geodetic2> positions, int level, Callback callback);
+
+private:
+    struct HeightTile;
+
+    struct Key {
+        uint16_t sourceId = 0;
+        TileIndex::TileHashKey tileHashKey = 0;
+
+        bool operator==(const Key& rhs) const = default;
+    };
+
+    struct KeyHasher {
+        unsigned long long operator()(const Key& key) const;
+    };
+
+    struct FinishedRequest {
+        Callback callback;
+        std::shared_ptr<const std::vector<Geodetic2>> positions;
+        PartialHeights heights;
+    };
+
+    std::shared_ptr<const Sources> sources() const;
+
+    std::shared_ptr<const HeightTile> cachedTile(const Key& key);
+    std::shared_ptr<const HeightTile> loadTile(const Source& source,
+        const TileIndex& tileIndex);
+    void enqueueTileLoad(std::shared_ptr<const Source> source, TileIndex tileIndex);
+    void loadAndSampleTiles(const Sources& sources,
+        const std::vector<Geodetic2>& positions, int level, std::vector<float>& heights,
+        std::vector<int>& heightSources);
+
+    float sampleHeight(const Sources& sources, const Geodetic2& position, int level,
+        bool loadMissingTiles, int& heightSource);
+    void sampleRenderedTiles(const Sources& sources,
+        const std::vector<Geodetic2>& positions, int level, std::vector<float>& heights,
+        const std::vector<int>& heightSources) const;
+
+    const Ellipsoid _ellipsoid;
+
+    std::shared_ptr<const Sources> _sources;
+    uint16_t _nextSourceId = 0;
+    unsigned int _generation = 0;
+
+    cache::LRUCache<Key, std::shared_ptr<const HeightTile>, KeyHasher> _tileCache;
+    std::unordered_map<
+        Key, std::shared_future<std::shared_ptr<const HeightTile>>, KeyHasher
+    > _tilesInFlight;
+    std::unordered_set<Key, KeyHasher> _tilesQueued;
+    mutable std::mutex _mutex;
+
+    std::vector<FinishedRequest> _finishedRequests;
+    std::mutex _finishedRequestsMutex;
+
+    // The thread pool has to be the last member so that its worker threads are joined
+    // before any of the data they access is destroyed
+    ThreadPool _threadPool;
+};
+
+} // namespace openspace::globebrowsing
+
+#endif // __OPENSPACE_MODULE_GLOBEBROWSING___HEIGHTQUERYSERVICE___H__
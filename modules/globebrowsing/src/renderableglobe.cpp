@@ -99,8 +99,9 @@ namespace {
     constexpr int UnknownDesiredLevel = -1;
     constexpr int DefaultHeightTileResolution = 512;
 
-    const openspace::globebrowsing::GeodeticPatch Coverage =
-        openspace::globebrowsing::GeodeticPatch(0, 0, 90, 180);
+    // The accuracy of CPU height queries relative to the distance of the queried position
+    // from the reference ellipsoid
+    constexpr double HeightQueryRelativeAccuracy = 0.01;
 
     const openspace::globebrowsing::TileIndex LeftHemisphereIndex =
         openspace::globebrowsing::TileIndex(0, 0, 1);
@@ -325,30 +326,22 @@ bool isLeaf(const Chunk& cn) {
     return cn.children[0] == nullptr;
 }
 
-const Chunk& findChunkNode(const Chunk& node, const Geodetic2& location) {
-    const Chunk* n = &node;
-
-    while (!isLeaf(*n)) {
-        const Geodetic2 center = n->surfacePatch.center();
-        int index = 0;
-        if (center.lon < location.lon) {
-            ++index;
-        }
-        if (location.lat < center.lat) {
-            ++index;
-            ++index;
-        }
-        n = n->children[static_cast<Quad>(index)];
-    }
-    return *n;
-}
-
 #if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
 using ChunkTileVector = std::vector<std::pair<ChunkTile, const LayerRenderSettings*>>;
+using ChunkList = std::vector<const Chunk*>;
 #else
 using ChunkTileVector =
     std::pmr::vector<std::pair<ChunkTile, const LayerRenderSettings*>>;
+using ChunkList = std::pmr::vector<const Chunk*>;
+#endif
+
+ChunkList temporaryChunkList() {
+#if defined(__APPLE__) || (defined(__linux__) && defined(__clang__))
+    return ChunkList();
+#else
+    return ChunkList(&global::memoryManager->TemporaryMemory);
 #endif
+}
 
 ChunkTileVector tilesAndSettingsUnsorted(const LayerGroup& layerGroup,
                                          const TileIndex& tileIndex)
@@ -598,6 +591,8 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     // For globes, the interaction sphere is always the same as the bounding sphere
     setInteractionSphere(boundingSphere());
 
+    _heightQueryService = std::make_unique<HeightQueryService>(_ellipsoid);
+
     _generalProperties.performShading =
         p.performShading.value_or(_generalProperties.performShading);
 
@@ -678,10 +673,6 @@ RenderableGlobe::RenderableGlobe(const ghoul::Dictionary& dictionary)
     addPropertySubOwner(_debugPropertyOwner);
     addPropertySubOwner(_layerManager);
 
-    _globalChunkBuffer.resize(2048);
-    _localChunkBuffer.resize(2048);
-    _traversalMemory.resize(512);
-
     _labelsDictionary = p.labels.value_or(_labelsDictionary);
 
     // Init geojson manager
@@ -953,6 +944,9 @@ void RenderableGlobe::update(const UpdateData& data) {
     //                           // LayerManager hasn't updated yet :o
     _layerManagerDirty = true;
 
+    _heightQueryService->updateSources(_layerManager);
+    _heightQueryService->update();
+
     _geoJsonManager.update();
 }
 
@@ -976,6 +970,10 @@ GeoJsonManager& RenderableGlobe::geoJsonManager() {
     return _geoJsonManager;
 }
 
+HeightQueryService& RenderableGlobe::heightQueryService() const {
+    return *_heightQueryService;
+}
+
 const Ellipsoid& RenderableGlobe::ellipsoid() const {
     return _ellipsoid;
 }
@@ -1213,74 +1211,59 @@ void RenderableGlobe::renderChunks(const RenderData& data, RendererTasks&,
         _globalRenderer.program->setIgnoreUniformLocationError(IgnoreError::Yes);
     }
 
-    int globalCount = 0;
-    int localCount = 0;
+    // The chunk lists only live for this frame, so they are allocated from the temporary
+    // memory instead of being kept around between frames
+    ChunkList globalChunks = temporaryChunkList();
+    ChunkList localChunks = temporaryChunkList();
+    ChunkList traversalQueue = temporaryChunkList();
 
-    auto traversal = [](const Chunk& node, std::vector<const Chunk*>& global,
-        int& iGlobal, std::vector<const Chunk*>& local, int& iLocal, int cutoff,
-        std::vector<const Chunk*>& traversalMemory)
+    auto traversal = [&traversalQueue](const Chunk& node, ChunkList& global,
+                                       ChunkList& local, int cutoff)
     {
         ZoneScopedN("traversal");
 
-        traversalMemory.clear();
-
-        // Loop through nodes in breadths first order
-        traversalMemory.push_back(&node);
-        while (!traversalMemory.empty()) {
-            const Chunk* n = traversalMemory.front();
-            traversalMemory.erase(traversalMemory.begin());
-
-            if (isLeaf(*n) && n->isVisible) {
-                if (n->tileIndex.level < cutoff) {
-                    global[iGlobal] = n;
-                    ++iGlobal;
-                }
-                else {
-                    local[iLocal] = n;
-                    ++iLocal;
+        // Loop through nodes in breadths first order. The queue is only ever appended
+        // to, so the nodes are visited by advancing an index instead of popping them
+        traversalQueue.clear();
+        traversalQueue.push_back(&node);
+        for (size_t i = 0; i < traversalQueue.size(); ++i) {
+            const Chunk* n = traversalQueue[i];
+
+            if (isLeaf(*n)) {
+                if (n->isVisible) {
+                    if (n->tileIndex.level < cutoff) {
+                        global.push_back(n);
+                    }
+                    else {
+                        local.push_back(n);
+                    }
                 }
             }
-
-            // Add children to queue, if any
-            if (!isLeaf(*n)) {
-                for (int i = 0; i < 4; ++i) {
-                    traversalMemory.push_back(n->children[i]);
+            else {
+                // Add children to queue
+                for (int j = 0; j < 4; ++j) {
+                    traversalQueue.push_back(n->children[j]);
                 }
             }
         }
     };
 
-    traversal(
-        _leftRoot,
-        _globalChunkBuffer,
-        globalCount,
-        _localChunkBuffer,
-        localCount,
-        _debugProperties.modelSpaceRenderingCutoffLevel,
-        _traversalMemory
-    );
-    traversal(
-        _rightRoot,
-        _globalChunkBuffer,
-        globalCount,
-        _localChunkBuffer,
-        localCount,
-        _debugProperties.modelSpaceRenderingCutoffLevel,
-        _traversalMemory
-    );
+    const int cutoff = _debugProperties.modelSpaceRenderingCutoffLevel;
+    traversal(_leftRoot, globalChunks, localChunks, cutoff);
+    traversal(_rightRoot, globalChunks, localChunks, cutoff);
 
     // Render all chunks that want to be rendered globally
     _globalRenderer.program->activate();
-    for (int i = 0; i < globalCount; ++i) {
-        renderChunkGlobally(*_globalChunkBuffer[i], data, shadowData, renderGeomOnly);
+    for (const Chunk* chunk : globalChunks) {
+        renderChunkGlobally(*chunk, data, shadowData, renderGeomOnly);
     }
     _globalRenderer.program->deactivate();
 
 
     // Render all chunks that need to be rendered locally
     _localRenderer.program->activate();
-    for (int i = 0; i < localCount; ++i) {
-        renderChunkLocally(*_localChunkBuffer[i], data, shadowData, renderGeomOnly);
+    for (const Chunk* chunk : localChunks) {
+        renderChunkLocally(*chunk, data, shadowData, renderGeomOnly);
     }
     _localRenderer.program->deactivate();
 
@@ -1922,154 +1905,17 @@ int RenderableGlobe::desiredLevel(const Chunk& chunk, const RenderData& renderDa
 float RenderableGlobe::getHeight(const glm::dvec3& position) const {
     ZoneScoped;
 
-    float height = 0;
-
-    // Get the uv coordinates to sample from
     const Geodetic2 geodeticPosition = _ellipsoid.cartesianToGeodetic2(position);
-    const Chunk& node = geodeticPosition.lon < Coverage.center().lon ?
-        findChunkNode(_leftRoot, geodeticPosition) :
-        findChunkNode(_rightRoot, geodeticPosition);
-    const int chunkLevel = node.tileIndex.level;
-
-
-    const int numIndicesAtLevel = 1 << chunkLevel;
-    const double u = 0.5 + geodeticPosition.lon / glm::two_pi<double>();
-    const double v = 0.25 - geodeticPosition.lat / glm::two_pi<double>();
-    const double xIndexSpace = u * numIndicesAtLevel;
-    const double yIndexSpace = v * numIndicesAtLevel;
-
-    const int x = static_cast<int>(floor(xIndexSpace));
-    const int y = static_cast<int>(floor(yIndexSpace));
 
-    ghoul_assert(chunkLevel < std::numeric_limits<uint8_t>::max(), "Too high level");
-    const TileIndex tileIndex(x, y, static_cast<uint8_t>(chunkLevel));
-    const GeodeticPatch patch = GeodeticPatch(tileIndex);
+    // The required accuracy of the height depends on how far away from the surface the
+    // position is. Positions that are further away don't need to trigger the loading
+    // of high resolution tiles
+    const glm::dvec3 surface = _ellipsoid.geodeticSurfaceProjection(position);
+    const double altitude = glm::length(position - surface);
+    const double accuracy = std::max(altitude * HeightQueryRelativeAccuracy, 1.0);
+    const int level = _heightQueryService->levelForAccuracy(accuracy);
 
-    const Geodetic2 northEast = patch.corner(Quad::NORTH_EAST);
-    const Geodetic2 southWest = patch.corner(Quad::SOUTH_WEST);
-
-    const Geodetic2 geoDiffPatch = {
-        .lat = northEast.lat - southWest.lat,
-        .lon = northEast.lon - southWest.lon
-    };
-
-    const Geodetic2 geoDiffPoint = {
-        .lat = geodeticPosition.lat - southWest.lat,
-        .lon = geodeticPosition.lon - southWest.lon
-    };
-    const glm::vec2 patchUV = glm::vec2(
-        geoDiffPoint.lon / geoDiffPatch.lon,
-        geoDiffPoint.lat / geoDiffPatch.lat
-    );
-
-    // Get the tile providers for the height maps
-    const std::vector<Layer*>& heightMapLayers =
-        _layerManager.layerGroup(layers::Group::ID::HeightLayers).activeLayers();
-
-    for (Layer* layer : heightMapLayers) {
-        TileProvider* tileProvider = layer->tileProvider();
-        if (!tileProvider) {
-            continue;
-        }
-        // Transform the uv coordinates to the current tile texture
-        const ChunkTile chunkTile = tileProvider->chunkTile(tileIndex);
-        const Tile& tile = chunkTile.tile;
-        const TileUvTransform& uvTransform = chunkTile.uvTransform;
-        const TileDepthTransform& depthTransform = tileProvider->depthTransform();
-        if (tile.status != Tile::Status::OK) {
-            return 0;
-        }
-
-        ghoul::opengl::Texture* tileTexture = tile.texture;
-        if (!tileTexture) {
-            return 0;
-        }
-
-        glm::vec2 transformedUv = layer->tileUvToTextureSamplePosition(
-            uvTransform,
-            patchUV,
-            glm::uvec2(tileTexture->dimensions())
-        );
-
-        // Sample and do linear interpolation
-        // (could possibly be moved as a function in ghoul texture)
-        // Suggestion: a function in ghoul::opengl::Texture that takes uv coordinates
-        // in range [0,1] and uses the set interpolation method and clamping.
-
-        const glm::uvec3 dimensions = tileTexture->dimensions();
-
-        glm::vec2 samplePos = transformedUv * glm::vec2(dimensions);
-        // @TODO (emmbr, 2023-06-14) This 0.5f offset was added as a bandaid for issue
-        // #2696. It seems to improve the behavior, but I am not certain of why. And the
-        // underlying problem is still there and should at some point be looked at again
-        samplePos -= glm::vec2(0.5f);
-
-        glm::uvec2 samplePos00 = samplePos;
-        samplePos00 = glm::clamp(
-            samplePos00,
-            glm::uvec2(0, 0),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-        const glm::vec2 samplePosFract = samplePos - glm::vec2(samplePos00);
-
-        const glm::uvec2 samplePos10 = glm::min(
-            samplePos00 + glm::uvec2(1, 0),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-        const glm::uvec2 samplePos01 = glm::min(
-            samplePos00 + glm::uvec2(0, 1),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-        const glm::uvec2 samplePos11 = glm::min(
-            samplePos00 + glm::uvec2(1, 1),
-            glm::uvec2(dimensions) - glm::uvec2(1)
-        );
-
-        const float sample00 = tileTexture->texelAsFloat(samplePos00).x;
-        const float sample10 = tileTexture->texelAsFloat(samplePos10).x;
-        const float sample01 = tileTexture->texelAsFloat(samplePos01).x;
-        const float sample11 = tileTexture->texelAsFloat(samplePos11).x;
-
-        // In case the texture has NaN or no data values don't use this height map.
-        const bool anySampleIsNaN =
-            std::isnan(sample00) ||
-            std::isnan(sample01) ||
-            std::isnan(sample10) ||
-            std::isnan(sample11);
-
-        const bool anySampleIsNoData =
-            sample00 == tileProvider->noDataValueAsFloat() ||
-            sample01 == tileProvider->noDataValueAsFloat() ||
-            sample10 == tileProvider->noDataValueAsFloat() ||
-            sample11 == tileProvider->noDataValueAsFloat();
-
-        if (anySampleIsNaN || anySampleIsNoData) {
-            continue;
-        }
-
-        const float sample0 = sample00 * (1.f - samplePosFract.x) +
-            sample10 * samplePosFract.x;
-        const float sample1 = sample01 * (1.f - samplePosFract.x) +
-            sample11 * samplePosFract.x;
-
-        const float sample = sample0 * (1.f - samplePosFract.y) +
-            sample1 * samplePosFract.y;
-
-        // Same as is used in the shader. This is not a perfect solution but
-        // if the sample is actually a no-data-value (min_float) the interpolated
-        // value might not be. Therefore we have a cut-off. Assuming no data value
-        // is smaller than -100000
-        if (sample > -100000) {
-            // Perform depth transform to get the value in meters
-            height = depthTransform.offset + depthTransform.scale * sample;
-            // Make sure that the height value follows the layer settings.
-            // For example if the multiplier is set to a value bigger than one,
-            // the sampled height should be modified as well.
-            height = layer->renderSettings().performLayerSettings(height);
-        }
-    }
-    // Return the result
-    return height;
+    return _heightQueryService->heights({ geodeticPosition }, level).front();
 }
 
 void RenderableGlobe::calculateEclipseShadows(ghoul::opengl::ProgramObject& programObject,
@@ -32,6 +32,7 @@
 #include <modules/globebrowsing/src/geojson/geojsonmanager.h>
 #include <modules/globebrowsing/src/globelabelscomponent.h>
 #include <modules/globebrowsing/src/gpulayergroup.h>
+#include <modules/globebrowsing/src/heightqueryservice.h>
 #include <modules/globebrowsing/src/layermanager.h>
 #include <modules/globebrowsing/src/ringscomponent.h>
 #include <modules/globebrowsing/src/shadowcomponent.h>
@@ -119,6 +120,13 @@ public:
     const GeoJsonManager& geoJsonManager() const;
     GeoJsonManager& geoJsonManager();
 
+    /**
+     * Returns the service that can be used to query the height map of this globe on the
+     * CPU, independently of the chunks that are currently rendered. The service is
+     * thread-safe, which is why it is also accessible through a const globe.
+     */
+    HeightQueryService& heightQueryService() const;
+
     const glm::dmat4& modelTransform() const;
 
     static documentation::Documentation Documentation();
@@ -181,7 +189,11 @@ private:
      * Calculates the height from the surface of the reference ellipsoid to the height
      * mapped surface.
      *
-     * The height can be negative if the height map contains negative values.
+     * The height can be negative if the height map contains negative values. The height
+     * map is sampled through the HeightQueryService with an accuracy that depends on the
+     * distance between the `position` and the surface. While the height data for the
+     * `position` has not been cached yet, the tiles that are used for rendering are
+     * sampled instead.
      *
      * \param `position` is the position of a point that gets geodetically projected on
      *        the reference ellipsoid. `position` must be in Cartesian model space
@@ -255,6 +267,9 @@ private:
     SkirtedGrid _grid;
     LayerManager _layerManager;
 
+    // Has to be declared before the GeoJsonManager, as the GeoJson components might
+    // query heights from their worker threads until they are destroyed
+    std::unique_ptr<HeightQueryService> _heightQueryService;
     GeoJsonManager _geoJsonManager;
 
     glm::dmat4 _cachedModelTransform = glm::dmat4(1.0);
@@ -262,10 +277,6 @@ private:
 
     ghoul::ReusableTypedMemoryPool<Chunk, 256> _chunkPool;
 
-    std::vector<const Chunk*> _globalChunkBuffer;
-    std::vector<const Chunk*> _localChunkBuffer;
-    std::vector<const Chunk*> _traversalMemory;
-
 
     Chunk _leftRoot;  // Covers all negative longitudes
     Chunk _rightRoot; // Covers all positive longitudes
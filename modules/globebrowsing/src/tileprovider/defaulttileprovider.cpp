@@ -301,4 +301,9 @@ float DefaultTileProvider::noDataValueAsFloat() {
     return _asyncTextureDataProvider->noDataValueAsFloat();
 }
 
+std::shared_ptr<RawTileDataReader> DefaultTileProvider::rawTileDataReader() {
+    ghoul_assert(_asyncTextureDataProvider, "No data provider");
+    return _asyncTextureDataProvider->sharedRawTileDataReader();
+}
+
 } // namespace openspace::globebrowsing
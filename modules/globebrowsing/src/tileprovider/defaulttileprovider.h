@@ -44,6 +44,7 @@ public:
     int minLevel() override final;
     int maxLevel() override final;
     float noDataValueAsFloat() override final;
+    std::shared_ptr<RawTileDataReader> rawTileDataReader() override final;
 
     static documentation::Documentation Documentation();
 
@@ -194,6 +194,10 @@ ChunkTile TileProvider::traverseTree(TileIndex tileIndex, int parents, int maxPa
 void TileProvider::internalInitialize() {}
 void TileProvider::internalDeinitialize() {}
 
+std::shared_ptr<RawTileDataReader> TileProvider::rawTileDataReader() {
+    return nullptr;
+}
+
 ChunkTile TileProvider::chunkTile(TileIndex tileIndex, int parents, int maxParents) {
     ZoneScoped;
 
@@ -52,6 +52,7 @@ namespace openspace::globebrowsing {
     class AsyncTileDataProvider;
     struct RawTile;
     struct TileIndex;
+    class RawTileDataReader;
     namespace cache { class MemoryAwareTileCache; }
 } // namespace openspace::globebrowsing
 
@@ -131,6 +132,13 @@ struct TileProvider : public properties::PropertyOwner {
      */
     virtual float noDataValueAsFloat() = 0;
 
+    /**
+     * \return The reader that provides the raw data for this TileProvider, if there is a
+     *         single one. This is used to access the data on the CPU independently of
+     *         the rendering. The default implementation returns `nullptr`
+     */
+    virtual std::shared_ptr<RawTileDataReader> rawTileDataReader();
+
 
     virtual ChunkTile chunkTile(TileIndex tileIndex, int parents = 0,
         int maxParents = 1337);
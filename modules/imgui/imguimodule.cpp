@@ -37,6 +37,7 @@
 #include <openspace/rendering/renderengine.h>
 #include <openspace/scene/scene.h>
 #include <openspace/scripting/scriptengine.h>
+#include <openspace/util/memorymanager.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/opengl/textureunit.h>
@@ -265,7 +266,8 @@ void ImGUIModule::internalInitialize(const ghoul::Dictionary&) {
         global::renderEngine,
         global::parallelPeer,
         global::luaConsole,
-        global::dashboard
+        global::dashboard,
+        global::memoryManager
     });
 }
 
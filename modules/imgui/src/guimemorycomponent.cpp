@@ -68,8 +68,14 @@ void GuiMemoryComponent::render() {
     ImGui::Text("%s", "Persistent Memory Pool");
     renderMemoryPoolInformation(global::memoryManager->PersistentMemory);
 
-    //ImGui::Text("%s", "Temporary Memory Pool");
-    //renderMemoryPoolInformation(global::memoryManager.TemporaryMemory);
+    const FrameArena& temporary = global::memoryManager->TemporaryMemory;
+    const FrameArena::FrameStatistics frame = temporary.lastFrame();
+    ImGui::Text("%s", "Temporary Memory");
+    ImGui::Text("  Last Frame: %.2f kiB", frame.usedBytes / 1024.f);
+    ImGui::Text("  Overflow: %.2f kiB", frame.overflowBytes / 1024.f);
+    ImGui::Text("  Heap Allocations: %i", frame.nHeapAllocations);
+    ImGui::Text("  High-Water Mark: %.2f kiB", temporary.highWaterMark() / 1024.f);
+    ImGui::Text("  Capacity: %.2f kiB", temporary.capacity() / 1024.f);
     ImGui::End();
 }
 
@@ -28,6 +28,8 @@
 #include <algorithm>
 #include <fstream>
 #include <numeric>
+#include <span>
+#include <thread>
 
 namespace openspace {
 
@@ -248,38 +250,45 @@ void DataProcessor::add(const std::vector<std::vector<float>>& optionValues,
                 numBins
             );
 
+            // Carry the contents of the old histogram over into the new one
+            std::vector<float> binValues(numBins);
             for (int j = 0; j < numBins; ++j) {
-                float value = unnormalizeWithStandardScore(
-                    j * (histMax - histMin) + histMin,
+                const float value = unnormalizeWithStandardScore(
+                    j * (histMax - histMin) / numBins + histMin,
                     oldMean,
                     oldStandardDeviation,
                     _histNormValues
                 );
-                _histograms[i]->add(
-                    normalizeWithStandardScore(
-                        value,
-                        mean,
-                        _standardDeviation[i],
-                        _histNormValues
-                    ),
-                    histData[j]
+                binValues[j] = normalizeWithStandardScore(
+                    value,
+                    mean,
+                    _standardDeviation[i],
+                    _histNormValues
                 );
             }
+            newHist->add(binValues, std::span<const float>(histData, numBins));
             // _histograms[i]->changeRange(min, max);
             _histograms[i] = std::move(newHist);
         }
 
-        for (int j = 0; j < numValues; ++j) {
-            _histograms[i]->add(
-                normalizeWithStandardScore(
-                    values[j],
+        std::vector<float> normalizedValues(numValues);
+        std::transform(
+            values.begin(),
+            values.end(),
+            normalizedValues.begin(),
+            [&](float v) {
+                return normalizeWithStandardScore(
+                    v,
                     mean,
                     _standardDeviation[i],
                     _histNormValues
-                ),
-                1
-            );
-        }
+                );
+            }
+        );
+        _histograms[i]->addParallel(
+            normalizedValues,
+            std::thread::hardware_concurrency()
+        );
 
         _histograms[i]->generateEqualizer();
     }
@@ -104,6 +104,24 @@ std::string KameleonVolumeToRawTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> KameleonVolumeToRawTask::inputs() const {
+    return { _inputPath };
+}
+
+std::vector<std::filesystem::path> KameleonVolumeToRawTask::outputs() const {
+    return { _rawVolumeOutputPath, _dictionaryOutputPath };
+}
+
+size_t KameleonVolumeToRawTask::memoryEstimate() const {
+    return static_cast<size_t>(_dimensions.x) * _dimensions.y * _dimensions.z *
+        sizeof(float);
+}
+
+bool KameleonVolumeToRawTask::canRunConcurrently() const {
+    // Neither Kameleon nor the CDF library it uses to read the files are thread-safe
+    return false;
+}
+
 void KameleonVolumeToRawTask::perform(const Task::ProgressCallback& progressCallback) {
     KameleonVolumeReader reader(_inputPath.string());
 
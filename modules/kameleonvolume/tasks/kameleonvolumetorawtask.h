@@ -38,6 +38,10 @@ public:
     KameleonVolumeToRawTask(const ghoul::Dictionary& dictionary);
 
     std::string description() override;
+    std::vector<std::filesystem::path> inputs() const override;
+    std::vector<std::filesystem::path> outputs() const override;
+    size_t memoryEstimate() const override;
+    bool canRunConcurrently() const override;
     void perform(const Task::ProgressCallback& progressCallback) override;
 
     static documentation::Documentation documentation();
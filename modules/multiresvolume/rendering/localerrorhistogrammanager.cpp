@@ -170,6 +170,13 @@ bool LocalErrorHistogramManager::buildFromOctreeChild(unsigned int bstOffset,
             octreeChildIndex / 4
         ) * (brickDim / 2.f);
 
+        const size_t nVoxels = static_cast<size_t>(brickDim) * brickDim * brickDim;
+        std::vector<float> childSamples;
+        childSamples.reserve(nVoxels);
+        std::vector<float> parentSamples;
+        parentSamples.reserve(nVoxels);
+        std::vector<float> rectangleHeights;
+        rectangleHeights.reserve(nVoxels);
         for (int z = 0; z < brickDim; z++) {
             for (int y = 0; y < brickDim; y++) {
                 for (int x = 0; x < brickDim; x++) {
@@ -180,16 +187,18 @@ bool LocalErrorHistogramManager::buildFromOctreeChild(unsigned int bstOffset,
                     float childValue = childValues[linearCoords(childSamplePoint)];
                     float parentValue = interpolate(parentSamplePoint, parentValues);
 
+                    childSamples.push_back(childValue);
+                    parentSamples.push_back(parentValue);
                     // Divide by number of child voxels that will be taken into account
-                    float rectangleHeight = std::abs(childValue - parentValue) / 8.f;
-                    _spatialHistograms[parentInnerNodeIndex].addRectangle(
-                        childValue,
-                        parentValue,
-                        rectangleHeight
-                    );
+                    rectangleHeights.push_back(std::abs(childValue - parentValue) / 8.f);
                 }
             }
         }
+        _spatialHistograms[parentInnerNodeIndex].addRectangles(
+            childSamples,
+            parentSamples,
+            rectangleHeights
+        );
 
         const bool isLastOctreeChild = octreeOffset > 0 && octreeChildIndex == 7;
         if (isLastOctreeChild) {
@@ -265,6 +274,13 @@ bool LocalErrorHistogramManager::buildFromBstChild(unsigned int bstOffset,
         const int brickDim = static_cast<int>(_tsp->brickDim());
         const unsigned int padding = (paddedBrickDim - brickDim) / 2;
 
+        const size_t nVoxels = static_cast<size_t>(brickDim) * brickDim * brickDim;
+        std::vector<float> childSamples;
+        childSamples.reserve(nVoxels);
+        std::vector<float> parentSamples;
+        parentSamples.reserve(nVoxels);
+        std::vector<float> rectangleHeights;
+        rectangleHeights.reserve(nVoxels);
         for (int z = 0; z < brickDim; z++) {
             for (int y = 0; y < brickDim; y++) {
                 for (int x = 0; x < brickDim; x++) {
@@ -273,16 +289,18 @@ bool LocalErrorHistogramManager::buildFromBstChild(unsigned int bstOffset,
                     float childValue = childValues[linearSamplePoint];
                     float parentValue = parentValues[linearSamplePoint];
 
+                    childSamples.push_back(childValue);
+                    parentSamples.push_back(parentValue);
                     // Divide by number of child voxels that will be taken into account
-                    float rectangleHeight = std::abs(childValue - parentValue) / 2.f;
-                    _temporalHistograms[parentInnerNodeIndex].addRectangle(
-                        childValue,
-                        parentValue,
-                        rectangleHeight
-                    );
+                    rectangleHeights.push_back(std::abs(childValue - parentValue) / 2.f);
                 }
             }
         }
+        _temporalHistograms[parentInnerNodeIndex].addRectangles(
+            childSamples,
+            parentSamples,
+            rectangleHeights
+        );
 
         const bool isLastBstChild = bstOffset > 0 && bstChildIndex == 0;
         if (isLastBstChild) {
@@ -25,9 +25,15 @@
 #ifndef __OPENSPACE_MODULE_SKYBROWSER___WWTDATAHANDLER___H__
 #define __OPENSPACE_MODULE_SKYBROWSER___WWTDATAHANDLER___H__
 
+#include <ghoul/glm.h>
+#include <cstdint>
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace tinyxml2 { class XMLElement; }
 
@@ -56,11 +62,40 @@ public:
     std::optional<const ImageData> image(const std::string& imageUrl) const;
     const std::map<std::string, ImageData>& images() const;
 
+    /**
+     * Returns the images whose name starts with \p prefix, sorted by their name.
+     */
+    std::vector<const ImageData*> imagesWithNamePrefix(std::string_view prefix) const;
+
+    /**
+     * Returns the images with celestial coordinates whose center is at most \p radius
+     * degrees away from the equatorial Cartesian \p direction, sorted by their distance
+     * to it.
+     */
+    std::vector<const ImageData*> imagesNear(const glm::dvec3& direction,
+        double radius) const;
+
 private:
     void saveImagesFromXml(const tinyxml2::XMLElement* root, std::string collection);
 
+    bool loadCachedImages(const std::filesystem::path& file, uint64_t stamp);
+    void saveCachedImages(const std::filesystem::path& file, uint64_t stamp) const;
+
+    void buildIndices();
+
     // Images
     std::map<std::string, ImageData> _images;
+
+    // The images sorted by name, which is the order of their identifiers
+    std::vector<const ImageData*> _sortedImages;
+
+    // The images with celestial coordinates sorted into the cells of a grid over the
+    // sky. The grid consists of declination bands of equal height that are divided into
+    // a number of right ascension cells that is proportional to their circumference. The
+    // images of a cell are stored consecutively in _cellImages
+    std::vector<int> _bandFirstCell;
+    std::vector<int> _cellOffsets;
+    std::vector<const ImageData*> _cellImages;
 };
 } // namespace openspace
 
@@ -534,6 +534,8 @@ scripting::LuaLibrary SkyBrowserModule::luaLibrary() const {
             codegen::lua::SendOutIdsToBrowsers,
             codegen::lua::ListOfImages,
             codegen::lua::ListOfImagesDeprecated,
+            codegen::lua::ListOfImagesNear,
+            codegen::lua::ListOfImagesWithName,
             codegen::lua::SetHoverCircle,
             codegen::lua::MoveCircleToHoverImage,
             codegen::lua::DisableHoverCircle,
@@ -400,6 +400,43 @@ ghoul::Dictionary wwtImageCollectionUrlDeprecated()
     return listOfImages();
 }
 
+/**
+ * Returns the identifiers of the loaded AAS WorldWide Telescope images with celestial
+ * coordinates whose center is at most 'radius' degrees away from the equatorial
+ * coordinates 'ra' and 'dec' (in degrees). The images are sorted by their distance.
+ */
+[[codegen::luawrap]] std::vector<std::string> listOfImagesNear(double ra, double dec,
+                                                              double radius)
+{
+    using namespace openspace;
+
+    SkyBrowserModule* module = global::moduleEngine->module<SkyBrowserModule>();
+    const glm::dvec3 direction = skybrowser::sphericalToCartesian(glm::dvec2(ra, dec));
+
+    std::vector<std::string> res;
+    for (const ImageData* image : module->wwtDataHandler().imagesNear(direction, radius))
+    {
+        res.push_back(image->identifier);
+    }
+    return res;
+}
+
+/**
+ * Returns the identifiers of the loaded AAS WorldWide Telescope images whose name starts
+ * with the provided prefix. The images are sorted by their name.
+ */
+[[codegen::luawrap]] std::vector<std::string> listOfImagesWithName(std::string prefix) {
+    using namespace openspace;
+
+    SkyBrowserModule* module = global::moduleEngine->module<SkyBrowserModule>();
+
+    std::vector<std::string> res;
+    for (const ImageData* image : module->wwtDataHandler().imagesWithNamePrefix(prefix)) {
+        res.push_back(image->identifier);
+    }
+    return res;
+}
+
 /**
  * Returns a table of data regarding the current view and the sky browsers and targets.
  * returns a table of data regarding the current targets.
@@ -26,7 +26,11 @@
 
 #include <modules/skybrowser/include/utility.h>
 #include <openspace/util/httprequest.h>
+#include <ghoul/filesystem/cachemanager.h>
+#include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <fstream>
 #include <string_view>
 #include <tinyxml2.h>
 
@@ -49,6 +53,73 @@ namespace {
     constexpr std::string_view DataSetType = "DataSetType";
     constexpr std::string_view Sky = "Sky";
 
+    constexpr int8_t CurrentCacheVersion = 1;
+
+    // The height of the declination bands of the sky grid in degrees
+    constexpr double SkyCellSize = 2.0;
+    constexpr int NSkyBands = static_cast<int>(180.0 / SkyCellSize);
+
+    int skyBand(double dec) {
+        const int band = static_cast<int>(std::floor((dec + 90.0) / SkyCellSize));
+        return std::clamp(band, 0, NSkyBands - 1);
+    }
+
+    int nSkyCells(int band) {
+        const double dec = -90.0 + (band + 0.5) * SkyCellSize;
+        const double circumference = 360.0 * std::cos(glm::radians(dec));
+        return std::max(static_cast<int>(std::ceil(circumference / SkyCellSize)), 1);
+    }
+
+    int skyCell(double ra, int nCells) {
+        const int cell = static_cast<int>(std::floor(ra / 360.0 * nCells));
+        return std::clamp(cell, 0, nCells - 1);
+    }
+
+    uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Computes a stamp from the paths, sizes, and modification times of the files
+    uint64_t contentStamp(std::vector<std::filesystem::path> files) {
+        std::sort(files.begin(), files.end());
+
+        uint64_t hash = 14695981039346656037ULL;
+        for (const std::filesystem::path& file : files) {
+            const std::string path = file.string();
+            hash = fnv1a(hash, path.data(), path.size() + 1);
+
+            std::error_code ec;
+            const int64_t values[2] = {
+                static_cast<int64_t>(std::filesystem::file_size(file, ec)),
+                std::filesystem::last_write_time(file, ec).time_since_epoch().count()
+            };
+            hash = fnv1a(hash, values, sizeof(values));
+        }
+        return hash;
+    }
+
+    void writeString(std::ostream& stream, const std::string& s) {
+        const uint32_t size = static_cast<uint32_t>(s.size());
+        stream.write(reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+        stream.write(s.data(), size);
+    }
+
+    std::string readString(std::istream& stream) {
+        uint32_t size = 0;
+        stream.read(reinterpret_cast<char*>(&size), sizeof(uint32_t));
+        std::string s;
+        if (stream.good()) {
+            s.resize(size);
+            stream.read(s.data(), size);
+        }
+        return s;
+    }
+
     bool hasAttribute(const tinyxml2::XMLElement* element, std::string_view name) {
         std::string n = std::string(name);
         return element->FindAttribute(n.c_str());
@@ -305,11 +376,31 @@ void WwtDataHandler::loadImages(const std::string& root,
         std::ofstream(localHashFile) << remoteHash;
     }
 
-    // Finally, we can load the files that are now on disk
-    LINFO("Loading images from directory");
+    // Finally, we can load the files that are now on disk, unless they have already been
+    // parsed into the cache
+    std::vector<std::filesystem::path> files;
     for (const auto& entry : std::filesystem::directory_iterator(directory)) {
+        if (entry.is_regular_file()) {
+            files.push_back(entry.path());
+        }
+    }
+    const uint64_t stamp = contentStamp(files);
+    const std::filesystem::path cacheFile = FileSys.cacheManager()->cachedFilename(
+        directory / "images.cache",
+        "WwtDataHandler"
+    );
+    if (loadCachedImages(cacheFile, stamp)) {
+        buildIndices();
+        LINFO(fmt::format(
+            "Loaded {} WorldWide Telescope images from cache", _images.size()
+        ));
+        return;
+    }
+
+    LINFO("Loading images from directory");
+    for (const std::filesystem::path& file : files) {
         tinyxml2::XMLDocument document;
-        std::string path = entry.path().string();
+        std::string path = file.string();
         tinyxml2::XMLError successCode = document.LoadFile(path.c_str());
 
         if (successCode == tinyxml2::XMLError::XML_SUCCESS) {
@@ -318,21 +409,13 @@ void WwtDataHandler::loadImages(const std::string& root,
             saveImagesFromXml(rootNode, collectionName);
         }
     }
-    // Sort images. Copy images to vector
-    std::vector<ImageData> _imageVector;
-    for (const auto& [id, img] : _images) {
-        _imageVector.push_back(img);
-    }
-    // Sort
-    std::sort(_imageVector.begin(), _imageVector.end(),
-        [](const ImageData& lhs, const ImageData& rhs) {
-            return lhs.name < rhs.name;
-        }
-    );
-    // Set the identifiers to the correct order
-    for (size_t i = 0; i < _imageVector.size(); i++) {
-        _images[_imageVector[i].imageUrl].identifier = std::to_string(i);
+
+    buildIndices();
+    // Set the identifiers to the order of the names
+    for (size_t i = 0; i < _sortedImages.size(); i++) {
+        _images[_sortedImages[i]->imageUrl].identifier = std::to_string(i);
     }
+    saveCachedImages(cacheFile, stamp);
 
     LINFO(fmt::format("Loaded {} WorldWide Telescope images", _images.size()));
 }
@@ -353,6 +436,93 @@ const std::map<std::string, ImageData>& WwtDataHandler::images() const {
     return _images;
 }
 
+std::vector<const ImageData*>
+WwtDataHandler::imagesWithNamePrefix(std::string_view prefix) const
+{
+    auto it = std::lower_bound(
+        _sortedImages.begin(),
+        _sortedImages.end(),
+        prefix,
+        [](const ImageData* image, std::string_view p) { return image->name < p; }
+    );
+
+    std::vector<const ImageData*> result;
+    while (it != _sortedImages.end() && (*it)->name.starts_with(prefix)) {
+        result.push_back(*it);
+        it++;
+    }
+    return result;
+}
+
+std::vector<const ImageData*> WwtDataHandler::imagesNear(const glm::dvec3& direction,
+                                                         double radius) const
+{
+    if (_cellOffsets.empty()) {
+        return std::vector<const ImageData*>();
+    }
+
+    const glm::dvec3 dir = glm::normalize(direction);
+    const glm::dvec2 center = skybrowser::cartesianToSpherical(dir);
+    const double minDot = std::cos(glm::radians(std::min(radius, 180.0)));
+
+    // The right ascension range that the circle covers. If the circle contains a pole,
+    // it covers all right ascensions
+    double raExtent = 180.0;
+    if (std::abs(center.y) + radius < 90.0) {
+        const double s = std::sin(glm::radians(radius)) /
+                         std::cos(glm::radians(center.y));
+        raExtent = glm::degrees(std::asin(std::min(s, 1.0)));
+    }
+
+    std::vector<std::pair<double, const ImageData*>> found;
+    auto visitCell = [&](int cell) {
+        for (int i = _cellOffsets[cell]; i < _cellOffsets[cell + 1]; i++) {
+            const double d = glm::dot(dir, _cellImages[i]->equatorialCartesian);
+            if (d >= minDot) {
+                found.emplace_back(d, _cellImages[i]);
+            }
+        }
+    };
+
+    const int firstBand = skyBand(center.y - radius);
+    const int lastBand = skyBand(center.y + radius);
+    for (int band = firstBand; band <= lastBand; band++) {
+        const int nCells = _bandFirstCell[band + 1] - _bandFirstCell[band];
+        const int first = static_cast<int>(
+            std::floor((center.x - raExtent) / 360.0 * nCells)
+        );
+        const int last = static_cast<int>(
+            std::floor((center.x + raExtent) / 360.0 * nCells)
+        );
+        if (raExtent >= 180.0 || last - first + 1 >= nCells) {
+            for (int cell = 0; cell < nCells; cell++) {
+                visitCell(_bandFirstCell[band] + cell);
+            }
+        }
+        else {
+            for (int cell = first; cell <= last; cell++) {
+                visitCell(_bandFirstCell[band] + (cell % nCells + nCells) % nCells);
+            }
+        }
+    }
+
+    std::sort(
+        found.begin(),
+        found.end(),
+        [](const std::pair<double, const ImageData*>& a,
+           const std::pair<double, const ImageData*>& b)
+        {
+            return a.first > b.first;
+        }
+    );
+    std::vector<const ImageData*> result;
+    result.reserve(found.size());
+    for (const std::pair<double, const ImageData*>& f : found) {
+        result.push_back(f.second);
+    }
+    return result;
+}
+
 void WwtDataHandler::saveImagesFromXml(const tinyxml2::XMLElement* root,
                                        std::string collection)
 {
@@ -383,4 +553,142 @@ void WwtDataHandler::saveImagesFromXml(const tinyxml2::XMLElement* root,
     }
 }
 
+bool WwtDataHandler::loadCachedImages(const std::filesystem::path& file, uint64_t stamp)
+{
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        return false;
+    }
+
+    int8_t version = 0;
+    stream.read(reinterpret_cast<char*>(&version), sizeof(int8_t));
+    uint64_t cachedStamp = 0;
+    stream.read(reinterpret_cast<char*>(&cachedStamp), sizeof(uint64_t));
+    if (!stream.good() || version != CurrentCacheVersion || cachedStamp != stamp) {
+        return false;
+    }
+
+    uint32_t nImages = 0;
+    stream.read(reinterpret_cast<char*>(&nImages), sizeof(uint32_t));
+
+    // The images are stored in the order of their identifiers
+    std::map<std::string, ImageData> images;
+    for (uint32_t i = 0; i < nImages && stream.good(); i++) {
+        ImageData image;
+        image.name = readString(stream);
+        image.thumbnailUrl = readString(stream);
+        image.imageUrl = readString(stream);
+        image.credits = readString(stream);
+        image.creditsUrl = readString(stream);
+        image.collection = readString(stream);
+        uint8_t hasCelestialCoords = 0;
+        stream.read(reinterpret_cast<char*>(&hasCelestialCoords), sizeof(uint8_t));
+        image.hasCelestialCoords = hasCelestialCoords != 0;
+        stream.read(reinterpret_cast<char*>(&image.fov), sizeof(float));
+        stream.read(
+            reinterpret_cast<char*>(&image.equatorialSpherical),
+            sizeof(glm::dvec2)
+        );
+        stream.read(
+            reinterpret_cast<char*>(&image.equatorialCartesian),
+            sizeof(glm::dvec3)
+        );
+        image.identifier = std::to_string(i);
+        std::string url = image.imageUrl;
+        images.emplace(std::move(url), std::move(image));
+    }
+
+    if (!stream.good()) {
+        LWARNING(fmt::format("Could not read image cache {}", file));
+        return false;
+    }
+
+    _images = std::move(images);
+    return true;
+}
+
+void WwtDataHandler::saveCachedImages(const std::filesystem::path& file,
+                                      uint64_t stamp) const
+{
+    std::ofstream stream(file, std::ofstream::binary);
+    if (!stream.good()) {
+        LERROR(fmt::format("Error opening file {} for saving image cache", file));
+        return;
+    }
+
+    stream.write(reinterpret_cast<const char*>(&CurrentCacheVersion), sizeof(int8_t));
+    stream.write(reinterpret_cast<const char*>(&stamp), sizeof(uint64_t));
+    const uint32_t nImages = static_cast<uint32_t>(_sortedImages.size());
+    stream.write(reinterpret_cast<const char*>(&nImages), sizeof(uint32_t));
+    for (const ImageData* image : _sortedImages) {
+        writeString(stream, image->name);
+        writeString(stream, image->thumbnailUrl);
+        writeString(stream, image->imageUrl);
+        writeString(stream, image->credits);
+        writeString(stream, image->creditsUrl);
+        writeString(stream, image->collection);
+        const uint8_t hasCelestialCoords = image->hasCelestialCoords ? 1 : 0;
+        stream.write(reinterpret_cast<const char*>(&hasCelestialCoords), sizeof(uint8_t));
+        stream.write(reinterpret_cast<const char*>(&image->fov), sizeof(float));
+        stream.write(
+            reinterpret_cast<const char*>(&image->equatorialSpherical),
+            sizeof(glm::dvec2)
+        );
+        stream.write(
+            reinterpret_cast<const char*>(&image->equatorialCartesian),
+            sizeof(glm::dvec3)
+        );
+    }
+
+    if (!stream.good()) {
+        LERROR(fmt::format("Error writing image cache {}", file));
+    }
+}
+
+void WwtDataHandler::buildIndices() {
+    _sortedImages.clear();
+    _sortedImages.reserve(_images.size());
+    for (const std::pair<const std::string, ImageData>& image : _images) {
+        _sortedImages.push_back(&image.second);
+    }
+    std::stable_sort(
+        _sortedImages.begin(),
+        _sortedImages.end(),
+        [](const ImageData* lhs, const ImageData* rhs) { return lhs->name < rhs->name; }
+    );
+
+    _bandFirstCell.resize(NSkyBands + 1);
+    _bandFirstCell[0] = 0;
+    for (int band = 0; band < NSkyBands; band++) {
+        _bandFirstCell[band + 1] = _bandFirstCell[band] + nSkyCells(band);
+    }
+
+    // Sort the images into their cells with a counting sort
+    auto cellOf = [this](const ImageData& image) {
+        const glm::dvec2 coords = skybrowser::cartesianToSpherical(
+            image.equatorialCartesian
+        );
+        const int band = skyBand(coords.y);
+        const int nCells = _bandFirstCell[band + 1] - _bandFirstCell[band];
+        return _bandFirstCell[band] + skyCell(coords.x, nCells);
+    };
+
+    _cellOffsets.assign(_bandFirstCell.back() + 1, 0);
+    for (const ImageData* image : _sortedImages) {
+        if (image->hasCelestialCoords) {
+            _cellOffsets[cellOf(*image) + 1]++;
+        }
+    }
+    for (size_t i = 1; i < _cellOffsets.size(); i++) {
+        _cellOffsets[i] += _cellOffsets[i - 1];
+    }
+    _cellImages.resize(_cellOffsets.back());
+    std::vector<int> next = _cellOffsets;
+    for (const ImageData* image : _sortedImages) {
+        if (image->hasCelestialCoords) {
+            _cellImages[next[cellOf(*image)]++] = image;
+        }
+    }
+}
+
 } // namespace openspace
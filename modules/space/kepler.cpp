@@ -24,6 +24,7 @@
 
 #include <modules/space/kepler.h>
 
+#include <openspace/util/ephemeristimeconverter.h>
 #include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
@@ -36,128 +37,8 @@
 
 namespace {
     constexpr std::string_view _loggerCat = "Kepler";
-    constexpr int8_t CurrentCacheVersion = 1;
-
-    // The list of leap years only goes until 2056 as we need to touch this file then
-    // again anyway ;)
-    constexpr const std::array<int, 36> LeapYears = {
-        1956, 1960, 1964, 1968, 1972, 1976, 1980, 1984, 1988, 1992, 1996,
-        2000, 2004, 2008, 2012, 2016, 2020, 2024, 2028, 2032, 2036, 2040,
-        2044, 2048, 2052, 2056
-    };
-    constexpr const std::array<int, 12> DaysOfMonths = {
-        31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
-    };
-
-    // Count the number of full days since the beginning of 2000 to the beginning of
-    // the parameter 'year'
-    int countDays(int year) {
-        // Find the position of the current year in the vector, the difference
-        // between its position and the position of 2000 (for J2000) gives the
-        // number of leap years
-        constexpr const int Epoch = 2000;
-        constexpr const int DaysRegularYear = 365;
-        constexpr const int DaysLeapYear = 366;
-
-        if (year == Epoch) {
-            return 0;
-        }
-
-        // Get the position of the most recent leap year
-        const auto lb = std::lower_bound(LeapYears.begin(), LeapYears.end(), year);
-
-        // Get the position of the epoch
-        const auto y2000 = std::find(LeapYears.begin(), LeapYears.end(), Epoch);
-
-        // The distance between the two iterators gives us the number of leap years
-        const int nLeapYears = static_cast<int>(std::abs(std::distance(y2000, lb)));
-
-        const int nYears = std::abs(year - Epoch);
-        const int nRegularYears = nYears - nLeapYears;
-
-        // Get the total number of days as the sum of leap years + non leap years
-        const int result = nRegularYears * DaysRegularYear + nLeapYears * DaysLeapYear;
-        return result;
-    }
-
-    // Returns the number of leap seconds that lie between the {year, dayOfYear}
-    // time point and { 2000, 1 }
-    int countLeapSeconds(int year, int dayOfYear) {
-        // Find the position of the current year in the vector; its position in the vector
-        // gives the number of leap seconds
-        struct LeapSecond {
-            int year;
-            int dayOfYear;
-            bool operator<(const LeapSecond& rhs) const {
-                return std::tie(year, dayOfYear) < std::tie(rhs.year, rhs.dayOfYear);
-            }
-        };
-
-        constexpr const LeapSecond LeapEpoch = { .year = 2000, .dayOfYear = 1 };
-
-        // List taken from: https://www.ietf.org/timezones/data/leap-seconds.list
-        constexpr const std::array<LeapSecond, 28> LeapSeconds = {
-            LeapSecond { .year = 1972, .dayOfYear =   1 },
-            LeapSecond { .year = 1972, .dayOfYear = 183 },
-            LeapSecond { .year = 1973, .dayOfYear =   1 },
-            LeapSecond { .year = 1974, .dayOfYear =   1 },
-            LeapSecond { .year = 1975, .dayOfYear =   1 },
-            LeapSecond { .year = 1976, .dayOfYear =   1 },
-            LeapSecond { .year = 1977, .dayOfYear =   1 },
-            LeapSecond { .year = 1978, .dayOfYear =   1 },
-            LeapSecond { .year = 1979, .dayOfYear =   1 },
-            LeapSecond { .year = 1980, .dayOfYear =   1 },
-            LeapSecond { .year = 1981, .dayOfYear = 182 },
-            LeapSecond { .year = 1982, .dayOfYear = 182 },
-            LeapSecond { .year = 1983, .dayOfYear = 182 },
-            LeapSecond { .year = 1985, .dayOfYear = 182 },
-            LeapSecond { .year = 1988, .dayOfYear =   1 },
-            LeapSecond { .year = 1990, .dayOfYear =   1 },
-            LeapSecond { .year = 1991, .dayOfYear =   1 },
-            LeapSecond { .year = 1992, .dayOfYear = 183 },
-            LeapSecond { .year = 1993, .dayOfYear = 182 },
-            LeapSecond { .year = 1994, .dayOfYear = 182 },
-            LeapSecond { .year = 1996, .dayOfYear =   1 },
-            LeapSecond { .year = 1997, .dayOfYear = 182 },
-            LeapSecond { .year = 1999, .dayOfYear =   1 },
-            LeapSecond { .year = 2006, .dayOfYear =   1 },
-            LeapSecond { .year = 2009, .dayOfYear =   1 },
-            LeapSecond { .year = 2012, .dayOfYear = 183 },
-            LeapSecond { .year = 2015, .dayOfYear = 182 },
-            LeapSecond { .year = 2017, .dayOfYear =   1 }
-        };
-        // Get the position of the last leap second before the desired date
-        LeapSecond date{ year, dayOfYear };
-        const auto it = std::lower_bound(LeapSeconds.begin(), LeapSeconds.end(), date);
-
-        // Get the position of the Epoch
-        const auto y2000 = std::lower_bound(
-            LeapSeconds.begin(),
-            LeapSeconds.end(),
-            LeapEpoch
-        );
-
-        // The distance between the two iterators gives us the number of leap years
-        const int nLeapSeconds = static_cast<int>(std::abs(std::distance(y2000, it)));
-        return nLeapSeconds;
-    }
-
-    int daysIntoGivenYear(int year, int month, int dayOfMonth) {
-        // month and dayCount are zero-based.
-        month -= 1;
-        int dayCount = dayOfMonth - 1;
-        constexpr int February = 1;
-        const bool isInLeapYear =
-            std::find(LeapYears.begin(), LeapYears.end(), year) != LeapYears.end();
-
-        for (int m = 0; m < month; ++m) {
-            dayCount += DaysOfMonths[m];
-            if (m == February && isInLeapYear) {
-                dayCount += 1;
-            }
-        }
-        return dayCount;
-    }
+    constexpr int8_t CurrentCacheVersion = 2;
+    constexpr double SecondsPerDay = 86400.0;
 
     double calculateSemiMajorAxis(double meanMotion) {
         constexpr const double GravitationalConstant = 6.6740831e-11;
@@ -190,21 +71,12 @@ namespace {
         // With YY being the last two years of the launch epoch, the first DDD the day of
         // the year and the remaning a fractional part of the day
 
-        // The main overview of this function:
-        // 1. Reconstruct the full year from the YY part
-        // 2. Calculate the number of days since the beginning of the year
-        // 3. Convert the number of days to a number of seconds
-        // 4. Get the number of leap seconds since January 1st, 2000 and remove them
-        // 5. Adjust for the fact the epoch starts on 1st Januaray at 12:00:00, not
-        // midnight
-
         // According to https://celestrak.com/columns/v04n03/
         // Apparently, US Space Command sees no need to change the two-line element set
         // format yet since no artificial earth satellites existed prior to 1957. By their
         // reasoning, two-digit years from 57-99 correspond to 1957-1999 and those from
         // 00-56 correspond to 2000-2056. We'll see each other again in 2057!
 
-        // 1,2. Get the full year and days
         std::string e = epoch;
         if (e.find('.') == std::string::npos) {
             e += ".0";
@@ -214,28 +86,14 @@ namespace {
             throw ghoul::RuntimeError(fmt::format("Error parsing epoch '{}'", epoch));
         }
         year += year > 57 ? 1900 : 2000;
-        const int daysSince2000 = countDays(year);
-
-        // 3
-        using namespace std::chrono;
-        const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
-        //Need to subtract 1 from daysInYear since it is not a zero-based count
-        const double nSecondsSince2000 = (daysSince2000 + daysInYear - 1) * SecondsPerDay;
-
-        // 4
-        // We need to remove additional leap seconds past 2000 and add them prior to
-        // 2000 to sync up the time zones
-        const double nLeapSecondsOffset = countLeapSeconds(
+
+        // The day of the year is one-based and the fraction is the part of that day
+        const double dayOfYear = std::floor(daysInYear);
+        return EphemerisTimeConverter::ref().ephemerisTimeFromUtc(
             year,
-            static_cast<int>(std::floor(daysInYear))
+            static_cast<int>(dayOfYear),
+            (daysInYear - dayOfYear) * SecondsPerDay
         );
-
-        // 5
-        const double nSecondsEpochOffset =
-            static_cast<double>(seconds(hours(12)).count());
-
-        // Combine all of the values
-        return nSecondsSince2000 - nLeapSecondsOffset - nSecondsEpochOffset;
     }
 
     double epochFromYMDdSubstring(const std::string& epoch) {
@@ -245,20 +103,11 @@ namespace {
         // With YYYY as the year, MM the month (1 - 12), DD the day of month (1-31),
         // and dddd the fraction of that day.
 
-        // The main overview of this function:
-        // 1. Read the year value
-        // 2. Calculate the number of days since the beginning of the year
-        // 3. Convert the number of days to a number of seconds
-        // 4. Get the number of leap seconds since January 1st, 2000 and remove them
-        // 5. Adjust for the fact the epoch starts on 1st January at 12:00:00, not
-        // midnight
-
         std::string e = epoch;
         if (e.find('.') == std::string::npos) {
             // No . was found so the epoch was provided as an integer number (see #2551)
             e += ".0";
         }
-        // 1, 2
         size_t nDashes = std::count_if(
             epoch.begin(),
             epoch.end(),
@@ -270,29 +119,12 @@ namespace {
         if (!res) {
             throw ghoul::RuntimeError(fmt::format("Error parsing epoch '{}'", epoch));
         }
-        const int daysSince2000 = countDays(year);
-        int wholeDaysInto = daysIntoGivenYear(year, monthNum, dayOfMonthNum);
-        double daysInYear = static_cast<double>(wholeDaysInto) + fractionOfDay;
-
-        // 3
-        using namespace std::chrono;
-        const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
-        //Need to subtract 1 from daysInYear since it is not a zero-based count
-        const double nSecondsSince2000 = (daysSince2000 + daysInYear - 1) * SecondsPerDay;
-
-        // 4
-        // We need to remove additional leap seconds past 2000 and add them prior to
-        // 2000 to sync up the time zones
-        const double nLeapSecondsOffset = -countLeapSeconds(
+        return EphemerisTimeConverter::ref().ephemerisTimeFromUtc(
             year,
-            static_cast<int>(std::floor(daysInYear))
+            monthNum,
+            dayOfMonthNum,
+            fractionOfDay * SecondsPerDay
         );
-
-        // 5
-        const double offset = static_cast<double>(seconds(hours(12)).count());
-
-        // Combine all of the values
-        return nSecondsSince2000 + nLeapSecondsOffset - offset;
     }
 
     double epochFromOmmString(const std::string& epoch) {
@@ -300,86 +132,13 @@ namespace {
         // YYYY-MM-DDThh:mm:ss[.d->d][Z]
         // or
         // YYYY-DDDThh:mm:ss[.d->d][Z]
-
-        // The main overview of this function:
-        // 0. Determine which type it is
-        // 1. Read the year value
-        // 2. Calculate the number of days since the beginning of the year
-        // 3. Convert the number of days to a number of seconds
-        // 4. Get the number of leap seconds since January 1st, 2000 and remove them
-        // 5. Add the hh:mm:ss component
-        // 6. Adjust for the fact the epoch starts on 1st January at 12:00:00, not
-        // midnight
-
-        std::string e = epoch;
-        if (e.back() == 'Z') {
-            e.pop_back();
-        }
-
-        struct {
-            int year;
-            int nDays;
-            int hours;
-            int minutes;
-            double seconds;
-        } date;
-
-        // 1, 2
-        const size_t pos = epoch.find('T');
-        if (pos == 10) {
-            // We have the first form
-            int month;
-            int days;
-            auto res = scn::scan(
-                epoch, "{:4}-{:2}-{:2}T{:2}:{:2}:{}",
-                date.year, month, days, date.hours, date.minutes, date.seconds
-            );
-            if (!res) {
-                throw ghoul::RuntimeError(fmt::format("Error parsing epoch '{}'", epoch));
-            }
-            date.nDays = daysIntoGivenYear(date.year, month, days);
-        }
-        else if (pos == 8) {
-            // We have the second form
-
-            auto res = scn::scan(
-                epoch, "{:4}-{:3}T{:2}:{:2}:{}",
-                date.year, date.nDays, date.hours, date.minutes, date.seconds
-            );
-            if (!res) {
-                throw ghoul::RuntimeError(fmt::format("Error parsing epoch '{}'", epoch));
-            }
-        }
-        else {
+        // both of which are understood by the EphemerisTimeConverter
+        const std::optional<double> et =
+            EphemerisTimeConverter::ref().ephemerisTimeFromDate(epoch);
+        if (!et.has_value()) {
             throw ghoul::RuntimeError(fmt::format("Malformed epoch string '{}'", epoch));
         }
-
-        const int daysSince2000 = countDays(date.year);
-
-        // 3
-        using namespace std::chrono;
-        const int SecondsPerDay = static_cast<int>(seconds(hours(24)).count());
-        const double nSecondsSince2000 = (daysSince2000 + date.nDays) * SecondsPerDay;
-
-        // 4
-        // We need to remove additional leap seconds past 2000 and add them prior to
-        // 2000 to sync up the time zones
-        const double nLeapSecondsOffset = -countLeapSeconds(
-            date.year,
-            static_cast<int>(std::floor(date.nDays))
-        );
-
-        // 5
-        const long long totalSeconds =
-            std::chrono::seconds(std::chrono::hours(date.hours)).count() +
-            std::chrono::seconds(std::chrono::minutes(date.minutes)).count();
-
-        // 6
-        const long long offset = std::chrono::seconds(std::chrono::hours(12)).count();
-
-        // Combine all of the values
-        return
-            nSecondsSince2000 + totalSeconds + nLeapSecondsOffset - offset + date.seconds;
+        return *et;
     }
 } // namespace
 
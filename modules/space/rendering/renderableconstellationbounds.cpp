@@ -131,6 +131,8 @@ void RenderableConstellationBounds::initialize() {
 }
 
 void RenderableConstellationBounds::initializeGL() {
+    RenderableConstellationsBase::initializeGL();
+
     _program = global::renderEngine->buildRenderProgram(
         "ConstellationBounds",
         absPath("${MODULE_SPACE}/shaders/constellationbounds_vs.glsl"),
@@ -166,6 +168,8 @@ void RenderableConstellationBounds::deinitializeGL() {
         global::renderEngine->removeRenderProgram(_program.get());
         _program = nullptr;
     }
+
+    RenderableConstellationsBase::deinitializeGL();
 }
 
 bool RenderableConstellationBounds::isReady() const {
@@ -215,6 +215,8 @@ void RenderableConstellationLines::initialize() {
 }
 
 void RenderableConstellationLines::initializeGL() {
+    RenderableConstellationsBase::initializeGL();
+
     _program = global::renderEngine->buildRenderProgram(
         "RenderableConstellationLines",
         absPath("${MODULE_SPACE}/shaders/constellationlines_vs.glsl"),
@@ -238,6 +240,8 @@ void RenderableConstellationLines::deinitializeGL() {
         global::renderEngine->removeRenderProgram(_program.get());
         _program = nullptr;
     }
+
+    RenderableConstellationsBase::deinitializeGL();
 }
 
 void RenderableConstellationLines::renderConstellations(const RenderData&,
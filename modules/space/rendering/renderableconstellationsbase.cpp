@@ -205,6 +205,18 @@ void RenderableConstellationsBase::initialize() {
     }
 }
 
+void RenderableConstellationsBase::initializeGL() {
+    if (_hasLabels) {
+        _labels->initializeGL();
+    }
+}
+
+void RenderableConstellationsBase::deinitializeGL() {
+    if (_hasLabels) {
+        _labels->deinitializeGL();
+    }
+}
+
 bool RenderableConstellationsBase::isReady() const {
     return _hasLabels ? _labels->isReady() : true;
 }
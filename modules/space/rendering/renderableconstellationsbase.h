@@ -52,8 +52,8 @@ public:
     virtual ~RenderableConstellationsBase() override = default;
 
     virtual void initialize() override;
-    virtual void initializeGL() override = 0;
-    virtual void deinitializeGL() override = 0;
+    virtual void initializeGL() override;
+    virtual void deinitializeGL() override;
 
     virtual bool isReady() const override;
 
@@ -0,0 +1,223 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+#include <modules/space/tasks/debrisdensity.h>
+
+#include <ghoul/misc/assert.h>
+#include <glm/gtx/transform.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    double eccentricAnomaly(double meanAnomaly, double e) {
+        // Same solvers as in KeplerTranslation::eccentricAnomaly, each used in the
+        // regime in which it is most efficient
+        auto solveIteration = [](const auto& function, double x0, int maxIter) {
+            double x2 = x0;
+            for (int i = 0; i < maxIter; i++) {
+                const double x = x2;
+                x2 = function(x);
+                if (x2 == x) {
+                    return x2;
+                }
+            }
+            return x2;
+        };
+
+        if (e == 0.0) {
+            return meanAnomaly;
+        }
+        else if (e < 0.2) {
+            auto solver = [&](double x) { return meanAnomaly + e * std::sin(x); };
+            return solveIteration(solver, meanAnomaly, 5);
+        }
+        else if (e < 0.9) {
+            auto solver = [&](double x) {
+                return x + (meanAnomaly + e * std::sin(x) - x) / (1.0 - e * std::cos(x));
+            };
+            return solveIteration(solver, meanAnomaly, 6);
+        }
+        else {
+            auto sign = [](double val) {
+                return val > 0.0 ? 1.0 : ((val < 0.0) ? -1.0 : 0.0);
+            };
+            auto solver = [&](double x) {
+                const double s = e * std::sin(x);
+                const double c = e * std::cos(x);
+                const double f = x - s - meanAnomaly;
+                const double f1 = 1 - c;
+                const double f2 = s;
+                return x + (-5 * f / (f1 + sign(f1) *
+                    std::sqrt(std::abs(16 * f1 * f1 - 20 * f * f2))));
+            };
+            const double x0 = meanAnomaly + 0.85 * e * sign(std::sin(meanAnomaly));
+            return solveIteration(solver, x0, 8);
+        }
+    }
+
+    // Maps the value `v` in [0, extent] to a cell index in [0, n)
+    unsigned int binIndex(double v, double extent, unsigned int n) {
+        const double i = std::floor(v / extent * n);
+        return static_cast<unsigned int>(std::clamp(i, 0.0, static_cast<double>(n - 1)));
+    }
+} // namespace
+
+namespace openspace {
+
+DebrisDensity::DebrisDensity(const std::vector<kepler::Parameters>& orbits,
+                             glm::uvec3 dimensions, volume::VolumeGridType gridType)
+    : _dimensions(dimensions)
+    , _gridType(gridType)
+{
+    ghoul_assert(glm::all(glm::greaterThan(dimensions, glm::uvec3(0))), "Empty grid");
+
+    const size_t n = orbits.size();
+    _rotation.reserve(n);
+    _semiMajorAxis.reserve(n);
+    _semiMinorAxis.reserve(n);
+    _eccentricity.reserve(n);
+    _meanAnomalyAtEpoch.reserve(n);
+    _meanMotion.reserve(n);
+    _epoch.reserve(n);
+
+    for (const kepler::Parameters& orbit : orbits) {
+        // Identical to the orbit plane computation in KeplerTranslation
+        const double asc = glm::radians(orbit.ascendingNode);
+        const double inc = glm::radians(orbit.inclination);
+        const double per = glm::radians(orbit.argumentOfPeriapsis);
+        const glm::dmat4 r =
+            glm::rotate(asc, glm::dvec3(0.0, 0.0, 1.0)) *
+            glm::rotate(inc, glm::dvec3(1.0, 0.0, 0.0)) *
+            glm::rotate(per, glm::dvec3(0.0, 0.0, 1.0));
+        _rotation.push_back(glm::dmat3(r));
+
+        // The semi-major axis in the parameters is provided in km
+        const double a = orbit.semiMajorAxis * 1000.0;
+        const double e = orbit.eccentricity;
+        _semiMajorAxis.push_back(a);
+        _semiMinorAxis.push_back(a * std::sqrt(1.0 - e * e));
+        _eccentricity.push_back(e);
+        _meanAnomalyAtEpoch.push_back(glm::radians(orbit.meanAnomaly));
+        _meanMotion.push_back(glm::two_pi<double>() / orbit.period);
+        _epoch.push_back(orbit.epoch);
+
+        _maxApogee = std::max(_maxApogee, a * (1.0 + e));
+    }
+
+    if (_gridType == volume::VolumeGridType::Spherical) {
+        const double rStep = _maxApogee / _dimensions.x;
+        const double thetaStep = glm::pi<double>() / _dimensions.y;
+        const double phiIntegral = glm::two_pi<double>() / _dimensions.z;
+
+        _inverseCellVolumes.resize(static_cast<size_t>(_dimensions.x) * _dimensions.y);
+        for (unsigned int y = 0; y < _dimensions.y; y++) {
+            for (unsigned int x = 0; x < _dimensions.x; x++) {
+                // integral(r^2 dr) * integral(sin(theta) dTheta) * integral(dPhi)
+                const double rIntegral =
+                    (std::pow((x + 1) * rStep, 3) - std::pow(x * rStep, 3)) / 3.0;
+                const double thetaIntegral =
+                    std::cos(y * thetaStep) - std::cos((y + 1) * thetaStep);
+                _inverseCellVolumes[x + y * _dimensions.x] =
+                    1.0 / (rIntegral * thetaIntegral * phiIntegral);
+            }
+        }
+    }
+}
+
+void DebrisDensity::compute(double time, std::vector<glm::dvec3>& positions,
+                            std::vector<double>& density) const
+{
+    const size_t sliceSize = static_cast<size_t>(_dimensions.x) * _dimensions.y;
+    density.assign(sliceSize * _dimensions.z, 0.0);
+    if (_maxApogee <= 0.0) {
+        return;
+    }
+
+    propagate(time, positions);
+
+    if (_gridType == volume::VolumeGridType::Cartesian) {
+        for (const glm::dvec3& position : positions) {
+            density[cellIndex(position)] += 1.0;
+        }
+    }
+    else {
+        for (const glm::dvec3& position : positions) {
+            const size_t index = cellIndex(position);
+            density[index] += _inverseCellVolumes[index % sliceSize];
+        }
+    }
+}
+
+double DebrisDensity::maxApogee() const {
+    return _maxApogee;
+}
+
+size_t DebrisDensity::nObjects() const {
+    return _epoch.size();
+}
+
+void DebrisDensity::propagate(double time, std::vector<glm::dvec3>& positions) const {
+    const size_t n = _epoch.size();
+    positions.resize(n);
+    for (size_t i = 0; i < n; i++) {
+        const double meanAnomaly =
+            _meanAnomalyAtEpoch[i] + (time - _epoch[i]) * _meanMotion[i];
+        const double e = eccentricAnomaly(meanAnomaly, _eccentricity[i]);
+
+        const glm::dvec3 p = glm::dvec3(
+            _semiMajorAxis[i] * (std::cos(e) - _eccentricity[i]),
+            _semiMinorAxis[i] * std::sin(e),
+            0.0
+        );
+        positions[i] = _rotation[i] * p;
+    }
+}
+
+size_t DebrisDensity::cellIndex(const glm::dvec3& position) const {
+    glm::uvec3 cell;
+    if (_gridType == volume::VolumeGridType::Cartesian) {
+        // The Cartesian grid covers [-maxApogee, maxApogee] in all dimensions
+        const double extent = 2.0 * _maxApogee;
+        cell = glm::uvec3(
+            binIndex(position.x + _maxApogee, extent, _dimensions.x),
+            binIndex(position.y + _maxApogee, extent, _dimensions.y),
+            binIndex(position.z + _maxApogee, extent, _dimensions.z)
+        );
+    }
+    else {
+        // r in [0, maxApogee], theta in [0, pi], phi in [0, 2pi]
+        const double r = glm::length(position);
+        const double theta = r > 0.0 ? std::acos(position.z / r) : 0.0;
+        const double phi = std::atan2(position.y, position.x) + glm::pi<double>();
+        cell = glm::uvec3(
+            binIndex(r, _maxApogee, _dimensions.x),
+            binIndex(theta, glm::pi<double>(), _dimensions.y),
+            binIndex(phi, glm::two_pi<double>(), _dimensions.z)
+        );
+    }
+
+    return (static_cast<size_t>(cell.z) * _dimensions.y + cell.y) * _dimensions.x +
+        cell.x;
+}
+
+} // namespace openspace
@@ -0,0 +1,96 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+#ifndef __OPENSPACE_MODULE_SPACE___DEBRISDENSITY___H__
+#define __OPENSPACE_MODULE_SPACE___DEBRISDENSITY___H__
+
+#include <modules/space/kepler.h>
+#include <modules/volume/volumegridtype.h>
+#include <ghoul/glm.h>
+#include <vector>
+
+namespace openspace {
+
+/**
+ * Computes the spatial density of a set of objects on Keplerian orbits around Earth for
+ * individual points in time. All values that do not depend on the time are computed
+ * once on construction, so that each call to #compute only has to propagate the orbits
+ * and bin the resulting positions. A single instance can be used from multiple threads
+ * at the same time as long as each thread passes its own buffers.
+ */
+class DebrisDensity {
+public:
+    /**
+     * Creates the density computation for the provided \p orbits that is binned into a
+     * grid with \p dimensions cells of the type \p gridType. The grid is centered on
+     * Earth and its extent is determined by the largest apogee of all \p orbits.
+     */
+    DebrisDensity(const std::vector<kepler::Parameters>& orbits, glm::uvec3 dimensions,
+        volume::VolumeGridType gridType);
+
+    /**
+     * Computes the density of all objects at the \p time, in seconds past the J2000
+     * epoch, and writes it into \p density, which is resized to the number of cells in
+     * the grid. For a Cartesian grid, the density is the number of objects in each cell.
+     * For a spherical grid, it is the number of objects per cubic meter. The
+     * \p positions are used as scratch space so that they can be reused between calls.
+     */
+    void compute(double time, std::vector<glm::dvec3>& positions,
+        std::vector<double>& density) const;
+
+    /**
+     * Returns the largest apogee of all orbits in meters.
+     */
+    double maxApogee() const;
+
+    /**
+     * Returns the number of objects whose density is computed.
+     */
+    size_t nObjects() const;
+
+private:
+    void propagate(double time, std::vector<glm::dvec3>& positions) const;
+    size_t cellIndex(const glm::dvec3& position) const;
+
+    glm::uvec3 _dimensions;
+    volume::VolumeGridType _gridType;
+    double _maxApogee = 0.0;
+
+    // The orbital elements are stored as one array per quantity so that the propagation
+    // of all objects is a tight loop over contiguous memory
+    std::vector<glm::dmat3> _rotation;
+    std::vector<double> _semiMajorAxis; // in meters
+    std::vector<double> _semiMinorAxis; // in meters
+    std::vector<double> _eccentricity;
+    std::vector<double> _meanAnomalyAtEpoch; // in radians
+    std::vector<double> _meanMotion; // in radians per second
+    std::vector<double> _epoch; // in seconds past J2000
+
+    // The inverse volume of the spherical cells, which only depends on the radius and
+    // theta index of a cell
+    std::vector<double> _inverseCellVolumes;
+};
+
+} // namespace openspace
+
+#endif // __OPENSPACE_MODULE_SPACE___DEBRISDENSITY___H__
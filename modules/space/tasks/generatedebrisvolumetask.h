@@ -21,48 +21,47 @@
  * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
-
 #ifndef __OPENSPACE_MODULE_SPACE___GENERATEDEBRISVOLUMETASK___H__
 #define __OPENSPACE_MODULE_SPACE___GENERATEDEBRISVOLUMETASK___H__
 
 #include <openspace/util/task.h>
 
-
-#include <modules/space/rendering/renderableorbitalkepler.h>
-#include <modules/space/translation/keplertranslation.h>
-#include <openspace/util/time.h>
+#include <modules/space/kepler.h>
+#include <modules/volume/volumegridtype.h>
 #include <ghoul/glm.h>
+#include <filesystem>
 #include <string>
 #include <vector>
 
-namespace openspace::volume {
+namespace openspace {
 
 class GenerateDebrisVolumeTask : public Task {
 public:
     GenerateDebrisVolumeTask(const ghoul::Dictionary& dictionary);
     std::string description() override;
+    std::vector<std::filesystem::path> inputs() const override;
+    size_t memoryEstimate() const override;
+    bool canRunConcurrently() const override;
+    unsigned int requestedThreads() const override;
     void perform(const Task::ProgressCallback& progressCallback) override;
-    static documentation::Documentation documentation();
-
-    std::string _gridType;
+    static documentation::Documentation Documentation();
 
 private:
-    std::string _rawVolumeOutputPath;
-    std::string _dictionaryOutputPath;
+    std::filesystem::path _rawVolumeOutputPath;
+    std::filesystem::path _dictionaryOutputPath;
+    std::filesystem::path _inputPath;
     std::string _startTime;
-    std::string _timeStep;
     std::string _endTime;
-    std::string _inputPath;
-
-    glm::uvec3 _dimensions;
-    glm::vec3 _lowerDomainBound;
-    glm::vec3 _upperDomainBound;
+    double _timeStep = 0.0;
+    volume::VolumeGridType _gridType = volume::VolumeGridType::Cartesian;
 
-    std::vector<KeplerParameters> _TLEDataVector;
+    glm::uvec3 _dimensions = glm::uvec3(0);
+    glm::vec3 _lowerDomainBound = glm::vec3(0.f);
+    glm::vec3 _upperDomainBound = glm::vec3(0.f);
 
-    float _maxApogee;
+    std::vector<kepler::Parameters> _orbits;
 };
 
-} // namespace openspace::volume
+} // namespace openspace
 
 #endif // __OPENSPACE_MODULE_SPACE___GENERATEDEBRISVOLUMETASK___H__
@@ -28,6 +28,7 @@
 #include <openspace/util/timemanager.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
 
 namespace {
     constexpr std::string_view _loggerCat = "ImageSequencer";
@@ -132,29 +133,8 @@ const std::vector<double>& ImageSequencer::captureProgression() const {
 }
 
 std::vector<std::pair<std::string, bool>> ImageSequencer::activeInstruments(double time) {
-    // first set all instruments to off
-    for (std::pair<std::string, bool>& i : _switchingMap) {
-        i.second = false;
-    }
-
-    // go over the filetranslaton map
-    using K = std::string;
-    using V = std::unique_ptr<Decoder>;
-    for (const std::pair<const K, V>& key : _fileTranslation) {
-        // for each spice-instrument
-        for (const std::string& instrumentID : key.second->translations()) {
-            // check if the spice-instrument is active
-            if (isInstrumentActive(time, instrumentID)) {
-                // go over switching map
-                for (std::pair<std::string, bool>& instrument : _switchingMap) {
-                    // if instrument is present in switching map
-                    if (instrumentID == instrument.first) {
-                        // set as active
-                        instrument.second = true;
-                    }
-                }
-            }
-        }
+    for (std::pair<std::string, bool>& instrument : _switchingMap) {
+        instrument.second = activeRange(time, instrument.first).has_value();
     }
     // return entire map, seen in GUI
     return _switchingMap;
@@ -162,43 +142,47 @@ std::vector<std::pair<std::string, bool>> ImageSequencer::activeInstruments(doub
 
 bool ImageSequencer::isInstrumentActive(double time, const std::string& instrument) const
 {
-    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
-        // check if this instrument is in range
-        if (!i.second.includes(time)) {
-            continue;
-        }
-
-        // if so, then get the corresponding spiceID
-        const std::vector<std::string>& is = _fileTranslation.at(i.first)->translations();
-        // check which specific subinstrument is firing
-        const auto it = std::find(is.begin(), is.end(), instrument);
-        if (it != is.end()) {
-            return true;
-        }
-    }
-    return false;
+    return activeRange(time, instrument).has_value();
 }
 
 float ImageSequencer::instrumentActiveTime(double time,
                                            const std::string& instrumentID) const
 {
-    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
-        // check if this instrument is in range
-        if (!i.second.includes(time)) {
-            continue;
-        }
-        // if so, then get the corresponding spiceID
-        const std::vector<std::string>& is = _fileTranslation.at(i.first)->translations();
-
-        // check which specific subinstrument is firing
-        const auto it = std::find(is.begin(), is.end(), instrumentID);
-        if (it != is.end()) {
-            return static_cast<float>(
-                (time - i.second.start) / (i.second.end - i.second.start)
-            );
-        }
+    const std::optional<TimeRange> range = activeRange(time, instrumentID);
+    if (!range.has_value()) {
+        return -1.f;
+    }
+    return static_cast<float>((time - range->start) / (range->end - range->start));
+}
+
+std::optional<TimeRange> ImageSequencer::activeRange(double time,
+                                                     std::string_view instrument) const
+{
+    const auto it = _instrumentActivity.find(instrument);
+    if (it == _instrumentActivity.end()) {
+        return std::nullopt;
+    }
+    const InstrumentActivity& activity = it->second;
+
+    // All ranges before this one start no later than the time
+    const auto last = std::upper_bound(
+        activity.ranges.begin(),
+        activity.ranges.end(),
+        time,
+        [](double t, const TimeRange& range) { return t < range.start; }
+    );
+    // Since maxEnd is non-decreasing, the first entry that reaches the time belongs to
+    // the first range that ends no earlier than the time
+    const size_t nCandidates = std::distance(activity.ranges.begin(), last);
+    const auto first = std::lower_bound(
+        activity.maxEnd.begin(),
+        activity.maxEnd.begin() + nCandidates,
+        time
+    );
+    if (first == activity.maxEnd.begin() + nCandidates) {
+        return std::nullopt;
     }
-    return -1.f;
+    return activity.ranges[std::distance(activity.maxEnd.begin(), first)];
 }
 
 std::vector<Image> ImageSequencer::imagePaths(const std::string& projectee,
@@ -209,46 +193,59 @@ std::vector<Image> ImageSequencer::imagePaths(const std::string& projectee,
 
     // check if this instance is either in range or
     // a valid candidate to recieve data
+    const auto subset = _subsetMap.find(projectee);
+    if (subset == _subsetMap.end()) {
+        return std::vector<Image>();
+    }
+    const std::vector<Image>& images = subset->second._subset;
 
     const bool instrumentActive = isInstrumentActive(time, instrument);
-    const bool hasCurrentTime = _subsetMap[projectee]._range.includes(time);
-    const bool hasSinceTime = _subsetMap[projectee]._range.includes(sinceTime);
+    const bool hasCurrentTime = subset->second._range.includes(time);
+    const bool hasSinceTime = subset->second._range.includes(sinceTime);
 
     if (!instrumentActive || (!hasCurrentTime && !hasSinceTime)) {
         return std::vector<Image>();
     }
 
-    // for readability we store the iterators
-    auto begin = _subsetMap[projectee]._subset.begin();
-    auto end = _subsetMap[projectee]._subset.end();
-
-    // create temporary storage
-    std::vector<Image> captures;
-    // what to look for
-    Image findPrevious, findCurrent;
-    findPrevious.timeRange.start = sinceTime;
-    findCurrent.timeRange.start = time;
-
     // find the two iterators that correspond to the latest time jump
-    auto compareTime = [](const Image& a, const Image& b) -> bool {
-        return a.timeRange.start < b.timeRange.start;
-    };
-    auto curr = std::lower_bound(begin, end, findCurrent , compareTime);
-    auto prev = std::lower_bound(begin, end, findPrevious, compareTime);
+    auto compareTime = [](const Image& a, double t) { return a.timeRange.start < t; };
+    auto curr = std::lower_bound(images.begin(), images.end(), time, compareTime);
+    auto prev = std::lower_bound(images.begin(), images.end(), sinceTime, compareTime);
 
-    if (curr == begin || curr == end || prev == begin || prev == end || prev >= curr ||
+    if (curr == images.begin() || curr == images.end() || prev == images.begin() ||
+        prev == images.end() || prev >= curr ||
         curr->timeRange.start < prev->timeRange.start)
     {
         return std::vector<Image>();
     }
 
-    std::copy_if(
-        prev,
-        curr,
-        back_inserter(captures),
-        [instrument](const Image& i) { return i.activeInstruments[0] == instrument; }
+    // Only the captures of the instrument between the two iterators are considered
+    const auto target = _instrumentCaptures.find(projectee);
+    if (target == _instrumentCaptures.end()) {
+        return std::vector<Image>();
+    }
+    const auto indices = target->second.find(instrument);
+    if (indices == target->second.end()) {
+        return std::vector<Image>();
+    }
+    const std::vector<size_t>& idx = indices->second;
+    const auto idxBegin = std::lower_bound(
+        idx.begin(),
+        idx.end(),
+        static_cast<size_t>(std::distance(images.begin(), prev))
+    );
+    const auto idxEnd = std::lower_bound(
+        idxBegin,
+        idx.end(),
+        static_cast<size_t>(std::distance(images.begin(), curr))
     );
 
+    std::vector<Image> captures;
+    captures.reserve(std::distance(idxBegin, idxEnd));
+    for (auto it = idxBegin; it != idxEnd; it++) {
+        captures.push_back(images[*it]);
+    }
+
     if (!captures.empty()) {
         _latestImages[captures.back().activeInstruments.front()] = captures.back();
     }
@@ -411,7 +408,38 @@ void ImageSequencer::runSequenceParser(SequenceParser& parser) {
             }
         }
     }
+    buildIndices();
     _hasData = true;
 }
 
+void ImageSequencer::buildIndices() {
+    // _instrumentTimes is sorted by start time, so the ranges of each instrument are too
+    _instrumentActivity.clear();
+    for (const std::pair<std::string, TimeRange>& i : _instrumentTimes) {
+        const auto it = _fileTranslation.find(i.first);
+        if (it == _fileTranslation.end()) {
+            continue;
+        }
+        for (const std::string& instrument : it->second->translations()) {
+            InstrumentActivity& activity = _instrumentActivity[instrument];
+            const double maxEnd = activity.maxEnd.empty() ?
+                i.second.end :
+                std::max(activity.maxEnd.back(), i.second.end);
+            activity.ranges.push_back(i.second);
+            activity.maxEnd.push_back(maxEnd);
+        }
+    }
+
+    _instrumentCaptures.clear();
+    for (const std::pair<const std::string, ImageSubset>& subset : _subsetMap) {
+        auto& captures = _instrumentCaptures[subset.first];
+        for (size_t i = 0; i < subset.second._subset.size(); i++) {
+            const Image& image = subset.second._subset[i];
+            if (!image.activeInstruments.empty()) {
+                captures[image.activeInstruments.front()].push_back(i);
+            }
+        }
+    }
+}
+
 }  // namespace openspace
@@ -28,7 +28,9 @@
 #include <modules/spacecraftinstruments/util/sequenceparser.h>
 
 #include <map>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -138,6 +140,18 @@ public:
 private:
     void sortData();
 
+    /**
+     * Rebuilds the indices that are used for the per-frame queries from the currently
+     * loaded sequence data.
+     */
+    void buildIndices();
+
+    /**
+     * Returns the first activity range of the \p instrument that includes
+     * \p time, or `std::nullopt` if the instrument is not active at that time.
+     */
+    std::optional<TimeRange> activeRange(double time, std::string_view instrument) const;
+
     /**
      * This handles any types of ambiguities between the data and SPICE calls. This map is
      * composed of a key that is a string in the data to be translated and a Decoder that
@@ -180,6 +194,27 @@ private:
      */
     std::vector<double> _captureProgression;
 
+    struct InstrumentActivity {
+        /// The time ranges in which the instrument is active, sorted by start time
+        std::vector<TimeRange> ranges;
+        /// The latest end time of all ranges up to and including each index, which makes
+        /// it possible to find the first range that includes a time with a binary search
+        std::vector<double> maxEnd;
+    };
+
+    /**
+     * The activity ranges from the _instrumentTimes, with the translations from the
+     * _fileTranslation already resolved. The key is the SPICE instrument name.
+     */
+    std::map<std::string, InstrumentActivity, std::less<>> _instrumentActivity;
+
+    /**
+     * For each target and instrument, the indices into the subset of the target of all
+     * images that were captured by the instrument in chronological order.
+     */
+    std::map<std::string, std::map<std::string, std::vector<size_t>, std::less<>>,
+        std::less<>> _instrumentCaptures;
+
     // default capture image
     std::string _defaultCaptureImage;
 
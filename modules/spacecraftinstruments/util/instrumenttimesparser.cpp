@@ -26,13 +26,18 @@
 
 #include <openspace/documentation/documentation.h>
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/time.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/stringhelper.h>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <utility>
 
 namespace {
     constexpr std::string_view _loggerCat = "InstrumentTimesParser";
@@ -45,14 +50,36 @@ namespace {
         std::map<std::string, ghoul::Dictionary> instruments;
     };
 #include "instrumenttimesparser_codegen.cpp"
+
+    // Returns the start and stop time of a line in the format
+    // "YYYY-MM-DDTHH:MM:SS.sss" "YYYY-MM-DDTHH:MM:SS.sss", which is any line that
+    // consists of two quoted 23 character strings separated by a space
+    std::optional<std::pair<std::string, std::string>> parseTimes(std::string_view line)
+    {
+        constexpr size_t TimeLength = 23;
+        if (line.size() != 2 * TimeLength + 5 || line[0] != '"' ||
+            line[TimeLength + 1] != '"' || line[TimeLength + 2] != ' ' ||
+            line[TimeLength + 3] != '"' || line.back() != '"')
+        {
+            return std::nullopt;
+        }
+
+        const std::string_view start = line.substr(1, TimeLength);
+        const std::string_view stop = line.substr(TimeLength + 4, TimeLength);
+        if (start.find_first_of("\r\n") != std::string_view::npos ||
+            stop.find_first_of("\r\n") != std::string_view::npos)
+        {
+            return std::nullopt;
+        }
+        return std::pair(std::string(start), std::string(stop));
+    }
 } // namespace
 
 namespace openspace {
 
 InstrumentTimesParser::InstrumentTimesParser(std::string name, std::string sequenceSource,
                                              ghoul::Dictionary& inputDict)
-    : _pattern("\"(.{23})\" \"(.{23})\"")
-    , _name(std::move(name))
+    : _name(std::move(name))
     , _fileName(std::move(sequenceSource))
 {
     const Parameters p = codegen::bake<Parameters>(inputDict);
@@ -76,8 +103,29 @@ bool InstrumentTimesParser::create() {
         return false;
     }
 
+    std::vector<std::filesystem::path> files;
+    std::string information = _target;
     using K = std::string;
     using V = std::vector<std::string>;
+    for (const std::pair<const K, V>& p : _instrumentFiles) {
+        information += fmt::format("|{}={}", p.first, ghoul::join(p.second, ","));
+        for (const std::string& filename : p.second) {
+            files.push_back(sequenceDir / filename);
+        }
+    }
+    const uint64_t stamp = contentStamp(std::move(files), information);
+    const std::filesystem::path cacheFile = FileSys.cacheManager()->cachedFilename(
+        sequenceDir / "instrumenttimes.cache",
+        "InstrumentTimesParser|" + _name
+    );
+    if (loadCachedSequence(cacheFile, stamp)) {
+        LINFO(fmt::format("Loaded instrument times {} from cache", sequenceDir));
+        return true;
+    }
+
+    // A failure to convert the times might be caused by missing kernels rather than by
+    // the files, so the result is only cached if all files were read
+    bool allSuccessful = true;
     for (const std::pair<const K, V>& p : _instrumentFiles) {
         const std::string& instrumentID = p.first;
         for (std::string filename : p.second) {
@@ -91,29 +139,19 @@ bool InstrumentTimesParser::create() {
             // Read file into string
             std::ifstream inFile(filepath);
             std::string line;
-            std::smatch matches;
             TimeRange instrumentActiveTimeRange;
             bool successfulRead = true;
             while (std::getline(inFile, line)) {
-                if (!std::regex_match(line, matches, _pattern)) {
+                std::optional<std::pair<std::string, std::string>> times =
+                    parseTimes(line);
+                if (!times.has_value()) {
                     continue;
                 }
 
-                if (matches.size() != 3) {
-                    LERROR(
-                        "Bad event data formatting. Must have regex 3 matches "
-                        "(source string, start time, stop time)"
-                    );
-                    successfulRead = false;
-                    break;
-                }
-
                 TimeRange tr;
                 try { // parse date strings
-                    std::string start = matches[1].str();
-                    std::string stop = matches[2].str();
-                    tr.start = SpiceManager::ref().ephemerisTimeFromDate(start);
-                    tr.end = SpiceManager::ref().ephemerisTimeFromDate(stop);
+                    tr.start = Time::convertTime(times->first);
+                    tr.end = Time::convertTime(times->second);
                 }
                 catch (const SpiceManager::SpiceException& e) {
                     LERROR(e.what());
@@ -140,6 +178,7 @@ bool InstrumentTimesParser::create() {
                 _subsetMap[_target]._range.include(instrumentActiveTimeRange);
                 _instrumentTimes.emplace_back(instrumentID, instrumentActiveTimeRange);
             }
+            allSuccessful &= successfulRead;
         }
     }
 
@@ -154,6 +193,9 @@ bool InstrumentTimesParser::create() {
         }
     );
 
+    if (allSuccessful) {
+        saveCachedSequence(cacheFile, stamp);
+    }
     return true;
 }
 
@@ -27,8 +27,6 @@
 
 #include <modules/spacecraftinstruments/util/sequenceparser.h>
 
-#include <regex>
-
 namespace openspace {
 
 class InstrumentTimesParser : public SequenceParser {
@@ -39,8 +37,6 @@ public:
     bool create() override;
 
 private:
-    std::regex _pattern;
-
     std::map<std::string, std::vector<std::string>> _instrumentFiles;
 
     std::string _name;
@@ -25,19 +25,29 @@
 #include <modules/spacecraftinstruments/util/labelparser.h>
 
 #include <openspace/util/spicemanager.h>
+#include <openspace/util/time.h>
 #include <ghoul/fmt.h>
+#include <ghoul/filesystem/cachemanager.h>
 #include <ghoul/filesystem/file.h>
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/io/texture/texturereader.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/dictionary.h>
+#include <ghoul/misc/stringhelper.h>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "LabelParser";
     constexpr std::string_view keySpecs = "Read";
     constexpr std::string_view keyConvert = "Convert";
+
+    // Each thread that reads label files should at least get this many files to make up
+    // for the cost of starting the thread
+    constexpr size_t MinLabelFilesPerThread = 32;
 } // namespace
 
 namespace openspace {
@@ -110,12 +120,14 @@ LabelParser::LabelParser(std::string fileName, const ghoul::Dictionary& dictiona
     }
 }
 
-std::string LabelParser::decode(const std::string& line) {
-    for (std::pair<const std::string, std::unique_ptr<Decoder>>& key : _fileTranslation) {
+std::string LabelParser::decode(const std::string& line) const {
+    using K = std::string;
+    using V = std::unique_ptr<Decoder>;
+    for (const std::pair<const K, V>& key : _fileTranslation) {
         std::size_t value = line.find(key.first);
         if (value != std::string::npos) {
-            std::string toTranslate = line.substr(value);
-            return _fileTranslation[toTranslate]->translations()[0];
+            const auto it = _fileTranslation.find(line.substr(value));
+            return it != _fileTranslation.end() ? it->second->translations()[0] : "";
         }
     }
     return "";
@@ -133,6 +145,114 @@ std::string LabelParser::encode(const std::string& line) const {
     return "";
 }
 
+LabelParser::LabelFile LabelParser::parseLabelFile(const std::filesystem::path& path,
+                                         const std::vector<std::string>& extensions) const
+{
+    LabelFile result;
+
+    std::ifstream file(path);
+    if (!file.good()) {
+        LERROR(fmt::format("Failed to open label file {}", path));
+        return result;
+    }
+
+    int count = 0;
+
+    // open up label files
+    std::string target;
+    std::string instrumentID;
+    std::string startTime;
+    std::string stopTime;
+    std::string line;
+    while (std::getline(file, line)) {
+        line.erase(std::remove(line.begin(), line.end(), '"'), line.end());
+        line.erase(std::remove(line.begin(), line.end(), ' '), line.end());
+        line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+
+        std::string read = line.substr(0, line.find_first_of('='));
+
+        constexpr std::string_view ErrorMsg =
+            "Unrecognized '{}' in line {} in file {}. The 'Convert' table must "
+            "contain the identity tranformation for all values encountered in the "
+            "label files, for example: ROSETTA = {{ \"ROSETTA\" }}";
+
+        // Add more
+        if (read == "TARGET_NAME") {
+            target = decode(line);
+            if (target.empty()) {
+                LWARNING(fmt::format(ErrorMsg, "TARGET_NAME", line, path));
+            }
+            count++;
+        }
+        if (read == "INSTRUMENT_HOST_NAME") {
+            if (decode(line).empty()) {
+                LWARNING(fmt::format(ErrorMsg, "INSTRUMENT_HOST_NAME", line, path));
+            }
+            count++;
+        }
+        if (read == "INSTRUMENT_ID") {
+            instrumentID = decode(line);
+            if (instrumentID.empty()) {
+                LWARNING(fmt::format(ErrorMsg, "INSTRUMENT_ID", line, path));
+            }
+            result.lblName = encode(line);
+            count++;
+        }
+        if (read == "DETECTOR_TYPE") {
+            if (decode(line).empty()) {
+                LWARNING(fmt::format(ErrorMsg, "DETECTOR_TYPE", line, path));
+            }
+            count++;
+        }
+
+        if (read == "START_TIME") {
+            startTime = line.substr(line.find('=') + 1);
+            count++;
+
+            std::getline(file, line);
+            line.erase(std::remove(line.begin(), line.end(), '"'), line.end());
+            line.erase(std::remove(line.begin(), line.end(), ' '), line.end());
+            line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
+
+            read = line.substr(0, line.find_first_of('='));
+            if (read == "STOP_TIME") {
+                stopTime = line.substr(line.find('=') + 1);
+                count++;
+            }
+            else {
+                LERROR(fmt::format(
+                    "Label file {} deviates from generic standard", path
+                ));
+                LINFO(
+                    "Please make sure input data adheres to format from \
+                    https://pds.jpl.nasa.gov/documents/qs/labels.html"
+                );
+            }
+        }
+        if (count == static_cast<int>(_specsOfInterest.size())) {
+            count = 0;
+
+            std::filesystem::path imagePath = path;
+            for (const std::string& ext : extensions) {
+                imagePath.replace_extension(ext);
+                if (std::filesystem::is_regular_file(imagePath)) {
+                    result.labels.push_back({
+                        .startTime = startTime,
+                        .stopTime = stopTime,
+                        .instrumentID = instrumentID,
+                        .target = target,
+                        .imagePath = imagePath.string()
+                    });
+                    break;
+                }
+            }
+        }
+    }
+
+    result.success = true;
+    return result;
+}
+
 bool LabelParser::create() {
     std::filesystem::path sequenceDir = absPath(_fileName);
     if (!std::filesystem::is_directory(sequenceDir)) {
@@ -140,160 +260,104 @@ bool LabelParser::create() {
         return false;
     }
 
-    std::string lblName;
+    // All files are part of the content stamp since the images determine which labels
+    // are used
+    std::vector<std::filesystem::path> files;
+    std::vector<std::filesystem::path> labelFiles;
     namespace fs = std::filesystem;
     for (const fs::directory_entry& e : fs::recursive_directory_iterator(sequenceDir)) {
         if (!e.is_regular_file()) {
             continue;
         }
 
-        std::string path = e.path().string();
-
-        size_t position = path.find_last_of('.') + 1;
-        if (position == 0 || position == std::string::npos) {
-            continue;
+        files.push_back(e.path());
+        std::filesystem::path extension = e.path().extension();
+        if (extension == ".lbl" || extension == ".LBL") {
+            labelFiles.push_back(e.path());
         }
+    }
+    std::sort(labelFiles.begin(), labelFiles.end());
 
-        std::filesystem::path extension = std::filesystem::path(path).extension();
-        if (extension != ".lbl" && extension != ".LBL") {
-            continue;
-        }
+    const std::vector<std::string> extensions =
+        ghoul::io::TextureReader::ref().supportedExtensions();
 
-        std::ifstream file(path);
+    std::string information = fmt::format(
+        "{}|{}|", ghoul::join(_specsOfInterest, ","), ghoul::join(extensions, ",")
+    );
+    using K = std::string;
+    using V = std::unique_ptr<Decoder>;
+    for (const std::pair<const K, V>& translation : _fileTranslation) {
+        information += fmt::format(
+            "{}={};",
+            translation.first, ghoul::join(translation.second->translations(), ",")
+        );
+    }
+    const uint64_t stamp = contentStamp(std::move(files), information);
+    const std::filesystem::path cacheFile = FileSys.cacheManager()->cachedFilename(
+        sequenceDir / "labels.cache",
+        "LabelParser"
+    );
+    if (loadCachedSequence(cacheFile, stamp)) {
+        LINFO(fmt::format("Loaded label directory {} from cache", sequenceDir));
+        return true;
+    }
 
-        if (!file.good()) {
-            LERROR(fmt::format(
-                "Failed to open label file {}", std::filesystem::path(path)
-            ));
-            return false;
+    // The label files are read concurrently, but the times are converted afterwards as
+    // SPICE does not support being called from multiple threads
+    std::vector<LabelFile> parsed(labelFiles.size());
+    std::atomic<size_t> nextFile = 0;
+    auto work = [&]() {
+        for (size_t i = nextFile++; i < labelFiles.size(); i = nextFile++) {
+            parsed[i] = parseLabelFile(labelFiles[i], extensions);
         }
+    };
 
-        int count = 0;
-
-        // open up label files
-        double startTime = 0.0;
-        double stopTime = 0.0;
-        std::string line;
-        do {
-            std::getline(file, line);
-
-            line.erase(std::remove(line.begin(), line.end(), '"'), line.end());
-            line.erase(std::remove(line.begin(), line.end(), ' '), line.end());
-            line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
-
-            std::string read = line.substr(0, line.find_first_of('='));
-
-            _detectorType = "CAMERA"; // default value
-
-            constexpr std::string_view ErrorMsg =
-                "Unrecognized '{}' in line {} in file {}. The 'Convert' table must "
-                "contain the identity tranformation for all values encountered in the "
-                "label files, for example: ROSETTA = {{ \"ROSETTA\" }}";
+    const size_t nThreads = std::clamp<size_t>(
+        labelFiles.size() / MinLabelFilesPerThread,
+        1,
+        std::max(std::thread::hardware_concurrency(), 1u)
+    );
+    std::vector<std::thread> threads;
+    for (size_t i = 1; i < nThreads; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
 
-            // Add more
-            if (read == "TARGET_NAME") {
-                _target = decode(line);
-                if (_target.empty()) {
-                    LWARNING(fmt::format(ErrorMsg, "TARGET_NAME", line, path));
-                }
-                count++;
-            }
-            if (read == "INSTRUMENT_HOST_NAME") {
-                _instrumentHostID = decode(line);
-                if (_instrumentHostID.empty()) {
-                    LWARNING(fmt::format(ErrorMsg, "INSTRUMENT_HOST_NAME", line, path));
-                }
-                count++;
-            }
-            if (read == "INSTRUMENT_ID") {
-                _instrumentID = decode(line);
-                if (_instrumentID.empty()) {
-                    LWARNING(fmt::format(ErrorMsg, "INSTRUMENT_ID", line, path));
-                }
-                lblName = encode(line);
-                count++;
-            }
-            if (read == "DETECTOR_TYPE") {
-                _detectorType = decode(line);
-                if (_detectorType.empty()) {
-                    LWARNING(fmt::format(ErrorMsg, "DETECTOR_TYPE", line, path));
-                }
-                count++;
-            }
+    std::string lblName;
+    for (const LabelFile& file : parsed) {
+        if (!file.success) {
+            return false;
+        }
+        if (file.lblName.has_value()) {
+            lblName = *file.lblName;
+        }
 
-            if (read == "START_TIME") {
-                std::string start = line.substr(line.find('=') + 1);
-                start.erase(std::remove(start.begin(), start.end(), ' '), start.end());
-                startTime = SpiceManager::ref().ephemerisTimeFromDate(start);
-                count++;
+        for (const Label& label : file.labels) {
+            const double startTime = label.startTime.empty() ?
+                0.0 :
+                Time::convertTime(label.startTime);
+            const double stopTime = label.stopTime.empty() ?
+                0.0 :
+                Time::convertTime(label.stopTime);
+
+            Image image = {
+                .timeRange = TimeRange(startTime, stopTime),
+                .path = label.imagePath,
+                .activeInstruments = { label.instrumentID },
+                .target = label.target,
+                .isPlaceholder = false,
+                .projected = false
+            };
 
-                std::getline(file, line);
-                line.erase(std::remove(line.begin(), line.end(), '"'), line.end());
-                line.erase(std::remove(line.begin(), line.end(), ' '), line.end());
-                line.erase(std::remove(line.begin(), line.end(), '\r'), line.end());
-
-                read = line.substr(0, line.find_first_of('='));
-                if (read == "STOP_TIME") {
-                    std::string stop = line.substr(line.find('=') + 1);
-                    stop.erase(
-                        std::remove_if(
-                            stop.begin(),
-                            stop.end(),
-                            [](char c) { return c == ' ' || c == '\r'; }
-                        ),
-                        stop.end()
-                    );
-                    stopTime = SpiceManager::ref().ephemerisTimeFromDate(stop);
-                    count++;
-                }
-                else{
-                    LERROR(fmt::format(
-                        "Label file {} deviates from generic standard", path
-                    ));
-                    LINFO(
-                        "Please make sure input data adheres to format from \
-                        https://pds.jpl.nasa.gov/documents/qs/labels.html"
-                    );
-                }
-            }
-            if (count == static_cast<int>(_specsOfInterest.size())) {
-                const std::vector<std::string> extensions =
-                    ghoul::io::TextureReader::ref().supportedExtensions();
-
-                count = 0;
-
-                using namespace std::literals;
-                std::string p = path.substr(0, path.size() - ("lbl"s).size());
-                for (const std::string& ext : extensions) {
-                    std::string imagePath = p + ext;
-                    if (std::filesystem::is_regular_file(imagePath)) {
-                        std::vector<std::string> spiceInstrument;
-                        spiceInstrument.push_back(_instrumentID);
-
-                        Image image = {
-                            .timeRange = TimeRange(startTime, stopTime),
-                            .path = imagePath,
-                            .activeInstruments = spiceInstrument,
-                            .target = _target,
-                            .isPlaceholder = false,
-                            .projected = false
-                        };
-
-                        _subsetMap[image.target]._subset.push_back(image);
-                        _subsetMap[image.target]._range.include(startTime);
-
-                        _captureProgression.push_back(startTime);
-                        std::stable_sort(
-                            _captureProgression.begin(),
-                            _captureProgression.end()
-                        );
-
-                        break;
-                    }
-                }
-            }
-        } while (!file.eof());
+            _subsetMap[image.target]._subset.push_back(image);
+            _subsetMap[image.target]._range.include(startTime);
+            _captureProgression.push_back(startTime);
+        }
     }
+    std::stable_sort(_captureProgression.begin(), _captureProgression.end());
 
     std::vector<Image> tmp;
     for (const std::pair<const std::string, ImageSubset>& key : _subsetMap) {
@@ -309,6 +373,7 @@ bool LabelParser::create() {
         }
     );
 
+    // The images are sorted by time, so the target times are sorted as well
     std::string previousTarget;
     for (const Image& image : tmp) {
         if (previousTarget == image.target) {
@@ -317,20 +382,13 @@ bool LabelParser::create() {
 
         previousTarget = image.target;
         _targetTimes.emplace_back(image.timeRange.start , image.target);
-        std::sort(
-            _targetTimes.begin(),
-            _targetTimes.end(),
-            [](const std::pair<double, std::string>& a,
-               const std::pair<double, std::string>& b) -> bool
-            {
-                return a.first < b.first;
-            }
-        );
     }
 
     for (const std::pair<const std::string, ImageSubset>& target : _subsetMap) {
         _instrumentTimes.emplace_back(lblName, _subsetMap[target.first]._range);
     }
+
+    saveCachedSequence(cacheFile, stamp);
     return true;
 }
 
@@ -27,6 +27,8 @@
 
 #include <modules/spacecraftinstruments/util/sequenceparser.h>
 
+#include <optional>
+
 namespace openspace {
 
 class LabelParser : public SequenceParser {
@@ -36,16 +38,33 @@ public:
     bool create() override;
 
 private:
+    struct Label {
+        std::string startTime;
+        std::string stopTime;
+        std::string instrumentID;
+        std::string target;
+        std::string imagePath;
+    };
+
+    struct LabelFile {
+        bool success = false;
+        std::vector<Label> labels;
+        std::optional<std::string> lblName;
+    };
+
+    /**
+     * Reads the label file at \p path and returns the labels whose image exists with
+     * one of the provided \p extensions. This function does not modify the parser and
+     * does not call into SPICE, so it can be called from multiple threads concurrently.
+     */
+    LabelFile parseLabelFile(const std::filesystem::path& path,
+        const std::vector<std::string>& extensions) const;
+
     std::string encode(const std::string& line) const;
-    std::string decode(const std::string& line);
+    std::string decode(const std::string& line) const;
 
     std::string _fileName;
     std::vector<std::string> _specsOfInterest;
-
-    std::string _target;
-    std::string _instrumentID;
-    std::string _instrumentHostID;
-    std::string _detectorType;
 };
 
 } // namespace openspace
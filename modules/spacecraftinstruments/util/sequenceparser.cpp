@@ -26,7 +26,65 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/util/spicemanager.h>
+#include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
+#include <algorithm>
+#include <fstream>
+
+namespace {
+    constexpr std::string_view _loggerCat = "SequenceParser";
+
+    constexpr int8_t CurrentCacheVersion = 1;
+
+    uint64_t fnv1a(uint64_t hash, const void* data, size_t size) {
+        const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    void writeString(std::ostream& stream, const std::string& s) {
+        const uint32_t size = static_cast<uint32_t>(s.size());
+        stream.write(reinterpret_cast<const char*>(&size), sizeof(uint32_t));
+        stream.write(s.data(), size);
+    }
+
+    std::string readString(std::istream& stream) {
+        uint32_t size = 0;
+        stream.read(reinterpret_cast<char*>(&size), sizeof(uint32_t));
+        std::string s;
+        if (stream.good()) {
+            s.resize(size);
+            stream.read(s.data(), size);
+        }
+        return s;
+    }
+
+    template <typename T>
+    void writeValue(std::ostream& stream, const T& value) {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    T readValue(std::istream& stream) {
+        T value = T();
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return value;
+    }
+
+    void writeTimeRange(std::ostream& stream, const openspace::TimeRange& range) {
+        writeValue(stream, range.start);
+        writeValue(stream, range.end);
+    }
+
+    openspace::TimeRange readTimeRange(std::istream& stream) {
+        const double start = readValue<double>(stream);
+        const double end = readValue<double>(stream);
+        return openspace::TimeRange(start, end);
+    }
+} // namespace
 
 namespace openspace {
 
@@ -51,4 +109,158 @@ std::map<std::string, std::unique_ptr<Decoder>>& SequenceParser::translations()
     return _fileTranslation;
 }
 
+uint64_t SequenceParser::contentStamp(std::vector<std::filesystem::path> files,
+                                      std::string_view information)
+{
+    std::sort(files.begin(), files.end());
+
+    uint64_t hash = 14695981039346656037ULL;
+    hash = fnv1a(hash, information.data(), information.size());
+    for (const std::filesystem::path& file : files) {
+        const std::string path = file.string();
+        hash = fnv1a(hash, path.data(), path.size() + 1);
+
+        // Missing files are part of the stamp as well, so that the stamp changes when
+        // they are added later
+        std::error_code ec;
+        const uintmax_t size = std::filesystem::file_size(file, ec);
+        const int64_t modified = ec ?
+            0 :
+            std::filesystem::last_write_time(file, ec).time_since_epoch().count();
+        const int64_t values[2] = {
+            ec ? -1 : static_cast<int64_t>(size),
+            ec ? -1 : modified
+        };
+        hash = fnv1a(hash, values, sizeof(values));
+    }
+    return hash;
+}
+
+bool SequenceParser::loadCachedSequence(const std::filesystem::path& file,
+                                        uint64_t stamp)
+{
+    std::ifstream stream(file, std::ifstream::binary);
+    if (!stream.good()) {
+        return false;
+    }
+
+    const int8_t version = readValue<int8_t>(stream);
+    const uint64_t cachedStamp = readValue<uint64_t>(stream);
+    if (!stream.good() || version != CurrentCacheVersion || cachedStamp != stamp) {
+        return false;
+    }
+
+    std::map<std::string, ImageSubset> subsetMap;
+    const uint32_t nSubsets = readValue<uint32_t>(stream);
+    for (uint32_t i = 0; i < nSubsets && stream.good(); i++) {
+        const std::string key = readString(stream);
+        ImageSubset& subset = subsetMap[key];
+        subset._range = readTimeRange(stream);
+
+        const uint32_t nImages = readValue<uint32_t>(stream);
+        for (uint32_t j = 0; j < nImages && stream.good(); j++) {
+            Image image;
+            image.timeRange = readTimeRange(stream);
+            image.path = readString(stream);
+            const uint32_t nInstruments = readValue<uint32_t>(stream);
+            for (uint32_t k = 0; k < nInstruments && stream.good(); k++) {
+                image.activeInstruments.push_back(readString(stream));
+            }
+            image.target = readString(stream);
+            image.isPlaceholder = readValue<uint8_t>(stream) != 0;
+            image.projected = readValue<uint8_t>(stream) != 0;
+            subset._subset.push_back(std::move(image));
+        }
+    }
+
+    std::vector<std::pair<std::string, TimeRange>> instrumentTimes;
+    const uint32_t nInstrumentTimes = readValue<uint32_t>(stream);
+    for (uint32_t i = 0; i < nInstrumentTimes && stream.good(); i++) {
+        std::string instrument = readString(stream);
+        instrumentTimes.emplace_back(std::move(instrument), readTimeRange(stream));
+    }
+
+    std::vector<std::pair<double, std::string>> targetTimes;
+    const uint32_t nTargetTimes = readValue<uint32_t>(stream);
+    for (uint32_t i = 0; i < nTargetTimes && stream.good(); i++) {
+        const double time = readValue<double>(stream);
+        targetTimes.emplace_back(time, readString(stream));
+    }
+
+    const uint32_t nCaptures = readValue<uint32_t>(stream);
+    std::vector<double> captureProgression;
+    if (stream.good()) {
+        captureProgression.resize(nCaptures);
+        stream.read(
+            reinterpret_cast<char*>(captureProgression.data()),
+            nCaptures * sizeof(double)
+        );
+    }
+
+    if (!stream.good()) {
+        LWARNING(fmt::format("Could not read sequence cache {}", file));
+        return false;
+    }
+
+    _subsetMap = std::move(subsetMap);
+    _instrumentTimes = std::move(instrumentTimes);
+    _targetTimes = std::move(targetTimes);
+    _captureProgression = std::move(captureProgression);
+    return true;
+}
+
+void SequenceParser::saveCachedSequence(const std::filesystem::path& file,
+                                        uint64_t stamp) const
+{
+    std::ofstream stream(file, std::ofstream::binary);
+    if (!stream.good()) {
+        LERROR(fmt::format("Error opening file {} for saving sequence cache", file));
+        return;
+    }
+
+    writeValue(stream, CurrentCacheVersion);
+    writeValue(stream, stamp);
+
+    writeValue(stream, static_cast<uint32_t>(_subsetMap.size()));
+    for (const std::pair<const std::string, ImageSubset>& subset : _subsetMap) {
+        writeString(stream, subset.first);
+        writeTimeRange(stream, subset.second._range);
+
+        writeValue(stream, static_cast<uint32_t>(subset.second._subset.size()));
+        for (const Image& image : subset.second._subset) {
+            writeTimeRange(stream, image.timeRange);
+            writeString(stream, image.path);
+            writeValue(stream, static_cast<uint32_t>(image.activeInstruments.size()));
+            for (const std::string& instrument : image.activeInstruments) {
+                writeString(stream, instrument);
+            }
+            writeString(stream, image.target);
+            writeValue(stream, static_cast<uint8_t>(image.isPlaceholder));
+            writeValue(stream, static_cast<uint8_t>(image.projected));
+        }
+    }
+
+    writeValue(stream, static_cast<uint32_t>(_instrumentTimes.size()));
+    for (const std::pair<std::string, TimeRange>& instrumentTime : _instrumentTimes) {
+        writeString(stream, instrumentTime.first);
+        writeTimeRange(stream, instrumentTime.second);
+    }
+
+    writeValue(stream, static_cast<uint32_t>(_targetTimes.size()));
+    for (const std::pair<double, std::string>& targetTime : _targetTimes) {
+        writeValue(stream, targetTime.first);
+        writeString(stream, targetTime.second);
+    }
+
+    writeValue(stream, static_cast<uint32_t>(_captureProgression.size()));
+    stream.write(
+        reinterpret_cast<const char*>(_captureProgression.data()),
+        _captureProgression.size() * sizeof(double)
+    );
+
+    if (!stream.good()) {
+        LERROR(fmt::format("Error writing sequence cache {}", file));
+    }
+}
+
 } // namespace openspace
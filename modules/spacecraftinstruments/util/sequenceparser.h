@@ -28,9 +28,12 @@
 #include <modules/spacecraftinstruments/util/decoder.h>
 #include <modules/spacecraftinstruments/util/image.h>
 #include <openspace/util/timerange.h>
+#include <cstdint>
+#include <filesystem>
 #include <map>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace openspace {
@@ -47,6 +50,28 @@ public:
     const std::vector<double>& captureProgression() const;
 
 protected:
+    /**
+     * Computes a stamp for the contents of the \p files from their paths, sizes, and
+     * modification times, together with the \p information that describes how the files
+     * are parsed. The order of the \p files does not matter.
+     */
+    static uint64_t contentStamp(std::vector<std::filesystem::path> files,
+        std::string_view information);
+
+    /**
+     * Replaces the parsed sequence with the contents of the cache \p file if the cache
+     * was written for the same \p stamp.
+     *
+     * \return `true` if the sequence was loaded, `false` if the cache is missing, stale,
+     *         or unreadable
+     */
+    bool loadCachedSequence(const std::filesystem::path& file, uint64_t stamp);
+
+    /**
+     * Writes the parsed sequence and the \p stamp into the cache \p file.
+     */
+    void saveCachedSequence(const std::filesystem::path& file, uint64_t stamp) const;
+
     std::map<std::string, ImageSubset> _subsetMap;
     std::vector<std::pair<std::string, TimeRange>> _instrumentTimes;
     std::vector<std::pair<double, std::string>> _targetTimes;
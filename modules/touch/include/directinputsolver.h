@@ -27,6 +27,8 @@
 
 #include <openspace/util/touch.h>
 #include <modules/touch/ext/levmarq.h>
+#include <ghoul/glm.h>
+#include <array>
 #include <vector>
 
 namespace openspace {
@@ -36,7 +38,10 @@ class SceneGraphNode;
 
 /**
  * The DirectInputSolver is used to minimize the L2 error of touch input to 3D camera
- * position. It uses the levmarq algorithm in order to do this.
+ * position. It uses the Levenberg-Marquardt algorithm with exact Jacobians, which are
+ * computed with forward-mode automatic differentiation of the camera transformation,
+ * for the 2, 4, and 6 degrees of freedom of one, two, and three fingers. The solution of
+ * the previous frame is used as the initial guess as long as the same fingers are used.
  */
 class DirectInputSolver {
 public:
@@ -50,6 +55,21 @@ public:
         glm::dvec3 coordinates = glm::dvec3(0.0);
     };
 
+    /**
+     * The state of the camera and the selected node that the solved camera
+     * transformation is applied to
+     */
+    struct CameraState {
+        glm::dvec3 position = glm::dvec3(0.0);
+        glm::dquat rotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+        glm::dvec3 viewDirection = glm::dvec3(0.0, 0.0, -1.0);
+        glm::dvec3 lookUpWorldSpace = glm::dvec3(0.0, 1.0, 0.0);
+        glm::dvec3 lookUpCameraSpace = glm::dvec3(0.0, 1.0, 0.0);
+        glm::dmat4 projection = glm::dmat4(1.0);
+        glm::dvec3 nodePosition = glm::dvec3(0.0);
+        glm::dmat3 nodeRotation = glm::dmat3(1.0);
+    };
+
     DirectInputSolver();
 
     /**
@@ -61,6 +81,23 @@ public:
         const std::vector<SelectedBody>& selectedBodies,
         std::vector<double>* calculatedValues, const Camera& camera);
 
+    /**
+     * Solves for the camera transformation that moves the \p surfacePoints (in the
+     * coordinate system of the node) to the \p screenPoints (in normalized device
+     * coordinates). At most three points are used. The \p calculatedValues are the
+     * initial guess unless there is a previous solution with the same number of degrees
+     * of freedom, and contain the solution afterwards.
+     */
+    bool solve(const CameraState& state, const std::vector<glm::dvec3>& surfacePoints,
+        const std::vector<glm::dvec2>& screenPoints,
+        std::vector<double>* calculatedValues);
+
+    /**
+     * Discards the previous solution so that the next solve does not use it as the
+     * initial guess.
+     */
+    void resetWarmStart();
+
     int nDof() const;
 
     const LMstat& levMarqStat();
@@ -70,6 +107,10 @@ public:
 private:
     int _nDof = 0;
     LMstat _lmstat;
+
+    std::vector<size_t> _warmStartFingerIds;
+    int _warmStartDof = 0;
+    std::array<double, 6> _warmStart = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
 };
 
 } // openspace namespace
@@ -22,190 +22,458 @@
  * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
  ****************************************************************************************/
 
-#include <modules/touch/include/touchinteraction.h>
+#include <modules/touch/include/directinputsolver.h>
 
 #include <openspace/camera/camera.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <cmath>
 
 namespace {
-    // Used in the LM algorithm
-    struct FunctionData {
-        std::vector<glm::dvec3> selectedPoints;
-        std::vector<glm::dvec2> screenPoints;
-        int nDOF;
-        const openspace::Camera* camera;
-        openspace::SceneGraphNode* node;
-        LMstat stats;
+    // The smallest value that is used as the damping of a diagonal element of the
+    // approximated Hessian, to keep it positive definite for degenerate configurations
+    constexpr double DiagonalFloor = 1e-12;
+
+    // A number with its derivatives with respect to N parameters. Evaluating the camera
+    // transformation with this type instead of double yields the exact Jacobian together
+    // with the residuals
+    template <int N>
+    struct Dual {
+        Dual(double value = 0.0) : v(value) {}
+
+        static Dual variable(double value, int index) {
+            Dual res(value);
+            res.d[index] = 1.0;
+            return res;
+        }
+
+        friend Dual operator+(const Dual& a, const Dual& b) {
+            Dual res(a.v + b.v);
+            for (int i = 0; i < N; i++) {
+                res.d[i] = a.d[i] + b.d[i];
+            }
+            return res;
+        }
+
+        friend Dual operator-(const Dual& a, const Dual& b) {
+            Dual res(a.v - b.v);
+            for (int i = 0; i < N; i++) {
+                res.d[i] = a.d[i] - b.d[i];
+            }
+            return res;
+        }
+
+        friend Dual operator-(const Dual& a) {
+            Dual res(-a.v);
+            for (int i = 0; i < N; i++) {
+                res.d[i] = -a.d[i];
+            }
+            return res;
+        }
+
+        friend Dual operator*(const Dual& a, const Dual& b) {
+            Dual res(a.v * b.v);
+            for (int i = 0; i < N; i++) {
+                res.d[i] = a.d[i] * b.v + a.v * b.d[i];
+            }
+            return res;
+        }
+
+        friend Dual operator/(const Dual& a, const Dual& b) {
+            Dual res(a.v / b.v);
+            const double invB = 1.0 / b.v;
+            for (int i = 0; i < N; i++) {
+                res.d[i] = (a.d[i] - res.v * b.d[i]) * invB;
+            }
+            return res;
+        }
+
+        friend Dual sqrt(const Dual& a) {
+            Dual res(std::sqrt(a.v));
+            const double f = 0.5 / res.v;
+            for (int i = 0; i < N; i++) {
+                res.d[i] = a.d[i] * f;
+            }
+            return res;
+        }
+
+        friend Dual sin(const Dual& a) {
+            Dual res(std::sin(a.v));
+            const double f = std::cos(a.v);
+            for (int i = 0; i < N; i++) {
+                res.d[i] = a.d[i] * f;
+            }
+            return res;
+        }
+
+        friend Dual cos(const Dual& a) {
+            Dual res(std::cos(a.v));
+            const double f = -std::sin(a.v);
+            for (int i = 0; i < N; i++) {
+                res.d[i] = a.d[i] * f;
+            }
+            return res;
+        }
+
+        double v = 0.0;
+        std::array<double, N> d = {};
     };
-} // namespace
 
-namespace openspace {
+    template <typename T>
+    struct Vec3 {
+        T x;
+        T y;
+        T z;
+    };
 
-DirectInputSolver::DirectInputSolver() {
-    levmarq_init(&_lmstat);
-}
+    template <typename T>
+    Vec3<T> toVec3(const glm::dvec3& v) {
+        return { T(v.x), T(v.y), T(v.z) };
+    }
 
-// project back a 3D point in model view to clip space [-1,1] coordinates on the view
-// plane
-glm::dvec2 castToNDC(const glm::dvec3& vec, Camera& camera, SceneGraphNode* node) {
-    glm::dvec3 posInCamSpace = glm::inverse(camera.rotationQuaternion()) *
-        (node->worldRotationMatrix() * vec +
-        (node->worldPosition() - camera.positionVec3()));
+    template <typename T>
+    Vec3<T> operator+(const Vec3<T>& a, const Vec3<T>& b) {
+        return { a.x + b.x, a.y + b.y, a.z + b.z };
+    }
 
-    glm::dvec4 clipspace = camera.projectionMatrix() * glm::dvec4(posInCamSpace, 1.0);
-    return (glm::dvec2(clipspace) / clipspace.w);
-}
+    template <typename T>
+    Vec3<T> operator-(const Vec3<T>& a, const Vec3<T>& b) {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
 
-// Returns the screen point s(xi,par) dependent the transform M(par) and object point xi
-double distToMinimize(double* par, int x, void* fdata, LMstat* lmstat) {
-    FunctionData* ptr = reinterpret_cast<FunctionData*>(fdata);
+    template <typename T>
+    Vec3<T> operator*(const Vec3<T>& a, const T& s) {
+        return { a.x * s, a.y * s, a.z * s };
+    }
 
-    // Apply transform to camera and find the new screen point of the updated camera state
+    template <typename T>
+    T dot(const Vec3<T>& a, const Vec3<T>& b) {
+        return a.x * b.x + a.y * b.y + a.z * b.z;
+    }
 
-    // { vec2 globalRot, zoom, roll, vec2 localRot }
-    double q[6] = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
-    for (int i = 0; i < ptr->nDOF; ++i) {
-        q[i] = par[i];
+    template <typename T>
+    Vec3<T> cross(const Vec3<T>& a, const Vec3<T>& b) {
+        return {
+            a.y * b.z - a.z * b.y,
+            a.z * b.x - a.x * b.z,
+            a.x * b.y - a.y * b.x
+        };
     }
 
-    using namespace glm;
-    // Create variables from current state
-    dvec3 camPos = ptr->camera->positionVec3();
-    dvec3 centerPos = ptr->node->worldPosition();
-
-    dvec3 directionToCenter = normalize(centerPos - camPos);
-    dvec3 lookUp = ptr->camera->lookUpVectorWorldSpace();
-    dvec3 camDirection = ptr->camera->viewDirectionWorldSpace();
-
-    // Make a representation of the rotation quaternion with local and global
-    // rotations
-    dmat4 lookAtMat = lookAt(
-        dvec3(0, 0, 0),
-        directionToCenter,
-        // To avoid problem with lookup in up direction
-        normalize(camDirection + lookUp)
-    );
-    dquat globalCamRot = normalize(quat_cast(inverse(lookAtMat)));
-    dquat localCamRot = inverse(globalCamRot) * ptr->camera->rotationQuaternion();
+    template <typename T>
+    Vec3<T> normalize(const Vec3<T>& a) {
+        using std::sqrt;
+        const T invLength = T(1.0) / sqrt(dot(a, a));
+        return a * invLength;
+    }
 
-    {
-        // Roll
-        dquat rollRot = angleAxis(q[3], dvec3(0.0, 0.0, 1.0));
-        localCamRot = localCamRot * rollRot;
+    template <typename T>
+    struct Quat {
+        T w;
+        T x;
+        T y;
+        T z;
+    };
+
+    template <typename T>
+    Quat<T> toQuat(const glm::dquat& q) {
+        return { T(q.w), T(q.x), T(q.y), T(q.z) };
     }
-    {
-        // Panning (local rotation)
-        dvec3 eulerAngles(q[5], q[4], 0);
-        dquat panRot = dquat(eulerAngles);
-        localCamRot = localCamRot * panRot;
+
+    template <typename T>
+    Quat<T> operator*(const Quat<T>& p, const Quat<T>& q) {
+        return {
+            p.w * q.w - p.x * q.x - p.y * q.y - p.z * q.z,
+            p.w * q.x + p.x * q.w + p.y * q.z - p.z * q.y,
+            p.w * q.y + p.y * q.w + p.z * q.x - p.x * q.z,
+            p.w * q.z + p.z * q.w + p.x * q.y - p.y * q.x
+        };
+    }
+
+    template <typename T>
+    Quat<T> conjugate(const Quat<T>& q) {
+        return { q.w, -q.x, -q.y, -q.z };
     }
+
+    template <typename T>
+    Vec3<T> rotate(const Quat<T>& q, const Vec3<T>& v) {
+        const Vec3<T> u = { q.x, q.y, q.z };
+        const Vec3<T> t = cross(u, v) * T(2.0);
+        return v + t * q.w + cross(u, t);
+    }
+
+    // Equivalent to glm::dquat(glm::dvec3(pitch, yaw, 0.0))
+    template <typename T>
+    Quat<T> pitchYaw(const T& pitch, const T& yaw) {
+        using std::cos, std::sin;
+        const T cx = cos(pitch * T(0.5));
+        const T sx = sin(pitch * T(0.5));
+        const T cy = cos(yaw * T(0.5));
+        const T sy = sin(yaw * T(0.5));
+        return { cx * cy, sx * cy, cx * sy, -sx * sy };
+    }
+
+    // Equivalent to glm::angleAxis(angle, glm::dvec3(0.0, 0.0, 1.0))
+    template <typename T>
+    Quat<T> roll(const T& angle) {
+        using std::cos, std::sin;
+        return { cos(angle * T(0.5)), T(0.0), T(0.0), sin(angle * T(0.5)) };
+    }
+
+    // The parts of the camera transformation that do not depend on the parameters. All
+    // positions are relative to the center of the node to retain precision
+    struct Problem {
+        int nFingers = 0;
+        glm::dvec3 cameraOffset = glm::dvec3(0.0);
+        glm::dquat globalRotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+        glm::dquat localRotation = glm::dquat(1.0, 0.0, 0.0, 0.0);
+        glm::dvec3 lookUp = glm::dvec3(0.0);
+        glm::dmat4 projection = glm::dmat4(1.0);
+        std::array<glm::dvec3, 3> points;
+        std::array<glm::dvec2, 3> screenPoints;
+    };
+
+    Problem createProblem(const openspace::DirectInputSolver::CameraState& state,
+                          const std::vector<glm::dvec3>& surfacePoints,
+                          const std::vector<glm::dvec2>& screenPoints, int nFingers)
     {
-        // Orbit (global rotation)
-        dvec3 eulerAngles(q[1], q[0], 0);
-        dquat rotationDiffCamSpace = dquat(eulerAngles);
-
-        dvec3 centerToCamera = camPos - centerPos;
-
-        dquat rotationDiffWorldSpace =
-            globalCamRot * rotationDiffCamSpace * inverse(globalCamRot);
-        dvec3 rotationDiffVec3 = centerToCamera * rotationDiffWorldSpace - centerToCamera;
-        camPos += rotationDiffVec3;
-
-        centerToCamera = camPos - centerPos;
-        directionToCenter = normalize(-centerToCamera);
-        dvec3 lookUpWhenFacingCenter =
-            globalCamRot * dvec3(ptr->camera->lookUpVectorCameraSpace());
-        lookAtMat = lookAt(
-            dvec3(0, 0, 0),
+        using namespace glm;
+
+        Problem p;
+        p.nFingers = nFingers;
+        p.projection = state.projection;
+
+        // Make a representation of the rotation quaternion with local and global
+        // rotations
+        const dvec3 directionToCenter = normalize(state.nodePosition - state.position);
+        const dmat4 lookAtMat = lookAt(
+            dvec3(0.0),
             directionToCenter,
-            lookUpWhenFacingCenter
+            // To avoid problem with lookup in up direction
+            normalize(state.viewDirection + state.lookUpWorldSpace)
         );
-        globalCamRot = normalize(quat_cast(inverse(lookAtMat)));
+        p.globalRotation = normalize(quat_cast(inverse(lookAtMat)));
+        p.localRotation = inverse(p.globalRotation) * state.rotation;
+
+        // The orbit rotation is applied in the frame of the global rotation
+        const dvec3 centerToCamera = state.position - state.nodePosition;
+        p.cameraOffset = inverse(p.globalRotation) * centerToCamera;
+        p.lookUp = p.globalRotation * state.lookUpCameraSpace;
+
+        for (int i = 0; i < nFingers; i++) {
+            p.points[i] = state.nodeRotation * surfacePoints[i];
+            p.screenPoints[i] = screenPoints[i];
+        }
+        return p;
     }
-    { // Zooming
-        camPos += directionToCenter * q[2];
+
+    // Computes the difference between the projected surface points and the screen points
+    // after applying the camera transformation { vec2 globalRot, zoom, roll,
+    // vec2 localRot } in `q`
+    template <typename T>
+    void residuals(const Problem& p, const std::array<T, 6>& q, std::array<T, 6>& res) {
+        // Orbit (global rotation)
+        const Quat<T> orbit = pitchYaw(q[1], q[0]);
+        const Quat<T> globalRotation = toQuat<T>(p.globalRotation);
+        const Vec3<T> centerToCamera = rotate(
+            globalRotation,
+            rotate(conjugate(orbit), toVec3<T>(p.cameraOffset))
+        );
+
+        // The new global rotation looks at the center, it is stored as the rows of the
+        // inverse rotation matrix
+        const Vec3<T> forward = normalize(Vec3<T>{ T(0.0), T(0.0), T(0.0) } -
+            centerToCamera);
+        const Vec3<T> side = normalize(cross(forward, toVec3<T>(p.lookUp)));
+        const Vec3<T> up = cross(side, forward);
+
+        // Zooming
+        const Vec3<T> cameraPosition = centerToCamera + forward * q[2];
+
+        // Roll and panning (local rotation)
+        const Quat<T> inverseLocal = conjugate(
+            toQuat<T>(p.localRotation) * roll(q[3]) * pitchYaw(q[5], q[4])
+        );
+
+        const glm::dmat4& m = p.projection;
+        for (int i = 0; i < p.nFingers; i++) {
+            const Vec3<T> toPoint = toVec3<T>(p.points[i]) - cameraPosition;
+            const Vec3<T> inGlobal = {
+                dot(side, toPoint),
+                dot(up, toPoint),
+                T(0.0) - dot(forward, toPoint)
+            };
+            const Vec3<T> c = rotate(inverseLocal, inGlobal);
+
+            const T x = c.x * T(m[0][0]) + c.y * T(m[1][0]) + c.z * T(m[2][0]) +
+                T(m[3][0]);
+            const T y = c.x * T(m[0][1]) + c.y * T(m[1][1]) + c.z * T(m[2][1]) +
+                T(m[3][1]);
+            const T w = c.x * T(m[0][3]) + c.y * T(m[1][3]) + c.z * T(m[2][3]) +
+                T(m[3][3]);
+            res[2 * i] = x / w - T(p.screenPoints[i].x);
+            res[2 * i + 1] = y / w - T(p.screenPoints[i].y);
+        }
     }
-    // Update the camera state
-    Camera cam = *(ptr->camera);
-    cam.setPositionVec3(camPos);
-    cam.setRotation(globalCamRot * localCamRot);
-
-    // we now have a new position and orientation of camera, project surfacePoint to
-    // the new screen to get distance to minimize
-    glm::dvec2 newScreenPoint = castToNDC(
-        ptr->selectedPoints.at(x),
-        cam,
-        ptr->node
-    );
-    lmstat->pos.push_back(newScreenPoint);
-    return glm::length(ptr->screenPoints.at(x) - newScreenPoint);
-}
 
-// Gradient of distToMinimize w.r.t par (using forward difference)
-void gradient(double* g, double* par, int x, void* fdata, LMstat* lmstat) {
-    FunctionData* ptr = reinterpret_cast<FunctionData*>(fdata);
-    double f0 = distToMinimize(par, x, fdata, lmstat);
-    // scale value to find minimum step size h, dependant on planet size
-    double scale = log10(ptr->node->interactionSphere());
-    std::vector<double> dPar(ptr->nDOF, 0.0);
-    dPar.assign(par, par + ptr->nDOF);
-
-    for (int i = 0; i < ptr->nDOF; ++i) {
-        // Initial values
-        double h = 1e-8;
-        double lastG = 1;
-        dPar.at(i) += h;
-        double f1 = distToMinimize(dPar.data(), x, fdata, lmstat);
-        dPar.at(i) = par[i];
-        // Iterative process to find the minimum step h that gives a good gradient
-        for (int j = 0; j < 100; ++j) {
-            if ((f1 - f0) != 0 && lastG == 0) { // found minimum step size h
-                // scale up to get a good initial guess value
-                h *= scale * scale * scale;
-
-                // clamp min step size to a fraction of the incoming parameter
-                if (i == 2) {
-                    double epsilon = 1e-3;
-                    // make sure incoming parameter is larger than 0
-                    h = std::max(std::max(std::abs(dPar.at(i)), epsilon) * 0.001, h);
-                }
-                else if (ptr->nDOF == 2) {
-                    h = std::max(std::abs(dPar.at(i)) * 0.001, h);
+    // Solves A x = b for the symmetric positive-definite N x N matrix A using the
+    // Cholesky decomposition. Returns false if A is not positive definite
+    template <int N>
+    bool solveCholesky(std::array<double, N * N> a, const std::array<double, N>& b,
+                       std::array<double, N>& x)
+    {
+        constexpr double Tolerance = 1e-30;
+
+        // Decompose A = L L^T in place
+        for (int i = 0; i < N; i++) {
+            for (int j = 0; j < i; j++) {
+                double sum = a[i * N + j];
+                for (int k = 0; k < j; k++) {
+                    sum -= a[i * N + k] * a[j * N + k];
                 }
-
-                // calculate f1 with good h for finite difference
-                dPar[i] += h;
-                f1 = distToMinimize(dPar.data(), x, fdata, lmstat);
-                dPar[i] = par[i];
-                break;
+                a[i * N + j] = sum / a[j * N + j];
             }
-            else if ((f1 - f0) != 0 && lastG != 0) {
-                // h too big
-                h /= scale;
+            double sum = a[i * N + i];
+            for (int k = 0; k < i; k++) {
+                sum -= a[i * N + k] * a[i * N + k];
             }
-            else if ((f1 - f0) == 0) {
-                // h too small
-                h *= scale;
+            if (!(sum > Tolerance)) {
+                return false;
             }
-            lastG = f1 - f0;
-            dPar.at(i) += h;
-            f1 = distToMinimize(dPar.data(), x, fdata, lmstat);
-            dPar.at(i) = par[i];
+            a[i * N + i] = std::sqrt(sum);
         }
-        g[i] = (f1 - f0) / h;
-    }
-    if (ptr->nDOF == 2) {
-        // normalize on 1 finger case to allow for horizontal/vertical movement
-        for (int i = 0; i < 2; ++i) {
-            g[i] = g[i] / std::abs(g[i]);
+
+        // Solve L y = b and L^T x = y
+        for (int i = 0; i < N; i++) {
+            double sum = b[i];
+            for (int k = 0; k < i; k++) {
+                sum -= a[i * N + k] * x[k];
+            }
+            x[i] = sum / a[i * N + i];
+        }
+        for (int i = N - 1; i >= 0; i--) {
+            double sum = x[i];
+            for (int k = i + 1; k < N; k++) {
+                sum -= a[k * N + i] * x[k];
+            }
+            x[i] = sum / a[i * N + i];
         }
+        return true;
     }
-    else if (ptr->nDOF == 6) {
-        for (int i = 0; i < ptr->nDOF; ++i) {
-            // lock to only pan and zoom on 3 finger case, no roll/orbit
-            g[i] = (i == 2) ? g[i] : g[i] / std::abs(g[i]);
+
+    // Runs the Levenberg-Marquardt algorithm for NDof parameters, with two residuals for
+    // each of the NDof / 2 fingers, using the settings in `stat`
+    template <int NDof>
+    bool levenbergMarquardt(const Problem& p, std::array<double, 6>& par, LMstat& stat) {
+        constexpr int NResiduals = NDof;
+        using D = Dual<NDof>;
+
+        auto errorAt = [&p](const std::array<double, 6>& q) {
+            std::array<double, 6> r;
+            residuals(p, q, r);
+            double err = 0.0;
+            for (int i = 0; i < NResiduals; i++) {
+                err += r[i] * r[i];
+            }
+            return err;
+        };
+
+        // Computes the Gauss-Newton approximation of the Hessian J^T J and the negative
+        // gradient -J^T r at the current parameters and returns the error
+        std::array<double, NDof * NDof> hessian;
+        std::array<double, NDof> gradient;
+        auto linearize = [&]() {
+            std::array<D, 6> q;
+            for (int i = 0; i < 6; i++) {
+                q[i] = i < NDof ? D::variable(par[i], i) : D(par[i]);
+            }
+            std::array<D, 6> r;
+            residuals(p, q, r);
+
+            hessian.fill(0.0);
+            gradient.fill(0.0);
+            double err = 0.0;
+            for (int k = 0; k < NResiduals; k++) {
+                err += r[k].v * r[k].v;
+                for (int i = 0; i < NDof; i++) {
+                    gradient[i] -= r[k].d[i] * r[k].v;
+                    for (int j = 0; j <= i; j++) {
+                        hessian[i * NDof + j] += r[k].d[i] * r[k].d[j];
+                    }
+                }
+            }
+            return err;
+        };
+
+        double lambda = stat.init_lambda;
+        double err = linearize();
+        double derr = 0.0;
+        bool hasConverged = false;
+        int it = 0;
+        while (it < stat.max_it) {
+            // Make a step and increase the damping until the step reduces the error
+            std::array<double, 6> newPar = par;
+            double newErr = err;
+            bool isAccepted = false;
+            while (!isAccepted && it < stat.max_it) {
+                std::array<double, NDof * NDof> a = hessian;
+                for (int i = 0; i < NDof; i++) {
+                    a[i * NDof + i] += lambda * std::max(a[i * NDof + i], DiagonalFloor);
+                }
+                std::array<double, NDof> delta;
+                if (solveCholesky<NDof>(a, gradient, delta)) {
+                    for (int i = 0; i < NDof; i++) {
+                        newPar[i] = par[i] + delta[i];
+                    }
+                    newErr = errorAt(newPar);
+                    isAccepted = newErr <= err;
+                }
+                if (!isAccepted) {
+                    lambda *= stat.up_factor;
+                    it++;
+                }
+            }
+            if (!isAccepted) {
+                break;
+            }
+
+            derr = newErr - err;
+            par = newPar;
+            lambda /= stat.down_factor;
+            it++;
+            if (-derr < stat.target_derr) {
+                err = newErr;
+                hasConverged = true;
+                break;
+            }
+            err = linearize();
+        }
+
+        stat.final_it = it;
+        stat.final_err = err;
+        stat.final_derr = derr;
+        stat.data.clear();
+
+        // Store the final projected positions of the surface points for debugging
+        std::array<double, 6> r;
+        residuals(p, par, r);
+        stat.pos.clear();
+        for (int i = 0; i < p.nFingers; i++) {
+            stat.pos.push_back(
+                p.screenPoints[i] + glm::dvec2(r[2 * i], r[2 * i + 1])
+            );
         }
+
+        return hasConverged && std::isfinite(err);
     }
+} // namespace
+
+namespace openspace {
+
+DirectInputSolver::DirectInputSolver() {
+    levmarq_init(&_lmstat);
 }
 
 bool DirectInputSolver::solve(const std::vector<TouchInputHolder>& list,
@@ -219,12 +487,12 @@ bool DirectInputSolver::solve(const std::vector<TouchInputHolder>& list,
         "Number of touch inputs must match the number of 'selected bodies'"
     );
 
-    int nFingers = std::min(static_cast<int>(list.size()), 3);
-    _nDof = std::min(nFingers * 2, 6);
+    const int nFingers = std::min(static_cast<int>(list.size()), 3);
 
     // Parse input data to be used in the LM algorithm
     std::vector<glm::dvec3> selectedPoints;
     std::vector<glm::dvec2> screenPoints;
+    std::vector<size_t> fingerIds;
 
     for (int i = 0; i < nFingers; ++i) {
         const SelectedBody& sb = selectedBodies.at(i);
@@ -233,32 +501,84 @@ bool DirectInputSolver::solve(const std::vector<TouchInputHolder>& list,
             2.0 * (list[i].latestInput().x - 0.5),
             -2.0 * (list[i].latestInput().y - 0.5)
         );
+        fingerIds.push_back(list[i].fingerId());
     }
 
-    FunctionData fData = {
-        .selectedPoints = selectedPoints,
-        .screenPoints = screenPoints,
-        .nDOF = _nDof,
-        .camera = &camera,
-        .node = selectedBodies.at(0).node,
-        .stats = _lmstat
+    // The previous solution is only a good guess if the same fingers are still used
+    if (fingerIds != _warmStartFingerIds) {
+        resetWarmStart();
+        _warmStartFingerIds = std::move(fingerIds);
+    }
+
+    const SceneGraphNode* node = selectedBodies.at(0).node;
+    CameraState state = {
+        .position = camera.positionVec3(),
+        .rotation = camera.rotationQuaternion(),
+        .viewDirection = camera.viewDirectionWorldSpace(),
+        .lookUpWorldSpace = camera.lookUpVectorWorldSpace(),
+        .lookUpCameraSpace = camera.lookUpVectorCameraSpace(),
+        .projection = glm::dmat4(camera.projectionMatrix()),
+        .nodePosition = node->worldPosition(),
+        .nodeRotation = node->worldRotationMatrix()
     };
-    void* dataPtr = reinterpret_cast<void*>(&fData);
-
-    bool result = levmarq(
-        _nDof,
-        parameters->data(),
-        static_cast<int>(screenPoints.size()),
-        nullptr,
-        distToMinimize,
-        gradient,
-        dataPtr,
-        &_lmstat
+    return solve(state, selectedPoints, screenPoints, parameters);
+}
+
+bool DirectInputSolver::solve(const CameraState& state,
+                              const std::vector<glm::dvec3>& surfacePoints,
+                              const std::vector<glm::dvec2>& screenPoints,
+                              std::vector<double>* parameters)
+{
+    ghoul_assert(
+        surfacePoints.size() == screenPoints.size(),
+        "Number of surface points must match the number of screen points"
     );
+    ghoul_assert(parameters->size() >= 6, "Parameters must have 6 elements");
+
+    const int nFingers = std::min(static_cast<int>(surfacePoints.size()), 3);
+    _nDof = nFingers * 2;
+    if (_nDof == 0) {
+        return false;
+    }
+
+    const Problem problem = createProblem(state, surfacePoints, screenPoints, nFingers);
+
+    std::array<double, 6> par = { 0.0, 0.0, 0.0, 0.0, 0.0, 0.0 };
+    if (_warmStartDof == _nDof) {
+        par = _warmStart;
+    }
+    else {
+        std::copy_n(parameters->begin(), _nDof, par.begin());
+    }
 
+    bool result = false;
+    switch (_nDof) {
+        case 2:
+            result = levenbergMarquardt<2>(problem, par, _lmstat);
+            break;
+        case 4:
+            result = levenbergMarquardt<4>(problem, par, _lmstat);
+            break;
+        case 6:
+            result = levenbergMarquardt<6>(problem, par, _lmstat);
+            break;
+    }
+
+    std::copy_n(par.begin(), _nDof, parameters->begin());
+    if (result) {
+        _warmStart = par;
+        _warmStartDof = _nDof;
+    }
+    else {
+        _warmStartDof = 0;
+    }
     return result;
 }
 
+void DirectInputSolver::resetWarmStart() {
+    _warmStartDof = 0;
+}
+
 int DirectInputSolver::nDof() const {
     return _nDof;
 }
@@ -272,4 +592,3 @@ void DirectInputSolver::setLevMarqVerbosity(bool verbose) {
 }
 
 } // openspace namespace
-
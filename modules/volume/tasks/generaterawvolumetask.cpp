@@ -27,6 +27,7 @@
 #include <modules/volume/rawvolume.h>
 #include <modules/volume/rawvolumemetadata.h>
 #include <modules/volume/rawvolumewriter.h>
+#include <modules/volume/valueexpression.h>
 #include <openspace/documentation/verifier.h>
 #include <openspace/util/time.h>
 #include <openspace/util/spicemanager.h>
@@ -38,10 +39,16 @@
 #include <ghoul/lua/lua_helper.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
 #include <ghoul/misc/defer.h>
+#include <algorithm>
+#include <atomic>
 #include <filesystem>
 #include <fstream>
+#include <optional>
+#include <thread>
 
 namespace {
+    constexpr std::string_view _loggerCat = "GenerateRawVolumeTask";
+
     struct [[codegen::Dictionary(GenerateRawVolumeTask)]] Parameters {
         // The Lua function used to compute the cell values
         std::string valueFunction [[codegen::annotation("A Lua expression that returns a "
@@ -100,6 +107,24 @@ std::string GenerateRawVolumeTask::description() {
     );
 }
 
+std::vector<std::filesystem::path> GenerateRawVolumeTask::outputs() const {
+    return { _rawVolumeOutputPath, _dictionaryOutputPath };
+}
+
+size_t GenerateRawVolumeTask::memoryEstimate() const {
+    return static_cast<size_t>(_dimensions.x) * _dimensions.y * _dimensions.z *
+        sizeof(float);
+}
+
+bool GenerateRawVolumeTask::canRunConcurrently() const {
+    // Loads and unloads a kernel in the SpiceManager, which is not thread-safe
+    return false;
+}
+
+unsigned int GenerateRawVolumeTask::requestedThreads() const {
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
 void GenerateRawVolumeTask::perform(const Task::ProgressCallback& progressCallback) {
     // Spice kernel is required for time conversions.
     // Todo: Make this dependency less hard coded.
@@ -114,55 +139,122 @@ void GenerateRawVolumeTask::perform(const Task::ProgressCallback& progressCallba
     volume::RawVolume<float> rawVolume(_dimensions);
     progressCallback(0.1f);
 
-    ghoul::lua::LuaState state;
-    ghoul::lua::runScript(state, _valueFunctionLua);
-
-#if (defined(NDEBUG) || defined(DEBUG))
-    ghoul::lua::verifyStackSize(state, 1);
-#endif
-
-    int functionReference = luaL_ref(state, LUA_REGISTRYINDEX);
+    // If the value function only consists of simple arithmetic, we can evaluate it
+    // without going through Lua at all
+    const std::optional<ValueExpression> expression =
+        ValueExpression::compile(_valueFunctionLua);
+    if (expression.has_value()) {
+        LDEBUG("Evaluating value function without Lua");
+    }
 
-#if (defined(NDEBUG) || defined(DEBUG))
-    ghoul::lua::verifyStackSize(state, 0);
-#endif
+    const glm::dvec3 lowerBound = _lowerDomainBound;
+    const glm::dvec3 domainSize = glm::dvec3(_upperDomainBound - _lowerDomainBound);
+    const glm::dvec3 dimensions = glm::dvec3(_dimensions);
+    float* data = rawVolume.data();
+
+    // The volume is partitioned into slabs of constant z that the workers claim one at a
+    // time. Each worker writes directly into its own part of the volume buffer
+    const unsigned int nSlabs = _dimensions.z;
+    const size_t slabSize = static_cast<size_t>(_dimensions.x) * _dimensions.y;
+    std::atomic<unsigned int> nextSlab = 0;
+    std::atomic<unsigned int> nFinishedSlabs = 0;
+    std::atomic_bool hasFailed = false;
+
+    struct WorkerResult {
+        float minValue = std::numeric_limits<float>::max();
+        float maxValue = std::numeric_limits<float>::lowest();
+        std::exception_ptr exception;
+    };
 
-    glm::vec3 domainSize = _upperDomainBound - _lowerDomainBound;
+    const unsigned int nWorkers = std::clamp(numThreads(), 1u, std::max(nSlabs, 1u));
+    std::vector<WorkerResult> results(nWorkers);
+
+    auto worker = [&](WorkerResult& result, bool reportProgress) {
+        try {
+            // Every worker needs its own Lua state as they are not thread-safe
+            std::optional<ghoul::lua::LuaState> state;
+            int functionReference = LUA_NOREF;
+            if (!expression.has_value()) {
+                state.emplace();
+                ghoul::lua::runScript(*state, _valueFunctionLua);
+                functionReference = luaL_ref(*state, LUA_REGISTRYINDEX);
+            }
+
+            auto evaluate = [&](const glm::dvec3& coord) -> float {
+                if (expression.has_value()) {
+                    return static_cast<float>(
+                        expression->evaluate(coord.x, coord.y, coord.z)
+                    );
+                }
+
+                lua_rawgeti(*state, LUA_REGISTRYINDEX, functionReference);
+                lua_pushnumber(*state, coord.x);
+                lua_pushnumber(*state, coord.y);
+                lua_pushnumber(*state, coord.z);
+                if (lua_pcall(*state, 3, 1, 0) != LUA_OK) {
+                    throw ghoul::lua::LuaRuntimeException(fmt::format(
+                        "Error evaluating value function: {}",
+                        ghoul::lua::value<std::string>(*state)
+                    ));
+                }
+                const float value = static_cast<float>(luaL_checknumber(*state, 1));
+                lua_pop(*state, 1);
+                return value;
+            };
+
+            for (unsigned int z = nextSlab++; z < nSlabs && !hasFailed; z = nextSlab++) {
+                float* slab = data + z * slabSize;
+                for (unsigned int y = 0; y < _dimensions.y; y++) {
+                    for (unsigned int x = 0; x < _dimensions.x; x++) {
+                        const glm::dvec3 coord = lowerBound +
+                            glm::dvec3(x, y, z) / dimensions * domainSize;
+
+                        const float value = evaluate(coord);
+                        slab[x + y * _dimensions.x] = value;
+                        result.minValue = std::min(result.minValue, value);
+                        result.maxValue = std::max(result.maxValue, value);
+                    }
+                }
+
+                const unsigned int nFinished = ++nFinishedSlabs;
+                if (reportProgress) {
+                    progressCallback(
+                        0.1f + 0.8f * static_cast<float>(nFinished) / nSlabs
+                    );
+                }
+            }
+
+            if (state.has_value()) {
+                luaL_unref(*state, LUA_REGISTRYINDEX, functionReference);
+            }
+        }
+        catch (...) {
+            result.exception = std::current_exception();
+            hasFailed = true;
+        }
+    };
 
+    // The calling thread acts as the first worker so that the progress callback is only
+    // ever called from the thread that called this function
+    std::vector<std::thread> threads;
+    threads.reserve(nWorkers - 1);
+    for (unsigned int i = 1; i < nWorkers; i++) {
+        threads.emplace_back(worker, std::ref(results[i]), false);
+    }
+    worker(results[0], true);
+    for (std::thread& t : threads) {
+        t.join();
+    }
 
     float minVal = std::numeric_limits<float>::max();
-    float maxVal = std::numeric_limits<float>::min();
-
-    rawVolume.forEachVoxel([&](glm::uvec3 cell, float) {
-        glm::vec3 coord = _lowerDomainBound +
-            glm::vec3(cell) / glm::vec3(_dimensions) * domainSize;
-
-#if (defined(NDEBUG) || defined(DEBUG))
-        ghoul::lua::verifyStackSize(state, 0);
-#endif
-        lua_rawgeti(state, LUA_REGISTRYINDEX, functionReference);
-
-        lua_pushnumber(state, coord.x);
-        lua_pushnumber(state, coord.y);
-        lua_pushnumber(state, coord.z);
-
-#if (defined(NDEBUG) || defined(DEBUG))
-        ghoul::lua::verifyStackSize(state, 4);
-#endif
-
-        if (lua_pcall(state, 3, 1, 0) != LUA_OK) {
-            return;
+    float maxVal = std::numeric_limits<float>::lowest();
+    for (const WorkerResult& result : results) {
+        if (result.exception) {
+            std::rethrow_exception(result.exception);
         }
-
-        float value = static_cast<float>(luaL_checknumber(state, 1));
-        lua_pop(state, 1);
-        rawVolume.set(cell, value);
-
-        minVal = std::min(minVal, value);
-        maxVal = std::max(maxVal, value);
-    });
-
-    luaL_unref(state, LUA_REGISTRYINDEX, functionReference);
+        minVal = std::min(minVal, result.minValue);
+        maxVal = std::max(maxVal, result.maxValue);
+    }
 
     const std::filesystem::path directory = _rawVolumeOutputPath.parent_path();
     if (!std::filesystem::is_directory(directory)) {
@@ -172,8 +264,6 @@ void GenerateRawVolumeTask::perform(const Task::ProgressCallback& progressCallba
     volume::RawVolumeWriter<float> writer(_rawVolumeOutputPath.string());
     writer.write(rawVolume);
 
-    progressCallback(0.9f);
-
     RawVolumeMetadata metadata;
     metadata.time = Time::convertTime(_time);
     metadata.dimensions = _dimensions;
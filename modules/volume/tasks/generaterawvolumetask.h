@@ -37,6 +37,10 @@ class GenerateRawVolumeTask : public Task {
 public:
     GenerateRawVolumeTask(const ghoul::Dictionary& dictionary);
     std::string description() override;
+    std::vector<std::filesystem::path> outputs() const override;
+    size_t memoryEstimate() const override;
+    bool canRunConcurrently() const override;
+    unsigned int requestedThreads() const override;
     void perform(const Task::ProgressCallback& progressCallback) override;
     static documentation::Documentation Documentation();
 
@@ -0,0 +1,430 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <modules/volume/valueexpression.h>
+
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <string>
+
+namespace {
+    // Expressions that need a deeper stack than this are evaluated through Lua instead
+    constexpr size_t MaxStackSize = 64;
+
+    struct Token {
+        enum class Type {
+            Number,
+            Name,
+            Symbol,
+            End
+        };
+
+        Type type = Type::End;
+        std::string_view text;
+        double number = 0.0;
+    };
+
+    std::optional<std::vector<Token>> tokenize(std::string_view source) {
+        std::vector<Token> tokens;
+        size_t i = 0;
+        while (i < source.size()) {
+            const char c = source[i];
+            if (std::isspace(static_cast<unsigned char>(c))) {
+                i++;
+            }
+            else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+                const size_t begin = i;
+                while (i < source.size() &&
+                       (std::isalnum(static_cast<unsigned char>(source[i])) ||
+                        source[i] == '_'))
+                {
+                    i++;
+                }
+                tokens.push_back({
+                    Token::Type::Name,
+                    source.substr(begin, i - begin)
+                });
+            }
+            else if (std::isdigit(static_cast<unsigned char>(c)) ||
+                     (c == '.' && i + 1 < source.size() &&
+                      std::isdigit(static_cast<unsigned char>(source[i + 1]))))
+            {
+                if (c == '0' && i + 1 < source.size() &&
+                    (source[i + 1] == 'x' || source[i + 1] == 'X'))
+                {
+                    // Hexadecimal numbers are not supported
+                    return std::nullopt;
+                }
+                Token t;
+                t.type = Token::Type::Number;
+                const char* begin = source.data() + i;
+                const char* end = source.data() + source.size();
+                auto [ptr, ec] = std::from_chars(begin, end, t.number);
+                if (ec != std::errc()) {
+                    return std::nullopt;
+                }
+                t.text = source.substr(i, ptr - begin);
+                i += ptr - begin;
+                tokens.push_back(t);
+            }
+            else if (c == '-' && i + 1 < source.size() && source[i + 1] == '-') {
+                // Comments are not supported
+                return std::nullopt;
+            }
+            else if (std::string_view("+-*/%^(),.").find(c) != std::string_view::npos) {
+                tokens.push_back({ Token::Type::Symbol, source.substr(i, 1) });
+                i++;
+            }
+            else {
+                return std::nullopt;
+            }
+        }
+        tokens.push_back({ Token::Type::End, std::string_view() });
+        return tokens;
+    }
+} // namespace
+
+namespace openspace::volume {
+
+/**
+ * A recursive descent parser that follows the operator precedence of Lua.
+ */
+class ExpressionParser {
+public:
+    ExpressionParser(std::vector<Token> tokens) : _tokens(std::move(tokens)) {}
+
+    std::optional<ValueExpression> parse() {
+        try {
+            expectName("return");
+            expectName("function");
+            expectSymbol('(');
+            _arguments[0] = name();
+            expectSymbol(',');
+            _arguments[1] = name();
+            expectSymbol(',');
+            _arguments[2] = name();
+            expectSymbol(')');
+            expectName("return");
+            expression();
+            expectName("end");
+            if (current().type != Token::Type::End) {
+                return std::nullopt;
+            }
+        }
+        catch (const ghoul::RuntimeError&) {
+            return std::nullopt;
+        }
+
+        if (_maxStackSize > MaxStackSize) {
+            return std::nullopt;
+        }
+        _result._maxStackSize = _maxStackSize;
+        return std::move(_result);
+    }
+
+private:
+    using OpCode = ValueExpression::OpCode;
+
+    const Token& current() const {
+        return _tokens[_position];
+    }
+
+    bool isSymbol(char c) const {
+        return current().type == Token::Type::Symbol && current().text[0] == c;
+    }
+
+    [[noreturn]] void fail() const {
+        throw ghoul::RuntimeError("Unsupported expression", "ValueExpression");
+    }
+
+    void expectSymbol(char c) {
+        if (!isSymbol(c)) {
+            fail();
+        }
+        _position++;
+    }
+
+    void expectName(std::string_view n) {
+        if (current().type != Token::Type::Name || current().text != n) {
+            fail();
+        }
+        _position++;
+    }
+
+    std::string_view name() {
+        if (current().type != Token::Type::Name) {
+            fail();
+        }
+        return _tokens[_position++].text;
+    }
+
+    void emit(OpCode code, double value = 0.0) {
+        _result._program.push_back({ code, value });
+
+        // Keep track of the stack depth that is needed for the evaluation
+        switch (code) {
+            case OpCode::Constant:
+            case OpCode::X:
+            case OpCode::Y:
+            case OpCode::Z:
+                _stackSize++;
+                _maxStackSize = std::max(_maxStackSize, _stackSize);
+                break;
+            case OpCode::Add:
+            case OpCode::Subtract:
+            case OpCode::Multiply:
+            case OpCode::Divide:
+            case OpCode::Modulo:
+            case OpCode::Power:
+            case OpCode::Min:
+            case OpCode::Max:
+                _stackSize--;
+                break;
+            default:
+                break;
+        }
+    }
+
+    // expression := term { ('+' | '-') term }
+    void expression() {
+        term();
+        while (isSymbol('+') || isSymbol('-')) {
+            const bool isAdd = isSymbol('+');
+            _position++;
+            term();
+            emit(isAdd ? OpCode::Add : OpCode::Subtract);
+        }
+    }
+
+    // term := unary { ('*' | '/' | '%') unary }
+    void term() {
+        unary();
+        while (isSymbol('*') || isSymbol('/') || isSymbol('%')) {
+            const char op = current().text[0];
+            _position++;
+            unary();
+            emit(
+                op == '*' ? OpCode::Multiply :
+                op == '/' ? OpCode::Divide :
+                OpCode::Modulo
+            );
+        }
+    }
+
+    // unary := '-' unary | power
+    void unary() {
+        if (isSymbol('-')) {
+            _position++;
+            unary();
+            emit(OpCode::Negate);
+        }
+        else {
+            power();
+        }
+    }
+
+    // power := primary [ '^' unary ]     (right associative, binds tighter than unary)
+    void power() {
+        primary();
+        if (isSymbol('^')) {
+            _position++;
+            unary();
+            emit(OpCode::Power);
+        }
+    }
+
+    // primary := number | argument | '(' expression ')' | 'math' '.' function
+    void primary() {
+        if (current().type == Token::Type::Number) {
+            emit(OpCode::Constant, current().number);
+            _position++;
+            return;
+        }
+        if (isSymbol('(')) {
+            _position++;
+            expression();
+            expectSymbol(')');
+            return;
+        }
+
+        const std::string_view n = name();
+        if (n == _arguments[0]) {
+            emit(OpCode::X);
+        }
+        else if (n == _arguments[1]) {
+            emit(OpCode::Y);
+        }
+        else if (n == _arguments[2]) {
+            emit(OpCode::Z);
+        }
+        else if (n == "math") {
+            expectSymbol('.');
+            mathFunction(name());
+        }
+        else {
+            fail();
+        }
+    }
+
+    void mathFunction(std::string_view function) {
+        if (function == "pi") {
+            emit(OpCode::Constant, glm::pi<double>());
+            return;
+        }
+
+        struct Entry {
+            std::string_view name;
+            OpCode code;
+            bool isVariadic;
+        };
+        constexpr std::array<Entry, 11> Functions = {
+            Entry{ "abs", OpCode::Abs, false },
+            Entry{ "sqrt", OpCode::Sqrt, false },
+            Entry{ "exp", OpCode::Exp, false },
+            Entry{ "log", OpCode::Log, false },
+            Entry{ "sin", OpCode::Sin, false },
+            Entry{ "cos", OpCode::Cos, false },
+            Entry{ "tan", OpCode::Tan, false },
+            Entry{ "floor", OpCode::Floor, false },
+            Entry{ "ceil", OpCode::Ceil, false },
+            Entry{ "min", OpCode::Min, true },
+            Entry{ "max", OpCode::Max, true }
+        };
+        auto it = std::find_if(
+            Functions.begin(),
+            Functions.end(),
+            [function](const Entry& e) { return e.name == function; }
+        );
+        if (it == Functions.end()) {
+            fail();
+        }
+
+        expectSymbol('(');
+        expression();
+        if (it->isVariadic) {
+            // math.min(a, b, c) is evaluated as min(min(a, b), c)
+            while (isSymbol(',')) {
+                _position++;
+                expression();
+                emit(it->code);
+            }
+        }
+        else {
+            emit(it->code);
+        }
+        expectSymbol(')');
+    }
+
+    std::vector<Token> _tokens;
+    size_t _position = 0;
+    std::array<std::string_view, 3> _arguments;
+    size_t _stackSize = 0;
+    size_t _maxStackSize = 0;
+    ValueExpression _result;
+};
+
+std::optional<ValueExpression> ValueExpression::compile(std::string_view source) {
+    std::optional<std::vector<Token>> tokens = tokenize(source);
+    if (!tokens.has_value()) {
+        return std::nullopt;
+    }
+    return ExpressionParser(std::move(*tokens)).parse();
+}
+
+double ValueExpression::evaluate(double x, double y, double z) const {
+    std::array<double, MaxStackSize> stack;
+    size_t top = 0;
+
+    for (const Instruction& instr : _program) {
+        switch (instr.code) {
+            case OpCode::Constant: stack[top++] = instr.value; break;
+            case OpCode::X: stack[top++] = x; break;
+            case OpCode::Y: stack[top++] = y; break;
+            case OpCode::Z: stack[top++] = z; break;
+            case OpCode::Add:
+                top--;
+                stack[top - 1] += stack[top];
+                break;
+            case OpCode::Subtract:
+                top--;
+                stack[top - 1] -= stack[top];
+                break;
+            case OpCode::Multiply:
+                top--;
+                stack[top - 1] *= stack[top];
+                break;
+            case OpCode::Divide:
+                top--;
+                stack[top - 1] /= stack[top];
+                break;
+            case OpCode::Modulo: {
+                // Lua uses the floored modulo, so the result has the sign of the divisor
+                top--;
+                const double a = stack[top - 1];
+                const double b = stack[top];
+                double m = std::fmod(a, b);
+                if ((m > 0.0) ? b < 0.0 : (m < 0.0 && b != m)) {
+                    m += b;
+                }
+                stack[top - 1] = m;
+                break;
+            }
+            case OpCode::Power:
+                top--;
+                stack[top - 1] = std::pow(stack[top - 1], stack[top]);
+                break;
+            case OpCode::Negate: stack[top - 1] = -stack[top - 1]; break;
+            case OpCode::Abs: stack[top - 1] = std::abs(stack[top - 1]); break;
+            case OpCode::Sqrt: stack[top - 1] = std::sqrt(stack[top - 1]); break;
+            case OpCode::Exp: stack[top - 1] = std::exp(stack[top - 1]); break;
+            case OpCode::Log: stack[top - 1] = std::log(stack[top - 1]); break;
+            case OpCode::Sin: stack[top - 1] = std::sin(stack[top - 1]); break;
+            case OpCode::Cos: stack[top - 1] = std::cos(stack[top - 1]); break;
+            case OpCode::Tan: stack[top - 1] = std::tan(stack[top - 1]); break;
+            case OpCode::Floor: stack[top - 1] = std::floor(stack[top - 1]); break;
+            case OpCode::Ceil: stack[top - 1] = std::ceil(stack[top - 1]); break;
+            case OpCode::Min:
+                top--;
+                stack[top - 1] = std::min(stack[top - 1], stack[top]);
+                break;
+            case OpCode::Max:
+                top--;
+                stack[top - 1] = std::max(stack[top - 1], stack[top]);
+                break;
+            default:
+                throw ghoul::MissingCaseException();
+        }
+    }
+
+    ghoul_assert(top == 1, "Invalid expression program");
+    return stack[0];
+}
+
+} // namespace openspace::volume
@@ -0,0 +1,77 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifndef __OPENSPACE_MODULE_VOLUME___VALUEEXPRESSION___H__
+#define __OPENSPACE_MODULE_VOLUME___VALUEEXPRESSION___H__
+
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace openspace::volume {
+
+/**
+ * A compiled representation of a simple Lua value function of the form
+ * `return function(x, y, z) return <expression> end`, where the expression only consists
+ * of numbers, the three arguments, the arithmetic operators `+`, `-`, `*`, `/`, `%`, `^`,
+ * parentheses, `math.pi`, and the functions `math.abs`, `math.sqrt`, `math.exp`,
+ * `math.log`, `math.sin`, `math.cos`, `math.tan`, `math.floor`, `math.ceil`,
+ * `math.min`, and `math.max`. The expression is evaluated with the same semantics as in
+ * Lua, but without the overhead of calling into a Lua state, and can be evaluated from
+ * multiple threads at the same time.
+ */
+class ValueExpression {
+public:
+    /**
+     * Tries to compile the provided Lua \p source. Returns `std::nullopt` if the source
+     * is not a function of the supported form, in which case the function has to be
+     * evaluated through Lua.
+     */
+    static std::optional<ValueExpression> compile(std::string_view source);
+
+    double evaluate(double x, double y, double z) const;
+
+private:
+    enum class OpCode {
+        Constant,
+        X, Y, Z,
+        Add, Subtract, Multiply, Divide, Modulo, Power, Negate,
+        Abs, Sqrt, Exp, Log, Sin, Cos, Tan, Floor, Ceil, Min, Max
+    };
+
+    struct Instruction {
+        OpCode code;
+        double value = 0.0;
+    };
+
+    friend class ExpressionParser;
+
+    // The instructions for a stack machine, in postfix order
+    std::vector<Instruction> _program;
+    size_t _maxStackSize = 0;
+};
+
+} // namespace openspace::volume
+
+#endif // __OPENSPACE_MODULE_VOLUME___VALUEEXPRESSION___H__
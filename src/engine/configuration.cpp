@@ -282,6 +282,11 @@ namespace {
         // debugging support
         std::optional<bool> useMultithreadedInitialization;
 
+        // The time in milliseconds that is spent each frame on initializing assets that
+        // were added after the loading screen. Assets that do not fit into this budget
+        // are initialized in the following frames
+        std::optional<double> assetInitializationBudget [[codegen::greaterequal(0.0)]];
+
         // If this value is set to 'true', the launcher will not be shown and OpenSpace
         // will start with the provided configuration options directly. Useful in
         // multiprojector setups where a launcher window would be undesired
@@ -383,6 +388,7 @@ ghoul::Dictionary Configuration::createDictionary() {
 
     res.setValue("VersionCheckUrl", versionCheckUrl);
     res.setValue("UseMultithreadedInitialization", useMultithreadedInitialization);
+    res.setValue("AssetInitializationBudget", assetInitializationBudget);
 
     {
         ghoul::Dictionary loadingScreenDict;
@@ -527,6 +533,8 @@ void parseLuaState(Configuration& configuration) {
     c.versionCheckUrl = p.versionCheckUrl.value_or(c.versionCheckUrl);
     c.useMultithreadedInitialization =
         p.useMultithreadedInitialization.value_or(c.useMultithreadedInitialization);
+    c.assetInitializationBudget =
+        p.assetInitializationBudget.value_or(c.assetInitializationBudget);
     c.isCheckingOpenGLState = p.checkOpenGLState.value_or(c.isCheckingOpenGLState);
     c.isLoggingOpenGLCalls = p.logEachOpenGLCall.value_or(c.isLoggingOpenGLCalls);
     c.isPrintingEvents = p.printEvents.value_or(c.isPrintingEvents);
@@ -400,6 +400,7 @@ void initialize() {
 
     rootPropertyOwner->addPropertySubOwner(global::userPropertyOwner);
     rootPropertyOwner->addPropertySubOwner(global::openSpaceEngine);
+    rootPropertyOwner->addPropertySubOwner(global::memoryManager);
 
     syncEngine->addSyncable(global::scriptEngine);
 }
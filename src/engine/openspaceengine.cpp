@@ -86,6 +86,8 @@
 #include <ghoul/systemcapabilities/openglcapabilitiescomponent.h>
 #include <glbinding/glbinding.h>
 #include <glbinding-aux/types_to_string.h>
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 #include <future>
 #include <numeric>
@@ -159,6 +161,34 @@ namespace {
         // @VISIBILITY(2.67)
         openspace::properties::Property::Visibility::User
     };
+
+    // Logs the assets that took the longest to load and initialize so that they can be
+    // found more easily
+    void logSlowestAssets(std::vector<const openspace::Asset*> assets) {
+        constexpr size_t NAssets = 10;
+
+        auto totalTime = [](const openspace::Asset* asset) {
+            return asset->loadTime() + asset->initializationTime();
+        };
+        const size_t n = std::min(assets.size(), NAssets);
+        std::partial_sort(
+            assets.begin(),
+            assets.begin() + n,
+            assets.end(),
+            [&totalTime](const openspace::Asset* lhs, const openspace::Asset* rhs) {
+                return totalTime(lhs) > totalTime(rhs);
+            }
+        );
+        for (size_t i = 0; i < n; i++) {
+            const openspace::Asset* asset = assets[i];
+            LINFO(fmt::format(
+                "Asset {}: loading {:.2f} ms, initializing {:.2f} ms",
+                asset->path(),
+                asset->loadTime().count() / 1000.0,
+                asset->initializationTime().count() / 1000.0
+            ));
+        }
+    }
 } // namespace
 
 namespace openspace {
@@ -414,6 +444,13 @@ void OpenSpaceEngine::initialize() {
         global::scriptEngine->luaState(),
         absPath("${ASSETS}")
     );
+    _assetManager->setInitializationBudget(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::duration<double, std::milli>(
+                global::configuration->assetInitializationBudget
+            )
+        )
+    );
 
     global::scriptEngine->addLibrary(_assetManager->luaLibrary());
 
@@ -777,7 +814,8 @@ void OpenSpaceEngine::loadAssets() {
 
     while (true) {
         _loadingScreen->render();
-        _assetManager->update();
+        // Nothing else is rendered, so all assets that are ready can be initialized
+        _assetManager->update(AssetManager::UnlimitedBudget::Yes);
 
         std::vector<const Asset*> allAssets = _assetManager->allAssets();
 
@@ -871,6 +909,8 @@ void OpenSpaceEngine::loadAssets() {
         return;
     }
 
+    logSlowestAssets(_assetManager->allAssets());
+
     _loadingScreen->setPhase(LoadingScreen::Phase::Initialization);
 
     _loadingScreen->postMessage("Initializing scene");
@@ -1100,7 +1140,7 @@ void OpenSpaceEngine::preSynchronization() {
     FileSys.triggerFilesystemEvents();
 
     // Reset the temporary, frame-based storage
-    global::memoryManager->TemporaryMemory.reset();
+    global::memoryManager->resetTemporaryMemory();
 
     if (_isRenderingFirstFrame) {
         global::profile->ignoreUpdates = true;
@@ -1113,7 +1153,7 @@ void OpenSpaceEngine::preSynchronization() {
         setModulesFromProfile(*global::profile);
         setMarkInterestingNodesFromProfile(*global::profile);
         global::profile->ignoreUpdates = false;
-        resetPropertyChangeFlagsOfSubowners(global::rootPropertyOwner);
+        properties::Property::resetAllToUnchanged();
         global::windowDelegate->setSynchronization(false);
     }
 
@@ -1331,6 +1371,8 @@ void OpenSpaceEngine::postDraw() {
 
     global::eventEngine->postFrameCleanup();
     global::memoryManager->PersistentMemory.housekeeping();
+    properties::Property::clearChangeJournal();
+    properties::Property::compactDirtyProperties();
 
     LTRACE("OpenSpaceEngine::postDraw(end)");
 }
@@ -1338,19 +1380,15 @@ void OpenSpaceEngine::postDraw() {
 void OpenSpaceEngine::resetPropertyChangeFlags() {
     ZoneScoped;
 
-    std::vector<SceneGraphNode*> nodes =
-        global::renderEngine->scene()->allSceneGraphNodes();
-    for (SceneGraphNode* n : nodes) {
-        resetPropertyChangeFlagsOfSubowners(n);
-    }
-}
-
-void OpenSpaceEngine::resetPropertyChangeFlagsOfSubowners(properties::PropertyOwner* po) {
-    for (properties::PropertyOwner* subOwner : po->propertySubOwners()) {
-        resetPropertyChangeFlagsOfSubowners(subOwner);
-    }
-    for (properties::Property* p : po->properties()) {
-        p->resetToUnchanged();
+    // Only the properties that have actually changed need to be visited. Of those, only
+    // the ones that belong to a scene graph node are reset
+    for (properties::Property* p : properties::Property::dirtyProperties()) {
+        for (properties::PropertyOwner* o = p->owner(); o; o = o->owner()) {
+            if (dynamic_cast<SceneGraphNode*>(o)) {
+                p->resetToUnchanged();
+                break;
+            }
+        }
     }
 }
 
@@ -33,14 +33,15 @@
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <array>
 #include <functional>
+#include <span>
 
 namespace {
     constexpr std::string_view _loggerCat = "EventInfo";
 } // namespace
 
-using namespace std::string_literals;
-
 namespace openspace::events {
 
 void log(int i, const EventSceneGraphNodeAdded& e) {
@@ -321,207 +322,286 @@ Event::Type fromString(std::string_view str) {
     throw ghoul::RuntimeError(fmt::format("Unknown event type '{}'", str));
 }
 
+namespace {
+
+/**
+ * A named parameter of an event. Exactly one of the accessors is set, depending on
+ * whether the parameter is a string or a number.
+ */
+struct Field {
+    std::string_view key;
+    std::string_view (*string)(const Event&) = nullptr;
+    double (*number)(const Event&) = nullptr;
+};
+
+template <typename T, const tstring T::* Member>
+std::string_view stringField(const Event& e) {
+    ghoul_assert(e.type == T::Type, "Wrong type");
+    return static_cast<const T&>(e).*Member;
+}
+
+template <typename T, const double T::* Member>
+double numberField(const Event& e) {
+    ghoul_assert(e.type == T::Type, "Wrong type");
+    return static_cast<const T&>(e).*Member;
+}
+
+std::string_view parallelConnectionState(const Event& e) {
+    switch (static_cast<const EventParallelConnection&>(e).state) {
+        case EventParallelConnection::State::Established:    return "Established";
+        case EventParallelConnection::State::Lost:           return "Lost";
+        case EventParallelConnection::State::HostshipGained: return "HostshipGained";
+        case EventParallelConnection::State::HostshipLost:   return "HostshipLost";
+        default:                                  throw ghoul::MissingCaseException();
+    }
+}
+
+std::string_view applicationShutdownState(const Event& e) {
+    switch (static_cast<const EventApplicationShutdown&>(e).state) {
+        case EventApplicationShutdown::State::Started:  return "Started";
+        case EventApplicationShutdown::State::Aborted:  return "Aborted";
+        case EventApplicationShutdown::State::Finished: return "Finished";
+        default:                           throw ghoul::MissingCaseException();
+    }
+}
+
+std::string_view cameraFocusTransition(const Event& e) {
+    using Transition = EventCameraFocusTransition::Transition;
+    switch (static_cast<const EventCameraFocusTransition&>(e).transition) {
+        case Transition::Approaching: return "Approaching";
+        case Transition::Reaching:    return "Reaching";
+        case Transition::Receding:    return "Receding";
+        case Transition::Exiting:     return "Exiting";
+        default:                      throw ghoul::MissingCaseException();
+    }
+}
+
+std::string_view sessionRecordingPlaybackState(const Event& e) {
+    switch (static_cast<const EventSessionRecordingPlayback&>(e).state) {
+        case EventSessionRecordingPlayback::State::Started:  return "Started";
+        case EventSessionRecordingPlayback::State::Paused:   return "Paused";
+        case EventSessionRecordingPlayback::State::Resumed:  return "Resumed";
+        case EventSessionRecordingPlayback::State::Finished: return "Finished";
+        default:                                throw ghoul::MissingCaseException();
+    }
+}
+
+/**
+ * Returns the parameters of events of the provided \p type. These are the parameters
+ * that are passed to actions and that can be used in event filters.
+ */
+std::span<const Field> fields(Event::Type type) {
+    using E = Event::Type;
+    switch (type) {
+        case E::SceneGraphNodeAdded: {
+            using T = EventSceneGraphNodeAdded;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Node", &stringField<T, &T::node> }
+            };
+            return Fields;
+        }
+        case E::SceneGraphNodeRemoved: {
+            using T = EventSceneGraphNodeRemoved;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Node", &stringField<T, &T::node> }
+            };
+            return Fields;
+        }
+        case E::ParallelConnection: {
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "State", &parallelConnectionState }
+            };
+            return Fields;
+        }
+        case E::ApplicationShutdown: {
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "State", &applicationShutdownState }
+            };
+            return Fields;
+        }
+        case E::ScreenSpaceRenderableAdded: {
+            using T = EventScreenSpaceRenderableAdded;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Renderable", &stringField<T, &T::renderable> }
+            };
+            return Fields;
+        }
+        case E::ScreenSpaceRenderableRemoved: {
+            using T = EventScreenSpaceRenderableRemoved;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Renderable", &stringField<T, &T::renderable> }
+            };
+            return Fields;
+        }
+        case E::CameraFocusTransition: {
+            using T = EventCameraFocusTransition;
+            static constexpr std::array<Field, 2> Fields = {
+                Field{ "Node", &stringField<T, &T::node> },
+                Field{ "Transition", &cameraFocusTransition }
+            };
+            return Fields;
+        }
+        case E::PlanetEclipsed: {
+            using T = EventPlanetEclipsed;
+            static constexpr std::array<Field, 2> Fields = {
+                Field{ "Eclipsee", &stringField<T, &T::eclipsee> },
+                Field{ "Eclipser", &stringField<T, &T::eclipser> }
+            };
+            return Fields;
+        }
+        case E::InterpolationFinished: {
+            using T = EventInterpolationFinished;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Property", &stringField<T, &T::property> }
+            };
+            return Fields;
+        }
+        case E::FocusNodeChanged: {
+            using T = EventFocusNodeChanged;
+            static constexpr std::array<Field, 2> Fields = {
+                Field{ "OldNode", &stringField<T, &T::oldNode> },
+                Field{ "NewNode", &stringField<T, &T::newNode> }
+            };
+            return Fields;
+        }
+        case E::LayerAdded: {
+            using T = EventLayerAdded;
+            static constexpr std::array<Field, 3> Fields = {
+                Field{ "Globe", &stringField<T, &T::node> },
+                Field{ "Group", &stringField<T, &T::layerGroup> },
+                Field{ "Layer", &stringField<T, &T::layer> }
+            };
+            return Fields;
+        }
+        case E::LayerRemoved: {
+            using T = EventLayerRemoved;
+            static constexpr std::array<Field, 3> Fields = {
+                Field{ "Globe", &stringField<T, &T::node> },
+                Field{ "Group", &stringField<T, &T::layerGroup> },
+                Field{ "Layer", &stringField<T, &T::layer> }
+            };
+            return Fields;
+        }
+        case E::SessionRecordingPlayback: {
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "State", &sessionRecordingPlaybackState }
+            };
+            return Fields;
+        }
+        case E::PointSpacecraft: {
+            using T = EventPointSpacecraft;
+            static constexpr std::array<Field, 3> Fields = {
+                Field{ "Ra", nullptr, &numberField<T, &T::ra> },
+                Field{ "Dec", nullptr, &numberField<T, &T::dec> },
+                Field{ "Duration", nullptr, &numberField<T, &T::duration> }
+            };
+            return Fields;
+        }
+        case E::RenderableEnabled: {
+            using T = EventRenderableEnabled;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Node", &stringField<T, &T::node> }
+            };
+            return Fields;
+        }
+        case E::RenderableDisabled: {
+            using T = EventRenderableDisabled;
+            static constexpr std::array<Field, 1> Fields = {
+                Field{ "Node", &stringField<T, &T::node> }
+            };
+            return Fields;
+        }
+        case E::CameraPathStarted: {
+            using T = EventCameraPathStarted;
+            static constexpr std::array<Field, 2> Fields = {
+                Field{ "Origin", &stringField<T, &T::origin> },
+                Field{ "Destination", &stringField<T, &T::destination> }
+            };
+            return Fields;
+        }
+        case E::CameraPathFinished: {
+            using T = EventCameraPathFinished;
+            static constexpr std::array<Field, 2> Fields = {
+                Field{ "Origin", &stringField<T, &T::origin> },
+                Field{ "Destination", &stringField<T, &T::destination> }
+            };
+            return Fields;
+        }
+        case E::Custom: {
+            using T = CustomEvent;
+            static constexpr std::array<Field, 2> Fields = {
+                Field{ "Subtype", &stringField<T, &T::subtype> },
+                Field{ "Payload", &stringField<T, &T::payload> }
+            };
+            return Fields;
+        }
+        default:
+            return {};
+    }
+}
+
+} // namespace
+
 ghoul::Dictionary toParameter(const Event& e) {
     ghoul::Dictionary d;
-    switch (e.type) {
-        case Event::Type::SceneGraphNodeAdded:
-            d.setValue(
-                "Node",
-                std::string(static_cast<const EventSceneGraphNodeAdded&>(e).node)
-            );
-            break;
-        case Event::Type::SceneGraphNodeRemoved:
-            d.setValue(
-                "Node",
-                std::string(static_cast<const EventSceneGraphNodeRemoved&>(e).node)
-            );
-            break;
-        case Event::Type::ParallelConnection:
-            switch (static_cast<const EventParallelConnection&>(e).state) {
-                case EventParallelConnection::State::Established:
-                    d.setValue("State", "Established"s);
-                    break;
-                case EventParallelConnection::State::Lost:
-                    d.setValue("State", "Lost"s);
-                    break;
-                case EventParallelConnection::State::HostshipGained:
-                    d.setValue("State", "HostshipGained"s);
-                    break;
-                case EventParallelConnection::State::HostshipLost:
-                    d.setValue("State", "HostshipLost"s);
-                    break;
-            }
-            break;
-        case Event::Type::ApplicationShutdown:
-            switch (static_cast<const EventApplicationShutdown&>(e).state) {
-                case EventApplicationShutdown::State::Started:
-                    d.setValue("State", "Started"s);
-                    break;
-                case EventApplicationShutdown::State::Aborted:
-                    d.setValue("State", "Aborted"s);
-                    break;
-                case EventApplicationShutdown::State::Finished:
-                    d.setValue("State", "Finished"s);
-                    break;
-            }
-            break;
-        case Event::Type::ScreenSpaceRenderableAdded:
-            d.setValue(
-                "Renderable",
-                std::string(
-                    static_cast<const EventScreenSpaceRenderableAdded&>(e).renderable
-                )
-            );
-            break;
-        case Event::Type::ScreenSpaceRenderableRemoved:
-            d.setValue(
-                "Renderable",
-                std::string(
-                    static_cast<const EventScreenSpaceRenderableRemoved&>(e).renderable
-                )
-            );
-            break;
-        case Event::Type::CameraFocusTransition:
-            d.setValue(
-                "Node",
-                std::string(static_cast<const EventCameraFocusTransition&>(e).node)
-            );
-            switch (static_cast<const EventCameraFocusTransition&>(e).transition) {
-                case EventCameraFocusTransition::Transition::Approaching:
-                    d.setValue("Transition", "Approaching"s);
-                    break;
-                case EventCameraFocusTransition::Transition::Reaching:
-                    d.setValue("Transition", "Reaching"s);
-                    break;
-                case EventCameraFocusTransition::Transition::Receding:
-                    d.setValue("Transition", "Receding"s);
-                    break;
-                case EventCameraFocusTransition::Transition::Exiting:
-                    d.setValue("Transition", "Exiting"s);
-                    break;
-            }
-            break;
-        case Event::Type::PlanetEclipsed:
-            d.setValue(
-                "Eclipsee",
-                std::string(static_cast<const EventPlanetEclipsed&>(e).eclipsee)
-            );
-            d.setValue(
-                "Eclipser",
-                std::string(static_cast<const EventPlanetEclipsed&>(e).eclipser)
-            );
-            break;
-        case Event::Type::InterpolationFinished:
-            d.setValue(
-                "Property",
-                std::string(static_cast<const EventInterpolationFinished&>(e).property)
-            );
-            break;
-        case Event::Type::FocusNodeChanged:
-            d.setValue(
-                "OldNode",
-                std::string(static_cast<const EventFocusNodeChanged&>(e).oldNode)
-            );
-            d.setValue(
-                "NewNode",
-                std::string(static_cast<const EventFocusNodeChanged&>(e).newNode)
-            );
-            break;
-        case Event::Type::LayerAdded:
-            d.setValue(
-                "Globe",
-                std::string(static_cast<const EventLayerAdded&>(e).node)
-            );
-            d.setValue(
-                "Group",
-                std::string(static_cast<const EventLayerAdded&>(e).layerGroup)
-            );
-            d.setValue(
-                "Layer",
-                std::string(static_cast<const EventLayerAdded&>(e).layer)
-            );
-            break;
-        case Event::Type::LayerRemoved:
-            d.setValue(
-                "Globe",
-                std::string(static_cast<const EventLayerRemoved&>(e).node)
-            );
-            d.setValue(
-                "Group",
-                std::string(static_cast<const EventLayerRemoved&>(e).layerGroup)
-            );
-            d.setValue(
-                "Layer",
-                std::string(static_cast<const EventLayerRemoved&>(e).layer)
-            );
-            break;
-        case Event::Type::SessionRecordingPlayback:
-            switch (static_cast<const EventSessionRecordingPlayback&>(e).state) {
-                case EventSessionRecordingPlayback::State::Started:
-                    d.setValue("State", "Started"s);
-                    break;
-                case EventSessionRecordingPlayback::State::Paused:
-                    d.setValue("State", "Paused"s);
-                    break;
-                case EventSessionRecordingPlayback::State::Resumed:
-                    d.setValue("State", "Resumed"s);
-                    break;
-                case EventSessionRecordingPlayback::State::Finished:
-                    d.setValue("State", "Finished"s);
-                    break;
-            }
-            break;
-        case Event::Type::PointSpacecraft:
-            d.setValue("Ra", static_cast<const EventPointSpacecraft&>(e).ra);
-            d.setValue("Dec", static_cast<const EventPointSpacecraft&>(e).dec);
-            d.setValue("Duration", static_cast<const EventPointSpacecraft&>(e).duration);
-            break;
-        case Event::Type::RenderableEnabled:
-            d.setValue(
-                "Node",
-                std::string(static_cast<const EventRenderableEnabled&>(e).node)
-            );
-            break;
-        case Event::Type::RenderableDisabled:
-            d.setValue(
-                "Node",
-                std::string(static_cast<const EventRenderableDisabled&>(e).node)
-            );
-            break;
-        case Event::Type::CameraPathStarted:
-            d.setValue(
-                "Origin",
-                std::string(static_cast<const EventCameraPathStarted&>(e).origin)
-            );
-            d.setValue(
-                "Destination",
-                std::string(static_cast<const EventCameraPathStarted&>(e).destination)
-            );
-            break;
-        case Event::Type::CameraPathFinished:
-            d.setValue(
-                "Origin",
-                std::string(static_cast<const EventCameraPathFinished&>(e).origin)
-            );
-            d.setValue(
-                "Destination",
-                std::string(static_cast<const EventCameraPathFinished&>(e).destination)
-            );
-            break;
-        case Event::Type::Custom:
-            d.setValue(
-                "Subtype", std::string(static_cast<const CustomEvent&>(e).subtype)
-            );
-            d.setValue(
-                "Payload", std::string(static_cast<const CustomEvent&>(e).payload)
-            );
-            break;
-        default:
-            break;
+    for (const Field& field : fields(e.type)) {
+        if (field.string) {
+            d.setValue(std::string(field.key), std::string(field.string(e)));
+        }
+        else {
+            d.setValue(std::string(field.key), field.number(e));
+        }
     }
     return d;
 }
 
+EventFilter::EventFilter(Event::Type type, const ghoul::Dictionary& filter)
+    : _type(type)
+{
+    const std::span<const Field> f = fields(type);
+    for (std::string_view key : filter.keys()) {
+        const auto it = std::find_if(
+            f.begin(), f.end(),
+            [key](const Field& field) { return field.key == key; }
+        );
+        if (it == f.end()) {
+            // The events don't have this parameter, so they can never pass the filter
+            _isUnsatisfiable = true;
+            continue;
+        }
+
+        if (it->string && filter.hasValue<std::string>(key)) {
+            _stringPredicates.push_back({ it->string, filter.value<std::string>(key) });
+        }
+        else if (it->number && filter.hasValue<double>(key)) {
+            _numberPredicates.push_back({ it->number, filter.value<double>(key) });
+        }
+        else {
+            // The value in the filter has the wrong type and can never be equal
+            _isUnsatisfiable = true;
+        }
+    }
+}
+
+bool EventFilter::matches(const Event& e) const {
+    ghoul_assert(e.type == _type, "Wrong type");
+
+    if (_isUnsatisfiable) {
+        return false;
+    }
+    for (const StringPredicate& p : _stringPredicates) {
+        if (p.field(e) != p.value) {
+            return false;
+        }
+    }
+    for (const NumberPredicate& p : _numberPredicates) {
+        if (p.field(e) != p.value) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void logAllEvents(const Event* e) {
     int i = 0;
     while (e) {
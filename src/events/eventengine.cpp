@@ -26,6 +26,7 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/interaction/actionmanager.h>
+#include <algorithm>
 
 #include "eventengine_lua.inl"
 
@@ -54,19 +55,20 @@ void EventEngine::registerEventAction(events::Event::Type type,
                                       std::string identifier,
                                       std::optional<ghoul::Dictionary> filter)
 {
-    ActionInfo ai;
-    ai.id = nextRegisteredEventId;
-    ai.isEnabled = true;
-    ai.type = type;
-    ai.action = std::move(identifier);
-    ai.filter = std::move(filter);
-    const auto it = _eventActions.find(type);
-    if (it != _eventActions.end()) {
-        it->second.push_back(ai);
-    }
-    else {
-        _eventActions[type] = { std::move(ai) };
+    RegisteredAction ra;
+    ra.info.id = nextRegisteredEventId;
+    ra.info.isEnabled = true;
+    ra.info.type = type;
+    ra.info.action = std::move(identifier);
+    if (filter.has_value()) {
+        // Resolving the filter keys once here means that events don't have to be turned
+        // into dictionaries just to check them against the filter
+        ra.compiledFilter = events::EventFilter(type, *filter);
     }
+    ra.info.filter = std::move(filter);
+
+    _eventActions[static_cast<size_t>(type)].push_back(std::move(ra));
+    _actionTypes[nextRegisteredEventId] = type;
 
     nextRegisteredEventId++;
 }
@@ -75,104 +77,119 @@ void EventEngine::unregisterEventAction(events::Event::Type type,
                                         const std::string& identifier,
                                         std::optional<ghoul::Dictionary> filter)
 {
-    const auto it = _eventActions.find(type);
-    if (it != _eventActions.end()) {
-        const auto jt = std::find_if(
-            it->second.begin(), it->second.end(),
-            [identifier, filter](const ActionInfo& ai) {
-                const bool a = ai.action == identifier;
-                const bool f = !filter.has_value() || *filter == ai.filter;
-                return a && f;
-            }
-        );
-        if (jt != it->second.end()) {
-            it->second.erase(jt);
+    std::vector<RegisteredAction>& actions = _eventActions[static_cast<size_t>(type)];
+    const auto it = std::find_if(
+        actions.begin(), actions.end(),
+        [&identifier, &filter](const RegisteredAction& ra) {
+            const bool a = ra.info.action == identifier;
+            const bool f = !filter.has_value() || *filter == ra.info.filter;
+            return a && f;
         }
+    );
+    if (it != actions.end()) {
+        _actionTypes.erase(it->info.id);
+        actions.erase(it);
     }
 }
 
 void EventEngine::unregisterEventAction(uint32_t identifier) {
-    for (auto it = _eventActions.begin(); it != _eventActions.end(); it++) {
-        for (auto jt = it->second.begin(); jt != it->second.end(); jt++) {
-            if (jt->id == identifier) {
-                it->second.erase(jt);
-
-                // This might have been the last action so we might need to remove the
-                // entry alltogether
-                if (it->second.empty()) {
-                    _eventActions.erase(it);
-                }
-
-                // The identifier is unique so we can stop after this
-                return;
-            }
-        }
+    const auto it = _actionTypes.find(identifier);
+    if (it == _actionTypes.end()) {
+        throw ghoul::RuntimeError(fmt::format(
+            "Could not find event with identifier {}", identifier
+        ));
     }
 
-    // If we get this far, we haven't found the identifier
-    throw ghoul::RuntimeError(fmt::format(
-        "Could not find event with identifier {}", identifier
-    ));
+    std::vector<RegisteredAction>& actions =
+        _eventActions[static_cast<size_t>(it->second)];
+    const auto jt = std::lower_bound(
+        actions.begin(), actions.end(),
+        identifier,
+        [](const RegisteredAction& ra, uint32_t id) { return ra.info.id < id; }
+    );
+    ghoul_assert(
+        jt != actions.end() && jt->info.id == identifier,
+        "Action must exist for its type"
+    );
+    actions.erase(jt);
+    _actionTypes.erase(it);
 }
 
 std::vector<EventEngine::ActionInfo> EventEngine::registeredActions() const {
     std::vector<EventEngine::ActionInfo> result;
-    result.reserve(_eventActions.size());
-    using Type = events::Event::Type;
-    for (const std::pair<const Type, std::vector<ActionInfo>>& p : _eventActions) {
-        result.insert(result.end(), p.second.begin(), p.second.end());
+    result.reserve(_actionTypes.size());
+    for (const std::vector<RegisteredAction>& actions : _eventActions) {
+        for (const RegisteredAction& ra : actions) {
+            result.push_back(ra.info);
+        }
     }
+    std::sort(
+        result.begin(), result.end(),
+        [](const ActionInfo& lhs, const ActionInfo& rhs) { return lhs.id < rhs.id; }
+    );
     return result;
 }
 
+EventEngine::RegisteredAction* EventEngine::findAction(uint32_t identifier) {
+    const auto it = _actionTypes.find(identifier);
+    if (it == _actionTypes.end()) {
+        return nullptr;
+    }
+
+    std::vector<RegisteredAction>& actions =
+        _eventActions[static_cast<size_t>(it->second)];
+    const auto jt = std::lower_bound(
+        actions.begin(), actions.end(),
+        identifier,
+        [](const RegisteredAction& ra, uint32_t id) { return ra.info.id < id; }
+    );
+    return (jt != actions.end() && jt->info.id == identifier) ? &*jt : nullptr;
+}
+
 void EventEngine::enableEvent(uint32_t identifier) {
-    using Type = events::Event::Type;
-    for (std::pair<const Type, std::vector<ActionInfo>>& p : _eventActions) {
-        for (ActionInfo& ai : p.second) {
-            if (ai.id == identifier) {
-                ai.isEnabled = true;
-                break;
-            }
-        }
+    RegisteredAction* ra = findAction(identifier);
+    if (ra) {
+        ra->info.isEnabled = true;
     }
 }
 
 void EventEngine::disableEvent(uint32_t identifier) {
-    using Type = events::Event::Type;
-    for (std::pair<const Type, std::vector<ActionInfo>>& p : _eventActions) {
-        for (ActionInfo& ai : p.second) {
-            if (ai.id == identifier) {
-                ai.isEnabled = false;
-                break;
-            }
-        }
+    RegisteredAction* ra = findAction(identifier);
+    if (ra) {
+        ra->info.isEnabled = false;
     }
 }
 
 void EventEngine::triggerActions() const {
-    if (_eventActions.empty()) {
+    if (_actionTypes.empty()) {
         // Nothing to do here
         return;
     }
 
     const events::Event* e = _firstEvent;
     while (e) {
-        const auto it = _eventActions.find(e->type);
-        if (it != _eventActions.end()) {
-            ghoul::Dictionary params = toParameter(*e);
-            for (const ActionInfo& ai : it->second) {
-                if (ai.isEnabled &&
-                    (!ai.filter.has_value() || params.isSubset(*ai.filter)))
-                {
-                    // No sync because events are always synced and sent to the connected
-                    // nodes and peers
-                    global::actionManager->triggerAction(
-                        ai.action,
-                        params,
-                        interaction::ActionManager::ShouldBeSynchronized::No
-                    );
-                }
+        const std::vector<RegisteredAction>& actions =
+            _eventActions[static_cast<size_t>(e->type)];
+
+        // Only pay for creating the parameter dictionary if an action will consume it
+        std::optional<ghoul::Dictionary> params;
+        for (const RegisteredAction& ra : actions) {
+            if (!ra.info.isEnabled ||
+                (ra.compiledFilter.has_value() && !ra.compiledFilter->matches(*e)))
+            {
+                continue;
+            }
+
+            if (!params.has_value()) {
+                params = toParameter(*e);
             }
+            // No sync because events are always synced and sent to the connected nodes
+            // and peers
+            global::actionManager->triggerAction(
+                ra.info.action,
+                *params,
+                interaction::ActionManager::ShouldBeSynchronized::No
+            );
         }
 
         e = e->next;
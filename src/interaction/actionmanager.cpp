@@ -29,7 +29,7 @@
 #include <openspace/scripting/scriptengine.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/crc32.h>
-#include <ghoul/misc/dictionaryluaformatter.h>
+#include <ghoul/misc/dictionary.h>
 #include <algorithm>
 
 #include "actionmanager_lua.inl"
@@ -94,10 +94,6 @@ void ActionManager::triggerAction(const std::string& identifier,
     }
 
     const Action& a = action(identifier);
-    std::string script =
-        arguments.isEmpty() ?
-        a.command :
-        fmt::format("args = {}\n{}", ghoul::formatLua(arguments), a.command);
 
     using ShouldBeSynchronized = scripting::ScriptEngine::ShouldBeSynchronized;
     using ShouldSendToRemote = scripting::ScriptEngine::ShouldSendToRemote;
@@ -108,7 +104,9 @@ void ActionManager::triggerAction(const std::string& identifier,
         send = ShouldSendToRemote::No;
     }
 
-    global::scriptEngine->queueScript(script, sync, send);
+    // The arguments are passed to the compiled command rather than being written into
+    // the script so that the command only has to be compiled once
+    global::scriptEngine->queueScript(a.command, arguments, sync, send);
 }
 
 scripting::LuaLibrary ActionManager::luaLibrary() {
@@ -31,6 +31,7 @@
 #include <openspace/navigation/waypoint.h>
 #include <openspace/query/query.h>
 #include <openspace/scene/scenegraphnode.h>
+#include <openspace/scene/scenegraphnodebvh.h>
 #include <openspace/util/collisionhelper.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/exception.h>
@@ -52,7 +53,7 @@ namespace {
 namespace openspace::interaction {
 
 AvoidCollisionCurve::AvoidCollisionCurve(const Waypoint& start, const Waypoint& end) {
-    _relevantNodes = global::navigationHandler->pathNavigator().relevantNodes();
+    _relevantNodes = &global::navigationHandler->pathNavigator().relevantNodesBvh();
 
     if (!start.node() || !end.node()) { // guard, but should never happen
         LERROR("Something went wrong. The start or end node does not exist");
@@ -138,6 +139,7 @@ void AvoidCollisionCurve::removeCollisions(int step) {
         return;
     }
 
+    std::vector<uint32_t> candidates;
     const int nSegments = static_cast<int>(_points.size() - 3);
     for (int i = 0; i < nSegments; ++i) {
         const glm::dvec3 lineStart = _points[i + 1];
@@ -147,7 +149,18 @@ void AvoidCollisionCurve::removeCollisions(int step) {
             continue; // Start and end position are the same. Go to next segment
         }
 
-        for (SceneGraphNode* node : _relevantNodes) {
+        // Only the nodes whose sphere, including the buffer, touches the segment can
+        // collide with it. The candidates are in the same order as the relevant nodes
+        candidates.clear();
+        _relevantNodes->querySegment(
+            lineStart,
+            lineEnd,
+            candidates,
+            1.0 + CollisionBufferSizeRadiusMultiplier
+        );
+
+        for (uint32_t candidate : candidates) {
+            SceneGraphNode* node = _relevantNodes->entries()[candidate].node;
             // Do collision check in relative coordinates, to avoid huge numbers
             const glm::dmat4 modelTransform = node->modelTransform();
             glm::dvec3 p1 = glm::inverse(modelTransform) * glm::dvec4(lineStart, 1.0);
@@ -455,6 +455,36 @@ const std::vector<SceneGraphNode*>& PathNavigator::relevantNodes() {
     return _relevantNodes;
 }
 
+const SceneGraphNodeBvh& PathNavigator::relevantNodesBvh() {
+    const std::vector<SceneGraphNode*>& nodes = relevantNodes();
+
+    // The positions of the nodes only change in the scene update, so the hierarchy only
+    // has to be refreshed once per frame, regardless of how often it is queried
+    const uint64_t frame = global::renderEngine->frameNumber();
+    if (_relevantNodesBvhFrame == frame) {
+        return _relevantNodesBvh;
+    }
+    _relevantNodesBvhFrame = frame;
+
+    std::vector<SceneGraphNodeBvh::Entry> entries;
+    entries.reserve(nodes.size());
+    for (SceneGraphNode* node : nodes) {
+        // The proximity checks are done in the model coordinates of the nodes, where the
+        // sphere can be stretched by the node's scale
+        const double scale = glm::compMax(node->worldScale());
+        const double radius = std::max(
+            node->boundingSphere(),
+            _minValidBoundingSphere.value()
+        );
+        entries.push_back({ node, node->worldPosition(), scale * radius });
+    }
+
+    // The tree is only rebuilt if the relevant nodes changed, otherwise it is refitted to
+    // the positions of the nodes in the last scene update
+    _relevantNodesBvh.update(std::move(entries));
+    return _relevantNodesBvh;
+}
+
 void PathNavigator::handlePathEnd() {
     _isPlaying = false;
     global::openSpaceEngine->resetMode();
@@ -491,6 +521,9 @@ void PathNavigator::findRelevantNodes() {
 
     const std::vector<std::string> relevantTags = _relevantNodeTags;
 
+    // The hierarchy has to be rebuilt for the new set of nodes
+    _relevantNodesBvhFrame = std::nullopt;
+
     if (allNodes.empty() || relevantTags.empty()) {
         _relevantNodes = std::vector<SceneGraphNode*>();
         return;
@@ -526,10 +559,17 @@ void PathNavigator::findRelevantNodes() {
 
 SceneGraphNode* PathNavigator::findNodeNearTarget(const SceneGraphNode* node) {
     constexpr float LengthEpsilon = 1e-5f;
-    const std::vector<SceneGraphNode*>& relNodes =
-        global::navigationHandler->pathNavigator().relevantNodes();
+    constexpr float proximityRadiusFactor = 3.f;
 
-    for (SceneGraphNode* n : relNodes) {
+    // Only the nodes whose proximity sphere can contain the node have to be checked. The
+    // candidates are sorted in the same order as the relevant nodes
+    const SceneGraphNodeBvh& bvh =
+        global::navigationHandler->pathNavigator().relevantNodesBvh();
+    std::vector<uint32_t> candidates;
+    bvh.querySphere(node->worldPosition(), 0.0, candidates, proximityRadiusFactor);
+
+    for (uint32_t candidate : candidates) {
+        SceneGraphNode* n = bvh.entries()[candidate].node;
         bool isSame = (n->identifier() == node->identifier());
         // If the nodes are in the very same position, they are probably representing
         // the same object
@@ -540,8 +580,6 @@ SceneGraphNode* PathNavigator::findNodeNearTarget(const SceneGraphNode* node) {
             continue;
         }
 
-        constexpr float proximityRadiusFactor = 3.f;
-
         const float bs = static_cast<float>(n->boundingSphere());
         const float proximityRadius = proximityRadiusFactor * bs;
         const glm::dvec3 posInModelCoords =
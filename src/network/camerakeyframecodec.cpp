@@ -0,0 +1,364 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/network/camerakeyframecodec.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace {
+    constexpr uint8_t FollowNodeRotationBit = 1 << 0;
+    constexpr uint8_t FullKeyframeBit = 1 << 1;
+    constexpr uint8_t ScaleBit = 1 << 2;
+    constexpr int RotationIndexShift = 4;
+
+    // The smallest position quantization step that is used close to the anchor (in m)
+    constexpr double MinimumPositionStep = 1e-6;
+
+    // The three smallest components of a unit quaternion are in [-1/sqrt(2), 1/sqrt(2)]
+    constexpr double RotationScale = 32767.0 * 1.4142135623730951;
+
+    template <typename T>
+    void writeRaw(std::vector<char>& buffer, T value) {
+        const char* p = reinterpret_cast<const char*>(&value);
+        buffer.insert(buffer.end(), p, p + sizeof(T));
+    }
+
+    void writeVarint(std::vector<char>& buffer, int64_t value) {
+        // Zigzag encoding maps small negative numbers to small unsigned numbers
+        uint64_t v = (static_cast<uint64_t>(value) << 1) ^
+            static_cast<uint64_t>(value >> 63);
+        while (v >= 0x80) {
+            buffer.push_back(static_cast<char>((v & 0x7F) | 0x80));
+            v >>= 7;
+        }
+        buffer.push_back(static_cast<char>(v));
+    }
+
+    struct Reader {
+        const std::vector<char>& buffer;
+        size_t offset = 0;
+        bool isValid = true;
+
+        template <typename T>
+        T raw() {
+            T value = T();
+            if (offset + sizeof(T) > buffer.size()) {
+                isValid = false;
+                return value;
+            }
+            std::memcpy(&value, buffer.data() + offset, sizeof(T));
+            offset += sizeof(T);
+            return value;
+        }
+
+        int64_t varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                if (offset >= buffer.size()) {
+                    isValid = false;
+                    return 0;
+                }
+                const uint8_t byte = static_cast<uint8_t>(buffer[offset++]);
+                v |= static_cast<uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0) {
+                    return static_cast<int64_t>(v >> 1) ^ -static_cast<int64_t>(v & 1);
+                }
+            }
+            isValid = false;
+            return 0;
+        }
+    };
+
+    int8_t positionExponent(const glm::dvec3& position, double relativePrecision) {
+        const double step = std::max(
+            glm::length(position) * relativePrecision,
+            MinimumPositionStep
+        );
+        const double e = std::floor(std::log2(step));
+        return static_cast<int8_t>(std::clamp(e, -127.0, 127.0));
+    }
+
+    glm::i64vec3 quantizePosition(const glm::dvec3& position, int8_t exponent) {
+        return glm::i64vec3(
+            std::llround(std::ldexp(position.x, -exponent)),
+            std::llround(std::ldexp(position.y, -exponent)),
+            std::llround(std::ldexp(position.z, -exponent))
+        );
+    }
+
+    glm::dvec3 dequantizePosition(const glm::i64vec3& position, int8_t exponent) {
+        return glm::dvec3(
+            std::ldexp(static_cast<double>(position.x), exponent),
+            std::ldexp(static_cast<double>(position.y), exponent),
+            std::ldexp(static_cast<double>(position.z), exponent)
+        );
+    }
+
+    struct PackedRotation {
+        int largestIndex = 0;
+        std::array<int16_t, 3> components = { 0, 0, 0 };
+    };
+
+    PackedRotation packRotation(glm::dquat q) {
+        q = glm::normalize(q);
+        std::array<double, 4> c = { q.x, q.y, q.z, q.w };
+
+        PackedRotation res;
+        for (int i = 1; i < 4; i++) {
+            if (std::abs(c[i]) > std::abs(c[res.largestIndex])) {
+                res.largestIndex = i;
+            }
+        }
+        // q and -q describe the same rotation, so we can make the dropped component
+        // positive and only need its magnitude
+        const double sign = c[res.largestIndex] < 0.0 ? -1.0 : 1.0;
+
+        int j = 0;
+        for (int i = 0; i < 4; i++) {
+            if (i == res.largestIndex) {
+                continue;
+            }
+            const double v = std::clamp(sign * c[i] * RotationScale, -32767.0, 32767.0);
+            res.components[j] = static_cast<int16_t>(std::lround(v));
+            j++;
+        }
+        return res;
+    }
+
+    glm::dquat unpackRotation(const PackedRotation& packed) {
+        std::array<double, 4> c;
+        double sumSquared = 0.0;
+        int j = 0;
+        for (int i = 0; i < 4; i++) {
+            if (i == packed.largestIndex) {
+                continue;
+            }
+            c[i] = packed.components[j] / RotationScale;
+            sumSquared += c[i] * c[i];
+            j++;
+        }
+        c[packed.largestIndex] = std::sqrt(std::max(1.0 - sumSquared, 0.0));
+        return glm::normalize(glm::dquat(c[3], c[0], c[1], c[2]));
+    }
+} // namespace
+
+namespace openspace::datamessagestructures {
+
+CameraKeyframeEncoder::CameraKeyframeEncoder(Settings settings)
+    : _settings(std::move(settings))
+{}
+
+bool CameraKeyframeEncoder::hasMoved(const CameraKeyframe& kf) const {
+    if (!_hasPrevious || kf._focusNode != _anchor ||
+        kf._followNodeRotation != _followNodeRotation || kf._scale != _scale)
+    {
+        return true;
+    }
+
+    if (quantizePosition(kf._position, _exponent) != _quantizedPosition) {
+        return true;
+    }
+
+    // The angle between two rotations is 2 * acos(|dot(q1, q2)|)
+    const double cosHalfAngle = std::abs(
+        glm::dot(glm::normalize(kf._rotation), _rotation)
+    );
+    return cosHalfAngle < std::cos(_settings.rotationThreshold / 2.0);
+}
+
+void CameraKeyframeEncoder::encode(const CameraKeyframe& kf, std::vector<char>& buffer)
+{
+    const int8_t exponent = positionExponent(
+        kf._position,
+        _settings.relativePositionPrecision
+    );
+
+    // A difference keyframe can only be used if the position is expressed in the same
+    // frame and the quantization step has not drifted too far from the ideal one
+    const bool isFull = !_hasPrevious ||
+        _keyframesSinceFull + 1 >= _settings.fullKeyframeInterval ||
+        kf._focusNode != _anchor ||
+        kf._followNodeRotation != _followNodeRotation ||
+        std::abs(exponent - _exponent) > 1;
+
+    const PackedRotation rotation = packRotation(kf._rotation);
+    const bool hasScale = isFull || kf._scale != _scale;
+
+    uint8_t flags = static_cast<uint8_t>(rotation.largestIndex << RotationIndexShift);
+    if (kf._followNodeRotation) {
+        flags |= FollowNodeRotationBit;
+    }
+    if (isFull) {
+        flags |= FullKeyframeBit;
+    }
+    if (hasScale) {
+        flags |= ScaleBit;
+    }
+
+    _sequence = _hasPrevious ? static_cast<uint8_t>(_sequence + 1) : 0;
+    writeRaw(buffer, flags);
+    writeRaw(buffer, _sequence);
+
+    if (isFull) {
+        _exponent = exponent;
+        const glm::i64vec3 position = quantizePosition(kf._position, _exponent);
+
+        const uint16_t anchorLength = static_cast<uint16_t>(
+            std::min<size_t>(kf._focusNode.size(), std::numeric_limits<uint16_t>::max())
+        );
+        writeRaw(buffer, kf._timestamp);
+        writeRaw(buffer, anchorLength);
+        buffer.insert(
+            buffer.end(),
+            kf._focusNode.begin(),
+            kf._focusNode.begin() + anchorLength
+        );
+        writeRaw(buffer, _exponent);
+        writeVarint(buffer, position.x);
+        writeVarint(buffer, position.y);
+        writeVarint(buffer, position.z);
+
+        _timestamp = kf._timestamp;
+        _quantizedPosition = position;
+        _anchor = kf._focusNode.substr(0, anchorLength);
+        _followNodeRotation = kf._followNodeRotation;
+        _keyframesSinceFull = 0;
+    }
+    else {
+        // The differences are computed against the values the decoder reconstructs so
+        // that rounding errors do not accumulate over the difference keyframes
+        const int64_t dt = std::llround((kf._timestamp - _timestamp) * 1e6);
+        const glm::i64vec3 position = quantizePosition(kf._position, _exponent);
+        const glm::i64vec3 delta = position - _quantizedPosition;
+
+        writeVarint(buffer, dt);
+        writeVarint(buffer, delta.x);
+        writeVarint(buffer, delta.y);
+        writeVarint(buffer, delta.z);
+
+        _timestamp += static_cast<double>(dt) * 1e-6;
+        _quantizedPosition = position;
+        _keyframesSinceFull++;
+    }
+
+    for (int16_t c : rotation.components) {
+        writeRaw(buffer, c);
+    }
+    if (hasScale) {
+        writeRaw(buffer, kf._scale);
+    }
+
+    _rotation = glm::normalize(kf._rotation);
+    _scale = kf._scale;
+    _hasPrevious = true;
+}
+
+void CameraKeyframeEncoder::reset() {
+    _hasPrevious = false;
+    _keyframesSinceFull = 0;
+}
+
+std::optional<CameraKeyframe> CameraKeyframeDecoder::decode(
+                                                        const std::vector<char>& buffer)
+{
+    Reader reader = { buffer };
+
+    const uint8_t flags = reader.raw<uint8_t>();
+    const uint8_t sequence = reader.raw<uint8_t>();
+    if (!reader.isValid) {
+        return std::nullopt;
+    }
+
+    const bool isFull = flags & FullKeyframeBit;
+    if (!isFull && (!_hasPrevious || sequence != static_cast<uint8_t>(_sequence + 1))) {
+        // We missed the keyframe this one is relative to, so we have to wait for the
+        // next full keyframe
+        _hasPrevious = false;
+        return std::nullopt;
+    }
+
+    double timestamp = 0.0;
+    std::string anchor;
+    int8_t exponent = 0;
+    glm::i64vec3 position = glm::i64vec3(0);
+    if (isFull) {
+        timestamp = reader.raw<double>();
+        const uint16_t anchorLength = reader.raw<uint16_t>();
+        if (!reader.isValid || reader.offset + anchorLength > buffer.size()) {
+            return std::nullopt;
+        }
+        anchor.assign(buffer.data() + reader.offset, anchorLength);
+        reader.offset += anchorLength;
+        exponent = reader.raw<int8_t>();
+        position.x = reader.varint();
+        position.y = reader.varint();
+        position.z = reader.varint();
+    }
+    else {
+        timestamp = _timestamp + static_cast<double>(reader.varint()) * 1e-6;
+        anchor = _anchor;
+        exponent = _exponent;
+        position.x = _quantizedPosition.x + reader.varint();
+        position.y = _quantizedPosition.y + reader.varint();
+        position.z = _quantizedPosition.z + reader.varint();
+    }
+
+    PackedRotation rotation;
+    rotation.largestIndex = (flags >> RotationIndexShift) & 0x3;
+    for (int16_t& c : rotation.components) {
+        c = reader.raw<int16_t>();
+    }
+    const float scale = (flags & ScaleBit) ? reader.raw<float>() : _scale;
+
+    if (!reader.isValid) {
+        return std::nullopt;
+    }
+
+    _hasPrevious = true;
+    _sequence = sequence;
+    _timestamp = timestamp;
+    _anchor = anchor;
+    _exponent = exponent;
+    _quantizedPosition = position;
+    _scale = scale;
+
+    CameraKeyframe kf;
+    kf._position = dequantizePosition(position, exponent);
+    kf._rotation = unpackRotation(rotation);
+    kf._followNodeRotation = flags & FollowNodeRotationBit;
+    kf._focusNode = std::move(anchor);
+    kf._scale = scale;
+    kf._timestamp = timestamp;
+    return kf;
+}
+
+void CameraKeyframeDecoder::reset() {
+    _hasPrevious = false;
+}
+
+} // namespace openspace::datamessagestructures
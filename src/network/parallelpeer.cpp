@@ -115,6 +115,21 @@ namespace {
         // @VISIBILITY(3.5)
         openspace::properties::Property::Visibility::AdvancedUser
     };
+
+    constexpr openspace::properties::Property::PropertyInfo CompactCameraKeyframesInfo = {
+        "UseCompactCameraKeyframes",
+        "Use compact camera keyframes",
+        "If enabled, the camera keyframes are sent in a quantized, delta-encoded form "
+        "that requires a fraction of the bandwidth, and no keyframes are sent while the "
+        "camera is not moving. All connected peers need to support this encoding, so it "
+        "is disabled by default",
+        // @VISIBILITY(3.5)
+        openspace::properties::Property::Visibility::AdvancedUser
+    };
+
+    // While the camera is stationary, a compact camera keyframe is still sent this often
+    // (in seconds) so that peers that join the session receive the camera position
+    constexpr double IdleCameraKeyframeInterval = 1.0;
 } // namespace
 
 namespace openspace {
@@ -129,6 +144,7 @@ ParallelPeer::ParallelPeer()
     , _bufferTime(BufferTimeInfo, 0.2f, 0.01f, 5.0f)
     , _timeKeyframeInterval(TimeKeyFrameInfo, 0.1f, 0.f, 1.f)
     , _cameraKeyframeInterval(CameraKeyFrameInfo, 0.1f, 0.f, 1.f)
+    , _useCompactCameraKeyframes(CompactCameraKeyframesInfo, false)
     , _connectionEvent(std::make_shared<ghoul::Event<>>())
     , _connection(nullptr)
 {
@@ -142,6 +158,9 @@ ParallelPeer::ParallelPeer()
 
     addProperty(_timeKeyframeInterval);
     addProperty(_cameraKeyframeInterval);
+
+    _useCompactCameraKeyframes.onChange([this]() { _resetCameraKeyframeCodec = true; });
+    addProperty(_useCompactCameraKeyframes);
 }
 
 ParallelPeer::~ParallelPeer() {
@@ -323,24 +342,15 @@ void ParallelPeer::dataMessageReceived(const std::vector<char>& message) {
 
     switch (static_cast<datamessagestructures::Type>(type)) {
         case datamessagestructures::Type::CameraData: {
-            datamessagestructures::CameraKeyframe kf(buffer);
-            const double convertedTimestamp = convertTimestamp(kf._timestamp);
-
-            global::navigationHandler->keyframeNavigator().removeKeyframesAfter(
-                convertedTimestamp
-            );
-
-            interaction::KeyframeNavigator::CameraPose pose;
-            pose.focusNode = kf._focusNode;
-            pose.position = kf._position;
-            pose.rotation = kf._rotation;
-            pose.scale = kf._scale;
-            pose.followFocusNodeRotation = kf._followNodeRotation;
-
-            global::navigationHandler->keyframeNavigator().addKeyframe(
-                convertedTimestamp,
-                pose
-            );
+            addCameraKeyframe(datamessagestructures::CameraKeyframe(buffer));
+            break;
+        }
+        case datamessagestructures::Type::CompactCameraData: {
+            std::optional<datamessagestructures::CameraKeyframe> kf =
+                _cameraKeyframeDecoder.decode(buffer);
+            if (kf.has_value()) {
+                addCameraKeyframe(*kf);
+            }
             break;
         }
         case datamessagestructures::Type::TimelineData: {
@@ -555,6 +565,14 @@ void ParallelPeer::resetTimeOffset() {
 void ParallelPeer::preSynchronization() {
     ZoneScoped;
 
+    // The codec state is only touched on this thread, but the connection status can
+    // change on the receiving thread
+    if (_resetCameraKeyframeCodec.exchange(false)) {
+        _cameraKeyframeEncoder.reset();
+        _cameraKeyframeDecoder.reset();
+        _skippedCameraKeyframe = std::nullopt;
+    }
+
     std::unique_lock<std::mutex> unlock(_receiveBufferMutex);
     while (!_receiveBuffer.empty()) {
         ParallelConnection::Message& message = _receiveBuffer.front();
@@ -566,8 +584,34 @@ void ParallelPeer::preSynchronization() {
         double now = global::windowDelegate->applicationTime();
 
         if (_lastCameraKeyframeTimestamp + _cameraKeyframeInterval < now) {
-            sendCameraKeyframe();
-            _lastCameraKeyframeTimestamp = now;
+            std::optional<datamessagestructures::CameraKeyframe> kf =
+                currentCameraKeyframe();
+            if (!kf.has_value()) {
+                _lastCameraKeyframeTimestamp = now;
+            }
+            else if (!_useCompactCameraKeyframes) {
+                sendCameraKeyframe(*kf);
+                _lastCameraKeyframeTimestamp = now;
+            }
+            else if (_cameraKeyframeEncoder.hasMoved(*kf)) {
+                // If we skipped keyframes while the camera was stationary, we resend the
+                // last stationary pose first so that the receivers do not interpolate
+                // the start of the movement over the entire stationary period
+                if (_skippedCameraKeyframe.has_value()) {
+                    sendCameraKeyframe(*_skippedCameraKeyframe);
+                    _skippedCameraKeyframe = std::nullopt;
+                }
+                sendCameraKeyframe(*kf);
+                _lastCameraKeyframeTimestamp = now;
+            }
+            else if (_lastCameraKeyframeTimestamp + IdleCameraKeyframeInterval < now) {
+                sendCameraKeyframe(*kf);
+                _skippedCameraKeyframe = std::nullopt;
+                _lastCameraKeyframeTimestamp = now;
+            }
+            else {
+                _skippedCameraKeyframe = std::move(kf);
+            }
         }
         if (_timeTimelineChanged ||
             _lastTimeKeyframeTimestamp + _timeKeyframeInterval < now)
@@ -588,6 +632,7 @@ void ParallelPeer::setStatus(ParallelConnection::Status status) {
         ParallelConnection::Status prevStatus = _status;
         _status = status;
         _timeJumped = true;
+        _resetCameraKeyframeCodec = true;
         _connectionEvent->publish("statusChanged");
 
 
@@ -661,6 +706,8 @@ ParallelConnection::Status ParallelPeer::status() {
 void ParallelPeer::setNConnections(size_t nConnections) {
     if (_nConnections != nConnections) {
         _nConnections = nConnections;
+        // Peers that just joined need a full keyframe to decode the camera keyframes
+        _resetCameraKeyframeCodec = true;
         _connectionEvent->publish("nConnectionsChanged");
     }
 }
@@ -684,13 +731,15 @@ const std::string& ParallelPeer::hostName() {
     return _hostName;
 }
 
-void ParallelPeer::sendCameraKeyframe() {
+std::optional<datamessagestructures::CameraKeyframe>
+ParallelPeer::currentCameraKeyframe() const
+{
     interaction::NavigationHandler& navHandler = *global::navigationHandler;
 
     const SceneGraphNode* focusNode =
         navHandler.orbitalNavigator().anchorNode();
     if (!focusNode) {
-        return;
+        return std::nullopt;
     }
 
     // Create a keyframe with current position and orientation of camera
@@ -712,19 +761,44 @@ void ParallelPeer::sendCameraKeyframe() {
     // Timestamp as current runtime of OpenSpace instance
     kf._timestamp = global::windowDelegate->applicationTime();
 
+    return kf;
+}
+
+void ParallelPeer::sendCameraKeyframe(const datamessagestructures::CameraKeyframe& kf) {
     // Create a buffer for the keyframe
     std::vector<char> buffer;
 
     // Fill the keyframe buffer
-    kf.serialize(buffer);
+    datamessagestructures::Type type;
+    if (_useCompactCameraKeyframes) {
+        _cameraKeyframeEncoder.encode(kf, buffer);
+        type = datamessagestructures::Type::CompactCameraData;
+    }
+    else {
+        kf.serialize(buffer);
+        type = datamessagestructures::Type::CameraData;
+    }
 
     const double timestamp = global::windowDelegate->applicationTime();
     // Send message
-    _connection.sendDataMessage(ParallelConnection::DataMessage(
-        datamessagestructures::Type::CameraData,
-        timestamp,
-        buffer
-    ));
+    _connection.sendDataMessage(ParallelConnection::DataMessage(type, timestamp, buffer));
+}
+
+void ParallelPeer::addCameraKeyframe(const datamessagestructures::CameraKeyframe& kf) {
+    const double convertedTimestamp = convertTimestamp(kf._timestamp);
+
+    global::navigationHandler->keyframeNavigator().removeKeyframesAfter(
+        convertedTimestamp
+    );
+
+    interaction::KeyframeNavigator::CameraPose pose;
+    pose.focusNode = kf._focusNode;
+    pose.position = kf._position;
+    pose.rotation = kf._rotation;
+    pose.scale = kf._scale;
+    pose.followFocusNodeRotation = kf._followNodeRotation;
+
+    global::navigationHandler->keyframeNavigator().addKeyframe(convertedTimestamp, pose);
 }
 
 void ParallelPeer::sendTimeTimeline() {
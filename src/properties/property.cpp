@@ -30,6 +30,8 @@
 #include <ghoul/lua/ghoul_lua.h>
 #include <ghoul/misc/dictionaryjsonformatter.h>
 #include <algorithm>
+#include <iterator>
+#include <mutex>
 
 namespace {
     constexpr std::string_view MetaDataKeyGroup = "Group";
@@ -42,6 +44,42 @@ namespace {
     constexpr std::string_view TypeKey = "Type";
     constexpr std::string_view MetaDataKey = "MetaData";
     constexpr std::string_view AdditionalDataKey = "AdditionalData";
+
+    using PropertyList = std::vector<openspace::properties::Property*>;
+
+    // Properties can be changed from other threads than the main thread, so all access
+    // to the lists of changed properties has to be protected. A property that is deleted
+    // while it is in one of the lists is replaced by a nullptr in that list, so that the
+    // destructor does not have to search through the list
+    struct ChangedProperties {
+        std::mutex mutex;
+        PropertyList journal;
+        size_t nDeletedFromJournal = 0;
+        PropertyList dirty;
+        size_t nDeletedFromDirty = 0;
+    };
+
+    ChangedProperties& changedProperties() {
+        static ChangedProperties Changed;
+        return Changed;
+    }
+
+    // Returns the list without the entries of properties that have been deleted
+    PropertyList withoutDeleted(const PropertyList& list, size_t nDeleted) {
+        if (nDeleted == 0) {
+            return list;
+        }
+
+        PropertyList res;
+        res.reserve(list.size() - nDeleted);
+        std::copy_if(
+            list.begin(),
+            list.end(),
+            std::back_inserter(res),
+            [](openspace::properties::Property* p) { return p != nullptr; }
+        );
+        return res;
+    }
 } // namespace
 
 namespace openspace::properties {
@@ -69,6 +107,21 @@ Property::Property(PropertyInfo info)
 
 Property::~Property() {
     notifyDeleteListeners();
+
+    if (_isInChangeJournal || _isInDirtyList) {
+        ChangedProperties& changed = changedProperties();
+        std::lock_guard lock(changed.mutex);
+        // The lists might have been cleared in the meantime, so the flags have to be
+        // checked again while holding the lock
+        if (_isInChangeJournal) {
+            changed.journal[_changeJournalIndex] = nullptr;
+            changed.nDeletedFromJournal++;
+        }
+        if (_isInDirtyList) {
+            changed.dirty[_dirtyListIndex] = nullptr;
+            changed.nDeletedFromDirty++;
+        }
+    }
 }
 
 const std::string& Property::identifier() const {
@@ -241,11 +294,30 @@ void Property::setPropertyOwner(PropertyOwner* owner) {
 }
 
 void Property::notifyChangeListeners() {
+    // Only the thread that sets the flag adds the property to the journal
+    if (!_isInChangeJournal.exchange(true)) {
+        ChangedProperties& changed = changedProperties();
+        std::lock_guard lock(changed.mutex);
+        _changeJournalIndex = changed.journal.size();
+        changed.journal.push_back(this);
+    }
+
     for (const std::pair<OnChangeHandle, std::function<void()>>& p : _onChangeCallbacks) {
         p.second();
     }
 }
 
+void Property::markValueDirty() {
+    _isValueDirty = true;
+
+    if (!_isInDirtyList.exchange(true)) {
+        ChangedProperties& changed = changedProperties();
+        std::lock_guard lock(changed.mutex);
+        _dirtyListIndex = changed.dirty.size();
+        changed.dirty.push_back(this);
+    }
+}
+
 void Property::notifyDeleteListeners() {
     for (const std::pair<OnDeleteHandle, std::function<void()>>& p : _onDeleteCallbacks) {
         p.second();
@@ -260,6 +332,71 @@ void Property::resetToUnchanged() {
     _isValueDirty = false;
 }
 
+size_t Property::changeJournalSize() {
+    ChangedProperties& changed = changedProperties();
+    std::lock_guard lock(changed.mutex);
+    return changed.journal.size() - changed.nDeletedFromJournal;
+}
+
+void Property::clearChangeJournal() {
+    ChangedProperties& changed = changedProperties();
+    std::lock_guard lock(changed.mutex);
+    for (Property* p : changed.journal) {
+        if (p) {
+            p->_isInChangeJournal = false;
+        }
+    }
+    changed.journal.clear();
+    changed.nDeletedFromJournal = 0;
+}
+
+std::vector<Property*> Property::dirtyProperties() {
+    ChangedProperties& changed = changedProperties();
+    std::lock_guard lock(changed.mutex);
+    return withoutDeleted(changed.dirty, changed.nDeletedFromDirty);
+}
+
+void Property::compactDirtyProperties() {
+    ChangedProperties& changed = changedProperties();
+    std::lock_guard lock(changed.mutex);
+
+    size_t nKept = 0;
+    for (Property* p : changed.dirty) {
+        if (!p) {
+            continue;
+        }
+
+        if (!p->_isValueDirty) {
+            // If the property is marked as changed again after the flag has been cleared,
+            // either we keep it here or the other thread adds it to the list again once
+            // it gets the lock, but never both or neither
+            p->_isInDirtyList = false;
+            if (!p->_isValueDirty || p->_isInDirtyList.exchange(true)) {
+                continue;
+            }
+        }
+
+        p->_dirtyListIndex = nKept;
+        changed.dirty[nKept] = p;
+        nKept++;
+    }
+    changed.dirty.resize(nKept);
+    changed.nDeletedFromDirty = 0;
+}
+
+void Property::resetAllToUnchanged() {
+    ChangedProperties& changed = changedProperties();
+    std::lock_guard lock(changed.mutex);
+    for (Property* p : changed.dirty) {
+        if (p) {
+            p->_isValueDirty = false;
+            p->_isInDirtyList = false;
+        }
+    }
+    changed.dirty.clear();
+    changed.nDeletedFromDirty = 0;
+}
+
 std::string Property::generateJsonDescription() const {
     std::string cName = escapedJson(std::string(className()));
     std::string identifier = fullyQualifiedIdentifier();
@@ -62,7 +62,7 @@ void SelectionProperty::setValue(std::set<std::string> val) {
 
     _value = std::move(val);
     notifyChangeListeners();
-    _isValueDirty = true;
+    markValueDirty();
 }
 
 bool SelectionProperty::hasOption(const std::string& key) const {
@@ -101,7 +101,7 @@ void SelectionProperty::setOptions(const std::vector<std::string>& keys) {
     // In case we have a selection, remove non-existing options
     bool changed = removeInvalidKeys(_value);
     if (changed) {
-        _isValueDirty = true;
+        markValueDirty();
     }
 
     notifyChangeListeners();
@@ -121,7 +121,7 @@ void SelectionProperty::addOption(const std::string& key) {
 void SelectionProperty::clearSelection() {
     _value.clear();
     notifyChangeListeners();
-    _isValueDirty = true;
+    markValueDirty();
 }
 
 void SelectionProperty::clearOptions() {
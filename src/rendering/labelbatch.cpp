@@ -0,0 +1,485 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/rendering/labelbatch.h>
+
+#include <openspace/data/dataloader.h>
+#include <openspace/engine/globals.h>
+#include <openspace/rendering/renderengine.h>
+#include <openspace/util/threadpool.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/profiling.h>
+#include <ghoul/opengl/openglstatecache.h>
+#include <ghoul/opengl/programobject.h>
+#include <ghoul/opengl/texture.h>
+#include <ghoul/opengl/textureunit.h>
+#include <ghoul/opengl/uniformcache.h>
+#include <algorithm>
+#include <array>
+#include <latch>
+#include <thread>
+
+namespace {
+    // Each thread in the culling should at least get this many labels to make up for
+    // the cost of handing the work to the thread
+    constexpr size_t MinLabelsPerThread = 1 << 13;
+
+    constexpr std::array<const char*, 4> UniformNames = {
+        "mvpMatrix", "tex", "color", "outlineColor"
+    };
+
+    // The program is shared between all label batches and is created by the first and
+    // destroyed by the last batch that is initialized
+    ghoul::opengl::ProgramObject* Program = nullptr;
+    int NProgramUsers = 0;
+    UniformCache(mvpMatrix, tex, color, outlineColor) UniformLocations;
+
+    // The worker threads that are shared by all label batches. The calling thread takes
+    // part in the culling, so one hardware thread fewer is needed
+    openspace::ThreadPool& cullingThreadPool() {
+        static openspace::ThreadPool pool(
+            std::max(std::thread::hardware_concurrency(), 2u) - 1
+        );
+        return pool;
+    }
+
+    // Calls func(begin, end) for contiguous blocks of [0, n) on up to nThreads threads,
+    // including the calling thread
+    template <typename Func>
+    void forEachBlock(size_t n, unsigned int nThreads, const Func& func) {
+        if (nThreads == 0) {
+            nThreads = std::max(std::thread::hardware_concurrency(), 1u);
+        }
+        const size_t maxThreads = std::max<size_t>(n / MinLabelsPerThread, 1);
+        nThreads = static_cast<unsigned int>(std::min<size_t>(nThreads, maxThreads));
+        if (nThreads == 1) {
+            func(size_t(0), n);
+            return;
+        }
+
+        std::latch finished(nThreads - 1);
+        openspace::ThreadPool& pool = cullingThreadPool();
+        for (unsigned int i = 1; i < nThreads; i++) {
+            const size_t begin = n * i / nThreads;
+            const size_t end = n * (i + 1) / nThreads;
+            pool.enqueue([&func, &finished, begin, end]() {
+                func(begin, end);
+                finished.count_down();
+            });
+        }
+        func(size_t(0), n / nThreads);
+        finished.wait();
+    }
+
+    using CullSettings = openspace::LabelBatch::CullSettings;
+
+    // Returns the right and up vectors of the plane in which a label at the provided
+    // position is drawn
+    std::pair<glm::vec3, glm::vec3> labelPlane(const CullSettings& settings,
+                                               const glm::vec3& position)
+    {
+        using Orientation = openspace::LabelBatch::Orientation;
+        if (settings.orientation == Orientation::FaceCamera) {
+            return { settings.orthoRight, settings.orthoUp };
+        }
+
+        const glm::dvec3 normal = glm::normalize(
+            settings.cameraPosition - glm::dvec3(position)
+        );
+        const glm::dvec3 right = glm::normalize(
+            glm::cross(settings.cameraLookUp, normal)
+        );
+        const glm::dvec3 up = glm::cross(normal, right);
+        return { glm::vec3(right), glm::vec3(up) };
+    }
+} // namespace
+
+namespace openspace {
+
+void LabelBatch::initializeGL() {
+    if (NProgramUsers == 0) {
+        std::unique_ptr<ghoul::opengl::ProgramObject> program =
+            global::renderEngine->buildRenderProgram(
+                "LabelBatch",
+                absPath("${SHADERS}/core/labelbatch_vs.glsl"),
+                absPath("${SHADERS}/core/labelbatch_fs.glsl")
+            );
+        Program = program.release();
+        ghoul::opengl::updateUniformLocations(*Program, UniformLocations, UniformNames);
+    }
+    NProgramUsers++;
+
+    glGenVertexArrays(1, &_vao);
+    glGenBuffers(1, &_vbo);
+    glGenBuffers(1, &_ibo);
+
+    glBindVertexArray(_vao);
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ibo);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(
+        0,
+        3,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<void*>(offsetof(Vertex, position))
+    );
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(
+        1,
+        2,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<void*>(offsetof(Vertex, texCoords))
+    );
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(
+        2,
+        2,
+        GL_FLOAT,
+        GL_FALSE,
+        sizeof(Vertex),
+        reinterpret_cast<void*>(offsetof(Vertex, outlineTexCoords))
+    );
+
+    glBindVertexArray(0);
+    _nIndexedQuads = 0;
+}
+
+void LabelBatch::deinitializeGL() {
+    glDeleteVertexArrays(1, &_vao);
+    _vao = 0;
+    glDeleteBuffers(1, &_vbo);
+    _vbo = 0;
+    glDeleteBuffers(1, &_ibo);
+    _ibo = 0;
+    _nIndexedQuads = 0;
+
+    NProgramUsers--;
+    if (NProgramUsers == 0) {
+        global::renderEngine->removeRenderProgram(Program);
+        Program = nullptr;
+    }
+}
+
+void LabelBatch::invalidate() {
+    _hasLayout = false;
+}
+
+bool LabelBatch::hasLayout() const {
+    return _hasLayout;
+}
+
+void LabelBatch::layout(const dataloader::Labelset& labelset, const glm::dmat4& transform,
+                        double unitScale, float lineHeight, const GlyphFunction& glyph,
+                        const KerningFunction& kerning)
+{
+    ZoneScoped;
+
+    _labels.clear();
+    _quads.clear();
+    _labels.reserve(labelset.entries.size());
+
+    // The characters are single bytes, so every glyph is requested at most once and then
+    // looked up by its character
+    std::array<std::optional<Glyph>, 256> glyphs;
+    std::array<bool, 256> isRequested = {};
+
+    size_t nCharacters = 0;
+    for (const dataloader::Labelset::Entry& e : labelset.entries) {
+        nCharacters += e.isEnabled ? e.text.size() : 0;
+    }
+    _quads.reserve(nCharacters);
+
+    for (size_t i = 0; i < labelset.entries.size(); i++) {
+        const dataloader::Labelset::Entry& e = labelset.entries[i];
+        if (!e.isEnabled) {
+            continue;
+        }
+
+        Label label;
+        label.index = static_cast<unsigned int>(i);
+        label.position = glm::vec3(
+            glm::dvec3(transform * glm::dvec4(e.position, 1.0)) * unitScale
+        );
+        label.firstQuad = static_cast<unsigned int>(_quads.size());
+
+        glm::vec2 pen = glm::vec2(0.f);
+        glm::vec2 minimum = glm::vec2(std::numeric_limits<float>::max());
+        glm::vec2 maximum = glm::vec2(-std::numeric_limits<float>::max());
+        wchar_t previous = 0;
+        for (char ch : e.text) {
+            if (ch == '\n') {
+                pen = glm::vec2(0.f, pen.y - lineHeight);
+                previous = 0;
+                continue;
+            }
+
+            const unsigned char index = static_cast<unsigned char>(ch == '\t' ? ' ' : ch);
+            const wchar_t c = static_cast<wchar_t>(index);
+            if (!isRequested[index]) {
+                glyphs[index] = glyph(c);
+                isRequested[index] = true;
+            }
+            if (!glyphs[index].has_value()) {
+                continue;
+            }
+            const Glyph& g = *glyphs[index];
+
+            if (previous != 0 && kerning) {
+                pen.x += kerning(previous, c);
+            }
+            previous = c;
+
+            if (g.width > 0.f && g.height > 0.f) {
+                Quad quad;
+                quad.rect = glm::vec4(
+                    pen.x + g.leftBearing,
+                    pen.y + g.topBearing,
+                    pen.x + g.leftBearing + g.width,
+                    pen.y + g.topBearing - g.height
+                );
+                quad.texCoords = glm::vec4(g.topLeft, g.bottomRight);
+                quad.outlineTexCoords = glm::vec4(g.outlineTopLeft, g.outlineBottomRight);
+                _quads.push_back(quad);
+
+                minimum = glm::min(minimum, glm::vec2(quad.rect.x, quad.rect.w));
+                maximum = glm::max(maximum, glm::vec2(quad.rect.z, quad.rect.y));
+            }
+            pen.x += g.horizontalAdvance;
+        }
+
+        label.nQuads = static_cast<unsigned int>(_quads.size()) - label.firstQuad;
+        if (label.nQuads == 0) {
+            // Labels without any visible glyphs are never drawn
+            continue;
+        }
+        label.bounds = glm::vec4(minimum, maximum);
+        _labels.push_back(label);
+    }
+
+    _isVisible.clear();
+    _visibleLabels.clear();
+    _firstVertex.clear();
+    _vertices.clear();
+    _hasLayout = true;
+}
+
+size_t LabelBatch::cull(const CullSettings& settings, unsigned int nThreads) {
+    ZoneScoped;
+
+    const glm::mat4 mvp = glm::mat4(settings.modelViewProjection);
+    const glm::vec2 halfViewport = settings.viewportSize * 0.5f;
+
+    // Check the visibility of each label in parallel
+    _isVisible.resize(_labels.size());
+    forEachBlock(
+        _labels.size(),
+        nThreads,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Label& label = _labels[i];
+                const auto [right, up] = labelPlane(settings, label.position);
+                const glm::vec3 r = right * settings.scale;
+                const glm::vec3 u = up * settings.scale;
+                const glm::vec4& b = label.bounds;
+
+                const std::array<glm::vec4, 4> corners = {
+                    mvp * glm::vec4(label.position + b.x * r + b.y * u, 1.f),
+                    mvp * glm::vec4(label.position + b.x * r + b.w * u, 1.f),
+                    mvp * glm::vec4(label.position + b.z * r + b.w * u, 1.f),
+                    mvp * glm::vec4(label.position + b.z * r + b.y * u, 1.f)
+                };
+
+                // A label is culled if it is (partially) behind the camera or if all of
+                // its corners are outside of the same clipping plane
+                bool isVisible = true;
+                int outside = 0b1111;
+                for (const glm::vec4& c : corners) {
+                    if (c.w <= 0.f) {
+                        isVisible = false;
+                        break;
+                    }
+                    outside &= (c.x < -c.w ? 0b0001 : 0) | (c.x > c.w ? 0b0010 : 0) |
+                               (c.y < -c.w ? 0b0100 : 0) | (c.y > c.w ? 0b1000 : 0);
+                }
+                if (isVisible && outside == 0) {
+                    // The height of the label in pixels along its up direction
+                    const glm::vec2 bottom = glm::vec2(corners[0]) / corners[0].w;
+                    const glm::vec2 top = glm::vec2(corners[1]) / corners[1].w;
+                    const float height = glm::length((top - bottom) * halfViewport);
+                    isVisible = height >= settings.minMaxSize.x &&
+                                height <= settings.minMaxSize.y;
+                }
+                else {
+                    isVisible = false;
+                }
+                _isVisible[i] = isVisible ? 1 : 0;
+            }
+        }
+    );
+
+    _visibleLabels.clear();
+    _firstVertex.clear();
+    size_t nVertices = 0;
+    for (size_t i = 0; i < _labels.size(); i++) {
+        if (_isVisible[i]) {
+            _visibleLabels.push_back(static_cast<unsigned int>(i));
+            _firstVertex.push_back(static_cast<unsigned int>(nVertices));
+            nVertices += 4 * _labels[i].nQuads;
+        }
+    }
+
+    // Place the glyph quads of the visible labels in the world
+    _vertices.resize(nVertices);
+    forEachBlock(
+        _visibleLabels.size(),
+        nThreads,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                const Label& label = _labels[_visibleLabels[i]];
+                const auto [right, up] = labelPlane(settings, label.position);
+                const glm::vec3 r = right * settings.scale;
+                const glm::vec3 u = up * settings.scale;
+
+                Vertex* v = _vertices.data() + _firstVertex[i];
+                for (unsigned int j = 0; j < label.nQuads; j++) {
+                    const Quad& q = _quads[label.firstQuad + j];
+                    const glm::vec3 x0 = label.position + q.rect.x * r;
+                    const glm::vec3 x1 = label.position + q.rect.z * r;
+                    const glm::vec3 y0 = q.rect.y * u;
+                    const glm::vec3 y1 = q.rect.w * u;
+                    const glm::vec4& t = q.texCoords;
+                    const glm::vec4& o = q.outlineTexCoords;
+
+                    v[0] = { x0 + y0, glm::vec2(t.x, t.y), glm::vec2(o.x, o.y) };
+                    v[1] = { x0 + y1, glm::vec2(t.x, t.w), glm::vec2(o.x, o.w) };
+                    v[2] = { x1 + y1, glm::vec2(t.z, t.w), glm::vec2(o.z, o.w) };
+                    v[3] = { x1 + y0, glm::vec2(t.z, t.y), glm::vec2(o.z, o.y) };
+                    v += 4;
+                }
+            }
+        }
+    );
+
+    // Report the indices into the labelset rather than into the laid out labels
+    for (unsigned int& i : _visibleLabels) {
+        i = _labels[i].index;
+    }
+    return _visibleLabels.size();
+}
+
+void LabelBatch::render(const glm::dmat4& modelViewProjection, const glm::vec4& color,
+                        const glm::vec4& outlineColor, ghoul::opengl::Texture& atlas)
+{
+    ZoneScoped;
+
+    if (_vertices.empty()) {
+        return;
+    }
+    ghoul_assert(Program, "LabelBatch was not initialized");
+
+    const size_t nQuads = _vertices.size() / 4;
+
+    glBindVertexArray(_vao);
+
+    // The indices only depend on the number of quads, so they are only updated when the
+    // number of visible quads grows beyond what has been drawn before
+    if (nQuads > _nIndexedQuads) {
+        _nIndexedQuads = std::max(nQuads, 2 * _nIndexedQuads);
+        std::vector<GLuint> indices;
+        indices.reserve(6 * _nIndexedQuads);
+        for (size_t i = 0; i < _nIndexedQuads; i++) {
+            const GLuint first = static_cast<GLuint>(4 * i);
+            indices.insert(
+                indices.end(),
+                { first, first + 1, first + 2, first, first + 2, first + 3 }
+            );
+        }
+        glBufferData(
+            GL_ELEMENT_ARRAY_BUFFER,
+            indices.size() * sizeof(GLuint),
+            indices.data(),
+            GL_STATIC_DRAW
+        );
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
+    glBufferData(
+        GL_ARRAY_BUFFER,
+        _vertices.size() * sizeof(Vertex),
+        _vertices.data(),
+        GL_STREAM_DRAW
+    );
+
+    Program->activate();
+    Program->setUniform(UniformLocations.mvpMatrix, glm::mat4(modelViewProjection));
+    Program->setUniform(UniformLocations.color, color);
+    Program->setUniform(UniformLocations.outlineColor, outlineColor);
+
+    ghoul::opengl::TextureUnit unit;
+    unit.activate();
+    atlas.bind();
+    Program->setUniform(UniformLocations.tex, unit);
+
+    glEnablei(GL_BLEND, 0);
+    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glEnable(GL_DEPTH_TEST);
+    glDepthMask(false);
+
+    glDrawElements(
+        GL_TRIANGLES,
+        static_cast<GLsizei>(6 * nQuads),
+        GL_UNSIGNED_INT,
+        nullptr
+    );
+
+    glBindVertexArray(0);
+    Program->deactivate();
+
+    global::renderEngine->openglStateCache().resetBlendState();
+    global::renderEngine->openglStateCache().resetDepthState();
+}
+
+size_t LabelBatch::nLabels() const {
+    return _labels.size();
+}
+
+size_t LabelBatch::nGlyphs() const {
+    return _quads.size();
+}
+
+const std::vector<unsigned int>& LabelBatch::visibleLabels() const {
+    return _visibleLabels;
+}
+
+const std::vector<LabelBatch::Vertex>& LabelBatch::vertices() const {
+    return _vertices;
+}
+
+} // namespace openspace
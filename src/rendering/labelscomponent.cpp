@@ -27,18 +27,18 @@
 #include <openspace/engine/globals.h>
 #include <openspace/engine/windowdelegate.h>
 #include <openspace/documentation/documentation.h>
+#include <openspace/rendering/renderengine.h>
 #include <openspace/util/updatestructures.h>
 #include <ghoul/filesystem/filesystem.h>
+#include <ghoul/font/font.h>
 #include <ghoul/font/fontmanager.h>
-#include <ghoul/font/fontrenderer.h>
+#include <ghoul/font/textureatlas.h>
+#include <cmath>
 #include <optional>
 
 namespace {
     constexpr std::string_view _loggerCat = "LabelsComponent";
 
-    constexpr int RenderOptionFaceCamera = 0;
-    constexpr int RenderOptionPositionNormal = 1;
-
     constexpr openspace::properties::Property::PropertyInfo EnabledInfo = {
         "Enabled",
         "Enabled",
@@ -224,6 +224,7 @@ LabelsComponent::LabelsComponent(const ghoul::Dictionary& dictionary)
 }
 
 dataloader::Labelset& LabelsComponent::labelSet() {
+    _batch.invalidate();
     return _labelset;
 }
 
@@ -238,6 +239,15 @@ void LabelsComponent::initialize() {
         ghoul::fontrendering::FontManager::Outline::Yes,
         ghoul::fontrendering::FontManager::LoadGlyphs::No
     );
+    _batch.invalidate();
+}
+
+void LabelsComponent::initializeGL() {
+    _batch.initializeGL();
+}
+
+void LabelsComponent::deinitializeGL() {
+    _batch.deinitializeGL();
 }
 
 void LabelsComponent::loadLabels() {
@@ -248,6 +258,7 @@ void LabelsComponent::loadLabels() {
     else {
         _labelset = dataloader::label::loadFile(_labelFile);
     }
+    _batch.invalidate();
 }
 
 bool LabelsComponent::isReady() const {
@@ -266,43 +277,59 @@ void LabelsComponent::render(const RenderData& data,
     if (!_enabled) {
         return;
     }
-    float scale = static_cast<float>(toMeter(_unit));
-
-    int renderOption = _faceCamera ? RenderOptionFaceCamera : RenderOptionPositionNormal;
-
-    ghoul::fontrendering::FontRenderer::ProjectedLabelsInformation labelInfo;
-    labelInfo.orthoRight = orthoRight;
-    labelInfo.orthoUp = orthoUp;
-    labelInfo.minSize = _minMaxSize.value().x;
-    labelInfo.maxSize = _minMaxSize.value().y;
-    labelInfo.cameraPos = data.camera.positionVec3();
-    labelInfo.cameraLookUp = data.camera.lookUpVectorWorldSpace();
-    labelInfo.renderType = renderOption;
-    labelInfo.mvpMatrix = modelViewProjectionMatrix;
-    labelInfo.scale = pow(10.f, _size);
-    labelInfo.enableDepth = true;
-    labelInfo.enableFalseDepth = false;
-
-    glm::vec4 textColor = glm::vec4(glm::vec3(_color), opacity() * fadeInVariable);
-
-    for (const dataloader::Labelset::Entry& e : _labelset.entries) {
-        if (!e.isEnabled) {
-            continue;
-        }
-
-        // Transform and scale the labels
-        glm::vec3 transformedPos(_transformationMatrix * glm::dvec4(e.position, 1.0));
-        glm::vec3 scaledPos(transformedPos);
-        scaledPos *= scale;
-
-        ghoul::fontrendering::FontRenderer::defaultProjectionRenderer().render(
-            *_font,
-            scaledPos,
-            e.text,
-            textColor,
-            labelInfo
+
+    if (!_batch.hasLayout()) {
+        ghoul::fontrendering::Font& font = *_font;
+        _batch.layout(
+            _labelset,
+            _transformationMatrix,
+            toMeter(_unit),
+            font.height(),
+            [&font](wchar_t c) -> std::optional<LabelBatch::Glyph> {
+                const ghoul::fontrendering::Font::Glyph* g = font.glyph(c);
+                if (!g) {
+                    return std::nullopt;
+                }
+                LabelBatch::Glyph glyph;
+                glyph.width = g->width;
+                glyph.height = g->height;
+                glyph.leftBearing = g->leftBearing;
+                glyph.topBearing = g->topBearing;
+                glyph.horizontalAdvance = g->horizontalAdvance;
+                glyph.topLeft = g->topLeft;
+                glyph.bottomRight = g->bottomRight;
+                glyph.outlineTopLeft = g->outlineTopLeft;
+                glyph.outlineBottomRight = g->outlineBottomRight;
+                return glyph;
+            },
+            [&font](wchar_t previous, wchar_t current) {
+                return font.glyph(current)->kerning(previous);
+            }
         );
     }
+
+    LabelBatch::CullSettings settings;
+    settings.modelViewProjection = modelViewProjectionMatrix;
+    settings.orthoRight = orthoRight;
+    settings.orthoUp = orthoUp;
+    settings.cameraPosition = data.camera.positionVec3();
+    settings.cameraLookUp = data.camera.lookUpVectorWorldSpace();
+    settings.orientation =
+        _faceCamera ?
+        LabelBatch::Orientation::FaceCamera :
+        LabelBatch::Orientation::PositionNormal;
+    settings.scale = std::pow(10.f, _size);
+    settings.minMaxSize = glm::vec2(_minMaxSize.value());
+    settings.viewportSize = glm::vec2(global::renderEngine->renderingResolution());
+    _batch.cull(settings);
+
+    const float alpha = opacity() * fadeInVariable;
+    _batch.render(
+        modelViewProjectionMatrix,
+        glm::vec4(glm::vec3(_color), alpha),
+        glm::vec4(0.f, 0.f, 0.f, alpha),
+        _font->atlas().texture()
+    );
 }
 
 } // namespace openspace
@@ -731,9 +731,12 @@ void RenderEngine::render(const glm::mat4& sceneMatrix, const glm::mat4& viewMat
         std::string dt = std::to_string(global::windowDelegate->deltaTime());
         std::string avgDt = std::to_string(global::windowDelegate->averageDeltaTime());
 
+        const size_t nChanged = properties::Property::changeJournalSize();
+
         std::string res = fmt::format(
-            "Frame: {} {}\nSwap group frame: {}\nDt: {}\nAvg Dt: {}",
-            fn, fr, sgFn, dt, avgDt
+            "Frame: {} {}\nSwap group frame: {}\nDt: {}\nAvg Dt: {}\n"
+            "Changed properties: {}",
+            fn, fr, sgFn, dt, avgDt, nChanged
         );
         RenderFont(*_fontFrameInfo, penPosition, res);
     }
@@ -34,11 +34,28 @@
 #include <algorithm>
 #include <filesystem>
 #include <unordered_set>
+#include <utility>
 
 namespace openspace {
 
 namespace {
     constexpr std::string_view _loggerCat = "Asset";
+
+    using Clock = std::chrono::steady_clock;
+
+    // The time spent loading the assets required by the asset that is currently loading.
+    // Assets are only loaded on the main thread, so there is only ever one of them
+    std::chrono::microseconds RequiredLoadTime = std::chrono::microseconds(0);
+
+    std::chrono::microseconds timeSince(Clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(
+            Clock::now() - start
+        );
+    }
+
+    double milliseconds(std::chrono::microseconds time) {
+        return static_cast<double>(time.count()) / 1000.0;
+    }
 } // namespace
 
 Asset::Asset(AssetManager& manager, std::filesystem::path assetPath,
@@ -225,7 +242,21 @@ void Asset::addIdentifier(std::string identifier) {
 
 void Asset::load(Asset* parent) {
     if (!isLoaded()) {
+        // Required assets are loaded while this asset is loaded, so their time has to be
+        // subtracted from the total time
+        const std::chrono::microseconds outerLoadTime =
+            std::exchange(RequiredLoadTime, std::chrono::microseconds(0));
+        const Clock::time_point start = Clock::now();
+
         const bool loaded = _manager.loadAsset(this, parent);
+
+        const std::chrono::microseconds totalTime = timeSince(start);
+        _loadTime = totalTime - RequiredLoadTime;
+        RequiredLoadTime = outerLoadTime + totalTime;
+        LDEBUG(fmt::format(
+            "Loaded asset {} in {:.2f} ms", _assetPath, milliseconds(_loadTime)
+        ));
+
         setState(loaded ? State::Loaded : State::LoadingFailed);
     }
 }
@@ -289,6 +320,7 @@ void Asset::initialize() {
     }
 
     // 2. Call Lua onInitialize
+    const Clock::time_point start = Clock::now();
     try {
         _manager.callOnInitialize(this);
     }
@@ -298,11 +330,30 @@ void Asset::initialize() {
         setState(State::InitializationFailed);
         return;
     }
+    _initializationTime = timeSince(start);
+    LDEBUG(fmt::format(
+        "Initialized asset {} in {:.2f} ms",
+        _assetPath, milliseconds(_initializationTime)
+    ));
 
     // 3. Update state
     setState(State::Initialized);
 }
 
+Asset* Asset::nextAssetToInitialize() {
+    if (isInitialized() || !isSynchronized() || _state == State::InitializationFailed) {
+        return nullptr;
+    }
+
+    for (Asset* child : _requiredAssets) {
+        Asset* next = child->nextAssetToInitialize();
+        if (next) {
+            return next;
+        }
+    }
+    return this;
+}
+
 void Asset::deinitialize() {
     if (!isInitialized()) {
         return;
@@ -352,4 +403,12 @@ std::optional<Asset::MetaInformation> Asset::metaInformation() const {
     return _metaInformation;
 }
 
+std::chrono::microseconds Asset::loadTime() const {
+    return _loadTime;
+}
+
+std::chrono::microseconds Asset::initializationTime() const {
+    return _initializationTime;
+}
+
 } // namespace openspace
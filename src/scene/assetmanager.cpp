@@ -32,6 +32,11 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/lua_helper.h>
+#include <algorithm>
+#include <cctype>
+#include <fstream>
+#include <iterator>
+#include <thread>
 
 #include "assetmanager_lua.inl"
 
@@ -50,6 +55,38 @@ namespace {
         Tokenized ///< Specified as a path that starts with a token
     };
 
+    // Appends the compiled chunk that lua_dump produces piece by piece
+    int writeChunk(lua_State*, const void* data, size_t size, void* userData) {
+        std::string* chunk = reinterpret_cast<std::string*>(userData);
+        chunk->append(reinterpret_cast<const char*>(data), size);
+        return 0;
+    }
+
+    // Returns the paths of all `asset.require` calls in the provided asset source that
+    // use a string literal. Other calls are only found when the asset is executed
+    std::vector<std::string> findRequiredPaths(std::string_view source) {
+        constexpr std::string_view Require = "asset.require(";
+
+        std::vector<std::string> res;
+        size_t pos = source.find(Require);
+        while (pos != std::string_view::npos) {
+            pos += Require.size();
+            while (pos < source.size() &&
+                   std::isspace(static_cast<unsigned char>(source[pos])))
+            {
+                pos++;
+            }
+            if (pos < source.size() && (source[pos] == '"' || source[pos] == '\'')) {
+                const size_t end = source.find(source[pos], pos + 1);
+                if (end != std::string_view::npos) {
+                    res.emplace_back(source.substr(pos + 1, end - pos - 1));
+                }
+            }
+            pos = source.find(Require, pos);
+        }
+        return res;
+    }
+
     PathType classifyPath(const std::string& path) {
         if (path.size() > 2 && path[0] == '.' && path[1] == '/') {
             return PathType::RelativeToAsset;
@@ -125,7 +162,8 @@ namespace openspace {
 
 AssetManager::AssetManager(ghoul::lua::LuaState* state,
                            std::filesystem::path assetRootDirectory)
-    : _assetRootDirectory(std::move(assetRootDirectory))
+    : _prefetchThreads(std::clamp(std::thread::hardware_concurrency(), 1u, 4u))
+    , _assetRootDirectory(std::move(assetRootDirectory))
     , _luaState(state)
 {
     ghoul_precondition(state, "Lua state must not be nullptr");
@@ -157,7 +195,7 @@ void AssetManager::deinitialize() {
     _toBeDeleted.clear();
 }
 
-void AssetManager::update() {
+void AssetManager::update(UnlimitedBudget unlimitedBudget) {
     ZoneScoped;
 
     // Delete all the assets that have been marked for deletion in the previous frame
@@ -167,27 +205,50 @@ void AssetManager::update() {
         _toBeDeleted.clear();
     }
 
-    // Initialize all assets that have been loaded and synchronized but that not yet
-    // initialized
-    for (auto it = _toBeInitialized.cbegin(); it != _toBeInitialized.cend(); ++it) {
+    // Initialize the assets that have been loaded and synchronized but that are not yet
+    // initialized. The assets are initialized one by one, children before their parents,
+    // until the budget is used up so that a large asset tree is spread over multiple
+    // frames. At least one asset is initialized per call to guarantee progress
+    {
         ZoneScopedN("Initializing queued assets");
-        Asset* a = *it;
 
-        if (a->isInitialized() || !a->isSynchronized()) {
-            // nothing to do here
-            continue;
-        }
-
-        a->initialize();
+        using Clock = std::chrono::steady_clock;
+        const Clock::time_point start = Clock::now();
+        bool hasInitialized = false;
+        size_t i = 0;
+        while (i < _toBeInitialized.size()) {
+            Asset* root = _toBeInitialized[i];
+            Asset* next = root->nextAssetToInitialize();
+            if (!next) {
+                // Either the asset is finished or it is still waiting for its
+                // synchronizations. Only in the latter case it has to be kept around
+                if (root->isInitialized() || root->isFailed()) {
+                    _toBeInitialized.erase(_toBeInitialized.begin() + i);
+                }
+                else {
+                    i++;
+                }
+                continue;
+            }
 
-        // We are only doing one asset per frame to keep the loading screen working a bit
-        // smoother, so we remove the current one and then break out of the loop
-        _toBeInitialized.erase(it);
+            const bool isOverBudget = Clock::now() - start >= _initializationBudget;
+            if (hasInitialized && !unlimitedBudget && isOverBudget) {
+                break;
+            }
+            next->initialize();
+            hasInitialized = true;
+        }
+    }
 
-        // OBS: This can't be replaced with a (get the first one and then bail) as the
-        // first asset in the list might wait for its child later in the list to finished.
-        // So if we check the first one over and over again, we'll be in an infinite loop
-        break;
+    // Start reading all queued asset files at once, their children will be read while
+    // the assets are being loaded
+    for (const std::string& asset : _assetAddQueue) {
+        try {
+            prefetchAsset(generateAssetPath(_assetRootDirectory, asset));
+        }
+        catch (const ghoul::RuntimeError&) {
+            // The error is reported when the asset is actually loaded
+        }
     }
 
     // Add all assets that have been queued for loading since the last `update` call
@@ -227,6 +288,11 @@ void AssetManager::update() {
     }
     _assetAddQueue.clear();
 
+    // All assets are loaded inside this function, so the remaining prefetched files were
+    // not required after all, for example because the `require` was conditional
+    _prefetchThreads.clearTasks();
+    _prefetchedAssets.clear();
+
     // Remove assets
     for (const std::string& asset : _assetRemoveQueue) {
         ZoneScopedN("Removing queued assets");
@@ -302,6 +368,10 @@ void AssetManager::update() {
     }
 }
 
+void AssetManager::setInitializationBudget(std::chrono::microseconds budget) {
+    _initializationBudget = budget;
+}
+
 void AssetManager::add(const std::string& path) {
     ghoul_precondition(!path.empty(), "Path must not be empty");
     // First check if the path is already in the remove queue. If so, remove it from there
@@ -368,8 +438,43 @@ bool AssetManager::loadAsset(Asset* asset, Asset* parent) {
         return false;
     }
 
+    // If the file has been prefetched, we can use the compiled chunk and start reading
+    // the assets that this asset requires before they are needed
+    std::string bytecode;
+    const auto it = _prefetchedAssets.find(asset->path().string());
+    if (it != _prefetchedAssets.end()) {
+        PrefetchedAsset prefetched = it->second.get();
+        _prefetchedAssets.erase(it);
+        for (const std::string& path : prefetched.requiredPaths) {
+            try {
+                prefetchAsset(generateAssetPath(asset->path().parent_path(), path));
+            }
+            catch (const ghoul::RuntimeError&) {
+                // The error is reported when the required asset is loaded
+            }
+        }
+        bytecode = std::move(prefetched.bytecode);
+    }
+
     try {
-        ghoul::lua::runScriptFile(*_luaState, asset->path());
+        if (!bytecode.empty()) {
+            // Lua chunk names that start with @ are file names and used in error messages
+            const std::string chunkName = "@" + asset->path().string();
+            const int status = luaL_loadbuffer(
+                *_luaState,
+                bytecode.data(),
+                bytecode.size(),
+                chunkName.c_str()
+            );
+            if (status != LUA_OK || lua_pcall(*_luaState, 0, 0, 0) != LUA_OK) {
+                throw ghoul::lua::LuaRuntimeException(
+                    ghoul::lua::value<std::string>(*_luaState, -1)
+                );
+            }
+        }
+        else {
+            ghoul::lua::runScriptFile(*_luaState, asset->path());
+        }
     }
     catch (const ghoul::lua::LuaRuntimeException& e) {
         LERROR(fmt::format("Could not load asset {}: {}", asset->path(), e.message));
@@ -870,6 +975,50 @@ void AssetManager::setUpAssetLuaTable(Asset* asset) {
     lua_settop(*_luaState, top);
 }
 
+void AssetManager::prefetchAsset(const std::filesystem::path& path) {
+    std::string key = path.string();
+    if (_prefetchedAssets.contains(key) || !std::filesystem::is_regular_file(path)) {
+        return;
+    }
+    const bool isLoaded = std::any_of(
+        _assets.cbegin(),
+        _assets.cend(),
+        [&path](const std::unique_ptr<Asset>& asset) { return asset->path() == path; }
+    );
+    if (isLoaded) {
+        return;
+    }
+
+    // The promise is shared as the thread pool only accepts copyable functions
+    auto promise = std::make_shared<std::promise<PrefetchedAsset>>();
+    _prefetchedAssets[std::move(key)] = promise->get_future();
+    _prefetchThreads.enqueue([promise, path]() {
+        ZoneScopedN("Prefetch asset");
+
+        std::ifstream file(path);
+        const std::string source = std::string(
+            std::istreambuf_iterator<char>(file),
+            std::istreambuf_iterator<char>()
+        );
+
+        PrefetchedAsset res;
+        res.requiredPaths = findRequiredPaths(source);
+
+        // Compiling the file only requires a separate Lua state. The resulting bytecode
+        // can then be loaded into the shared Lua state without parsing it again
+        lua_State* state = luaL_newstate();
+        const std::string chunkName = "@" + path.string();
+        const int status =
+            luaL_loadbuffer(state, source.data(), source.size(), chunkName.c_str());
+        if (status == LUA_OK) {
+            lua_dump(state, writeChunk, &res.bytecode, 0);
+        }
+        lua_close(state);
+
+        promise->set_value(std::move(res));
+    });
+}
+
 Asset* AssetManager::retrieveAsset(const std::filesystem::path& path,
                                    const std::filesystem::path& retriever,
                                    std::optional<bool> explicitEnable)
@@ -40,6 +40,7 @@
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/misc/stringhelper.h>
+#include <algorithm>
 #include <ctime>
 #include <filesystem>
 #include <set>
@@ -57,16 +58,29 @@ namespace {
     std::vector<properties::Property*> changedProperties(
                                                       const properties::PropertyOwner& po)
     {
+        // Only the properties that have been marked as changed need to be checked rather
+        // than all properties below the property owner
         std::vector<properties::Property*> res;
-        for (properties::PropertyOwner* subOwner : po.propertySubOwners()) {
-            std::vector<properties::Property*> ps = changedProperties(*subOwner);
-            res.insert(res.end(), ps.begin(), ps.end());
-        }
-        for (properties::Property* p : po.properties()) {
-            if (p->hasChanged()) {
-                res.push_back(p);
+        for (properties::Property* p : properties::Property::dirtyProperties()) {
+            if (!p->hasChanged()) {
+                continue;
+            }
+            for (const properties::PropertyOwner* o = p->owner(); o; o = o->owner()) {
+                if (o == &po) {
+                    res.push_back(p);
+                    break;
+                }
             }
         }
+
+        // Keep the order stable regardless of the order in which the properties changed
+        std::sort(
+            res.begin(),
+            res.end(),
+            [](properties::Property* lhs, properties::Property* rhs) {
+                return lhs->fullyQualifiedIdentifier() < rhs->fullyQualifiedIdentifier();
+            }
+        );
         return res;
     }
 
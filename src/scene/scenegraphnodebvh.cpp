@@ -0,0 +1,344 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/scene/scenegraphnodebvh.h>
+
+#include <ghoul/misc/profiling.h>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <utility>
+
+namespace {
+    // The maximum number of entries that are stored in a leaf of the tree
+    constexpr uint32_t MaxEntriesPerLeaf = 4;
+
+    // Refitting the tree to moving nodes makes the bounds overlap more and more, so the
+    // tree is rebuilt after it has been refitted this many times
+    constexpr int MaxRefits = 64;
+
+    double distanceSquaredToBox(const glm::dvec3& p, const glm::dvec3& min,
+                                const glm::dvec3& max)
+    {
+        const glm::dvec3 d = glm::max(glm::max(min - p, p - max), glm::dvec3(0.0));
+        return glm::dot(d, d);
+    }
+
+    // Returns whether the points p + t * d with t in [0, tMax] intersect the box
+    bool intersectsBox(const glm::dvec3& p, const glm::dvec3& d, double tMax,
+                       const glm::dvec3& min, const glm::dvec3& max)
+    {
+        double t0 = 0.0;
+        double t1 = tMax;
+        for (int i = 0; i < 3; i++) {
+            if (d[i] == 0.0) {
+                if (p[i] < min[i] || p[i] > max[i]) {
+                    return false;
+                }
+                continue;
+            }
+
+            const double invD = 1.0 / d[i];
+            double tNear = (min[i] - p[i]) * invD;
+            double tFar = (max[i] - p[i]) * invD;
+            if (tNear > tFar) {
+                std::swap(tNear, tFar);
+            }
+            t0 = std::max(t0, tNear);
+            t1 = std::min(t1, tFar);
+            if (t0 > t1) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Returns the squared distance between c and the closest of the points p + t * d
+    // with t in [0, tMax]
+    double distanceSquaredToLine(const glm::dvec3& p, const glm::dvec3& d, double tMax,
+                                 const glm::dvec3& c)
+    {
+        const double dd = glm::dot(d, d);
+        const double t = dd > 0.0 ? std::clamp(glm::dot(c - p, d) / dd, 0.0, tMax) : 0.0;
+        const glm::dvec3 diff = p + t * d - c;
+        return glm::dot(diff, diff);
+    }
+} // namespace
+
+namespace openspace {
+
+void SceneGraphNodeBvh::update(std::vector<Entry> entries) {
+    ZoneScoped;
+
+    const bool hasSameNodes = _nRefits < MaxRefits &&
+        entries.size() == _entries.size() &&
+        std::equal(
+            entries.begin(), entries.end(),
+            _entries.begin(),
+            [](const Entry& lhs, const Entry& rhs) { return lhs.node == rhs.node; }
+        );
+    _entries = std::move(entries);
+
+    if (hasSameNodes) {
+        _nRefits++;
+    }
+    else {
+        const uint32_t nEntries = static_cast<uint32_t>(_entries.size());
+        _order.resize(nEntries);
+        std::iota(_order.begin(), _order.end(), 0);
+        _nodes.clear();
+        if (nEntries > 0) {
+            _nodes.reserve(2 * (nEntries / MaxEntriesPerLeaf + 1));
+            build(0, nEntries);
+        }
+        _nRefits = 0;
+    }
+    refit();
+}
+
+const std::vector<SceneGraphNodeBvh::Entry>& SceneGraphNodeBvh::entries() const {
+    return _entries;
+}
+
+uint32_t SceneGraphNodeBvh::build(uint32_t begin, uint32_t end) {
+    const uint32_t index = static_cast<uint32_t>(_nodes.size());
+    _nodes.emplace_back();
+
+    if (end - begin <= MaxEntriesPerLeaf) {
+        _nodes[index].first = begin;
+        _nodes[index].count = end - begin;
+        return index;
+    }
+
+    // Split the entries at the median of the longest axis of their centers
+    glm::dvec3 min = glm::dvec3(std::numeric_limits<double>::max());
+    glm::dvec3 max = glm::dvec3(-std::numeric_limits<double>::max());
+    for (uint32_t i = begin; i < end; i++) {
+        min = glm::min(min, _entries[_order[i]].center);
+        max = glm::max(max, _entries[_order[i]].center);
+    }
+    const glm::dvec3 size = max - min;
+    int axis = 0;
+    if (size.y > size[axis]) {
+        axis = 1;
+    }
+    if (size.z > size[axis]) {
+        axis = 2;
+    }
+
+    const uint32_t mid = begin + (end - begin) / 2;
+    std::nth_element(
+        _order.begin() + begin,
+        _order.begin() + mid,
+        _order.begin() + end,
+        [this, axis](uint32_t lhs, uint32_t rhs) {
+            return _entries[lhs].center[axis] < _entries[rhs].center[axis];
+        }
+    );
+
+    // The first child directly follows its parent
+    build(begin, mid);
+    const uint32_t second = build(mid, end);
+    _nodes[index].first = second;
+    _nodes[index].count = 0;
+    return index;
+}
+
+void SceneGraphNodeBvh::refit() {
+    // The children are stored after their parent, so iterating backwards updates the
+    // children before the parents that depend on them
+    for (size_t i = _nodes.size(); i > 0; i--) {
+        Node& node = _nodes[i - 1];
+        if (node.count > 0) {
+            const Entry& e = _entries[_order[node.first]];
+            node.min = e.center;
+            node.max = e.center;
+            node.maxRadius = e.radius;
+            for (uint32_t j = node.first + 1; j < node.first + node.count; j++) {
+                const Entry& f = _entries[_order[j]];
+                node.min = glm::min(node.min, f.center);
+                node.max = glm::max(node.max, f.center);
+                node.maxRadius = std::max(node.maxRadius, f.radius);
+            }
+        }
+        else {
+            const Node& a = _nodes[i];
+            const Node& b = _nodes[node.first];
+            node.min = glm::min(a.min, b.min);
+            node.max = glm::max(a.max, b.max);
+            node.maxRadius = std::max(a.maxRadius, b.maxRadius);
+        }
+    }
+}
+
+template <typename NodeTest, typename EntryTest>
+void SceneGraphNodeBvh::query(NodeTest nodeTest, EntryTest entryTest,
+                              std::vector<uint32_t>& result) const
+{
+    if (_nodes.empty()) {
+        return;
+    }
+
+    const size_t nPrevious = result.size();
+    std::vector<uint32_t> stack = { 0 };
+    while (!stack.empty()) {
+        const uint32_t index = stack.back();
+        stack.pop_back();
+
+        const Node& node = _nodes[index];
+        if (!nodeTest(node)) {
+            continue;
+        }
+
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                if (entryTest(_entries[_order[i]])) {
+                    result.push_back(_order[i]);
+                }
+            }
+        }
+        else {
+            stack.push_back(node.first);
+            stack.push_back(index + 1);
+        }
+    }
+    std::sort(result.begin() + nPrevious, result.end());
+}
+
+void SceneGraphNodeBvh::querySphere(const glm::dvec3& center, double radius,
+                                    std::vector<uint32_t>& result,
+                                    double radiusScale) const
+{
+    ZoneScoped;
+
+    query(
+        [&](const Node& node) {
+            const double r = node.maxRadius * radiusScale + radius;
+            return distanceSquaredToBox(center, node.min, node.max) <= r * r;
+        },
+        [&](const Entry& e) {
+            const double r = e.radius * radiusScale + radius;
+            const glm::dvec3 diff = e.center - center;
+            return glm::dot(diff, diff) <= r * r;
+        },
+        result
+    );
+}
+
+void SceneGraphNodeBvh::querySegment(const glm::dvec3& start, const glm::dvec3& end,
+                                     std::vector<uint32_t>& result,
+                                     double radiusScale) const
+{
+    ZoneScoped;
+
+    const glm::dvec3 d = end - start;
+    query(
+        [&](const Node& node) {
+            const glm::dvec3 r = glm::dvec3(node.maxRadius * radiusScale);
+            return intersectsBox(start, d, 1.0, node.min - r, node.max + r);
+        },
+        [&](const Entry& e) {
+            const double r = e.radius * radiusScale;
+            return distanceSquaredToLine(start, d, 1.0, e.center) <= r * r;
+        },
+        result
+    );
+}
+
+void SceneGraphNodeBvh::queryRay(const glm::dvec3& origin, const glm::dvec3& direction,
+                                 std::vector<uint32_t>& result,
+                                 double radiusScale) const
+{
+    ZoneScoped;
+
+    constexpr double Infinity = std::numeric_limits<double>::infinity();
+    query(
+        [&](const Node& node) {
+            const glm::dvec3 r = glm::dvec3(node.maxRadius * radiusScale);
+            return intersectsBox(origin, direction, Infinity, node.min - r, node.max + r);
+        },
+        [&](const Entry& e) {
+            const double r = e.radius * radiusScale;
+            return distanceSquaredToLine(origin, direction, Infinity, e.center) <= r * r;
+        },
+        result
+    );
+}
+
+void SceneGraphNodeBvh::queryNearest(const glm::dvec3& point, size_t k,
+                                     std::vector<uint32_t>& result) const
+{
+    ZoneScoped;
+
+    if (_nodes.empty() || k == 0) {
+        return;
+    }
+
+    using Item = std::pair<double, uint32_t>;
+    // The nodes that remain to be visited, with the closest node on top
+    std::priority_queue<Item, std::vector<Item>, std::greater<>> nodes;
+    // The closest entries found so far, with the farthest entry on top
+    std::priority_queue<Item> closest;
+
+    nodes.emplace(distanceSquaredToBox(point, _nodes[0].min, _nodes[0].max), 0);
+    while (!nodes.empty()) {
+        const auto [distance, index] = nodes.top();
+        nodes.pop();
+        if (closest.size() == k && distance > closest.top().first) {
+            // All remaining nodes are farther away than the entries we already have
+            break;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            for (uint32_t i = node.first; i < node.first + node.count; i++) {
+                const glm::dvec3 diff = _entries[_order[i]].center - point;
+                const double d = glm::dot(diff, diff);
+                if (closest.size() < k) {
+                    closest.emplace(d, _order[i]);
+                }
+                else if (d < closest.top().first) {
+                    closest.pop();
+                    closest.emplace(d, _order[i]);
+                }
+            }
+        }
+        else {
+            const Node& a = _nodes[index + 1];
+            const Node& b = _nodes[node.first];
+            nodes.emplace(distanceSquaredToBox(point, a.min, a.max), index + 1);
+            nodes.emplace(distanceSquaredToBox(point, b.min, b.max), node.first);
+        }
+    }
+
+    const size_t nPrevious = result.size();
+    result.resize(nPrevious + closest.size());
+    for (size_t i = result.size(); i > nPrevious; i--) {
+        result[i - 1] = closest.top().second;
+        closest.pop();
+    }
+}
+
+} // namespace openspace
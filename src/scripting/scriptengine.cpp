@@ -35,6 +35,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/lua/lua_helper.h>
+#include <ghoul/misc/dictionaryluaformatter.h>
 #include <ghoul/misc/profiling.h>
 #include <ghoul/ext/assimp/contrib/zip/src/zip.h>
 #include <filesystem>
@@ -46,6 +47,34 @@ namespace {
 
     constexpr int TableOffset = -3; // top-first argument-second argument
 
+    // The maximum number of compiled scripts that are kept around. Scripts that are run
+    // repeatedly, such as actions, keybindings, and scheduled scripts, stay in the cache
+    // while one-off scripts are evicted again
+    constexpr size_t MaxCompiledChunks = 512;
+
+    // The textual version of a script with arguments, used where the script has to be
+    // sent to or recorded for someone else. This is the same format that the actions
+    // used before the arguments were passed to the compiled scripts directly
+    std::string scriptWithArguments(const std::string& script,
+                                    const ghoul::Dictionary& arguments)
+    {
+        if (arguments.isEmpty()) {
+            return script;
+        }
+        return fmt::format("args = {}\n{}", ghoul::formatLua(arguments), script);
+    }
+
+    // Lua keeps the chunk name around for as long as the compiled function exists, so
+    // only the beginning of the script is used to identify it in error messages
+    std::string chunkName(std::string_view script) {
+        constexpr size_t MaxLength = 40;
+        const std::string_view firstLine = script.substr(0, script.find('\n'));
+        if (firstLine.size() > MaxLength || firstLine.size() < script.size()) {
+            return fmt::format("=[script \"{}...\"]", firstLine.substr(0, MaxLength));
+        }
+        return fmt::format("=[script \"{}\"]", firstLine);
+    }
+
     struct [[codegen::Dictionary(Documentation)]] Parameters {
         std::string name;
         std::map<std::string, std::string> arguments;
@@ -132,6 +161,7 @@ void ScriptEngine::initialize() {
 void ScriptEngine::deinitialize() {
     ZoneScoped;
 
+    clearCompiledChunks();
     _registeredLibraries.clear();
 }
 
@@ -210,7 +240,7 @@ bool ScriptEngine::runScript(const std::string& script, ScriptCallback callback)
             callback(returnValue);
         }
         else {
-            ghoul::lua::runScript(_state, script);
+            runCompiledChunk(script, nullptr);
         }
     }
     catch (const ghoul::lua::LuaLoadingException& e) {
@@ -238,6 +268,122 @@ bool ScriptEngine::runScript(const std::string& script, ScriptCallback callback)
     return true;
 }
 
+bool ScriptEngine::runScript(const std::string& script,
+                             const ghoul::Dictionary& arguments)
+{
+    ZoneScoped;
+
+    ghoul_assert(!script.empty(), "Script must not be empty");
+
+    if (arguments.isEmpty()) {
+        return runScript(script);
+    }
+
+    if (_logScripts) {
+        writeLog(scriptWithArguments(script, arguments));
+    }
+
+    try {
+        runCompiledChunk(script, &arguments);
+    }
+    catch (const ghoul::lua::LuaLoadingException& e) {
+        LERRORC(e.component, e.message);
+        return false;
+    }
+    catch (const ghoul::lua::LuaExecutionException& e) {
+        LERRORC(e.component, e.message);
+        return false;
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LERRORC(e.component, e.message);
+        return false;
+    }
+
+    return true;
+}
+
+int ScriptEngine::compiledChunk(const std::string& script) {
+    ZoneScoped;
+
+    auto it = _compiledChunkMap.find(script);
+    if (it != _compiledChunkMap.end()) {
+        // Move the chunk to the front as it is now the most recently used one
+        _compiledChunks.splice(_compiledChunks.begin(), _compiledChunks, it->second);
+        return it->second->second;
+    }
+
+    const std::string name = chunkName(script);
+    if (luaL_loadbuffer(_state, script.data(), script.size(), name.c_str()) != LUA_OK) {
+        const char* error = lua_tostring(_state, -1);
+        std::string message = error ? error : "Unknown error";
+        lua_pop(_state, 1);
+        throw ghoul::lua::LuaLoadingException(std::move(message));
+    }
+
+    if (_compiledChunks.size() >= MaxCompiledChunks) {
+        const std::pair<std::string, int>& lru = _compiledChunks.back();
+        luaL_unref(_state, LUA_REGISTRYINDEX, lru.second);
+        _compiledChunkMap.erase(lru.first);
+        _compiledChunks.pop_back();
+    }
+
+    // luaL_ref pops the compiled function from the stack
+    const int reference = luaL_ref(_state, LUA_REGISTRYINDEX);
+    _compiledChunks.emplace_front(script, reference);
+    _compiledChunkMap[_compiledChunks.front().first] = _compiledChunks.begin();
+    return reference;
+}
+
+void ScriptEngine::runCompiledChunk(const std::string& script,
+                                    const ghoul::Dictionary* arguments)
+{
+    const int reference = compiledChunk(script);
+
+    // Scripts with arguments see them as the global variable 'args' while they run,
+    // which is how actions check whether they were called with arguments. The
+    // previous value of 'args' is restored afterwards
+    int previousArgs = LUA_REFNIL;
+    if (arguments) {
+        lua_getglobal(_state, "args");
+        previousArgs = luaL_ref(_state, LUA_REGISTRYINDEX);
+    }
+
+    lua_rawgeti(_state, LUA_REGISTRYINDEX, reference);
+    int nArguments = 0;
+    if (arguments) {
+        ghoul::lua::push(_state, *arguments);
+        lua_pushvalue(_state, -1);
+        lua_setglobal(_state, "args");
+        nArguments = 1;
+    }
+
+    const int status = lua_pcall(_state, nArguments, 0, 0);
+    std::string error;
+    if (status != LUA_OK) {
+        const char* e = lua_tostring(_state, -1);
+        error = e ? e : "Unknown error";
+        lua_pop(_state, 1);
+    }
+
+    if (arguments) {
+        lua_rawgeti(_state, LUA_REGISTRYINDEX, previousArgs);
+        lua_setglobal(_state, "args");
+        luaL_unref(_state, LUA_REGISTRYINDEX, previousArgs);
+    }
+
+    if (status != LUA_OK) {
+        throw ghoul::lua::LuaExecutionException(std::move(error));
+    }
+}
+
+void ScriptEngine::clearCompiledChunks() {
+    for (const std::pair<std::string, int>& chunk : _compiledChunks) {
+        luaL_unref(_state, LUA_REGISTRYINDEX, chunk.second);
+    }
+    _compiledChunks.clear();
+    _compiledChunkMap.clear();
+}
+
 bool ScriptEngine::runScriptFile(const std::filesystem::path& filename) {
     ZoneScoped;
 
@@ -533,23 +679,33 @@ void ScriptEngine::preSync(bool isMaster) {
             QueueItem item = std::move(_incomingScripts.front());
             _incomingScripts.pop();
 
-            // Not really a received script but the master also needs to run the script...
-            _masterScriptQueue.push(item);
+            const bool isRecording = global::sessionRecording->isRecording();
+            const bool isSentToRemote =
+                global::parallelPeer->isHost() && item.shouldSendToRemote;
+            if (!isRecording && !item.shouldBeSynchronized && !isSentToRemote) {
+                // Not really a received script but the master also needs to run the
+                // script. Nobody else needs the textual version of the arguments
+                _masterScriptQueue.push(std::move(item));
+                continue;
+            }
 
-            if (global::sessionRecording->isRecording()) {
-                global::sessionRecording->saveScriptKeyframeToTimeline(item.script);
+            const std::string script = scriptWithArguments(item.script, item.arguments);
+            const bool shouldBeSynchronized = item.shouldBeSynchronized;
+            _masterScriptQueue.push(std::move(item));
+
+            if (isRecording) {
+                global::sessionRecording->saveScriptKeyframeToTimeline(script);
             }
 
             // Sync out to other nodes (cluster)
-            if (!item.shouldBeSynchronized) {
+            if (!shouldBeSynchronized) {
                 continue;
             }
-            _scriptsToSync.push_back(item.script);
+            _scriptsToSync.push_back(script);
 
             // Send to other peers (parallel connection)
-            const bool shouldSendToRemote = item.shouldSendToRemote;
-            if (global::parallelPeer->isHost() && shouldSendToRemote) {
-                global::parallelPeer->sendScript(item.script);
+            if (isSentToRemote) {
+                global::parallelPeer->sendScript(script);
             }
         }
     }
@@ -557,7 +713,7 @@ void ScriptEngine::preSync(bool isMaster) {
         while (!_incomingScripts.empty()) {
             QueueItem item = std::move(_incomingScripts.front());
             _incomingScripts.pop();
-            _clientScriptQueue.push(item.script);
+            _clientScriptQueue.push(scriptWithArguments(item.script, item.arguments));
         }
     }
 }
@@ -592,11 +748,15 @@ void ScriptEngine::postSync(bool isMaster) {
 
     if (isMaster) {
         while (!_masterScriptQueue.empty()) {
-            std::string script = std::move(_masterScriptQueue.front().script);
-            ScriptCallback callback = std::move(_masterScriptQueue.front().callback);
+            QueueItem item = std::move(_masterScriptQueue.front());
             _masterScriptQueue.pop();
             try {
-                runScript(script, callback);
+                if (item.arguments.isEmpty()) {
+                    runScript(item.script, item.callback);
+                }
+                else {
+                    runScript(item.script, item.arguments);
+                }
             }
             catch (const ghoul::RuntimeError& e) {
                 LERRORC(e.component, e.message);
@@ -636,6 +796,24 @@ void ScriptEngine::queueScript(std::string script,
     });
 }
 
+void ScriptEngine::queueScript(std::string script, ghoul::Dictionary arguments,
+                               ScriptEngine::ShouldBeSynchronized shouldBeSynchronized,
+                               ScriptEngine::ShouldSendToRemote shouldSendToRemote)
+{
+    ZoneScoped;
+
+    if (script.empty()) {
+        return;
+    }
+    _incomingScripts.push({
+        std::move(script),
+        shouldBeSynchronized,
+        shouldSendToRemote,
+        ScriptCallback(),
+        std::move(arguments)
+    });
+}
+
 
 void ScriptEngine::addBaseLibrary() {
     ZoneScoped;
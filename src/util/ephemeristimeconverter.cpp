@@ -0,0 +1,1042 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/ephemeristimeconverter.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/misc/assert.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+namespace {
+    constexpr double SecondsPerDay = 86400.0;
+    // The J2000 epoch is at noon, whereas the days start at midnight
+    constexpr double J2000Offset = 43200.0;
+
+    // Dates before this year use the Julian calendar in SPICE
+    constexpr int MinimumYear = 1583;
+    constexpr int MaximumYear = 9999;
+    constexpr int MaximumFractionDigits = 9;
+
+    constexpr std::array<std::string_view, 12> MonthNames = {
+        "JANUARY", "FEBRUARY", "MARCH", "APRIL", "MAY", "JUNE", "JULY", "AUGUST",
+        "SEPTEMBER", "OCTOBER", "NOVEMBER", "DECEMBER"
+    };
+
+    constexpr bool isLeapYear(int year) {
+        return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    }
+
+    constexpr int daysInMonth(int year, int month) {
+        constexpr std::array<int, 12> Days = {
+            31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31
+        };
+        return (month == 2 && isLeapYear(year)) ? 29 : Days[month - 1];
+    }
+
+    // Returns the number of days from 2000-01-01 to the provided date in the Gregorian
+    // calendar (see http://howardhinnant.github.io/date_algorithms.html)
+    constexpr long long daysFromCivil(int year, int month, int day) {
+        const long long y = year - (month <= 2 ? 1 : 0);
+        const long long era = (y >= 0 ? y : y - 399) / 400;
+        const long long yearOfEra = y - era * 400;
+        const long long monthIndex = month + (month > 2 ? -3 : 9);
+        const long long dayOfYear = (153 * monthIndex + 2) / 5 + day - 1;
+        const long long dayOfEra =
+            yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+        return era * 146097 + dayOfEra - 719468 - 10957;
+    }
+
+    struct CivilDate {
+        int year = 0;
+        int month = 0;
+        int day = 0;
+        int dayOfYear = 0;
+    };
+
+    // The inverse of daysFromCivil
+    constexpr CivilDate civilFromDays(long long days) {
+        const long long z = days + 10957 + 719468;
+        const long long era = (z >= 0 ? z : z - 146096) / 146097;
+        const long long dayOfEra = z - era * 146097;
+        const long long yearOfEra =
+            (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        const long long dayOfYear =
+            dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        const long long mp = (5 * dayOfYear + 2) / 153;
+
+        CivilDate date;
+        date.day = static_cast<int>(dayOfYear - (153 * mp + 2) / 5 + 1);
+        date.month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+        date.year = static_cast<int>(yearOfEra + era * 400 + (date.month <= 2 ? 1 : 0));
+        date.dayOfYear = static_cast<int>(days - daysFromCivil(date.year, 1, 1) + 1);
+        return date;
+    }
+
+    static_assert(daysFromCivil(2000, 1, 1) == 0);
+    static_assert(daysFromCivil(2017, 1, 1) == 6210);
+    static_assert(civilFromDays(6210).year == 2017 && civilFromDays(6210).day == 1);
+    static_assert(civilFromDays(59).month == 2 && civilFromDays(59).day == 29);
+    static_assert(civilFromDays(365).dayOfYear == 366);
+
+    constexpr double utcSecondsFromDays(long long days) {
+        return static_cast<double>(days) * SecondsPerDay - J2000Offset;
+    }
+
+    struct DefaultLeapSecond {
+        int year;
+        int month;
+        int deltaAT;
+    };
+
+    // The leap seconds of naif0012.tls, which all take effect on the first of the month
+    constexpr std::array<DefaultLeapSecond, 28> DefaultLeapSeconds = {
+        DefaultLeapSecond { 1972, 1, 10 }, DefaultLeapSecond { 1972, 7, 11 },
+        DefaultLeapSecond { 1973, 1, 12 }, DefaultLeapSecond { 1974, 1, 13 },
+        DefaultLeapSecond { 1975, 1, 14 }, DefaultLeapSecond { 1976, 1, 15 },
+        DefaultLeapSecond { 1977, 1, 16 }, DefaultLeapSecond { 1978, 1, 17 },
+        DefaultLeapSecond { 1979, 1, 18 }, DefaultLeapSecond { 1980, 1, 19 },
+        DefaultLeapSecond { 1981, 7, 20 }, DefaultLeapSecond { 1982, 7, 21 },
+        DefaultLeapSecond { 1983, 7, 22 }, DefaultLeapSecond { 1985, 7, 23 },
+        DefaultLeapSecond { 1988, 1, 24 }, DefaultLeapSecond { 1990, 1, 25 },
+        DefaultLeapSecond { 1991, 1, 26 }, DefaultLeapSecond { 1992, 7, 27 },
+        DefaultLeapSecond { 1993, 7, 28 }, DefaultLeapSecond { 1994, 7, 29 },
+        DefaultLeapSecond { 1996, 1, 30 }, DefaultLeapSecond { 1997, 7, 31 },
+        DefaultLeapSecond { 1999, 1, 32 }, DefaultLeapSecond { 2006, 1, 33 },
+        DefaultLeapSecond { 2009, 1, 34 }, DefaultLeapSecond { 2012, 7, 35 },
+        DefaultLeapSecond { 2015, 7, 36 }, DefaultLeapSecond { 2017, 1, 37 }
+    };
+
+    // A minimal reader for the supported date strings
+    struct Cursor {
+        std::string_view text;
+        size_t pos = 0;
+
+        bool atEnd() const {
+            return pos >= text.size();
+        }
+
+        char peek() const {
+            return atEnd() ? '\0' : text[pos];
+        }
+
+        bool isDigit() const {
+            return std::isdigit(static_cast<unsigned char>(peek())) != 0;
+        }
+
+        bool isAlpha() const {
+            return std::isalpha(static_cast<unsigned char>(peek())) != 0;
+        }
+
+        bool consume(char c) {
+            if (!atEnd() && std::toupper(static_cast<unsigned char>(text[pos])) == c) {
+                pos++;
+                return true;
+            }
+            return false;
+        }
+
+        // Returns true if at least one space was skipped
+        bool skipSpaces() {
+            const size_t start = pos;
+            while (!atEnd() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+                pos++;
+            }
+            return pos != start;
+        }
+
+        // Reads an unsigned integer and stores the number of digits in nDigits
+        std::optional<int> integer(int& nDigits) {
+            int value = 0;
+            nDigits = 0;
+            while (isDigit() && nDigits < 9) {
+                value = value * 10 + (text[pos] - '0');
+                pos++;
+                nDigits++;
+            }
+            if (nDigits == 0 || isDigit()) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        std::optional<int> integer(int minDigits, int maxDigits) {
+            int nDigits = 0;
+            std::optional<int> value = integer(nDigits);
+            if (nDigits < minDigits || nDigits > maxDigits) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        // Reads an unsigned number with an optional fractional part
+        std::optional<double> number() {
+            const size_t start = pos;
+            while (isDigit()) {
+                pos++;
+            }
+            if (pos == start) {
+                return std::nullopt;
+            }
+            if (peek() == '.') {
+                pos++;
+                while (isDigit()) {
+                    pos++;
+                }
+            }
+            double value = 0.0;
+            const std::from_chars_result res = std::from_chars(
+                text.data() + start,
+                text.data() + pos,
+                value
+            );
+            if (res.ec != std::errc() || res.ptr != text.data() + pos) {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        std::string_view word() {
+            const size_t start = pos;
+            while (isAlpha()) {
+                pos++;
+            }
+            return text.substr(start, pos - start);
+        }
+    };
+
+    // Returns the month (1-12) for a full or three letter month name
+    std::optional<int> monthFromName(std::string_view name) {
+        if (name.size() < 3) {
+            return std::nullopt;
+        }
+        for (size_t i = 0; i < MonthNames.size(); i++) {
+            const std::string_view month = MonthNames[i];
+            if (name.size() != 3 && name.size() != month.size()) {
+                continue;
+            }
+            const bool isEqual = std::equal(
+                name.begin(),
+                name.end(),
+                month.begin(),
+                [](char a, char b) {
+                    return std::toupper(static_cast<unsigned char>(a)) == b;
+                }
+            );
+            if (isEqual) {
+                return static_cast<int>(i + 1);
+            }
+        }
+        return std::nullopt;
+    }
+
+    enum class TimeScale {
+        Utc,
+        Tdb,
+        Tdt
+    };
+
+    enum class Token {
+        Literal,
+        Year,
+        MonthNumber,
+        MonthUpper,
+        MonthTitle,
+        MonthLower,
+        MonthNameUpper,
+        MonthNameTitle,
+        MonthNameLower,
+        Day,
+        DayOfYear,
+        Hour,
+        Minute,
+        Second,
+        Round,
+        Truncate,
+        Utc,
+        Tdb,
+        Tdt,
+        Unsupported
+    };
+
+    // The tokens of a format picture. Longer tokens have to come before tokens that they
+    // start with. The unsupported tokens are the remaining tokens that SPICE interprets
+    constexpr std::array<std::pair<std::string_view, Token>, 41> Tokens = {
+        std::pair{ "::RND", Token::Round },
+        std::pair{ "::TRNC", Token::Truncate },
+        std::pair{ "::UTC", Token::Utc },
+        std::pair{ "::TDB", Token::Tdb },
+        std::pair{ "::TDT", Token::Tdt },
+        std::pair{ "::", Token::Unsupported },
+        std::pair{ "YYYY", Token::Year },
+        std::pair{ "MONTH", Token::MonthNameUpper },
+        std::pair{ "Month", Token::MonthNameTitle },
+        std::pair{ "month", Token::MonthNameLower },
+        std::pair{ "MON", Token::MonthUpper },
+        std::pair{ "Mon", Token::MonthTitle },
+        std::pair{ "mon", Token::MonthLower },
+        std::pair{ "MM", Token::MonthNumber },
+        std::pair{ "DOY", Token::DayOfYear },
+        std::pair{ "DD", Token::Day },
+        std::pair{ "HR", Token::Hour },
+        std::pair{ "MN", Token::Minute },
+        std::pair{ "SC", Token::Second },
+        std::pair{ "#", Token::Unsupported },
+        std::pair{ "AMPM", Token::Unsupported },
+        std::pair{ "ampm", Token::Unsupported },
+        std::pair{ "AP", Token::Unsupported },
+        std::pair{ "ERA", Token::Unsupported },
+        std::pair{ "era", Token::Unsupported },
+        std::pair{ "JULIAND", Token::Unsupported },
+        std::pair{ "JULIAN", Token::Unsupported },
+        std::pair{ "SP1950", Token::Unsupported },
+        std::pair{ "SP2000", Token::Unsupported },
+        std::pair{ "WEEKDAY", Token::Unsupported },
+        std::pair{ "Weekday", Token::Unsupported },
+        std::pair{ "weekday", Token::Unsupported },
+        std::pair{ "WKD", Token::Unsupported },
+        std::pair{ "Wkd", Token::Unsupported },
+        std::pair{ "wkd", Token::Unsupported },
+        std::pair{ "YR", Token::Unsupported },
+        std::pair{ "Yr", Token::Unsupported },
+        std::pair{ "yr", Token::Unsupported },
+        std::pair{ "AD", Token::Unsupported },
+        std::pair{ "BC", Token::Unsupported },
+        std::pair{ "ad", Token::Unsupported }
+    };
+
+    // Returns the token at the start of the format and its length in characters
+    std::pair<Token, size_t> nextToken(std::string_view format) {
+        for (const auto& [name, token] : Tokens) {
+            if (format.starts_with(name)) {
+                return { token, name.size() };
+            }
+        }
+        return { Token::Literal, 1 };
+    }
+
+    // Returns the number of '#' following a '.' at the start of the format
+    int fractionDigits(std::string_view format) {
+        if (!format.starts_with(".#")) {
+            return 0;
+        }
+        size_t n = 1;
+        while (n < format.size() && format[n] == '#') {
+            n++;
+        }
+        return static_cast<int>(n - 1);
+    }
+
+    // Writes the value with the given number of digits, padded with zeros
+    bool writeNumber(long long value, int nDigits, char*& out, const char* end) {
+        if (end - out < nDigits) {
+            return false;
+        }
+        for (int i = nDigits - 1; i >= 0; i--) {
+            out[i] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        }
+        out += nDigits;
+        return true;
+    }
+
+    bool writeString(std::string_view value, char*& out, const char* end) {
+        if (end - out < static_cast<std::ptrdiff_t>(value.size())) {
+            return false;
+        }
+        std::copy(value.begin(), value.end(), out);
+        out += value.size();
+        return true;
+    }
+
+    // Reads the DELTET variables from the data sections of a leap seconds kernel
+    struct KernelReader {
+        std::string data;
+
+        explicit KernelReader(std::string_view source) {
+            constexpr std::string_view BeginData = "\\begindata";
+            constexpr std::string_view BeginText = "\\begintext";
+            size_t begin = source.find(BeginData);
+            while (begin != std::string_view::npos) {
+                begin += BeginData.size();
+                const size_t end = source.find(BeginText, begin);
+                data += source.substr(begin, end - begin);
+                data += '\n';
+                if (end == std::string_view::npos) {
+                    break;
+                }
+                begin = source.find(BeginData, end);
+            }
+        }
+
+        // Returns the whitespace or comma separated values of the variable
+        std::vector<std::string_view> values(std::string_view name) const {
+            const std::string_view d = data;
+            size_t pos = d.find(name);
+            while (pos != std::string_view::npos) {
+                size_t p = pos + name.size();
+                while (p < d.size() && std::isspace(static_cast<unsigned char>(d[p]))) {
+                    p++;
+                }
+                if (p < d.size() && d[p] == '=') {
+                    break;
+                }
+                pos = d.find(name, pos + 1);
+            }
+            if (pos == std::string_view::npos) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "Missing variable '{}' in leap seconds kernel", name
+                ));
+            }
+
+            size_t begin = d.find('=', pos) + 1;
+            while (begin < d.size() && std::isspace(static_cast<unsigned char>(d[begin])))
+            {
+                begin++;
+            }
+            size_t end = 0;
+            if (begin < d.size() && d[begin] == '(') {
+                begin++;
+                end = d.find(')', begin);
+                if (end == std::string_view::npos) {
+                    throw ghoul::RuntimeError(fmt::format(
+                        "Unterminated variable '{}' in leap seconds kernel", name
+                    ));
+                }
+            }
+            else {
+                end = d.find('\n', begin);
+            }
+
+            std::vector<std::string_view> result;
+            const std::string_view list = d.substr(begin, end - begin);
+            size_t i = 0;
+            while (i < list.size()) {
+                const char c = list[i];
+                if (std::isspace(static_cast<unsigned char>(c)) || c == ',') {
+                    i++;
+                    continue;
+                }
+                const size_t start = i;
+                while (i < list.size() && list[i] != ',' &&
+                       !std::isspace(static_cast<unsigned char>(list[i])))
+                {
+                    i++;
+                }
+                result.push_back(list.substr(start, i - start));
+            }
+            return result;
+        }
+
+        double number(std::string_view value) const {
+            // Fortran style exponents use D instead of E
+            std::string v = std::string(value);
+            std::replace(v.begin(), v.end(), 'D', 'E');
+            std::replace(v.begin(), v.end(), 'd', 'e');
+            double result = 0.0;
+            const std::from_chars_result res =
+                std::from_chars(v.data(), v.data() + v.size(), result);
+            if (res.ec != std::errc() || res.ptr != v.data() + v.size()) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "Could not parse number '{}' in leap seconds kernel", value
+                ));
+            }
+            return result;
+        }
+
+        // Parses dates in the form @YYYY-MON-D into UTC seconds past J2000
+        double date(std::string_view value) const {
+            Cursor c = { value };
+            std::optional<int> year;
+            std::optional<int> month;
+            std::optional<int> day;
+            if (c.consume('@')) {
+                year = c.integer(4, 4);
+                if (c.consume('-')) {
+                    month = monthFromName(c.word());
+                    if (c.consume('-')) {
+                        day = c.integer(1, 2);
+                    }
+                }
+            }
+            if (!year || !month || !day || !c.atEnd()) {
+                throw ghoul::RuntimeError(fmt::format(
+                    "Could not parse date '{}' in leap seconds kernel", value
+                ));
+            }
+            return utcSecondsFromDays(daysFromCivil(*year, *month, *day));
+        }
+    };
+
+    // The converters that have been set are kept alive so that references that were
+    // handed out by EphemerisTimeConverter::ref remain valid
+    std::mutex ConvertersMutex;
+    std::vector<std::unique_ptr<const openspace::EphemerisTimeConverter>> Converters;
+    std::atomic<const openspace::EphemerisTimeConverter*> CurrentConverter = nullptr;
+} // namespace
+
+namespace openspace {
+
+EphemerisTimeConverter::EphemerisTimeConverter() {
+    _leapSeconds.reserve(DefaultLeapSeconds.size());
+    for (const DefaultLeapSecond& ls : DefaultLeapSeconds) {
+        _leapSeconds.push_back({
+            utcSecondsFromDays(daysFromCivil(ls.year, ls.month, 1)),
+            static_cast<double>(ls.deltaAT)
+        });
+    }
+}
+
+EphemerisTimeConverter::EphemerisTimeConverter(Parameters parameters,
+                                               std::vector<LeapSecond> leapSeconds)
+    : _parameters(parameters)
+    , _leapSeconds(std::move(leapSeconds))
+{
+    ghoul_assert(!_leapSeconds.empty(), "Leap seconds must not be empty");
+    ghoul_assert(
+        std::is_sorted(
+            _leapSeconds.begin(),
+            _leapSeconds.end(),
+            [](const LeapSecond& lhs, const LeapSecond& rhs) {
+                return lhs.date < rhs.date;
+            }
+        ),
+        "Leap seconds must be sorted"
+    );
+}
+
+EphemerisTimeConverter EphemerisTimeConverter::createFromLeapSecondsKernel(
+                                                                 std::string_view source)
+{
+    const KernelReader reader(source);
+
+    auto singleValue = [&reader](std::string_view name) {
+        const std::vector<std::string_view> v = reader.values(name);
+        if (v.size() != 1) {
+            throw ghoul::RuntimeError(fmt::format(
+                "Expected a single value for '{}' in leap seconds kernel", name
+            ));
+        }
+        return reader.number(v.front());
+    };
+
+    Parameters parameters;
+    parameters.deltaTA = singleValue("DELTET/DELTA_T_A");
+    parameters.k = singleValue("DELTET/K");
+    parameters.eb = singleValue("DELTET/EB");
+
+    const std::vector<std::string_view> m = reader.values("DELTET/M");
+    if (m.size() != 2) {
+        throw ghoul::RuntimeError("Expected two values for 'DELTET/M'");
+    }
+    parameters.m0 = reader.number(m[0]);
+    parameters.m1 = reader.number(m[1]);
+
+    const std::vector<std::string_view> deltaAT = reader.values("DELTET/DELTA_AT");
+    if (deltaAT.empty() || deltaAT.size() % 2 != 0) {
+        throw ghoul::RuntimeError("Expected pairs of values for 'DELTET/DELTA_AT'");
+    }
+    std::vector<LeapSecond> leapSeconds;
+    leapSeconds.reserve(deltaAT.size() / 2);
+    for (size_t i = 0; i < deltaAT.size(); i += 2) {
+        leapSeconds.push_back({
+            reader.date(deltaAT[i + 1]),
+            reader.number(deltaAT[i])
+        });
+    }
+    std::sort(
+        leapSeconds.begin(),
+        leapSeconds.end(),
+        [](const LeapSecond& lhs, const LeapSecond& rhs) { return lhs.date < rhs.date; }
+    );
+
+    return EphemerisTimeConverter(parameters, std::move(leapSeconds));
+}
+
+const EphemerisTimeConverter& EphemerisTimeConverter::ref() {
+    static const EphemerisTimeConverter Default;
+    const EphemerisTimeConverter* current =
+        CurrentConverter.load(std::memory_order_acquire);
+    return current ? *current : Default;
+}
+
+void EphemerisTimeConverter::setCurrent(std::optional<EphemerisTimeConverter> converter)
+{
+    if (!converter.has_value()) {
+        CurrentConverter.store(nullptr, std::memory_order_release);
+        return;
+    }
+
+    std::lock_guard lock(ConvertersMutex);
+    Converters.push_back(
+        std::make_unique<const EphemerisTimeConverter>(std::move(*converter))
+    );
+    CurrentConverter.store(Converters.back().get(), std::memory_order_release);
+}
+
+std::optional<double> EphemerisTimeConverter::ephemerisTimeFromDate(
+                                                             std::string_view date) const
+{
+    Cursor c = { date };
+    c.skipSpaces();
+
+    // Date
+    const std::optional<int> year = c.integer(4, 4);
+    if (!year.has_value() || *year < MinimumYear || *year > MaximumYear) {
+        return std::nullopt;
+    }
+
+    std::optional<int> month;
+    std::optional<int> day;
+    std::optional<int> dayOfYear;
+    const bool hasDash = c.consume('-');
+    if (!hasDash && !c.skipSpaces()) {
+        return std::nullopt;
+    }
+    if (c.isAlpha()) {
+        // YYYY MON DD or YYYY-MON-DD
+        month = monthFromName(c.word());
+        if (!c.consume('-') && !c.skipSpaces()) {
+            return std::nullopt;
+        }
+        day = c.integer(1, 2);
+    }
+    else if (hasDash) {
+        // YYYY-MM-DD or YYYY-DDD
+        int nDigits = 0;
+        const std::optional<int> value = c.integer(nDigits);
+        if (nDigits == 3 && c.peek() != '-') {
+            dayOfYear = value;
+        }
+        else if (nDigits <= 2 && c.consume('-')) {
+            month = value;
+            day = c.integer(1, 2);
+        }
+    }
+
+    long long days = 0;
+    if (dayOfYear.has_value()) {
+        const int nDays = isLeapYear(*year) ? 366 : 365;
+        if (*dayOfYear < 1 || *dayOfYear > nDays) {
+            return std::nullopt;
+        }
+        days = daysFromCivil(*year, 1, 1) + *dayOfYear - 1;
+    }
+    else {
+        if (!month.has_value() || !day.has_value() || *month < 1 || *month > 12 ||
+            *day < 1 || *day > daysInMonth(*year, *month))
+        {
+            return std::nullopt;
+        }
+        days = daysFromCivil(*year, *month, *day);
+    }
+
+    // Time
+    int hour = 0;
+    int minute = 0;
+    double second = 0.0;
+    const size_t timeStart = c.pos;
+    const bool hasSeparator = c.consume('T') || c.skipSpaces();
+    if (hasSeparator && c.isDigit()) {
+        const std::optional<int> h = c.integer(1, 2);
+        if (!h.has_value()) {
+            return std::nullopt;
+        }
+        hour = *h;
+        if (c.consume(':')) {
+            const std::optional<int> m = c.integer(1, 2);
+            if (!m.has_value()) {
+                return std::nullopt;
+            }
+            minute = *m;
+            if (c.consume(':')) {
+                const std::optional<double> s = c.number();
+                if (!s.has_value()) {
+                    return std::nullopt;
+                }
+                second = *s;
+            }
+        }
+        c.consume('Z');
+    }
+    else {
+        c.pos = timeStart;
+    }
+
+    // Time scale label
+    c.skipSpaces();
+    TimeScale scale = TimeScale::Utc;
+    const std::string_view label = c.word();
+    if (!label.empty()) {
+        if (label.size() != 3) {
+            return std::nullopt;
+        }
+        std::array<char, 3> l;
+        std::transform(
+            label.begin(),
+            label.end(),
+            l.begin(),
+            [](char ch) { return static_cast<char>(std::toupper(ch)); }
+        );
+        const std::string_view upperLabel = std::string_view(l.data(), l.size());
+        if (upperLabel == "UTC") {
+            scale = TimeScale::Utc;
+        }
+        else if (upperLabel == "TDB") {
+            scale = TimeScale::Tdb;
+        }
+        else if (upperLabel == "TDT") {
+            scale = TimeScale::Tdt;
+        }
+        else {
+            return std::nullopt;
+        }
+        c.skipSpaces();
+    }
+    if (!c.atEnd()) {
+        return std::nullopt;
+    }
+
+    // A 60th second is only allowed for leap seconds
+    const bool isLeapSecond = scale == TimeScale::Utc && hour == 23 && minute == 59 &&
+        utcFromEphemerisTime(ephemerisTimeFromUtc(days, 0.0)).dayLength > SecondsPerDay;
+    if (hour > 23 || minute > 59 || second >= (isLeapSecond ? 61.0 : 60.0)) {
+        return std::nullopt;
+    }
+
+    const double seconds = hour * 3600.0 + minute * 60.0 + second;
+    switch (scale) {
+        case TimeScale::Utc:
+            return ephemerisTimeFromUtc(days, seconds);
+        case TimeScale::Tdb:
+            return utcSecondsFromDays(days) + seconds;
+        case TimeScale::Tdt:
+            return tdbFromTdt(utcSecondsFromDays(days) + seconds);
+        default:
+            throw ghoul::MissingCaseException();
+    }
+}
+
+double EphemerisTimeConverter::ephemerisTimeFromUtc(int year, int dayOfYear,
+                                                    double seconds) const
+{
+    return ephemerisTimeFromUtc(daysFromCivil(year, 1, 1) + dayOfYear - 1, seconds);
+}
+
+double EphemerisTimeConverter::ephemerisTimeFromUtc(int year, int month, int day,
+                                                    double seconds) const
+{
+    return ephemerisTimeFromUtc(daysFromCivil(year, month, day), seconds);
+}
+
+std::optional<int> EphemerisTimeConverter::dateFromEphemerisTime(double ephemerisTime,
+                                                                 std::string_view format,
+                                                                 char* buffer,
+                                                                 int bufferSize) const
+{
+    ghoul_assert(buffer, "Buffer must not be nullptr");
+
+    if (!std::isfinite(ephemerisTime) || bufferSize <= 0) {
+        return std::nullopt;
+    }
+
+    // Find the modifiers and the smallest unit that is part of the format
+    TimeScale scale = TimeScale::Utc;
+    bool shouldRound = false;
+    int nFractionDigits = 0;
+    long long granularity = static_cast<long long>(SecondsPerDay);
+    for (size_t i = 0; i < format.size();) {
+        const auto [token, length] = nextToken(format.substr(i));
+        i += length;
+        switch (token) {
+            case Token::Unsupported:
+                return std::nullopt;
+            case Token::Round:
+                shouldRound = true;
+                break;
+            case Token::Truncate:
+                shouldRound = false;
+                break;
+            case Token::Utc:
+                // Time zone offsets are not supported
+                if (i < format.size() && (format[i] == '+' || format[i] == '-')) {
+                    return std::nullopt;
+                }
+                scale = TimeScale::Utc;
+                break;
+            case Token::Tdb:
+                scale = TimeScale::Tdb;
+                break;
+            case Token::Tdt:
+                scale = TimeScale::Tdt;
+                break;
+            case Token::Hour:
+                granularity = std::min(granularity, 3600LL);
+                break;
+            case Token::Minute:
+                granularity = std::min(granularity, 60LL);
+                break;
+            case Token::Second:
+                granularity = 1;
+                nFractionDigits = fractionDigits(format.substr(i));
+                if (nFractionDigits > MaximumFractionDigits) {
+                    return std::nullopt;
+                }
+                if (nFractionDigits > 0) {
+                    i += nFractionDigits + 1;
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    UtcDate date;
+    if (scale == TimeScale::Utc) {
+        date = utcFromEphemerisTime(ephemerisTime);
+    }
+    else {
+        const double t = J2000Offset +
+            (scale == TimeScale::Tdb ? ephemerisTime : tdtFromTdb(ephemerisTime));
+        date.day = static_cast<long long>(std::floor(t / SecondsPerDay));
+        date.seconds = t - static_cast<double>(date.day) * SecondsPerDay;
+        date.dayLength = SecondsPerDay;
+    }
+
+    // Round or truncate the seconds of the day to the smallest unit in the format. The
+    // seconds are stored as an integer number of ticks to avoid rounding errors
+    long long ticksPerSecond = 1;
+    for (int i = 0; i < nFractionDigits; i++) {
+        ticksPerSecond *= 10;
+    }
+    const double units = date.seconds * ticksPerSecond / granularity;
+    long long ticks =
+        static_cast<long long>(shouldRound ? std::round(units) : std::floor(units)) *
+        granularity;
+    const long long ticksPerDay =
+        static_cast<long long>(std::llround(date.dayLength)) * ticksPerSecond;
+    if (ticks >= ticksPerDay) {
+        ticks -= ticksPerDay;
+        date.day++;
+    }
+
+    const CivilDate civil = civilFromDays(date.day);
+    if (civil.year < MinimumYear || civil.year > MaximumYear) {
+        return std::nullopt;
+    }
+
+    // A leap second is represented as the 60th second of the last minute of the day
+    const long long ticksPerMinute = 60 * ticksPerSecond;
+    const long long lastMinute = 1439 * ticksPerMinute;
+    const long long minutes = std::min(ticks / ticksPerMinute, 1439LL);
+    const long long hour = minutes / 60;
+    const long long minute = minutes % 60;
+    const long long secondTicks =
+        ticks >= lastMinute ? ticks - lastMinute : ticks % ticksPerMinute;
+
+    char* out = buffer;
+    // Leave room for the null terminator
+    const char* end = buffer + bufferSize - 1;
+    for (size_t i = 0; i < format.size();) {
+        const auto [token, length] = nextToken(format.substr(i));
+        bool success = true;
+        switch (token) {
+            case Token::Literal:
+                success = writeString(format.substr(i, 1), out, end);
+                break;
+            case Token::Year:
+                success = writeNumber(civil.year, 4, out, end);
+                break;
+            case Token::MonthNumber:
+                success = writeNumber(civil.month, 2, out, end);
+                break;
+            case Token::MonthUpper:
+            case Token::MonthTitle:
+            case Token::MonthLower:
+            case Token::MonthNameUpper:
+            case Token::MonthNameTitle:
+            case Token::MonthNameLower:
+            {
+                const bool isShort = token == Token::MonthUpper ||
+                    token == Token::MonthTitle || token == Token::MonthLower;
+                std::string_view name = MonthNames[civil.month - 1];
+                if (isShort) {
+                    name = name.substr(0, 3);
+                }
+                char* first = out;
+                success = writeString(name, out, end);
+                const bool isTitle =
+                    token == Token::MonthTitle || token == Token::MonthNameTitle;
+                const bool isLower =
+                    token == Token::MonthLower || token == Token::MonthNameLower;
+                if (success && (isTitle || isLower)) {
+                    for (char* c = isTitle ? first + 1 : first; c < out; c++) {
+                        *c = static_cast<char>(std::tolower(*c));
+                    }
+                }
+                break;
+            }
+            case Token::Day:
+                success = writeNumber(civil.day, 2, out, end);
+                break;
+            case Token::DayOfYear:
+                success = writeNumber(civil.dayOfYear, 3, out, end);
+                break;
+            case Token::Hour:
+                success = writeNumber(hour, 2, out, end);
+                break;
+            case Token::Minute:
+                success = writeNumber(minute, 2, out, end);
+                break;
+            case Token::Second:
+                success = writeNumber(secondTicks / ticksPerSecond, 2, out, end);
+                if (success && nFractionDigits > 0) {
+                    const long long fraction = secondTicks % ticksPerSecond;
+                    success = writeString(".", out, end) &&
+                        writeNumber(fraction, nFractionDigits, out, end);
+                    i += nFractionDigits + 1;
+                }
+                break;
+            default:
+                // Modifiers do not produce any output
+                break;
+        }
+        if (!success) {
+            return std::nullopt;
+        }
+        i += length;
+    }
+
+    // Like SPICE, trailing whitespace that is left after removing modifiers is removed
+    while (out > buffer && std::isspace(static_cast<unsigned char>(*(out - 1)))) {
+        out--;
+    }
+    *out = '\0';
+    return static_cast<int>(out - buffer);
+}
+
+std::optional<std::string> EphemerisTimeConverter::dateFromEphemerisTime(
+                                                                    double ephemerisTime,
+                                                           std::string_view format) const
+{
+    // Each token produces at most as many characters as the longest month name
+    std::string result;
+    result.resize(format.size() * MonthNames[8].size() + 1);
+    const std::optional<int> length = dateFromEphemerisTime(
+        ephemerisTime,
+        format,
+        result.data(),
+        static_cast<int>(result.size())
+    );
+    if (!length.has_value()) {
+        return std::nullopt;
+    }
+    result.resize(*length);
+    return result;
+}
+
+double EphemerisTimeConverter::ephemerisTimeFromUtc(long long day, double seconds) const
+{
+    // Leap seconds only change at the start of a day, so the difference of the day is
+    // used for all seconds in it, including the leap second at its end
+    const double dayStart = utcSecondsFromDays(day);
+    const auto it = std::upper_bound(
+        _leapSeconds.begin(),
+        _leapSeconds.end(),
+        dayStart,
+        [](double date, const LeapSecond& ls) { return date < ls.date; }
+    );
+    // Like SPICE, dates before the first leap second use one second less than it
+    const double deltaAT = it == _leapSeconds.begin() ?
+        _leapSeconds.front().deltaAT - 1.0 :
+        std::prev(it)->deltaAT;
+
+    const double tai = dayStart + seconds + deltaAT;
+    return tdbFromTdt(tai + _parameters.deltaTA);
+}
+
+EphemerisTimeConverter::UtcDate EphemerisTimeConverter::utcFromEphemerisTime(
+                                                              double ephemerisTime) const
+{
+    const double tai = tdtFromTdb(ephemerisTime) - _parameters.deltaTA;
+
+    // Find the first leap second that is not yet in effect at this TAI
+    const auto next = std::upper_bound(
+        _leapSeconds.begin(),
+        _leapSeconds.end(),
+        tai,
+        [](double t, const LeapSecond& ls) { return t < ls.date + ls.deltaAT; }
+    );
+    const double deltaAT = next == _leapSeconds.begin() ?
+        _leapSeconds.front().deltaAT - 1.0 :
+        std::prev(next)->deltaAT;
+    const double utc = tai - deltaAT;
+
+    UtcDate date;
+    if (next != _leapSeconds.end() && utc >= next->date) {
+        // We are inside a leap second, which belongs to the end of the previous day
+        date.day = static_cast<long long>(
+            std::llround((next->date + J2000Offset) / SecondsPerDay)
+        ) - 1;
+    }
+    else {
+        date.day = static_cast<long long>(
+            std::floor((utc + J2000Offset) / SecondsPerDay)
+        );
+    }
+    date.seconds = utc - utcSecondsFromDays(date.day);
+
+    date.dayLength = SecondsPerDay;
+    if (next != _leapSeconds.end() && next->date == utcSecondsFromDays(date.day + 1)) {
+        date.dayLength += next->deltaAT - deltaAT;
+    }
+    return date;
+}
+
+double EphemerisTimeConverter::tdbFromTdt(double tdt) const {
+    const double m = _parameters.m0 + _parameters.m1 * tdt;
+    const double e = m + _parameters.eb * std::sin(m);
+    return tdt + _parameters.k * std::sin(e);
+}
+
+double EphemerisTimeConverter::tdtFromTdb(double tdb) const {
+    // The difference depends on the TDT, but changes so slowly that a few fixed-point
+    // iterations converge to full precision
+    double tdt = tdb;
+    for (int i = 0; i < 3; i++) {
+        const double m = _parameters.m0 + _parameters.m1 * tdt;
+        const double e = m + _parameters.eb * std::sin(m);
+        tdt = tdb - _parameters.k * std::sin(e);
+    }
+    return tdt;
+}
+
+} // namespace openspace
@@ -0,0 +1,213 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/framearena.h>
+
+#include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <bit>
+#include <new>
+
+namespace {
+    // All blocks are aligned to a cache line so that the blocks of different threads
+    // never share one
+    constexpr size_t BlockAlignment = 64;
+
+    // Overflow blocks are rounded up to full pages to increase the chance that they can
+    // be reused in later frames
+    constexpr size_t OverflowGranularity = 4096;
+
+    // The block that the current thread is bumping its allocations from
+    struct ThreadBlock {
+        uint64_t generation = 0;
+        uintptr_t cursor = 0;
+        uintptr_t end = 0;
+    };
+    thread_local ThreadBlock CurrentBlock;
+
+    // The generations are shared between all arenas so that a generation uniquely
+    // identifies both the arena and the frame that a thread's block belongs to
+    std::atomic<uint64_t> NextGeneration = 1;
+
+    uintptr_t alignUp(uintptr_t ptr, size_t alignment) {
+        return (ptr + alignment - 1) & ~(alignment - 1);
+    }
+
+    std::byte* allocateBlock(size_t size) {
+        return static_cast<std::byte*>(
+            ::operator new(size, std::align_val_t(BlockAlignment))
+        );
+    }
+
+    void freeBlock(std::byte* data) {
+        ::operator delete(data, std::align_val_t(BlockAlignment));
+    }
+} // namespace
+
+namespace openspace {
+
+FrameArena::FrameArena(size_t blockSize)
+    : _blockSize(blockSize)
+    , _generation(NextGeneration++)
+{
+    ghoul_assert(blockSize > 0, "Block size must be bigger than 0");
+}
+
+FrameArena::~FrameArena() {
+    for (const Block& block : _blocks) {
+        freeBlock(block.data);
+    }
+    for (const Block& block : _overflowBlocks) {
+        freeBlock(block.data);
+    }
+}
+
+void FrameArena::reset() {
+    std::lock_guard lock(_mutex);
+
+    _lastFrame = {
+        .usedBytes = _usedBytes.exchange(0),
+        .overflowBytes = _overflowBytes.exchange(0),
+        .nHeapAllocations = _nHeapAllocations.exchange(0)
+    };
+    _highWaterMark = std::max(_highWaterMark, _lastFrame.usedBytes);
+
+    _nUsedBlocks = 0;
+
+    // Overflow blocks that were not needed in the last frame are returned to the heap so
+    // that a single spike in memory usage does not keep the memory around forever
+    for (const Block& block : _overflowBlocks) {
+        if (!block.isUsed) {
+            freeBlock(block.data);
+        }
+    }
+    std::erase_if(_overflowBlocks, [](const Block& block) { return !block.isUsed; });
+    for (Block& block : _overflowBlocks) {
+        block.isUsed = false;
+    }
+
+    // Invalidates the blocks that the threads were allocating from
+    _generation.store(NextGeneration++, std::memory_order_release);
+}
+
+FrameArena::FrameStatistics FrameArena::lastFrame() const {
+    std::lock_guard lock(_mutex);
+    return _lastFrame;
+}
+
+size_t FrameArena::highWaterMark() const {
+    std::lock_guard lock(_mutex);
+    return _highWaterMark;
+}
+
+size_t FrameArena::capacity() const {
+    std::lock_guard lock(_mutex);
+    size_t res = 0;
+    for (const Block& block : _blocks) {
+        res += block.size;
+    }
+    for (const Block& block : _overflowBlocks) {
+        res += block.size;
+    }
+    return res;
+}
+
+void* FrameArena::do_allocate(size_t bytes, size_t alignment) {
+    ghoul_assert(std::has_single_bit(alignment), "Alignment must be a power of two");
+
+    _usedBytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    // Large allocations would waste most of a regular block, so they get their own
+    if (bytes + alignment > _blockSize / 4) {
+        _overflowBytes.fetch_add(bytes, std::memory_order_relaxed);
+        const Block block = overflowBlock(bytes + alignment);
+        return reinterpret_cast<void*>(
+            alignUp(reinterpret_cast<uintptr_t>(block.data), alignment)
+        );
+    }
+
+    ThreadBlock& current = CurrentBlock;
+    const uint64_t generation = _generation.load(std::memory_order_acquire);
+    if (current.generation == generation) {
+        const uintptr_t ptr = alignUp(current.cursor, alignment);
+        if (ptr <= current.end && current.end - ptr >= bytes) {
+            current.cursor = ptr + bytes;
+            return reinterpret_cast<void*>(ptr);
+        }
+    }
+
+    // The thread either has not allocated anything in this frame yet, or its block is
+    // full. In both cases the remainder of the old block is abandoned
+    const Block block = nextBlock();
+    const uintptr_t ptr = alignUp(reinterpret_cast<uintptr_t>(block.data), alignment);
+    current.generation = generation;
+    current.cursor = ptr + bytes;
+    current.end = reinterpret_cast<uintptr_t>(block.data) + block.size;
+    return reinterpret_cast<void*>(ptr);
+}
+
+void FrameArena::do_deallocate(void*, size_t, size_t) {
+    // All memory is reclaimed at once in the `reset` function
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+    return this == &other;
+}
+
+FrameArena::Block FrameArena::nextBlock() {
+    std::lock_guard lock(_mutex);
+
+    if (_nUsedBlocks == _blocks.size()) {
+        _blocks.push_back({ .data = allocateBlock(_blockSize), .size = _blockSize });
+        _nHeapAllocations++;
+    }
+    Block& block = _blocks[_nUsedBlocks];
+    _nUsedBlocks++;
+    return block;
+}
+
+FrameArena::Block FrameArena::overflowBlock(size_t bytes) {
+    std::lock_guard lock(_mutex);
+
+    Block* bestFit = nullptr;
+    for (Block& block : _overflowBlocks) {
+        if (!block.isUsed && block.size >= bytes &&
+            (!bestFit || block.size < bestFit->size))
+        {
+            bestFit = &block;
+        }
+    }
+
+    if (!bestFit) {
+        const size_t size = alignUp(bytes, OverflowGranularity);
+        _overflowBlocks.push_back({ .data = allocateBlock(size), .size = size });
+        _nHeapAllocations++;
+        bestFit = &_overflowBlocks.back();
+    }
+
+    bestFit->isUsed = true;
+    return *bestFit;
+}
+
+} // namespace openspace
@@ -26,10 +26,124 @@
 
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/misc/assert.h>
+#include <algorithm>
+#include <array>
+#include <barrier>
 #include <cmath>
+#include <cstdint>
+#include <thread>
 
 namespace {
     constexpr std::string_view _loggerCat = "Histogram";
+
+    // The number of values for which the bin indices are computed at the same time
+    constexpr size_t BlockSize = 256;
+
+    // Each thread in addParallel should at least get this many values to make up for the
+    // cost of starting the thread and merging the partial histograms
+    constexpr size_t MinValuesPerThread = 1 << 16;
+
+    // Computes the bin index for each of the `n` values, or `numBins` for values that are
+    // outside of [minValue, maxValue]. The loop is free of branches and function calls so
+    // that the compiler can vectorize it. The bin is the same as the one computed in
+    // Histogram::add: for values in the range, the scaled value is not negative, so the
+    // truncating conversion is equal to the floor function
+    void computeBinIndices(const float* values, size_t n, float minValue, float maxValue,
+                           int numBins, int32_t* indices)
+    {
+        const float range = maxValue - minValue;
+        const float nBins = static_cast<float>(numBins);
+        const float lastBin = nBins - 1.f;
+        for (size_t i = 0; i < n; ++i) {
+            const float v = values[i];
+            const float normalizedValue = (v - minValue) / range;
+            // The argument order is important here, since it makes a NaN end up in the
+            // last bin rather than being converted to an integer
+            const float bin = std::max(0.f, std::min(lastBin, normalizedValue * nBins));
+            const bool isInRange = v >= minValue && v <= maxValue;
+            indices[i] = isInRange ? static_cast<int32_t>(bin) : numBins;
+        }
+    }
+
+    struct Accumulation {
+        size_t nValues = 0;
+        double totalWeight = 0.0;
+    };
+
+    // Adds the `values` into `bins`, each with a weight of 1. Consecutive values that end
+    // up in the same bin would make every increment wait for the previous one, so the
+    // values are counted into several interleaved integer counters that are only summed
+    // up at the end. Counting in integers also means that bins with more than 2^24
+    // values are still counted correctly
+    Accumulation accumulate(float* bins, int numBins, float minValue, float maxValue,
+                            std::span<const float> values)
+    {
+        constexpr size_t NStripes = 4;
+        std::vector<uint32_t> counts(NStripes * (numBins + 1), 0);
+
+        std::array<int32_t, BlockSize> indices;
+        for (size_t begin = 0; begin < values.size(); begin += BlockSize) {
+            const size_t n = std::min(BlockSize, values.size() - begin);
+            computeBinIndices(
+                values.data() + begin,
+                n,
+                minValue,
+                maxValue,
+                numBins,
+                indices.data()
+            );
+
+            // Values outside of the range are counted in the extra bin at the end
+            for (size_t i = 0; i < n; ++i) {
+                counts[(i % NStripes) * (numBins + 1) + indices[i]]++;
+            }
+        }
+
+        Accumulation result;
+        for (int i = 0; i < numBins; ++i) {
+            uint64_t count = 0;
+            for (size_t stripe = 0; stripe < NStripes; ++stripe) {
+                count += counts[stripe * (numBins + 1) + i];
+            }
+            bins[i] += static_cast<float>(count);
+            result.nValues += count;
+        }
+        result.totalWeight = static_cast<double>(result.nValues);
+        return result;
+    }
+
+    // Adds the `values` into `bins`, where each value is weighted by the corresponding
+    // entry in `weights`
+    Accumulation accumulate(float* bins, int numBins, float minValue, float maxValue,
+                            std::span<const float> values, std::span<const float> weights)
+    {
+        ghoul_assert(weights.size() == values.size(), "Wrong number of weights");
+
+        Accumulation result;
+        std::array<int32_t, BlockSize> indices;
+        for (size_t begin = 0; begin < values.size(); begin += BlockSize) {
+            const size_t n = std::min(BlockSize, values.size() - begin);
+            computeBinIndices(
+                values.data() + begin,
+                n,
+                minValue,
+                maxValue,
+                numBins,
+                indices.data()
+            );
+
+            for (size_t i = 0; i < n; ++i) {
+                if (indices[i] == numBins) {
+                    continue;
+                }
+
+                bins[indices[i]] += weights[begin + i];
+                result.nValues++;
+                result.totalWeight += weights[begin + i];
+            }
+        }
+        return result;
+    }
 } // namespace
 
 namespace openspace {
@@ -86,6 +200,79 @@ bool Histogram::add(float value, float repeat) {
     return true;
 }
 
+size_t Histogram::add(std::span<const float> values) {
+    const Accumulation acc = accumulate(_data, _numBins, _minValue, _maxValue, values);
+    _numValues += static_cast<int>(acc.nValues);
+    return acc.nValues;
+}
+
+size_t Histogram::add(std::span<const float> values, std::span<const float> weights) {
+    ghoul_assert(values.size() == weights.size(), "Wrong number of weights");
+
+    const Accumulation acc =
+        accumulate(_data, _numBins, _minValue, _maxValue, values, weights);
+    _numValues = static_cast<int>(_numValues + acc.totalWeight);
+    return acc.nValues;
+}
+
+size_t Histogram::addParallel(std::span<const float> values, unsigned int nThreads) {
+    const size_t maxThreads = std::max<size_t>(values.size() / MinValuesPerThread, 1);
+    nThreads = static_cast<unsigned int>(
+        std::clamp<size_t>(nThreads, 1, std::min<size_t>(maxThreads, _numBins))
+    );
+    if (nThreads == 1) {
+        return add(values);
+    }
+
+    std::vector<std::vector<float>> partials(nThreads);
+    for (std::vector<float>& partial : partials) {
+        partial.resize(_numBins, 0.f);
+    }
+    std::vector<Accumulation> results(nThreads);
+
+    // All threads first fill their partial histogram, then wait for each other, and then
+    // each thread merges one range of bins across all partial histograms
+    std::barrier sync(nThreads);
+    auto work = [&](unsigned int thread) {
+        const size_t valueBegin = values.size() * thread / nThreads;
+        const size_t valueEnd = values.size() * (thread + 1) / nThreads;
+        results[thread] = accumulate(
+            partials[thread].data(),
+            _numBins,
+            _minValue,
+            _maxValue,
+            values.subspan(valueBegin, valueEnd - valueBegin)
+        );
+
+        sync.arrive_and_wait();
+
+        const int binBegin = static_cast<int>(_numBins * thread / nThreads);
+        const int binEnd = static_cast<int>(_numBins * (thread + 1) / nThreads);
+        for (const std::vector<float>& partial : partials) {
+            for (int i = binBegin; i < binEnd; i++) {
+                _data[i] += partial[i];
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(nThreads - 1);
+    for (unsigned int i = 1; i < nThreads; i++) {
+        threads.emplace_back(work, i);
+    }
+    work(0);
+    for (std::thread& t : threads) {
+        t.join();
+    }
+
+    size_t nValues = 0;
+    for (const Accumulation& result : results) {
+        nValues += result.nValues;
+    }
+    _numValues += static_cast<int>(nValues);
+    return nValues;
+}
+
 void Histogram::changeRange(float minValue, float maxValue){
     if (minValue > _minValue && maxValue < _maxValue) {
         return;
@@ -172,6 +359,70 @@ bool Histogram::addRectangle(float lowBin, float highBin, float value) {
     return true;
 }
 
+size_t Histogram::addRectangles(std::span<const float> lowBins,
+                                std::span<const float> highBins,
+                                std::span<const float> values)
+{
+    ghoul_assert(
+        lowBins.size() == highBins.size() && lowBins.size() == values.size(),
+        "All spans must have the same size"
+    );
+
+    // A rectangle adds its value to all bins in [fillLow, fillHigh), which is stored as
+    // an addition at fillLow and a subtraction at fillHigh and summed up at the end. The
+    // differences are kept in double precision so that the additions and subtractions of
+    // the rectangles cancel out exactly in the bins outside of them
+    std::vector<double> differences(_numBins + 1, 0.0);
+    size_t nRectangles = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        float lowBin = lowBins[i];
+        float highBin = highBins[i];
+        const float value = values[i];
+
+        if (lowBin == highBin) {
+            nRectangles++;
+            continue;
+        }
+        if (lowBin > highBin) {
+            std::swap(lowBin, highBin);
+        }
+        if (lowBin < _minValue || highBin > _maxValue) {
+            // Out of range
+            continue;
+        }
+
+        const float normalizedLowBin = (lowBin - _minValue) / (_maxValue - _minValue);
+        const float normalizedHighBin = (highBin - _minValue) / (_maxValue - _minValue);
+
+        const float lowBinIndex = normalizedLowBin * _numBins;
+        const float highBinIndex = normalizedHighBin * _numBins;
+
+        const int fillLow = static_cast<int>(floor(lowBinIndex));
+        const int fillHigh = static_cast<int>(ceil(highBinIndex));
+
+        differences[fillLow] += value;
+        differences[fillHigh] -= value;
+
+        if (lowBinIndex > fillLow) {
+            const float diff = lowBinIndex - fillLow;
+            _data[fillLow] -= diff * value;
+        }
+        if (highBinIndex < fillHigh) {
+            const float diff = -highBinIndex + fillHigh;
+            _data[fillHigh - 1] -= diff * value;
+        }
+        nRectangles++;
+    }
+
+    double sum = 0.0;
+    for (int i = 0; i < _numBins; i++) {
+        sum += differences[i];
+        _data[i] += static_cast<float>(sum);
+    }
+
+    return nRectangles;
+}
+
 float Histogram::interpolate(float bin) const {
     const float normalizedBin = (bin - _minValue) / (_maxValue - _minValue);
     const float binIndex = normalizedBin * _numBins - 0.5f; // Center
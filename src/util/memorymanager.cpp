@@ -0,0 +1,118 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/memorymanager.h>
+
+#include <ghoul/misc/profiling.h>
+
+namespace {
+    constexpr openspace::properties::Property::PropertyInfo FrameUsageInfo = {
+        "FrameUsage",
+        "Frame Usage",
+        "The number of bytes of temporary memory that were used in the last frame",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo HighWaterMarkInfo = {
+        "HighWaterMark",
+        "High-Water Mark",
+        "The largest number of bytes of temporary memory that were used in a single "
+        "frame since the application was started",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrameOverflowInfo = {
+        "FrameOverflow",
+        "Frame Overflow",
+        "The number of bytes of temporary memory in the last frame that came from "
+        "allocations that were too large to fit into the regular memory blocks",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo FrameHeapAllocationsInfo = {
+        "FrameHeapAllocations",
+        "Frame Heap Allocations",
+        "The number of times that the temporary memory had to request more memory from "
+        "the operating system in the last frame. Once the application has reached a "
+        "steady state, this value should be 0",
+        openspace::properties::Property::Visibility::Developer
+    };
+
+    constexpr openspace::properties::Property::PropertyInfo TemporaryCapacityInfo = {
+        "TemporaryCapacity",
+        "Temporary Capacity",
+        "The total number of bytes that are currently reserved for temporary memory",
+        openspace::properties::Property::Visibility::Developer
+    };
+} // namespace
+
+namespace openspace {
+
+MemoryManager::MemoryManager()
+    : properties::PropertyOwner({ "MemoryManager", "Memory Manager" })
+    , _frameUsage(FrameUsageInfo)
+    , _highWaterMark(HighWaterMarkInfo)
+    , _frameOverflow(FrameOverflowInfo)
+    , _frameHeapAllocations(FrameHeapAllocationsInfo)
+    , _temporaryCapacity(TemporaryCapacityInfo)
+{
+    _frameUsage.setReadOnly(true);
+    addProperty(_frameUsage);
+
+    _highWaterMark.setReadOnly(true);
+    addProperty(_highWaterMark);
+
+    _frameOverflow.setReadOnly(true);
+    addProperty(_frameOverflow);
+
+    _frameHeapAllocations.setReadOnly(true);
+    addProperty(_frameHeapAllocations);
+
+    _temporaryCapacity.setReadOnly(true);
+    addProperty(_temporaryCapacity);
+}
+
+void MemoryManager::resetTemporaryMemory() {
+    ZoneScoped;
+
+    TemporaryMemory.reset();
+
+    const FrameArena::FrameStatistics frame = TemporaryMemory.lastFrame();
+    _frameUsage = static_cast<unsigned long>(frame.usedBytes);
+    _highWaterMark = static_cast<unsigned long>(TemporaryMemory.highWaterMark());
+    _frameOverflow = static_cast<unsigned long>(frame.overflowBytes);
+    _frameHeapAllocations = frame.nHeapAllocations;
+    _temporaryCapacity = static_cast<unsigned long>(TemporaryMemory.capacity());
+
+#ifdef TRACY_ENABLE
+    TracyPlot("Temporary Memory", static_cast<int64_t>(frame.usedBytes));
+    TracyPlot("Temporary Memory Overflow", static_cast<int64_t>(frame.overflowBytes));
+    TracyPlot(
+        "Temporary Memory Heap Allocations",
+        static_cast<int64_t>(frame.nHeapAllocations)
+    );
+#endif // TRACY_ENABLE
+}
+
+} // namespace openspace
@@ -0,0 +1,166 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/memorymappedfile.h>
+
+#include <ghoul/fmt.h>
+#include <ghoul/misc/exception.h>
+#include <utility>
+
+#ifdef WIN32
+#include <Windows.h>
+#else // ^^^ WIN32 / !WIN32 vvv
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // WIN32
+
+namespace openspace {
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path) {
+#ifdef WIN32
+    _file = CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr
+    );
+    if (_file == INVALID_HANDLE_VALUE) {
+        _file = nullptr;
+        throw ghoul::RuntimeError(fmt::format("Could not open file '{}'", path));
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(_file, &size)) {
+        unmap();
+        throw ghoul::RuntimeError(fmt::format("Could not get size of file '{}'", path));
+    }
+    _size = static_cast<size_t>(size.QuadPart);
+    if (_size == 0) {
+        // Empty files cannot be mapped, but they are still valid files
+        return;
+    }
+
+    _mapping = CreateFileMappingW(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!_mapping) {
+        unmap();
+        throw ghoul::RuntimeError(fmt::format("Could not map file '{}'", path));
+    }
+    _data = static_cast<const std::byte*>(
+        MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0)
+    );
+    if (!_data) {
+        unmap();
+        throw ghoul::RuntimeError(fmt::format("Could not map file '{}'", path));
+    }
+#else // ^^^ WIN32 / !WIN32 vvv
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        throw ghoul::RuntimeError(fmt::format("Could not open file '{}'", path));
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) == -1) {
+        close(fd);
+        throw ghoul::RuntimeError(fmt::format("Could not get size of file '{}'", path));
+    }
+    _size = static_cast<size_t>(info.st_size);
+    if (_size == 0) {
+        // Empty files cannot be mapped, but they are still valid files
+        close(fd);
+        return;
+    }
+
+    void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    close(fd);
+    if (data == MAP_FAILED) {
+        _size = 0;
+        throw ghoul::RuntimeError(fmt::format("Could not map file '{}'", path));
+    }
+    _data = static_cast<const std::byte*>(data);
+#endif // WIN32
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+    unmap();
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    : _data(std::exchange(other._data, nullptr))
+    , _size(std::exchange(other._size, 0))
+#ifdef WIN32
+    , _file(std::exchange(other._file, nullptr))
+    , _mapping(std::exchange(other._mapping, nullptr))
+#endif // WIN32
+{}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        _data = std::exchange(other._data, nullptr);
+        _size = std::exchange(other._size, 0);
+#ifdef WIN32
+        _file = std::exchange(other._file, nullptr);
+        _mapping = std::exchange(other._mapping, nullptr);
+#endif // WIN32
+    }
+    return *this;
+}
+
+std::span<const std::byte> MemoryMappedFile::data() const {
+    return std::span<const std::byte>(_data, _data ? _size : 0);
+}
+
+size_t MemoryMappedFile::size() const {
+    return _size;
+}
+
+void MemoryMappedFile::unmap() {
+#ifdef WIN32
+    if (_data) {
+        UnmapViewOfFile(_data);
+    }
+    if (_mapping) {
+        CloseHandle(_mapping);
+    }
+    if (_file) {
+        CloseHandle(_file);
+    }
+    _mapping = nullptr;
+    _file = nullptr;
+#else // ^^^ WIN32 / !WIN32 vvv
+    if (_data) {
+        munmap(const_cast<std::byte*>(_data), _size);
+    }
+#endif // WIN32
+    _data = nullptr;
+    _size = 0;
+}
+
+} // namespace openspace
@@ -26,6 +26,7 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/scripting/lualibrary.h>
+#include <openspace/util/ephemeristimeconverter.h>
 #include <ghoul/fmt.h>
 #include <ghoul/logging/logmanager.h>
 #include <ghoul/filesystem/file.h>
@@ -34,6 +35,8 @@
 #include <ghoul/misc/profiling.h>
 #include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <sstream>
 #include "SpiceUsr.h"
 #include "SpiceZpr.h"
 
@@ -54,6 +57,11 @@ namespace {
         }
     }
 
+    bool isLeapSecondsKernelPath(const std::filesystem::path& path) {
+        const std::filesystem::path extension = path.extension();
+        return extension == ".tls" || extension == ".TLS";
+    }
+
     const char* toString(openspace::SpiceManager::TerminatorType t) {
         using SM = openspace::SpiceManager;
         switch (t) {
@@ -162,6 +170,7 @@ SpiceManager::~SpiceManager() {
     for (const KernelInformation& i : _loadedKernels) {
         unload_c(i.path.c_str());
     }
+    EphemerisTimeConverter::setCurrent(std::nullopt);
 
     // Set values back to default
     erract_c("SET", 0, const_cast<char*>("DEFAULT"));
@@ -259,6 +268,10 @@ SpiceManager::KernelHandle SpiceManager::loadKernel(std::string filePath) {
     KernelHandle kernelId = ++_lastAssignedKernel;
     ghoul_assert(kernelId != 0, fmt::format("Kernel Handle wrapped around to 0"));
     _loadedKernels.push_back({ path.string(), kernelId, 1 });
+
+    if (fileExtension == ".tls" || fileExtension == ".TLS") {
+        updateEphemerisTimeConverter(); // leap seconds kernel
+    }
     return kernelId;
 }
 
@@ -278,7 +291,11 @@ void SpiceManager::unloadKernel(KernelHandle kernelId) {
             // No need to check for errors as we do not allow empty path names
             LINFO(fmt::format("Unloading SPICE kernel {}", it->path));
             unload_c(it->path.c_str());
+            const bool isLeapSecondsKernel = isLeapSecondsKernelPath(it->path);
             _loadedKernels.erase(it);
+            if (isLeapSecondsKernel) {
+                updateEphemerisTimeConverter();
+            }
         }
         // Otherwise, we hold on to it, but reduce the reference counter by 1
         else {
@@ -315,6 +332,9 @@ void SpiceManager::unloadKernel(std::string filePath) {
             LINFO(fmt::format("Unloading SPICE kernel {}", path));
             unload_c(path.string().c_str());
             _loadedKernels.erase(it);
+            if (isLeapSecondsKernelPath(path)) {
+                updateEphemerisTimeConverter();
+            }
         }
         else {
             // Otherwise, we hold on to it, but reduce the reference counter by 1
@@ -1360,6 +1380,40 @@ glm::dmat3 SpiceManager::getEstimatedTransformMatrix(const std::string& fromFram
     return result;
 }
 
+void SpiceManager::updateEphemerisTimeConverter() {
+    // SPICE uses the most recently loaded leap seconds kernel, so we do the same. The
+    // default kernel is loaded from a temporary file which no longer exists, but its
+    // leap seconds are also the defaults of the EphemerisTimeConverter
+    const auto it = std::find_if(
+        _loadedKernels.rbegin(),
+        _loadedKernels.rend(),
+        [](const KernelInformation& info) {
+            return isLeapSecondsKernelPath(info.path) &&
+                   std::filesystem::is_regular_file(info.path);
+        }
+    );
+    if (it == _loadedKernels.rend()) {
+        EphemerisTimeConverter::setCurrent(std::nullopt);
+        return;
+    }
+
+    std::ifstream file(it->path);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    try {
+        EphemerisTimeConverter::setCurrent(
+            EphemerisTimeConverter::createFromLeapSecondsKernel(buffer.str())
+        );
+    }
+    catch (const ghoul::RuntimeError& e) {
+        LWARNING(fmt::format(
+            "Could not read leap seconds from {}, using the default leap seconds "
+            "for time conversions instead: {}", it->path, e.message
+        ));
+        EphemerisTimeConverter::setCurrent(std::nullopt);
+    }
+}
+
 void SpiceManager::loadLeapSecondsSpiceKernel() {
     constexpr std::string_view Naif00012tlsSource = R"(
 KPL/LSK
@@ -29,6 +29,8 @@
 #include <openspace/util/factorymanager.h>
 #include <ghoul/misc/dictionary.h>
 #include <ghoul/misc/templatefactory.h>
+#include <algorithm>
+#include <optional>
 
 namespace {
 
@@ -45,6 +47,15 @@ namespace {
         // valid Tasks that are available for creation (see the FactoryDocumentation for a
         // list of possible Tasks), which depends on the configration of the application
         std::string type [[codegen::annotation("A valid Task created by a factory")]];
+
+        // An identifier that other tasks can use to declare a dependency on this task
+        std::optional<std::string> identifier;
+
+        // The identifiers of tasks that have to be finished before this task is
+        // performed. If any of these tasks is performed, this task is performed as well,
+        // even if its outputs are up to date. Tasks that read the outputs of another task
+        // automatically depend on that task and do not need to list it here
+        std::optional<std::vector<std::string>> dependencies;
     };
 #include "task_codegen.cpp"
 } // namespace
@@ -55,11 +66,51 @@ documentation::Documentation Task::documentation() {
     return codegen::doc<Parameters>("core_task");
 }
 
+std::vector<std::filesystem::path> Task::inputs() const {
+    return {};
+}
+
+std::vector<std::filesystem::path> Task::outputs() const {
+    return {};
+}
+
+size_t Task::memoryEstimate() const {
+    return 0;
+}
+
+unsigned int Task::requestedThreads() const {
+    return 1;
+}
+
+bool Task::canRunConcurrently() const {
+    return true;
+}
+
+const std::string& Task::identifier() const {
+    return _identifier;
+}
+
+const std::vector<std::string>& Task::dependencies() const {
+    return _dependencies;
+}
+
+void Task::setNumThreads(unsigned int nThreads) {
+    _nThreads = std::max(nThreads, 1u);
+}
+
+unsigned int Task::numThreads() const {
+    return _nThreads;
+}
+
 std::unique_ptr<Task> Task::createFromDictionary(const ghoul::Dictionary& dictionary) {
     const Parameters p = codegen::bake<Parameters>(dictionary);
 
     ghoul::TemplateFactory<Task>* factory = FactoryManager::ref().factory<Task>();
     Task* task = factory->create(p.type, dictionary);
+    if (task) {
+        task->_identifier = p.identifier.value_or("");
+        task->_dependencies = p.dependencies.value_or(std::vector<std::string>());
+    }
     return std::unique_ptr<Task>(task);
 }
 
@@ -0,0 +1,374 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <openspace/util/taskscheduler.h>
+
+#include <openspace/util/progressbar.h>
+#include <openspace/util/task.h>
+#include <ghoul/fmt.h>
+#include <ghoul/logging/logmanager.h>
+#include <ghoul/misc/exception.h>
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+
+namespace {
+    constexpr std::string_view _loggerCat = "TaskScheduler";
+
+    std::filesystem::path normalizedPath(const std::filesystem::path& path) {
+        std::error_code ec;
+        std::filesystem::path result = std::filesystem::weakly_canonical(path, ec);
+        return ec ? path.lexically_normal() : result;
+    }
+
+    std::string_view statusName(openspace::TaskScheduler::Status status) {
+        using Status = openspace::TaskScheduler::Status;
+        switch (status) {
+            case Status::Performed:        return "Performed";
+            case Status::UpToDate:         return "Up to date";
+            case Status::Failed:           return "Failed";
+            case Status::DependencyFailed: return "Skipped";
+            default:                       throw ghoul::MissingCaseException();
+        }
+    }
+} // namespace
+
+namespace openspace {
+
+TaskScheduler::TaskScheduler(Settings settings)
+    : _settings(std::move(settings))
+{
+    _settings.nThreads = std::max(_settings.nThreads, 1u);
+}
+
+std::vector<TaskScheduler::Result> TaskScheduler::performTasks(
+                                         const std::vector<std::unique_ptr<Task>>& tasks)
+{
+    const size_t nTasks = tasks.size();
+    std::vector<Result> results(nTasks);
+    for (size_t i = 0; i < nTasks; ++i) {
+        results[i].description = tasks[i]->description();
+    }
+
+    //
+    // Build the dependency graph
+    //
+    std::map<std::string, size_t> identifiers;
+    std::map<std::filesystem::path, size_t> producers;
+    for (size_t i = 0; i < nTasks; ++i) {
+        const std::string& identifier = tasks[i]->identifier();
+        if (!identifier.empty() && !identifiers.emplace(identifier, i).second) {
+            LWARNING(fmt::format("Task identifier '{}' is not unique", identifier));
+        }
+        for (const std::filesystem::path& output : tasks[i]->outputs()) {
+            producers.emplace(normalizedPath(output), i);
+        }
+    }
+
+    std::vector<std::set<size_t>> dependencies(nTasks);
+    std::vector<bool> hasFailedDependency(nTasks, false);
+    std::vector<bool> hasPerformedDependency(nTasks, false);
+    for (size_t i = 0; i < nTasks; ++i) {
+        for (const std::string& dependency : tasks[i]->dependencies()) {
+            auto it = identifiers.find(dependency);
+            if (it == identifiers.end()) {
+                LERROR(fmt::format(
+                    "Task '{}' depends on unknown task '{}'",
+                    results[i].description, dependency
+                ));
+                hasFailedDependency[i] = true;
+            }
+            else if (it->second != i) {
+                dependencies[i].insert(it->second);
+            }
+        }
+        for (const std::filesystem::path& input : tasks[i]->inputs()) {
+            auto it = producers.find(normalizedPath(input));
+            if (it != producers.end() && it->second != i) {
+                dependencies[i].insert(it->second);
+            }
+        }
+    }
+
+    std::vector<std::vector<size_t>> dependents(nTasks);
+    std::vector<size_t> nOpenDependencies(nTasks, 0);
+    for (size_t i = 0; i < nTasks; ++i) {
+        for (size_t dependency : dependencies[i]) {
+            dependents[dependency].push_back(i);
+        }
+        nOpenDependencies[i] = dependencies[i].size();
+    }
+
+    //
+    // Run the tasks
+    //
+    std::mutex mutex;
+    std::condition_variable finishedCondition;
+    std::vector<size_t> finished;
+    std::vector<std::thread> threads;
+
+    std::vector<size_t> ready;
+    for (size_t i = 0; i < nTasks; ++i) {
+        if (nOpenDependencies[i] == 0) {
+            ready.push_back(i);
+        }
+    }
+
+    std::vector<unsigned int> grantedThreads(nTasks, 0);
+    std::vector<size_t> grantedMemory(nTasks, 0);
+    std::vector<bool> isDone(nTasks, false);
+    unsigned int freeThreads = _settings.nThreads;
+    size_t usedMemory = 0;
+    size_t nRunning = 0;
+    bool exclusiveIsRunning = false;
+
+    auto runTask = [&](size_t i) {
+        Task& task = *tasks[i];
+        Status status = Status::Performed;
+
+        // Progress bars of tasks that run at the same time would overwrite each other,
+        // so the progress is logged instead in that case
+        std::unique_ptr<ProgressBar> progressBar;
+        int lastReported = 0;
+        Task::ProgressCallback onProgress;
+        if (_settings.nThreads == 1) {
+            progressBar = std::make_unique<ProgressBar>(100);
+            onProgress = [&progressBar](float progress) {
+                progressBar->print(static_cast<int>(progress * 100.f));
+            };
+        }
+        else {
+            onProgress = [&lastReported, &results, i](float progress) {
+                const int percent = static_cast<int>(progress * 10.f) * 10;
+                if (percent > lastReported) {
+                    lastReported = percent;
+                    LINFO(fmt::format("{}: {}%", results[i].description, percent));
+                }
+            };
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        try {
+            task.perform(onProgress);
+        }
+        catch (const ghoul::RuntimeError& e) {
+            LERROR(fmt::format(
+                "Task '{}' failed: {} ({})", results[i].description, e.message,
+                e.component
+            ));
+            status = Status::Failed;
+        }
+        catch (const std::exception& e) {
+            LERROR(fmt::format("Task '{}' failed: {}", results[i].description, e.what()));
+            status = Status::Failed;
+        }
+        const auto end = std::chrono::steady_clock::now();
+        progressBar = nullptr;
+
+        std::lock_guard lock(mutex);
+        results[i].status = status;
+        results[i].duration = end - start;
+        finished.push_back(i);
+        finishedCondition.notify_one();
+    };
+
+    std::unique_lock lock(mutex);
+    while (true) {
+        // Release the resources of all finished tasks and find the tasks that can run now
+        while (!finished.empty()) {
+            const size_t f = finished.back();
+            finished.pop_back();
+
+            if (!isDone[f] && grantedThreads[f] > 0) {
+                nRunning--;
+                freeThreads += grantedThreads[f];
+                usedMemory -= grantedMemory[f];
+                if (!tasks[f]->canRunConcurrently()) {
+                    exclusiveIsRunning = false;
+                }
+            }
+            isDone[f] = true;
+
+            const bool hasFailed = results[f].status == Status::Failed ||
+                results[f].status == Status::DependencyFailed;
+            const bool wasPerformed = results[f].status == Status::Performed;
+            for (size_t d : dependents[f]) {
+                hasFailedDependency[d] = hasFailedDependency[d] || hasFailed;
+                hasPerformedDependency[d] = hasPerformedDependency[d] || wasPerformed;
+                nOpenDependencies[d]--;
+                if (nOpenDependencies[d] == 0) {
+                    ready.push_back(d);
+                }
+            }
+        }
+
+        // Keep the order of the task file as far as possible
+        std::sort(ready.begin(), ready.end());
+
+        // Start as many of the ready tasks as the resources allow
+        for (auto it = ready.begin(); it != ready.end() && !exclusiveIsRunning;) {
+            const size_t i = *it;
+            Task& task = *tasks[i];
+
+            if (hasFailedDependency[i]) {
+                LWARNING(fmt::format(
+                    "Skipping task '{}' as one of its dependencies failed",
+                    results[i].description
+                ));
+                results[i].status = Status::DependencyFailed;
+                finished.push_back(i);
+                it = ready.erase(it);
+                continue;
+            }
+
+            // A task has to run again if any of its dependencies did, even if the
+            // dependency does not produce any of the files that the task reads
+            if (!_settings.forceRun && !hasPerformedDependency[i] && isUpToDate(task)) {
+                LINFO(fmt::format(
+                    "Skipping task '{}' as its outputs are up to date",
+                    results[i].description
+                ));
+                results[i].status = Status::UpToDate;
+                finished.push_back(i);
+                it = ready.erase(it);
+                continue;
+            }
+
+            if (freeThreads == 0) {
+                break;
+            }
+
+            const bool isExclusive = !task.canRunConcurrently();
+            if (isExclusive && nRunning > 0) {
+                // Wait for the running tasks to finish and don't start any other tasks
+                // in the meantime, as the exclusive task would never get to run otherwise
+                break;
+            }
+
+            const size_t memory = task.memoryEstimate();
+            const bool fitsMemory = _settings.memoryBudget == 0 || nRunning == 0 ||
+                usedMemory + memory <= _settings.memoryBudget;
+            if (!fitsMemory) {
+                // A later task might have a smaller memory footprint
+                ++it;
+                continue;
+            }
+
+            const unsigned int requested =
+                std::clamp(task.requestedThreads(), 1u, _settings.nThreads);
+            const unsigned int granted = std::min(requested, freeThreads);
+            task.setNumThreads(granted);
+            grantedThreads[i] = granted;
+            grantedMemory[i] = memory;
+            results[i].nThreads = granted;
+
+            freeThreads -= granted;
+            usedMemory += memory;
+            nRunning++;
+            exclusiveIsRunning = isExclusive;
+
+            LINFO(fmt::format(
+                "Performing task '{}' using {} thread(s)", results[i].description, granted
+            ));
+            threads.emplace_back(runTask, i);
+            it = ready.erase(it);
+        }
+
+        if (!finished.empty()) {
+            continue;
+        }
+        if (nRunning == 0) {
+            // Nothing is running and nothing could be started, so we are done
+            break;
+        }
+        finishedCondition.wait(lock, [&finished]() { return !finished.empty(); });
+    }
+    lock.unlock();
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // Any task that has not been run at this point is part of a dependency cycle
+    for (size_t i = 0; i < nTasks; ++i) {
+        if (!isDone[i]) {
+            LERROR(fmt::format(
+                "Task '{}' was not performed due to a cyclic dependency",
+                results[i].description
+            ));
+            results[i].status = Status::DependencyFailed;
+        }
+    }
+
+    return results;
+}
+
+void TaskScheduler::logSummary(const std::vector<Result>& results) {
+    LINFO("Task summary:");
+    for (const Result& r : results) {
+        LINFO(fmt::format(
+            "{:<10} {:>10.2f} s {:>3} thread(s)  {}",
+            statusName(r.status), r.duration.count(), r.nThreads, r.description
+        ));
+    }
+}
+
+bool TaskScheduler::isUpToDate(const Task& task) const {
+    const std::vector<std::filesystem::path> outputs = task.outputs();
+    if (outputs.empty()) {
+        return false;
+    }
+
+    std::vector<std::filesystem::path> inputs = task.inputs();
+    inputs.insert(
+        inputs.end(),
+        _settings.commonInputs.begin(),
+        _settings.commonInputs.end()
+    );
+
+    std::error_code ec;
+    std::filesystem::file_time_type latestInput = std::filesystem::file_time_type::min();
+    for (const std::filesystem::path& input : inputs) {
+        const std::filesystem::file_time_type t =
+            std::filesystem::last_write_time(input, ec);
+        if (ec) {
+            return false;
+        }
+        latestInput = std::max(latestInput, t);
+    }
+
+    for (const std::filesystem::path& output : outputs) {
+        const std::filesystem::file_time_type t =
+            std::filesystem::last_write_time(output, ec);
+        if (ec || t < latestInput) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace openspace
@@ -32,6 +32,7 @@
 #include <openspace/scene/profile.h>
 #include <openspace/scene/scene.h>
 #include <openspace/scripting/scriptengine.h>
+#include <openspace/util/ephemeristimeconverter.h>
 #include <openspace/util/memorymanager.h>
 #include <openspace/util/spicemanager.h>
 #include <openspace/util/syncbuffer.h>
@@ -53,11 +54,14 @@ namespace openspace {
 
 double Time::convertTime(const std::string& time) {
     ghoul_assert(!time.empty(), "timeString must not be empty");
-    return SpiceManager::ref().ephemerisTimeFromDate(time);
+    return convertTime(time.c_str());
 }
 
 double Time::convertTime(const char* time) {
-    return SpiceManager::ref().ephemerisTimeFromDate(time);
+    // Dates that the native converter does not understand are left to SPICE
+    const std::optional<double> et =
+        EphemerisTimeConverter::ref().ephemerisTimeFromDate(time);
+    return et.has_value() ? *et : SpiceManager::ref().ephemerisTimeFromDate(time);
 }
 
 std::string Time::currentWallTime() {
@@ -74,9 +78,7 @@ std::string Time::currentWallTime() {
 
 Time::Time(double secondsJ2000) : _time(secondsJ2000) {}
 
-Time::Time(const std::string& time) :
-    _time(SpiceManager::ref().ephemerisTimeFromDate(time))
-{}
+Time::Time(const std::string& time) : _time(convertTime(time)) {}
 
 Time Time::now() {
     Time now;
@@ -105,11 +107,11 @@ double Time::advanceTime(double delta) {
 }
 
 void Time::setTime(const std::string& time) {
-    _time = SpiceManager::ref().ephemerisTimeFromDate(time);
+    _time = convertTime(time);
 }
 
 void Time::setTime(const char* time) {
-    _time = SpiceManager::ref().ephemerisTimeFromDate(time);
+    _time = convertTime(time);
 }
 
 std::string_view Time::UTC() const {
@@ -119,7 +121,10 @@ std::string_view Time::UTC() const {
     );
     std::memset(b, 0, 32);
 
-    SpiceManager::ref().dateFromEphemerisTime(_time, b, 32, Format);
+    const EphemerisTimeConverter& converter = EphemerisTimeConverter::ref();
+    if (!converter.dateFromEphemerisTime(_time, Format, b, 32).has_value()) {
+        SpiceManager::ref().dateFromEphemerisTime(_time, b, 32, Format);
+    }
     return std::string_view(b);
 }
 
@@ -133,7 +138,10 @@ std::string_view Time::ISO8601() const {
     );
     std::memset(b, 0, S);
 
-    SpiceManager::ref().dateFromEphemerisTime(_time, b, S, Format);
+    const EphemerisTimeConverter& converter = EphemerisTimeConverter::ref();
+    if (!converter.dateFromEphemerisTime(_time, Format, b, S).has_value()) {
+        SpiceManager::ref().dateFromEphemerisTime(_time, b, S, Format);
+    }
     return std::string_view(b, S - 1);
 }
 
@@ -141,7 +149,10 @@ void Time::ISO8601(char* buffer) const {
     constexpr const char Format[] = "YYYY-MM-DDTHR:MN:SC.###";
     constexpr int S = sizeof(Format) + 1;
     std::memset(buffer, 0, S);
-    SpiceManager::ref().dateFromEphemerisTime(_time, buffer, S, Format);
+    const EphemerisTimeConverter& converter = EphemerisTimeConverter::ref();
+    if (!converter.dateFromEphemerisTime(_time, Format, buffer, S).has_value()) {
+        SpiceManager::ref().dateFromEphemerisTime(_time, buffer, S, Format);
+    }
 }
 
 std::string Time::advancedTime(std::string base, std::string change) {
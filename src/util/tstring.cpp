@@ -26,26 +26,26 @@
 
 #include <openspace/engine/globals.h>
 #include <openspace/util/memorymanager.h>
+#include <cstring>
 
 namespace openspace {
 
 tstring temporaryString(const std::string& str) {
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(str.size(), 8);
-    std::strcpy(reinterpret_cast<char*>(ptr), str.data());
-    return tstring(reinterpret_cast<char*>(ptr), str.size());
+    return temporaryString(std::string_view(str));
 }
 
 tstring temporaryString(std::string_view str) {
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(str.size(), 8);
-    std::strcpy(reinterpret_cast<char*>(ptr), str.data());
-    return tstring(reinterpret_cast<char*>(ptr), str.size());
+    // The string is null-terminated so that its data can be passed to C functions
+    char* ptr = static_cast<char*>(
+        global::memoryManager->TemporaryMemory.allocate(str.size() + 1, 1)
+    );
+    std::memcpy(ptr, str.data(), str.size());
+    ptr[str.size()] = '\0';
+    return tstring(ptr, str.size());
 }
 
 tstring temporaryString(const char str[]) {
-    size_t size = strlen(str);
-    void* ptr = global::memoryManager->TemporaryMemory.do_allocate(size, 8);
-    std::strcpy(reinterpret_cast<char*>(ptr), str);
-    return tstring(reinterpret_cast<char*>(ptr), size);
+    return temporaryString(std::string_view(str));
 }
 
 } // namespace openspace
@@ -0,0 +1,149 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/properties/scalar/intproperty.h>
+#include <algorithm>
+#include <memory>
+
+using namespace openspace::properties;
+
+namespace {
+    bool isDirty(const Property& p) {
+        const std::vector<Property*> dirty = Property::dirtyProperties();
+        return std::find(dirty.begin(), dirty.end(), &p) != dirty.end();
+    }
+} // namespace
+
+TEST_CASE("ChangeJournal: Changed Property", "[changejournal]") {
+    Property::clearChangeJournal();
+    Property::resetAllToUnchanged();
+
+    IntProperty p({ "id", "gui", "desc" }, 1);
+    CHECK(Property::changeJournalSize() == 0);
+    CHECK_FALSE(p.hasChanged());
+
+    p.setValue(2);
+    CHECK(Property::changeJournalSize() == 1);
+    CHECK(p.hasChanged());
+
+    // Changing the same property twice only adds it to the journal once
+    p.setValue(3);
+    CHECK(Property::changeJournalSize() == 1);
+
+    Property::clearChangeJournal();
+    CHECK(Property::changeJournalSize() == 0);
+    // The change flag survives the end of the frame
+    CHECK(p.hasChanged());
+
+    Property::resetAllToUnchanged();
+    CHECK_FALSE(p.hasChanged());
+    CHECK(Property::dirtyProperties().empty());
+}
+
+TEST_CASE("ChangeJournal: Unchanged Value", "[changejournal]") {
+    Property::clearChangeJournal();
+
+    IntProperty p({ "id", "gui", "desc" }, 1);
+    p.setValue(1);
+    CHECK(Property::changeJournalSize() == 0);
+    CHECK_FALSE(isDirty(p));
+    CHECK_FALSE(p.hasChanged());
+}
+
+TEST_CASE("ChangeJournal: Deleted Property", "[changejournal]") {
+    Property::clearChangeJournal();
+    Property::resetAllToUnchanged();
+
+    auto p = std::make_unique<IntProperty>(Property::PropertyInfo{ "id", "gui", "desc" });
+    p->setValue(5);
+    CHECK(Property::changeJournalSize() == 1);
+    CHECK(Property::dirtyProperties().size() == 1);
+
+    p = nullptr;
+    CHECK(Property::changeJournalSize() == 0);
+    CHECK(Property::dirtyProperties().empty());
+}
+
+TEST_CASE("ChangeJournal: Deleted Property Keeps Order", "[changejournal]") {
+    Property::clearChangeJournal();
+    Property::resetAllToUnchanged();
+
+    IntProperty a({ "a", "gui", "desc" }, 1);
+    auto b = std::make_unique<IntProperty>(Property::PropertyInfo{ "b", "gui", "desc" });
+    IntProperty c({ "c", "gui", "desc" }, 1);
+    a.setValue(2);
+    b->setValue(2);
+    c.setValue(2);
+
+    b = nullptr;
+    CHECK(Property::changeJournalSize() == 2);
+    CHECK(Property::dirtyProperties() == std::vector<Property*>{ &a, &c });
+
+    // Properties that change after a deletion are still appended in order
+    IntProperty d({ "d", "gui", "desc" }, 1);
+    d.setValue(2);
+    CHECK(Property::changeJournalSize() == 3);
+    CHECK(Property::dirtyProperties() == std::vector<Property*>{ &a, &c, &d });
+
+    Property::clearChangeJournal();
+    Property::resetAllToUnchanged();
+    CHECK(Property::changeJournalSize() == 0);
+    CHECK(Property::dirtyProperties().empty());
+}
+
+TEST_CASE("ChangeJournal: Compact Dirty Properties", "[changejournal]") {
+    Property::clearChangeJournal();
+    Property::resetAllToUnchanged();
+
+    IntProperty a({ "a", "gui", "desc" }, 1);
+    auto b = std::make_unique<IntProperty>(Property::PropertyInfo{ "b", "gui", "desc" });
+    IntProperty c({ "c", "gui", "desc" }, 1);
+    a.setValue(2);
+    b->setValue(2);
+    c.setValue(2);
+
+    // Deleted properties and properties that are no longer changed are removed, while
+    // the changed properties keep their order
+    b = nullptr;
+    a.resetToUnchanged();
+    Property::compactDirtyProperties();
+    CHECK(Property::dirtyProperties() == std::vector<Property*>{ &c });
+    CHECK(c.hasChanged());
+
+    // A property that was removed is added again once it changes
+    a.setValue(3);
+    CHECK(Property::dirtyProperties() == std::vector<Property*>{ &c, &a });
+
+    // Deleting a property after the compaction uses the updated position in the list
+    auto d = std::make_unique<IntProperty>(Property::PropertyInfo{ "d", "gui", "desc" });
+    d->setValue(2);
+    Property::compactDirtyProperties();
+    d = nullptr;
+    CHECK(Property::dirtyProperties() == std::vector<Property*>{ &c, &a });
+
+    Property::clearChangeJournal();
+    Property::resetAllToUnchanged();
+}
@@ -36,6 +36,7 @@
 #include <ghoul/filesystem/filesystem.h>
 #include <ghoul/lua/lua_helper.h>
 #include <ghoul/misc/dictionaryluaformatter.h>
+#include <chrono>
 #include <exception>
 #include <memory>
 
@@ -72,3 +73,53 @@ TEST_CASE("AssetLoader: Asset Functions", "[assetloader]") {
 
     CHECK_NOTHROW(assetLoader.add("assetfunctionsexist"));
 }
+
+TEST_CASE("AssetLoader: Initialization Budget", "[assetloader]") {
+    openspace::Scene scene(std::make_unique<openspace::SingleThreadedSceneInitializer>());
+    ghoul::lua::LuaState* state = openspace::global::scriptEngine->luaState();
+    openspace::AssetManager assetLoader(
+        state,
+        absPath("${TESTDIR}/AssetLoaderTest/").string()
+    );
+
+    // Without any budget, only a single asset is initialized in each update call
+    assetLoader.setInitializationBudget(std::chrono::microseconds(0));
+    assetLoader.add("require");
+    assetLoader.update();
+
+    std::vector<const openspace::Asset*> assets = assetLoader.allAssets();
+    REQUIRE(assets.size() == 2);
+    const openspace::Asset* root = assetLoader.rootAssets().front();
+    const openspace::Asset* child = root == assets[0] ? assets[1] : assets[0];
+    CHECK(!root->isInitialized());
+    CHECK(!child->isInitialized());
+
+    assetLoader.update();
+    CHECK(!root->isInitialized());
+    CHECK(child->isInitialized());
+
+    assetLoader.update();
+    CHECK(root->isInitialized());
+
+    assetLoader.deinitialize();
+}
+
+TEST_CASE("AssetLoader: Unlimited Initialization Budget", "[assetloader]") {
+    openspace::Scene scene(std::make_unique<openspace::SingleThreadedSceneInitializer>());
+    ghoul::lua::LuaState* state = openspace::global::scriptEngine->luaState();
+    openspace::AssetManager assetLoader(
+        state,
+        absPath("${TESTDIR}/AssetLoaderTest/").string()
+    );
+
+    assetLoader.setInitializationBudget(std::chrono::microseconds(0));
+    assetLoader.add("require");
+    assetLoader.update();
+    assetLoader.update(openspace::AssetManager::UnlimitedBudget::Yes);
+
+    for (const openspace::Asset* asset : assetLoader.allAssets()) {
+        CHECK(asset->isInitialized());
+    }
+
+    assetLoader.deinitialize();
+}
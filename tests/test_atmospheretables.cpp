@@ -0,0 +1,184 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_ATMOSPHERE_ENABLED
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <modules/atmosphere/atmospheretables.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+
+using namespace openspace::atmosphere;
+
+namespace {
+    // The Earth atmosphere with a reduced texture scale to keep the tests fast
+    TableParameters earthParameters() {
+        TableParameters p;
+        p.planetRadius = 6377.f;
+        p.atmosphereRadius = 6447.f;
+        p.averageGroundReflectance = 0.1f;
+        p.rayleighHeightScale = 8.f;
+        p.rayleighScatteringCoeff = glm::vec3(0.0058f, 0.0135f, 0.0331f);
+        p.mieHeightScale = 1.2f;
+        p.mieScatteringCoeff = glm::vec3(0.004f);
+        p.mieExtinctionCoeff = glm::vec3(0.004f / 0.9f);
+        p.miePhaseConstant = 0.85f;
+        p.textureScale = 0.25f;
+        return p;
+    }
+
+    // Returns the analytic optical depth of an exponentially decaying atmosphere
+    // along a vertical ray that starts at height h
+    float verticalOpticalDepth(float h, float H, float thickness) {
+        return H * (std::exp(-h / H) - std::exp(-thickness / H));
+    }
+} // namespace
+
+TEST_CASE("AtmosphereTables: Table Sizes", "[atmospheretables]") {
+    const TableSizes sizes = TableSizes(1.f);
+    CHECK(sizes.transmittance == glm::ivec2(256, 64));
+    CHECK(sizes.irradiance == glm::ivec2(64, 16));
+    CHECK(sizes.inScattering() == glm::ivec3(32 * 8, 128, 32));
+
+    const LookupTables tables = computeLookupTables(earthParameters());
+    const glm::ivec3 size3D = tables.sizes.inScattering();
+    CHECK(tables.transmittance.size() == 64u * 16u * 3u);
+    CHECK(tables.irradiance.size() == 16u * 4u * 3u);
+    const size_t n3D = static_cast<size_t>(size3D.x) * size3D.y * size3D.z;
+    CHECK(tables.inScattering.size() == n3D * 4);
+}
+
+TEST_CASE("AtmosphereTables: Physical Plausibility", "[atmospheretables]") {
+    const TableParameters p = earthParameters();
+    const LookupTables tables = computeLookupTables(p);
+
+    auto isValid = [](float v) { return std::isfinite(v) && v >= 0.f; };
+    CHECK(std::all_of(tables.transmittance.begin(), tables.transmittance.end(), isValid));
+    CHECK(std::all_of(tables.irradiance.begin(), tables.irradiance.end(), isValid));
+    CHECK(std::all_of(tables.inScattering.begin(), tables.inScattering.end(), isValid));
+    CHECK(std::all_of(
+        tables.transmittance.begin(),
+        tables.transmittance.end(),
+        [](float v) { return v <= 1.f; }
+    ));
+
+    // The optical depth along a ray that starts close to the ground can be approximated
+    // by a plane-parallel atmosphere for view directions close to the zenith. The last
+    // column of the first row stores the ray closest to the zenith
+    const glm::ivec2 size = tables.sizes.transmittance;
+    const float uR = 0.5f / size.y;
+    const float uMu = (size.x - 0.5f) / size.x;
+    const float h = uR * uR * (p.atmosphereRadius - p.planetRadius);
+    const float mu = -0.15f + std::tan(1.5f * uMu) / std::tan(1.5f) * 1.15f;
+    const float thickness = p.atmosphereRadius - p.planetRadius;
+    for (int c = 0; c < 3; c++) {
+        const float depth =
+            p.rayleighScatteringCoeff[c] *
+                verticalOpticalDepth(h, p.rayleighHeightScale, thickness) +
+            p.mieExtinctionCoeff[c] *
+                verticalOpticalDepth(h, p.mieHeightScale, thickness);
+        const float value = tables.transmittance[(size.x - 1) * 3 + c];
+        CHECK(value == Catch::Approx(std::exp(-depth / mu)).epsilon(0.01));
+    }
+
+    // Blue light is scattered more than red light, so less of it is transmitted and
+    // more of it is inscattered
+    const size_t zenith = (size.x - 1) * 3;
+    CHECK(tables.transmittance[zenith + 2] < tables.transmittance[zenith]);
+    float red = 0.f;
+    float blue = 0.f;
+    for (size_t i = 0; i < tables.inScattering.size(); i += 4) {
+        red += tables.inScattering[i];
+        blue += tables.inScattering[i + 2];
+    }
+    CHECK(blue > red);
+}
+
+TEST_CASE("AtmosphereTables: Deterministic", "[atmospheretables]") {
+    const TableParameters p = earthParameters();
+    const LookupTables single = computeLookupTables(p, 1);
+    const LookupTables multi = computeLookupTables(p, 4);
+
+    CHECK(single.transmittance == multi.transmittance);
+    CHECK(single.irradiance == multi.irradiance);
+    CHECK(single.inScattering == multi.inScattering);
+}
+
+TEST_CASE("AtmosphereTables: Progress", "[atmospheretables]") {
+    std::vector<float> progress;
+    computeLookupTables(earthParameters(), 2, [&](float f) { progress.push_back(f); });
+
+    REQUIRE_FALSE(progress.empty());
+    CHECK(std::is_sorted(progress.begin(), progress.end()));
+    CHECK(progress.back() == Catch::Approx(1.f));
+}
+
+TEST_CASE("AtmosphereTables: Cache Key", "[atmospheretables]") {
+    const TableParameters p = earthParameters();
+    CHECK(cacheKey(p) == cacheKey(earthParameters()));
+
+    TableParameters mieChanged = p;
+    mieChanged.miePhaseConstant = 0.76f;
+    CHECK(cacheKey(mieChanged) != cacheKey(p));
+
+    TableParameters scaleChanged = p;
+    scaleChanged.textureScale = 0.5f;
+    CHECK(cacheKey(scaleChanged) != cacheKey(p));
+
+    TableParameters ozoneChanged = p;
+    ozoneChanged.ozoneEnabled = true;
+    CHECK(cacheKey(ozoneChanged) != cacheKey(p));
+}
+
+TEST_CASE("AtmosphereTables: Cache Roundtrip", "[atmospheretables]") {
+    const TableParameters p = earthParameters();
+    const LookupTables tables = computeLookupTables(p);
+
+    const std::filesystem::path file =
+        std::filesystem::temp_directory_path() / "test_atmospheretables.bin";
+    REQUIRE(saveLookupTables(file, p, tables));
+
+    const std::optional<LookupTables> loaded = loadLookupTables(file, p);
+    REQUIRE(loaded.has_value());
+    CHECK(loaded->transmittance == tables.transmittance);
+    CHECK(loaded->irradiance == tables.irradiance);
+    CHECK(loaded->inScattering == tables.inScattering);
+
+    // Tables that were calculated for different parameters must not be used
+    TableParameters other = p;
+    other.rayleighHeightScale = 8.5f;
+    CHECK_FALSE(loadLookupTables(file, other).has_value());
+
+    // A truncated file must not be used either
+    std::filesystem::resize_file(file, std::filesystem::file_size(file) / 2);
+    CHECK_FALSE(loadLookupTables(file, p).has_value());
+
+    std::filesystem::remove(file);
+    CHECK_FALSE(loadLookupTables(file, p).has_value());
+}
+
+#endif // OPENSPACE_MODULE_ATMOSPHERE_ENABLED
@@ -0,0 +1,193 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/network/camerakeyframecodec.h>
+#include <cmath>
+#include <deque>
+
+using namespace openspace::datamessagestructures;
+
+namespace {
+    // The size of the type and timestamp that precede each data message
+    constexpr size_t DataMessageHeaderSize = sizeof(uint32_t) + sizeof(double);
+
+    CameraKeyframe cameraPath(double t) {
+        CameraKeyframe kf;
+        kf._timestamp = t;
+        kf._scale = 1.f;
+        kf._followNodeRotation = t < 30.0;
+
+        if (t < 20.0) {
+            // Orbiting the anchor
+            const double a = t * 0.1;
+            kf._focusNode = "Earth";
+            kf._position = 2e7 * glm::dvec3(std::cos(a), std::sin(a), 0.1);
+            kf._rotation = glm::angleAxis(a, glm::dvec3(0.0, 0.0, 1.0));
+        }
+        else if (t < 40.0) {
+            // Stationary
+            kf._focusNode = "Earth";
+            kf._position = 2e7 * glm::dvec3(std::cos(2.0), std::sin(2.0), 0.1);
+            kf._rotation = glm::angleAxis(2.0, glm::dvec3(0.0, 0.0, 1.0));
+        }
+        else {
+            // Approaching a different anchor while turning
+            const double s = (t - 40.0) / 20.0;
+            kf._focusNode = "Moon";
+            kf._position = glm::mix(1e8, 2e6, s) * glm::dvec3(0.6, 0.0, 0.8);
+            kf._rotation = glm::angleAxis(s, glm::normalize(glm::dvec3(1.0, 1.0, 0.0)));
+        }
+        return kf;
+    }
+
+    double rotationError(const glm::dquat& a, const glm::dquat& b) {
+        const double d = std::min(std::abs(glm::dot(glm::normalize(a), b)), 1.0);
+        return 2.0 * std::acos(d);
+    }
+} // namespace
+
+TEST_CASE("CameraKeyframeCodec: Loopback", "[camerakeyframecodec]") {
+    // The host renders at 60 fps and sends a keyframe at most every 0.1 seconds, but
+    // only if the camera moved or if it has been stationary for a second. The messages
+    // are relayed through a queue that stands in for the parallel server
+    constexpr double Duration = 60.0;
+    constexpr double FrameTime = 1.0 / 60.0;
+    constexpr double KeyframeInterval = 0.1;
+    constexpr double IdleInterval = 1.0;
+
+    CameraKeyframeEncoder encoder;
+    CameraKeyframeDecoder decoder;
+    std::deque<std::pair<CameraKeyframe, std::vector<char>>> server;
+
+    size_t legacyBytes = 0;
+    size_t compactBytes = 0;
+    double lastLegacySent = -1.0;
+    double lastSent = -1.0;
+    for (double t = 0.0; t < Duration; t += FrameTime) {
+        const CameraKeyframe kf = cameraPath(t);
+
+        if (lastLegacySent + KeyframeInterval < t) {
+            std::vector<char> legacy;
+            kf.serialize(legacy);
+            legacyBytes += legacy.size() + DataMessageHeaderSize;
+            lastLegacySent = t;
+        }
+
+        if (lastSent + KeyframeInterval < t) {
+            if (encoder.hasMoved(kf) || lastSent + IdleInterval < t) {
+                std::vector<char> compact;
+                encoder.encode(kf, compact);
+                compactBytes += compact.size() + DataMessageHeaderSize;
+                server.emplace_back(kf, std::move(compact));
+                lastSent = t;
+            }
+        }
+    }
+
+    double maxPositionError = 0.0;
+    double maxRotationError = 0.0;
+    double maxTimestampError = 0.0;
+    while (!server.empty()) {
+        const auto& [original, buffer] = server.front();
+        std::optional<CameraKeyframe> kf = decoder.decode(buffer);
+        REQUIRE(kf.has_value());
+
+        CHECK(kf->_focusNode == original._focusNode);
+        CHECK(kf->_followNodeRotation == original._followNodeRotation);
+        CHECK(kf->_scale == original._scale);
+
+        maxPositionError = std::max(
+            maxPositionError,
+            glm::length(kf->_position - original._position) /
+                glm::length(original._position)
+        );
+        maxRotationError = std::max(
+            maxRotationError,
+            rotationError(kf->_rotation, original._rotation)
+        );
+        maxTimestampError = std::max(
+            maxTimestampError,
+            std::abs(kf->_timestamp - original._timestamp)
+        );
+        server.pop_front();
+    }
+
+    WARN(
+        "Legacy: " << legacyBytes / Duration << " B/s, compact: " <<
+        compactBytes / Duration << " B/s. Max relative position error: " <<
+        maxPositionError << ", max rotation error: " << maxRotationError <<
+        " rad, max timestamp error: " << maxTimestampError << " s"
+    );
+
+    CHECK(compactBytes * 3 < legacyBytes);
+    CHECK(maxPositionError < 1e-8);
+    CHECK(maxRotationError < 1e-4);
+    CHECK(maxTimestampError < 1e-5);
+}
+
+TEST_CASE("CameraKeyframeCodec: Stationary Camera", "[camerakeyframecodec]") {
+    CameraKeyframeEncoder encoder;
+    const CameraKeyframe kf = cameraPath(22.0);
+    CHECK(encoder.hasMoved(kf));
+
+    std::vector<char> buffer;
+    encoder.encode(kf, buffer);
+    CHECK_FALSE(encoder.hasMoved(cameraPath(28.0)));
+    CHECK(encoder.hasMoved(cameraPath(10.0)));
+}
+
+TEST_CASE("CameraKeyframeCodec: Missed Keyframe", "[camerakeyframecodec]") {
+    CameraKeyframeEncoder::Settings settings;
+    settings.fullKeyframeInterval = 5;
+    CameraKeyframeEncoder encoder(settings);
+    CameraKeyframeDecoder decoder;
+
+    std::vector<std::vector<char>> buffers;
+    for (int i = 0; i < 10; i++) {
+        std::vector<char> buffer;
+        encoder.encode(cameraPath(i * 0.1), buffer);
+        buffers.push_back(std::move(buffer));
+    }
+
+    CHECK(decoder.decode(buffers[0]).has_value());
+    CHECK(decoder.decode(buffers[1]).has_value());
+    // Dropping buffer 2 invalidates the difference keyframes until the next full one
+    CHECK_FALSE(decoder.decode(buffers[3]).has_value());
+    CHECK_FALSE(decoder.decode(buffers[4]).has_value());
+    CHECK(decoder.decode(buffers[5]).has_value());
+    CHECK(decoder.decode(buffers[6]).has_value());
+}
+
+TEST_CASE("CameraKeyframeCodec: Malformed Buffer", "[camerakeyframecodec]") {
+    CameraKeyframeEncoder encoder;
+    std::vector<char> buffer;
+    encoder.encode(cameraPath(0.0), buffer);
+
+    CameraKeyframeDecoder decoder;
+    CHECK_FALSE(decoder.decode(std::vector<char>()).has_value());
+    buffer.resize(buffer.size() / 2);
+    CHECK_FALSE(decoder.decode(buffer).has_value());
+}
@@ -0,0 +1,159 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#ifdef OPENSPACE_MODULE_SPACE_ENABLED
+#include <modules/space/tasks/debrisdensity.h>
+#include <ghoul/glm.h>
+#include <numeric>
+
+using namespace openspace;
+
+namespace {
+    // A circular orbit in the equatorial plane of the provided radius in km
+    kepler::Parameters circularOrbit(double radius, double meanAnomaly = 0.0) {
+        kepler::Parameters p;
+        p.semiMajorAxis = radius;
+        p.meanAnomaly = meanAnomaly;
+        p.period = 5400.0;
+        return p;
+    }
+
+    double sum(const std::vector<double>& values) {
+        return std::accumulate(values.begin(), values.end(), 0.0);
+    }
+} // namespace
+
+TEST_CASE("DebrisDensity: Empty", "[debrisdensity]") {
+    const DebrisDensity debris({}, glm::uvec3(4), volume::VolumeGridType::Cartesian);
+    CHECK(debris.nObjects() == 0);
+    CHECK(debris.maxApogee() == 0.0);
+
+    std::vector<glm::dvec3> positions;
+    std::vector<double> density;
+    debris.compute(0.0, positions, density);
+    REQUIRE(density.size() == 64);
+    CHECK(sum(density) == 0.0);
+}
+
+TEST_CASE("DebrisDensity: Max Apogee", "[debrisdensity]") {
+    kepler::Parameters elliptic = circularOrbit(8000.0);
+    elliptic.eccentricity = 0.25;
+    const DebrisDensity debris(
+        { circularOrbit(7000.0), elliptic },
+        glm::uvec3(4),
+        volume::VolumeGridType::Cartesian
+    );
+    CHECK(debris.nObjects() == 2);
+    CHECK(debris.maxApogee() == Catch::Approx(10000.0 * 1000.0));
+}
+
+TEST_CASE("DebrisDensity: Cartesian Counts", "[debrisdensity]") {
+    const std::vector<kepler::Parameters> orbits = {
+        circularOrbit(7000.0, 0.0),
+        circularOrbit(7000.0, 90.0),
+        circularOrbit(7000.0, 180.0),
+        circularOrbit(7000.0, 270.0),
+        circularOrbit(7000.0, 0.0)
+    };
+    const glm::uvec3 dims = glm::uvec3(2, 2, 2);
+    const DebrisDensity debris(orbits, dims, volume::VolumeGridType::Cartesian);
+
+    std::vector<glm::dvec3> positions;
+    std::vector<double> density;
+    debris.compute(0.0, positions, density);
+    REQUIRE(positions.size() == orbits.size());
+    REQUIRE(density.size() == 8);
+
+    // Every object is counted exactly once, including the ones that lie exactly on the
+    // border of the grid
+    CHECK(sum(density) == 5.0);
+
+    // The two objects at a mean anomaly of 0 are at (+r, 0, 0), which lies in the
+    // +x, +y, +z cell
+    CHECK(positions[0].x == Catch::Approx(7000.0 * 1000.0));
+    CHECK(density[1 + 1 * 2 + 1 * 4] >= 2.0);
+}
+
+TEST_CASE("DebrisDensity: Periodicity", "[debrisdensity]") {
+    const std::vector<kepler::Parameters> orbits = {
+        circularOrbit(7000.0, 10.0),
+        circularOrbit(7500.0, 200.0)
+    };
+    const DebrisDensity debris(
+        orbits,
+        glm::uvec3(8),
+        volume::VolumeGridType::Cartesian
+    );
+
+    std::vector<glm::dvec3> positions;
+    std::vector<double> density;
+    debris.compute(1000.0, positions, density);
+    const std::vector<glm::dvec3> first = positions;
+    const std::vector<double> firstDensity = density;
+
+    // After one full period, all objects are back where they started
+    debris.compute(1000.0 + 5400.0, positions, density);
+    for (size_t i = 0; i < positions.size(); i++) {
+        CHECK(positions[i].x == Catch::Approx(first[i].x).margin(1.0));
+        CHECK(positions[i].y == Catch::Approx(first[i].y).margin(1.0));
+        CHECK(positions[i].z == Catch::Approx(first[i].z).margin(1.0));
+    }
+    CHECK(density == firstDensity);
+}
+
+TEST_CASE("DebrisDensity: Spherical Volume", "[debrisdensity]") {
+    const std::vector<kepler::Parameters> orbits = {
+        circularOrbit(7000.0, 45.0)
+    };
+    const glm::uvec3 dims = glm::uvec3(4, 4, 4);
+    const DebrisDensity debris(orbits, dims, volume::VolumeGridType::Spherical);
+
+    std::vector<glm::dvec3> positions;
+    std::vector<double> density;
+    debris.compute(0.0, positions, density);
+    REQUIRE(density.size() == 64);
+
+    // The single object contributes the inverse volume of its cell, so multiplying the
+    // density of each cell with its volume has to yield exactly one object
+    const double rStep = debris.maxApogee() / dims.x;
+    const double thetaStep = glm::pi<double>() / dims.y;
+    const double phiStep = glm::two_pi<double>() / dims.z;
+    double nObjects = 0.0;
+    for (unsigned int z = 0; z < dims.z; z++) {
+        for (unsigned int y = 0; y < dims.y; y++) {
+            for (unsigned int x = 0; x < dims.x; x++) {
+                const double volume =
+                    (std::pow((x + 1) * rStep, 3) - std::pow(x * rStep, 3)) / 3.0 *
+                    (std::cos(y * thetaStep) - std::cos((y + 1) * thetaStep)) *
+                    phiStep;
+                nObjects += density[x + (y + z * dims.y) * dims.x] * volume;
+            }
+        }
+    }
+    CHECK(nObjects == Catch::Approx(1.0));
+}
+
+#endif // OPENSPACE_MODULE_SPACE_ENABLED
@@ -0,0 +1,166 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_TOUCH_ENABLED
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <modules/touch/include/directinputsolver.h>
+#include <cmath>
+
+using namespace openspace;
+
+namespace {
+    constexpr double Radius = 6.4e6;
+    constexpr double FieldOfView = 0.8;
+    constexpr double AspectRatio = 16.0 / 9.0;
+    constexpr int NFrames = 60;
+
+    // A camera at three radii from the node, looking at its center
+    DirectInputSolver::CameraState cameraState() {
+        DirectInputSolver::CameraState state;
+        state.position = glm::dvec3(0.0, 0.0, 3.0 * Radius);
+        state.projection = glm::perspective(FieldOfView, AspectRatio, 1.0, 1e10);
+        return state;
+    }
+
+    // Returns the point on the node that is seen at the normalized device coordinates
+    glm::dvec3 surfacePoint(const DirectInputSolver::CameraState& state, glm::dvec2 ndc) {
+        const double t = std::tan(FieldOfView / 2.0);
+        const glm::dvec3 dir = glm::normalize(
+            glm::dvec3(ndc.x * t * AspectRatio, ndc.y * t, -1.0)
+        );
+        // Ray-sphere intersection with the sphere at the origin
+        const double b = glm::dot(state.position, dir);
+        const double c = glm::dot(state.position, state.position) - Radius * Radius;
+        const double dist = -b - std::sqrt(b * b - c);
+        return state.position + dist * dir;
+    }
+
+    // The fingers touch down at these positions and move along a track that drags,
+    // pinches, and rotates them around their center over the frames
+    std::vector<glm::dvec2> fingerPositions(int nFingers, int frame) {
+        const std::array<glm::dvec2, 3> TouchDown = {
+            glm::dvec2(0.1, 0.05),
+            glm::dvec2(-0.15, 0.1),
+            glm::dvec2(0.0, -0.2)
+        };
+        const double s = static_cast<double>(frame) / NFrames;
+
+        glm::dvec2 center = glm::dvec2(0.0);
+        for (int i = 0; i < nFingers; i++) {
+            center += TouchDown[i] / static_cast<double>(nFingers);
+        }
+
+        const glm::dvec2 drag = glm::dvec2(0.1, -0.05) * s;
+        const double angle = nFingers > 1 ? 0.2 * s : 0.0;
+        const double spread = nFingers > 1 ? 1.0 + 0.1 * s : 1.0;
+
+        std::vector<glm::dvec2> res;
+        for (int i = 0; i < nFingers; i++) {
+            const glm::dvec2 d = (TouchDown[i] - center) * spread;
+            res.push_back(center + drag + glm::dvec2(
+                d.x * std::cos(angle) - d.y * std::sin(angle),
+                d.x * std::sin(angle) + d.y * std::cos(angle)
+            ));
+        }
+        return res;
+    }
+
+    // Solves all frames of a finger track and returns the number of solves for which the
+    // fingers end up within a fraction of a pixel of the surface points
+    int solveTrack(DirectInputSolver& solver, int nFingers, int* nIterations = nullptr) {
+        const DirectInputSolver::CameraState state = cameraState();
+        std::vector<glm::dvec3> surfacePoints;
+        for (const glm::dvec2& p : fingerPositions(nFingers, 0)) {
+            surfacePoints.push_back(surfacePoint(state, p));
+        }
+
+        solver.resetWarmStart();
+        int nSuccesses = 0;
+        for (int frame = 0; frame < NFrames; frame++) {
+            std::vector<double> par(6, 0.0);
+            const bool success = solver.solve(
+                state,
+                surfacePoints,
+                fingerPositions(nFingers, frame),
+                &par
+            );
+            if (success && solver.levMarqStat().final_err < 1e-7) {
+                nSuccesses++;
+            }
+            if (nIterations) {
+                *nIterations += solver.levMarqStat().final_it;
+            }
+        }
+        return nSuccesses;
+    }
+} // namespace
+
+TEST_CASE("DirectInputSolver: Convergence", "[directinputsolver]") {
+    DirectInputSolver solver;
+    for (int nFingers = 1; nFingers <= 3; nFingers++) {
+        int nIterations = 0;
+        CHECK(solveTrack(solver, nFingers, &nIterations) == NFrames);
+        CHECK(solver.nDof() == 2 * nFingers);
+        // Starting from the previous frame's solution only needs a few iterations
+        CHECK(nIterations < 5 * NFrames);
+    }
+}
+
+TEST_CASE("DirectInputSolver: Touch Down", "[directinputsolver]") {
+    // Without any finger movement, the identity transformation is the solution
+    const DirectInputSolver::CameraState state = cameraState();
+    const std::vector<glm::dvec2> screenPoints = fingerPositions(2, 0);
+    const std::vector<glm::dvec3> surfacePoints = {
+        surfacePoint(state, screenPoints[0]),
+        surfacePoint(state, screenPoints[1])
+    };
+
+    DirectInputSolver solver;
+    std::vector<double> par(6, 0.0);
+    REQUIRE(solver.solve(state, surfacePoints, screenPoints, &par));
+    for (int i = 0; i < 4; i++) {
+        CHECK(std::abs(par[i]) < 1e-9);
+    }
+}
+
+TEST_CASE("DirectInputSolver: Benchmark", "[.benchmark][directinputsolver]") {
+    DirectInputSolver solver;
+
+    BENCHMARK("1 finger") {
+        return solveTrack(solver, 1);
+    };
+
+    BENCHMARK("2 fingers") {
+        return solveTrack(solver, 2);
+    };
+
+    BENCHMARK("3 fingers") {
+        return solveTrack(solver, 3);
+    };
+}
+
+#endif // OPENSPACE_MODULE_TOUCH_ENABLED
@@ -0,0 +1,319 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/ephemeristimeconverter.h>
+#include <openspace/util/spicemanager.h>
+#include <ghoul/fmt.h>
+#include <ghoul/filesystem/filesystem.h>
+#include <ghoul/misc/exception.h>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "SpiceUsr.h"
+#include "SpiceZpr.h"
+
+using namespace openspace;
+
+namespace {
+    std::string leapSecondsKernel() {
+        std::ifstream file(absPath("${TESTDIR}/horizonsTest/naif0012.tls"));
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        return buffer.str();
+    }
+} // namespace
+
+TEST_CASE("EphemerisTimeConverter: J2000", "[ephemeristimeconverter]") {
+    const EphemerisTimeConverter converter;
+
+    const std::optional<double> et =
+        converter.ephemerisTimeFromDate("2000-01-01T12:00:00.000");
+    REQUIRE(et.has_value());
+    CHECK(*et == Catch::Approx(64.183927284731).epsilon(1e-12));
+
+    CHECK(
+        converter.ephemerisTimeFromUtc(2000, 1, 43200.0) ==
+        Catch::Approx(*et).epsilon(1e-12)
+    );
+    CHECK(
+        converter.ephemerisTimeFromUtc(2000, 1, 1, 43200.0) ==
+        Catch::Approx(*et).epsilon(1e-12)
+    );
+    CHECK(converter.ephemerisTimeFromDate("2000-01-01T12:00:00 TDB") == 0.0);
+}
+
+TEST_CASE("EphemerisTimeConverter: Date Forms", "[ephemeristimeconverter]") {
+    const EphemerisTimeConverter converter;
+
+    const std::optional<double> reference =
+        converter.ephemerisTimeFromDate("2021-03-04T05:06:07.5");
+    REQUIRE(reference.has_value());
+
+    constexpr std::array<std::string_view, 8> Equivalent = {
+        "2021-03-04 05:06:07.5",
+        "2021-063T05:06:07.5",
+        "2021 MAR 04 05:06:07.5",
+        "2021-mar-4 05:06:07.5",
+        "2021 March 04T05:06:07.500Z",
+        "  2021-03-04T05:06:07.5 UTC  ",
+        "2021-03-04T05:06:07.5utc",
+        "2021-MARCH-04 05:06:07.5"
+    };
+    for (std::string_view date : Equivalent) {
+        INFO(date);
+        const std::optional<double> et = converter.ephemerisTimeFromDate(date);
+        REQUIRE(et.has_value());
+        CHECK(*et == *reference);
+    }
+
+    CHECK(
+        converter.ephemerisTimeFromDate("2021-03-04") ==
+        converter.ephemerisTimeFromDate("2021-03-04T00:00:00")
+    );
+    CHECK(
+        converter.ephemerisTimeFromDate("2021-03-04T05") ==
+        converter.ephemerisTimeFromDate("2021-03-04T05:00:00")
+    );
+    CHECK(
+        converter.ephemerisTimeFromDate("2021-03-04T05:06") ==
+        converter.ephemerisTimeFromDate("2021-03-04T05:06:00")
+    );
+
+    constexpr std::array<std::string_view, 14> Invalid = {
+        "",
+        "2021",
+        "2021-02-29",
+        "2020-367",
+        "2021-13-01",
+        "2021-01-01T24:00:00",
+        "2021-01-01T12:60:00",
+        "2021-01-01T12:00:60",
+        "2021-01-01T12:00:00 PST",
+        "2021-01-01T12:00:00 garbage",
+        "1582-10-15",
+        "JD 2451545.0",
+        "21-01-01",
+        "2021-JUNUARY-01"
+    };
+    for (std::string_view date : Invalid) {
+        INFO(date);
+        CHECK_FALSE(converter.ephemerisTimeFromDate(date).has_value());
+    }
+}
+
+TEST_CASE("EphemerisTimeConverter: Leap Seconds", "[ephemeristimeconverter]") {
+    const EphemerisTimeConverter converter;
+
+    const std::optional<double> before =
+        converter.ephemerisTimeFromDate("2016-12-31T23:59:59");
+    const std::optional<double> leap =
+        converter.ephemerisTimeFromDate("2016-12-31T23:59:60");
+    const std::optional<double> after =
+        converter.ephemerisTimeFromDate("2017-01-01T00:00:00");
+    REQUIRE(before.has_value());
+    REQUIRE(leap.has_value());
+    REQUIRE(after.has_value());
+    CHECK(*leap - *before == Catch::Approx(1.0));
+    CHECK(*after - *leap == Catch::Approx(1.0));
+
+    CHECK(
+        converter.dateFromEphemerisTime(*leap + 0.5, "YYYY-MM-DDTHR:MN:SC.###") ==
+        "2016-12-31T23:59:60.500"
+    );
+    CHECK(
+        converter.dateFromEphemerisTime(*after, "YYYY-MM-DDTHR:MN:SC.###") ==
+        "2017-01-01T00:00:00.000"
+    );
+
+    // A 60th second is only valid at the end of a day with a leap second
+    CHECK_FALSE(converter.ephemerisTimeFromDate("2017-12-31T23:59:60").has_value());
+}
+
+TEST_CASE("EphemerisTimeConverter: Formatting", "[ephemeristimeconverter]") {
+    const EphemerisTimeConverter converter;
+
+    const std::optional<double> et =
+        converter.ephemerisTimeFromDate("2021-03-04T05:06:07.6789");
+    REQUIRE(et.has_value());
+
+    CHECK(
+        converter.dateFromEphemerisTime(*et, "YYYY-MM-DDTHR:MN:SC.###") ==
+        "2021-03-04T05:06:07.678"
+    );
+    CHECK(
+        converter.dateFromEphemerisTime(*et, "YYYY-MM-DDTHR:MN:SC.### ::RND") ==
+        "2021-03-04T05:06:07.679"
+    );
+    CHECK(
+        converter.dateFromEphemerisTime(*et, "YYYY MON DD HR:MN:SC") ==
+        "2021 MAR 04 05:06:07"
+    );
+    CHECK(
+        converter.dateFromEphemerisTime(*et, "Month DD, YYYY (DOY) ::UTC") ==
+        "March 04, 2021 (063)"
+    );
+    CHECK(converter.dateFromEphemerisTime(*et, "mon HR:MN ::RND") == "mar 05:06");
+    CHECK(converter.dateFromEphemerisTime(*et, "YYYY-MM-DD") == "2021-03-04");
+
+    // Rounding carries over into the next day
+    const std::optional<double> late =
+        converter.ephemerisTimeFromDate("2021-12-31T23:59:59.9");
+    REQUIRE(late.has_value());
+    CHECK(
+        converter.dateFromEphemerisTime(*late, "YYYY-MM-DD HR:MN:SC ::RND") ==
+        "2022-01-01 00:00:00"
+    );
+
+    CHECK(converter.dateFromEphemerisTime(0.0, "YYYY-MM-DD HR:MN:SC ::TDB") ==
+        "2000-01-01 12:00:00"
+    );
+
+    constexpr std::array<std::string_view, 6> Unsupported = {
+        "YYYY-MM-DD HR:MN:SC AMPM",
+        "JULIAND.#####",
+        "Weekday YYYY",
+        "YR-MM-DD",
+        "YYYY-MM-DD ::UTC+1",
+        "YYYY-MM-DD HR:MN:SC.##########"
+    };
+    for (std::string_view format : Unsupported) {
+        INFO(format);
+        CHECK_FALSE(converter.dateFromEphemerisTime(*et, format).has_value());
+    }
+
+    std::array<char, 8> buffer;
+    CHECK_FALSE(
+        converter.dateFromEphemerisTime(*et, "YYYY-MM-DD", buffer.data(), 8).has_value()
+    );
+    CHECK(converter.dateFromEphemerisTime(*et, "YYYY", buffer.data(), 8) == 4);
+    CHECK(std::string_view(buffer.data()) == "2021");
+}
+
+TEST_CASE("EphemerisTimeConverter: Leap Seconds Kernel", "[ephemeristimeconverter]") {
+    const EphemerisTimeConverter defaultConverter;
+    const EphemerisTimeConverter converter =
+        EphemerisTimeConverter::createFromLeapSecondsKernel(leapSecondsKernel());
+
+    for (double et = -1e9; et < 1e9; et += 1234567.891) {
+        const std::optional<std::string> date =
+            converter.dateFromEphemerisTime(et, "YYYY-MM-DDTHR:MN:SC.######");
+        REQUIRE(date.has_value());
+        CHECK(defaultConverter.dateFromEphemerisTime(et, "YYYY-MM-DDTHR:MN:SC.######") ==
+            date
+        );
+    }
+
+    CHECK_THROWS_AS(
+        EphemerisTimeConverter::createFromLeapSecondsKernel("\\begindata\n"),
+        ghoul::RuntimeError
+    );
+}
+
+TEST_CASE("EphemerisTimeConverter: Compare With SPICE", "[ephemeristimeconverter]") {
+    SpiceManager::initialize();
+    SpiceManager::ref().loadKernel(
+        absPath("${TESTDIR}/horizonsTest/naif0012.tls").string()
+    );
+    const EphemerisTimeConverter converter =
+        EphemerisTimeConverter::createFromLeapSecondsKernel(leapSecondsKernel());
+
+    constexpr std::string_view Format = "YYYY-MM-DDTHR:MN:SC.######";
+    std::array<char, 64> spiceBuffer;
+    std::array<char, 64> buffer;
+    // Covers all leap seconds in steps that are not a multiple of a second or a day
+    for (double et = -9e8; et < 8e8; et += 86400.0 * 3.141592653) {
+        const std::optional<int> length = converter.dateFromEphemerisTime(
+            et,
+            Format,
+            buffer.data(),
+            static_cast<int>(buffer.size())
+        );
+        REQUIRE(length.has_value());
+        timout_c(
+            et,
+            std::string(Format).c_str(),
+            static_cast<SpiceInt>(spiceBuffer.size()),
+            spiceBuffer.data()
+        );
+        CHECK(std::string_view(buffer.data()) == std::string_view(spiceBuffer.data()));
+
+        double spiceEt = 0.0;
+        str2et_c(buffer.data(), &spiceEt);
+        const std::optional<double> parsed = converter.ephemerisTimeFromDate(
+            std::string_view(buffer.data(), *length)
+        );
+        REQUIRE(parsed.has_value());
+        CHECK(*parsed == Catch::Approx(spiceEt).margin(1e-6));
+    }
+
+    // The leap seconds themselves, which are only accepted at the end of their days
+    int nLeapSeconds = 0;
+    for (int year = 1972; year < 2017; year++) {
+        for (std::string_view month : { "JUN 30", "DEC 31" }) {
+            const std::string date = fmt::format("{} {} 23:59:60.25", year, month);
+            const std::optional<double> et = converter.ephemerisTimeFromDate(date);
+            if (!et.has_value()) {
+                continue;
+            }
+            nLeapSeconds++;
+            double spiceEt = 0.0;
+            str2et_c(date.c_str(), &spiceEt);
+            CHECK(*et == Catch::Approx(spiceEt).margin(1e-6));
+        }
+    }
+    CHECK(nLeapSeconds == 27);
+
+    SpiceManager::deinitialize();
+}
+
+TEST_CASE("EphemerisTimeConverter: Threads", "[ephemeristimeconverter]") {
+    const EphemerisTimeConverter& converter = EphemerisTimeConverter::ref();
+
+    constexpr int NThreads = 8;
+    std::array<bool, NThreads> success;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < NThreads; i++) {
+        threads.emplace_back([&converter, &success, i]() {
+            success[i] = true;
+            for (int j = 0; j < 10000; j++) {
+                const double et = (i * 10000 + j) * 1000.123;
+                const std::optional<std::string> date =
+                    converter.dateFromEphemerisTime(et, "YYYY-MM-DDTHR:MN:SC.###");
+                const std::optional<double> parsed =
+                    converter.ephemerisTimeFromDate(date.value_or(""));
+                success[i] &= parsed.has_value() && std::abs(*parsed - et) < 1e-3;
+            }
+        });
+    }
+    for (std::thread& t : threads) {
+        t.join();
+    }
+    for (bool s : success) {
+        CHECK(s);
+    }
+}
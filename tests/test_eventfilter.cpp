@@ -0,0 +1,92 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/events/event.h>
+#include <ghoul/misc/dictionary.h>
+#include <string>
+
+using namespace openspace::events;
+
+TEST_CASE("EventFilter: Parameters", "[eventfilter]") {
+    // Every event has to pass a filter that consists of all of its own parameters
+    const CustomEvent custom = CustomEvent("subtype", "payload");
+    CHECK(EventFilter(custom.type, toParameter(custom)).matches(custom));
+
+    const EventPointSpacecraft point = EventPointSpacecraft(1.0, 2.0, 3.0);
+    CHECK(EventFilter(point.type, toParameter(point)).matches(point));
+
+    const EventParallelConnection connection = EventParallelConnection(
+        EventParallelConnection::State::HostshipGained
+    );
+    CHECK(EventFilter(connection.type, toParameter(connection)).matches(connection));
+
+    const EventSessionRecordingPlayback playback = EventSessionRecordingPlayback(
+        EventSessionRecordingPlayback::State::Paused
+    );
+    CHECK(EventFilter(playback.type, toParameter(playback)).matches(playback));
+}
+
+TEST_CASE("EventFilter: Values", "[eventfilter]") {
+    const CustomEvent e = CustomEvent("subtype", "payload");
+
+    SECTION("Empty") {
+        CHECK(EventFilter(e.type, ghoul::Dictionary()).matches(e));
+    }
+
+    SECTION("Subset") {
+        ghoul::Dictionary filter;
+        filter.setValue("Subtype", std::string("subtype"));
+        CHECK(EventFilter(e.type, filter).matches(e));
+    }
+
+    SECTION("Different value") {
+        ghoul::Dictionary filter;
+        filter.setValue("Subtype", std::string("subtype"));
+        filter.setValue("Payload", std::string("other"));
+        CHECK_FALSE(EventFilter(e.type, filter).matches(e));
+    }
+
+    SECTION("Unknown key") {
+        ghoul::Dictionary filter;
+        filter.setValue("Node", std::string("subtype"));
+        CHECK_FALSE(EventFilter(e.type, filter).matches(e));
+    }
+
+    SECTION("Wrong type") {
+        ghoul::Dictionary filter;
+        filter.setValue("Subtype", 1.0);
+        CHECK_FALSE(EventFilter(e.type, filter).matches(e));
+    }
+
+    SECTION("Number") {
+        const EventPointSpacecraft point = EventPointSpacecraft(1.0, 2.0, 3.0);
+        ghoul::Dictionary filter;
+        filter.setValue("Dec", 2.0);
+        CHECK(EventFilter(point.type, filter).matches(point));
+        filter.setValue("Ra", 2.0);
+        CHECK_FALSE(EventFilter(point.type, filter).matches(point));
+    }
+}
@@ -0,0 +1,183 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_EXOPLANETS_ENABLED
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <modules/exoplanets/exoplanetsarchive.h>
+#include <ghoul/misc/exception.h>
+#include <filesystem>
+#include <fstream>
+
+using namespace openspace::exoplanets;
+
+namespace {
+    const std::vector<std::pair<std::string, uint64_t>> Planets = {
+        { "Kepler-90 b", 4 },
+        { "HD 10180 c", 100 },
+        { "Kepler-90 c", 200 },
+        { "Kepler-11 b", 300 },
+        { "HD 10180 d", 400 }
+    };
+} // namespace
+
+TEST_CASE("ExoplanetsIndex: Lookup", "[exoplanetsarchive]") {
+    const std::vector<std::byte> data = ExoplanetsIndex::create(Planets, 500, { 10, 20 });
+    const ExoplanetsIndex index(data);
+    CHECK(index.dataFileSize() == 500);
+    CHECK(index.lookUpTable().size == 10);
+    CHECK(index.lookUpTable().hash == 20);
+
+    const std::vector<ExoplanetsIndex::Planet> kepler90 = index.planets("Kepler-90");
+    REQUIRE(kepler90.size() == 2);
+    CHECK(kepler90[0].name == "Kepler-90 b");
+    CHECK(kepler90[0].dataOffset == 4);
+    CHECK(kepler90[1].name == "Kepler-90 c");
+    CHECK(kepler90[1].dataOffset == 200);
+
+    CHECK(index.planets("HD 10180").size() == 2);
+    CHECK(index.planets("Kepler-9").empty());
+    CHECK(index.planets("").empty());
+}
+
+TEST_CASE("ExoplanetsIndex: Prefix Search", "[exoplanetsarchive]") {
+    const std::vector<std::byte> data = ExoplanetsIndex::create(Planets, 500, { 10, 20 });
+    const ExoplanetsIndex index(data);
+
+    const std::vector<std::string_view> all = index.hostStars();
+    REQUIRE(all.size() == 3);
+    CHECK(all[0] == "HD 10180");
+    CHECK(all[1] == "Kepler-11");
+    CHECK(all[2] == "Kepler-90");
+
+    const std::vector<std::string_view> kepler = index.hostStars("Kepler");
+    REQUIRE(kepler.size() == 2);
+    CHECK(kepler[0] == "Kepler-11");
+    CHECK(kepler[1] == "Kepler-90");
+
+    CHECK(index.hostStars("WASP").empty());
+}
+
+TEST_CASE("ExoplanetsIndex: Corrupted", "[exoplanetsarchive]") {
+    std::vector<std::byte> data = ExoplanetsIndex::create(Planets, 500, { 10, 20 });
+    data.pop_back();
+    CHECK_THROWS_AS(ExoplanetsIndex(data), ghoul::RuntimeError);
+    data[0] = std::byte(0);
+    CHECK_THROWS_AS(ExoplanetsIndex(data), ghoul::RuntimeError);
+}
+
+TEST_CASE("ExoplanetsArchive: Look-up Table Fallback", "[exoplanetsarchive]") {
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "test_exoplanetsarchive";
+    std::filesystem::create_directories(dir);
+
+    // A data file with the version number and two planets, of which only the first one
+    // has sufficient data
+    {
+        std::ofstream data(dir / "exoplanets_data.bin", std::ios::binary);
+        const int version = 1;
+        data.write(reinterpret_cast<const char*>(&version), sizeof(int));
+
+        ExoplanetDataEntry p;
+        p.a = 1.f;
+        p.per = 365.f;
+        p.positionX = 1.f;
+        p.positionY = 2.f;
+        p.positionZ = 3.f;
+        data.write(reinterpret_cast<const char*>(&p), sizeof(ExoplanetDataEntry));
+        ExoplanetDataEntry q;
+        data.write(reinterpret_cast<const char*>(&q), sizeof(ExoplanetDataEntry));
+
+        std::ofstream lut(dir / "lookup.txt");
+        lut << "Star A b," << sizeof(int) << '\n';
+        lut << "Star B b," << sizeof(int) + sizeof(ExoplanetDataEntry) << '\n';
+    }
+    std::filesystem::remove(dir / "lookup.idx");
+
+    const ExoplanetsArchive archive(
+        dir / "exoplanets_data.bin",
+        dir / "lookup.txt",
+        dir / "lookup.idx"
+    );
+
+    const ExoplanetSystem a = archive.system("Star A");
+    REQUIRE(a.planetsData.size() == 1);
+    CHECK(a.planetNames[0] == "Star A b");
+    CHECK(a.planetsData[0].per == 365.f);
+    CHECK(a.starData.position == glm::vec3(1.f, 2.f, 3.f));
+
+    CHECK(archive.system("Star B").planetsData.empty());
+    CHECK(archive.system("Star C").planetsData.empty());
+
+    const std::vector<std::string> names = archive.hostStarsWithSufficientData();
+    REQUIRE(names.size() == 1);
+    CHECK(names[0] == "Star A");
+
+    const std::vector<ExoplanetSystem> systems =
+        archive.systems({ "Star B", "Star A" });
+    REQUIRE(systems.size() == 2);
+    CHECK(systems[0].planetsData.empty());
+    CHECK(systems[1].planetsData.size() == 1);
+
+    // An up-to-date index file is used instead of the look-up table
+    {
+        const std::vector<std::byte> index = ExoplanetsIndex::create(
+            { { "Star B b", sizeof(int) } },
+            std::filesystem::file_size(dir / "exoplanets_data.bin"),
+            ExoplanetsIndex::lookUpTableInfo(dir / "lookup.txt")
+        );
+        std::ofstream file(dir / "lookup.idx", std::ios::binary);
+        file.write(reinterpret_cast<const char*>(index.data()), index.size());
+    }
+    {
+        const ExoplanetsArchive indexed(
+            dir / "exoplanets_data.bin",
+            dir / "lookup.txt",
+            dir / "lookup.idx"
+        );
+        CHECK(indexed.system("Star A").planetsData.empty());
+        CHECK(indexed.system("Star B").planetsData.size() == 1);
+    }
+
+    // An index file that was created for a different look-up table is ignored, even if
+    // the data file did not change
+    {
+        std::ofstream lut(dir / "lookup.txt");
+        lut << "Star A b," << sizeof(int) << '\n';
+    }
+    {
+        const ExoplanetsArchive stale(
+            dir / "exoplanets_data.bin",
+            dir / "lookup.txt",
+            dir / "lookup.idx"
+        );
+        CHECK(stale.system("Star A").planetsData.size() == 1);
+        CHECK(stale.system("Star B").planetsData.empty());
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+#endif // OPENSPACE_MODULE_EXOPLANETS_ENABLED
@@ -0,0 +1,159 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/framearena.h>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST_CASE("FrameArena: Alignment", "[framearena]") {
+    openspace::FrameArena arena(1024);
+
+    for (size_t alignment : { 1, 2, 4, 8, 16, 32, 64, 128 }) {
+        void* ptr = arena.allocate(3, alignment);
+        CHECK(reinterpret_cast<uintptr_t>(ptr) % alignment == 0);
+    }
+}
+
+TEST_CASE("FrameArena: Allocations Do Not Overlap", "[framearena]") {
+    openspace::FrameArena arena(1024);
+
+    std::vector<std::byte*> ptrs;
+    for (int i = 0; i < 100; ++i) {
+        std::byte* ptr = static_cast<std::byte*>(arena.allocate(32, 8));
+        std::memset(ptr, i, 32);
+        ptrs.push_back(ptr);
+    }
+    for (int i = 0; i < 100; ++i) {
+        for (int j = 0; j < 32; ++j) {
+            CHECK(ptrs[i][j] == std::byte(i));
+        }
+    }
+}
+
+TEST_CASE("FrameArena: Statistics", "[framearena]") {
+    openspace::FrameArena arena(1024);
+
+    CHECK(arena.allocate(100));
+    CHECK(arena.allocate(200));
+    // Too large for a regular block
+    CHECK(arena.allocate(2000));
+    arena.reset();
+
+    openspace::FrameArena::FrameStatistics frame = arena.lastFrame();
+    CHECK(frame.usedBytes == 2300);
+    CHECK(frame.overflowBytes == 2000);
+    CHECK(frame.nHeapAllocations == 2);
+    CHECK(arena.highWaterMark() == 2300);
+
+    CHECK(arena.allocate(50));
+    arena.reset();
+
+    frame = arena.lastFrame();
+    CHECK(frame.usedBytes == 50);
+    CHECK(frame.overflowBytes == 0);
+    CHECK(arena.highWaterMark() == 2300);
+}
+
+TEST_CASE("FrameArena: Steady State Reuses Memory", "[framearena]") {
+    openspace::FrameArena arena(1024);
+
+    auto frame = [&arena]() {
+        for (int i = 0; i < 50; ++i) {
+            CHECK(arena.allocate(100));
+        }
+        CHECK(arena.allocate(5000));
+        arena.reset();
+    };
+
+    frame();
+    CHECK(arena.lastFrame().nHeapAllocations > 0);
+    const size_t capacity = arena.capacity();
+
+    for (int i = 0; i < 10; ++i) {
+        frame();
+        CHECK(arena.lastFrame().nHeapAllocations == 0);
+        CHECK(arena.capacity() == capacity);
+    }
+}
+
+TEST_CASE("FrameArena: Unused Overflow Blocks Are Released", "[framearena]") {
+    openspace::FrameArena arena(1024);
+
+    CHECK(arena.allocate(10000));
+    arena.reset();
+    CHECK(arena.capacity() >= 10000);
+
+    // The overflow block was used in the last frame, but not in this one
+    arena.reset();
+    CHECK(arena.capacity() == 0);
+}
+
+TEST_CASE("FrameArena: PMR Container", "[framearena]") {
+    openspace::FrameArena arena(1024);
+
+    std::pmr::vector<int> values(&arena);
+    for (int i = 0; i < 1000; ++i) {
+        values.push_back(i);
+    }
+    CHECK(std::accumulate(values.begin(), values.end(), 0) == 499500);
+}
+
+TEST_CASE("FrameArena: Multiple Threads", "[framearena]") {
+    openspace::FrameArena arena(4096);
+
+    constexpr int NThreads = 8;
+    constexpr int NAllocations = 1000;
+
+    for (int frame = 0; frame < 3; ++frame) {
+        std::vector<std::vector<int*>> results(NThreads);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NThreads; ++t) {
+            threads.emplace_back([&arena, &results, t]() {
+                for (int i = 0; i < NAllocations; ++i) {
+                    void* memory = arena.allocate(sizeof(int), alignof(int));
+                    int* ptr = static_cast<int*>(memory);
+                    *ptr = t * NAllocations + i;
+                    results[t].push_back(ptr);
+                }
+            });
+        }
+        for (std::thread& t : threads) {
+            t.join();
+        }
+
+        for (int t = 0; t < NThreads; ++t) {
+            for (int i = 0; i < NAllocations; ++i) {
+                CHECK(*results[t][i] == t * NAllocations + i);
+            }
+        }
+
+        arena.reset();
+        CHECK(arena.lastFrame().usedBytes == NThreads * NAllocations * sizeof(int));
+    }
+}
@@ -0,0 +1,149 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <modules/globebrowsing/src/geojson/geometryfeaturejob.h>
+#include <modules/globebrowsing/src/geojson/globegeometryfeature.h>
+#include <modules/globebrowsing/src/renderableglobe.h>
+#include <openspace/json.h>
+#include <openspace/util/concurrentjobmanager.h>
+#include <ghoul/fmt.h>
+#include <ghoul/glm.h>
+#include <ghoul/misc/dictionary.h>
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace geos_nlohmann = nlohmann;
+#include <geos/geom/Geometry.h>
+#include <geos/io/GeoJSON.h>
+#include <geos/io/GeoJSONReader.h>
+
+namespace {
+    using namespace openspace;
+    using namespace openspace::globebrowsing;
+
+    constexpr int NumberOfFeatures = 2000;
+    constexpr int VerticesPerRing = 32;
+
+    // Creates a FeatureCollection of roughly circular polygons that are spread out over
+    // the globe, which is similar to a parcel- or country-level data set
+    std::string syntheticFeatureCollection() {
+        std::string features;
+        for (int i = 0; i < NumberOfFeatures; ++i) {
+            const double lat = -60.0 + 120.0 * (i % 50) / 50.0;
+            const double lon = -180.0 + 360.0 * (i / 50) / (NumberOfFeatures / 50.0);
+
+            std::string ring;
+            for (int v = 0; v <= VerticesPerRing; ++v) {
+                const double a = glm::two_pi<double>() * (v % VerticesPerRing) /
+                    VerticesPerRing;
+                ring += fmt::format(
+                    "{}[{},{}]",
+                    v == 0 ? "" : ",", lon + 0.5 * std::cos(a), lat + 0.5 * std::sin(a)
+                );
+            }
+
+            features += fmt::format(
+                R"({}{{"type":"Feature","properties":{{}},)"
+                R"("geometry":{{"type":"Polygon","coordinates":[[{}]]}}}})",
+                i == 0 ? "" : ",", ring
+            );
+        }
+        return fmt::format(R"({{"type":"FeatureCollection","features":[{}]}})", features);
+    }
+
+    std::unique_ptr<RenderableGlobe> createGlobe() {
+        ghoul::Dictionary dictionary;
+        dictionary.setValue("Type", std::string("RenderableGlobe"));
+        dictionary.setValue("Radii", 6378137.0);
+        dictionary.setValue("Layers", ghoul::Dictionary());
+        return std::make_unique<RenderableGlobe>(dictionary);
+    }
+} // namespace
+
+TEST_CASE("GeoJsonTessellation: Benchmark", "[.benchmark][geojsontessellation]") {
+    std::unique_ptr<RenderableGlobe> globe = createGlobe();
+
+    geos::io::GeoJSONReader reader;
+    const geos::io::GeoJSONFeatureCollection fc =
+        reader.readFeatures(syntheticFeatureCollection());
+
+    GeoJsonProperties defaultProperties;
+    GeoJsonOverrideProperties overrideProperties;
+
+    std::vector<GlobeGeometryFeature> features;
+    features.reserve(fc.getFeatures().size());
+    for (size_t i = 0; i < fc.getFeatures().size(); ++i) {
+        GlobeGeometryFeature f(*globe, defaultProperties, overrideProperties);
+        f.createFromSingleGeosGeometry(
+            fc.getFeatures()[i].getGeometry(),
+            static_cast<int>(i),
+            true
+        );
+        features.push_back(std::move(f));
+    }
+    REQUIRE(features.size() == NumberOfFeatures);
+
+    GlobeGeometryFeature::GeometrySettings settings;
+    settings.tessellationEnabled = true;
+    settings.tessellationStepSize = 5000.f;
+
+    BENCHMARK("Serial") {
+        size_t nRenderFeatures = 0;
+        for (const GlobeGeometryFeature& f : features) {
+            nRenderFeatures += f.createGeometry(settings).size();
+        }
+        return nRenderFeatures;
+    };
+
+    ConcurrentJobManager<GeometryFeatureResult> jobManager(
+        ThreadPool(std::max(std::thread::hardware_concurrency(), 1u))
+    );
+    BENCHMARK("Parallel") {
+        for (size_t i = 0; i < features.size(); ++i) {
+            jobManager.enqueueJob(
+                std::make_shared<GeometryFeatureJob>(features[i], i, 0, settings)
+            );
+        }
+
+        size_t nRenderFeatures = 0;
+        size_t nFinished = 0;
+        while (nFinished < features.size()) {
+            if (jobManager.numFinishedJobs() == 0) {
+                std::this_thread::yield();
+                continue;
+            }
+            GeometryFeatureResult result = jobManager.popFinishedJob()->product();
+            nRenderFeatures += result.renderFeatures.size();
+            nFinished++;
+        }
+        return nRenderFeatures;
+    };
+}
@@ -0,0 +1,130 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <openspace/util/histogram.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace openspace;
+
+namespace {
+    constexpr int NumBins = 512;
+
+    // Values in [-0.1, 1.1], so that some of them are outside of the histogram's range
+    std::vector<float> randomValues(size_t n) {
+        std::mt19937 rng(1337);
+        std::uniform_real_distribution<float> dist(-0.1f, 1.1f);
+        std::vector<float> values(n);
+        for (float& v : values) {
+            v = dist(rng);
+        }
+        return values;
+    }
+} // namespace
+
+TEST_CASE("Histogram: Bulk Add", "[histogram]") {
+    const std::vector<float> values = randomValues(100000);
+
+    Histogram single(0.f, 1.f, NumBins);
+    size_t nInRange = 0;
+    for (float v : values) {
+        nInRange += single.add(v) ? 1 : 0;
+    }
+
+    Histogram bulk(0.f, 1.f, NumBins);
+    CHECK(bulk.add(values) == nInRange);
+
+    Histogram parallel(0.f, 1.f, NumBins);
+    CHECK(parallel.addParallel(values, 4) == nInRange);
+
+    for (int i = 0; i < NumBins; i++) {
+        CHECK(bulk.sample(i) == single.sample(i));
+        CHECK(parallel.sample(i) == single.sample(i));
+    }
+}
+
+TEST_CASE("Histogram: Bulk Add Weighted", "[histogram]") {
+    const std::vector<float> values = randomValues(10000);
+    const std::vector<float> weights = randomValues(10000);
+
+    Histogram single(0.f, 1.f, NumBins);
+    for (size_t i = 0; i < values.size(); i++) {
+        single.add(values[i], weights[i]);
+    }
+
+    Histogram bulk(0.f, 1.f, NumBins);
+    bulk.add(values, weights);
+
+    for (int i = 0; i < NumBins; i++) {
+        CHECK(bulk.sample(i) == single.sample(i));
+    }
+}
+
+TEST_CASE("Histogram: Add Rectangles", "[histogram]") {
+    const std::vector<float> lows = randomValues(1000);
+    const std::vector<float> highs = randomValues(2000);
+    const std::vector<float> heights(lows.size(), 0.25f);
+    const std::span<const float> h = std::span(highs).subspan(1000);
+
+    Histogram single(0.f, 1.f, 64);
+    for (size_t i = 0; i < lows.size(); i++) {
+        single.addRectangle(lows[i], h[i], heights[i]);
+    }
+
+    Histogram bulk(0.f, 1.f, 64);
+    bulk.addRectangles(lows, h, heights);
+
+    for (int i = 0; i < 64; i++) {
+        CHECK_THAT(bulk.sample(i), Catch::Matchers::WithinAbs(single.sample(i), 1e-3));
+    }
+}
+
+TEST_CASE("Histogram: Benchmark", "[.benchmark][histogram]") {
+    const std::vector<float> values = randomValues(10000000);
+
+    BENCHMARK("Single") {
+        Histogram histogram(0.f, 1.f, NumBins);
+        for (float v : values) {
+            histogram.add(v);
+        }
+        return histogram.sample(0);
+    };
+
+    BENCHMARK("Bulk") {
+        Histogram histogram(0.f, 1.f, NumBins);
+        histogram.add(values);
+        return histogram.sample(0);
+    };
+
+    BENCHMARK("Parallel") {
+        Histogram histogram(0.f, 1.f, NumBins);
+        histogram.addParallel(values, std::thread::hardware_concurrency());
+        return histogram.sample(0);
+    };
+}
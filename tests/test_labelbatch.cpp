@@ -0,0 +1,293 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <openspace/data/dataloader.h>
+#include <openspace/rendering/labelbatch.h>
+#include <ghoul/glm.h>
+#include <random>
+#include <string>
+
+using namespace openspace;
+
+namespace {
+    constexpr float LineHeight = 14.f;
+
+    // A monospaced font where every character except for the space is a 10 x 12 glyph
+    // whose texture coordinates encode the character
+    std::optional<LabelBatch::Glyph> glyph(wchar_t c) {
+        if (c == L'#') {
+            return std::nullopt;
+        }
+
+        LabelBatch::Glyph g;
+        g.horizontalAdvance = 11.f;
+        if (c != L' ') {
+            g.width = 10.f;
+            g.height = 12.f;
+            g.leftBearing = 1.f;
+            g.topBearing = 12.f;
+            g.topLeft = glm::vec2(static_cast<float>(c), 0.f);
+            g.bottomRight = glm::vec2(static_cast<float>(c) + 1.f, 1.f);
+            g.outlineTopLeft = glm::vec2(static_cast<float>(c), 1.f);
+            g.outlineBottomRight = glm::vec2(static_cast<float>(c) + 1.f, 2.f);
+        }
+        return g;
+    }
+
+    dataloader::Labelset::Entry entry(glm::vec3 position, std::string text,
+                                      bool isEnabled = true)
+    {
+        dataloader::Labelset::Entry e;
+        e.position = position;
+        e.text = std::move(text);
+        e.isEnabled = isEnabled;
+        return e;
+    }
+
+    dataloader::Labelset createLabels(size_t n) {
+        std::mt19937 generator(1337);
+        std::normal_distribution<float> position(0.f, 100.f);
+        std::uniform_int_distribution<int> length(4, 24);
+        std::uniform_int_distribution<int> character('A', 'z');
+
+        dataloader::Labelset labelset;
+        labelset.entries.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            std::string text(length(generator), ' ');
+            for (char& c : text) {
+                c = static_cast<char>(character(generator));
+            }
+            labelset.entries.push_back(entry(
+                glm::vec3(position(generator), position(generator), position(generator)),
+                std::move(text)
+            ));
+        }
+        return labelset;
+    }
+
+    LabelBatch::CullSettings cameraSettings(const glm::dvec3& position) {
+        const glm::dvec3 up = glm::dvec3(0.0, 0.0, 1.0);
+        LabelBatch::CullSettings settings;
+        settings.modelViewProjection = glm::perspective(0.8, 16.0 / 9.0, 0.1, 1e6) *
+            glm::lookAt(position, glm::dvec3(0.0), up);
+        const glm::dvec3 forward = glm::normalize(-position);
+        const glm::dvec3 right = glm::normalize(glm::cross(forward, up));
+        settings.orthoRight = glm::vec3(right);
+        settings.orthoUp = glm::vec3(glm::cross(right, forward));
+        settings.cameraPosition = position;
+        settings.cameraLookUp = up;
+        settings.scale = 0.05f;
+        settings.minMaxSize = glm::vec2(2.f, 200.f);
+        settings.viewportSize = glm::vec2(1920.f, 1080.f);
+        return settings;
+    }
+} // namespace
+
+TEST_CASE("LabelBatch: Layout", "[labelbatch]") {
+    dataloader::Labelset labelset;
+    labelset.entries = {
+        entry(glm::vec3(1.f, 2.f, 3.f), "ab"),
+        entry(glm::vec3(0.f), "a b"),
+        entry(glm::vec3(0.f), "disabled", false),
+        entry(glm::vec3(0.f), ""),
+        entry(glm::vec3(0.f), "  "),
+        entry(glm::vec3(0.f), "a#\nb")
+    };
+
+    LabelBatch batch;
+    CHECK_FALSE(batch.hasLayout());
+    const glm::dmat4 transform = glm::translate(glm::dmat4(1.0), glm::dvec3(1.0));
+    batch.layout(labelset, transform, 2.0, LineHeight, glyph);
+    REQUIRE(batch.hasLayout());
+
+    // Disabled labels and labels without visible glyphs are skipped, as are spaces and
+    // characters without a glyph
+    CHECK(batch.nLabels() == 3);
+    CHECK(batch.nGlyphs() == 6);
+
+    // With an identity projection and a large viewport, every label is visible
+    LabelBatch::CullSettings settings;
+    settings.scale = 0.01f;
+    settings.viewportSize = glm::vec2(1000.f);
+    settings.minMaxSize = glm::vec2(0.f, 1000.f);
+    // Scale the label positions into the clipping volume
+    settings.modelViewProjection = glm::scale(glm::dmat4(1.0), glm::dvec3(0.01));
+    settings.modelViewProjection[3][3] = 1.0;
+    REQUIRE(batch.cull(settings, 1) == 3);
+    CHECK(batch.visibleLabels() == std::vector<unsigned int>{ 0, 1, 5 });
+
+    const std::vector<LabelBatch::Vertex>& v = batch.vertices();
+    REQUIRE(v.size() == 4 * 6);
+
+    // The first glyph of the first label starts at the transformed and scaled position,
+    // offset by the left and top bearing
+    const glm::vec3 position = glm::vec3(4.f, 6.f, 8.f);
+    CHECK(glm::all(glm::epsilonEqual(
+        v[0].position,
+        position + glm::vec3(0.01f, 0.12f, 0.f),
+        1e-5f
+    )));
+    CHECK(glm::all(glm::epsilonEqual(
+        v[2].position,
+        position + glm::vec3(0.11f, 0.f, 0.f),
+        1e-5f
+    )));
+    CHECK(v[0].texCoords == glm::vec2(float(L'a'), 0.f));
+    CHECK(v[2].texCoords == glm::vec2(float(L'a') + 1.f, 1.f));
+    CHECK(v[2].outlineTexCoords == glm::vec2(float(L'a') + 1.f, 2.f));
+
+    // The second glyph of the first label is advanced by one character
+    CHECK(v[4].position.x == Catch::Approx(v[0].position.x + 11.f * settings.scale));
+    CHECK(v[4].texCoords.x == float(L'b'));
+
+    // The space in the second label advances the pen without creating a quad
+    CHECK(
+        v[12].position.x - v[8].position.x ==
+        Catch::Approx(2 * 11.f * settings.scale)
+    );
+
+    // The second line of the last label is moved down by the line height
+    CHECK(v[20].position.x == v[16].position.x);
+    CHECK(
+        v[20].position.y ==
+        Catch::Approx(v[16].position.y - LineHeight * settings.scale)
+    );
+
+    batch.invalidate();
+    CHECK_FALSE(batch.hasLayout());
+}
+
+TEST_CASE("LabelBatch: Kerning", "[labelbatch]") {
+    dataloader::Labelset labelset;
+    labelset.entries = { entry(glm::vec3(0.f), "abc") };
+
+    LabelBatch batch;
+    batch.layout(
+        labelset,
+        glm::dmat4(1.0),
+        1.0,
+        LineHeight,
+        glyph,
+        [](wchar_t previous, wchar_t) { return previous == L'a' ? -2.f : 0.f; }
+    );
+
+    LabelBatch::CullSettings settings;
+    settings.modelViewProjection = glm::scale(glm::dmat4(1.0), glm::dvec3(0.01));
+    settings.modelViewProjection[3][3] = 1.0;
+    REQUIRE(batch.cull(settings) == 1);
+
+    const std::vector<LabelBatch::Vertex>& v = batch.vertices();
+    REQUIRE(v.size() == 12);
+    CHECK(v[4].position.x - v[0].position.x == 9.f);
+    CHECK(v[8].position.x - v[4].position.x == 11.f);
+}
+
+TEST_CASE("LabelBatch: Culling", "[labelbatch]") {
+    dataloader::Labelset labelset;
+    labelset.entries = {
+        // In front of the camera
+        entry(glm::vec3(0.f), "center"),
+        // Behind the camera
+        entry(glm::vec3(200.f, 0.f, 0.f), "behind"),
+        // Outside of the field of view
+        entry(glm::vec3(0.f, 500.f, 0.f), "outside"),
+        // So close to the camera that it is larger than the maximum size
+        entry(glm::vec3(99.f, 0.f, 0.f), "close"),
+        // So far from the camera that it is smaller than the minimum size
+        entry(glm::vec3(-50000.f, 0.f, 0.f), "far")
+    };
+
+    LabelBatch batch;
+    batch.layout(labelset, glm::dmat4(1.0), 1.0, LineHeight, glyph);
+
+    LabelBatch::CullSettings settings = cameraSettings(glm::dvec3(100.0, 0.0, 0.0));
+    REQUIRE(batch.cull(settings) == 1);
+    CHECK(batch.visibleLabels() == std::vector<unsigned int>{ 0 });
+    CHECK(batch.vertices().size() == 4 * 6);
+
+    // Without size limits, only the labels outside of the frustum are culled
+    settings.minMaxSize = glm::vec2(0.f, std::numeric_limits<float>::max());
+    REQUIRE(batch.cull(settings) == 3);
+    CHECK(batch.visibleLabels() == std::vector<unsigned int>{ 0, 3, 4 });
+
+    // The labels that face the camera position are culled in the same way
+    settings.orientation = LabelBatch::Orientation::PositionNormal;
+    REQUIRE(batch.cull(settings) == 3);
+    CHECK(batch.visibleLabels() == std::vector<unsigned int>{ 0, 3, 4 });
+}
+
+TEST_CASE("LabelBatch: Parallel culling", "[labelbatch]") {
+    const dataloader::Labelset labelset = createLabels(50000);
+    LabelBatch batch;
+    batch.layout(labelset, glm::dmat4(1.0), 1.0, LineHeight, glyph);
+    REQUIRE(batch.nLabels() == labelset.entries.size());
+
+    const glm::dvec3 camera = glm::dvec3(300.0, 50.0, 0.0);
+    const LabelBatch::CullSettings settings = cameraSettings(camera);
+    const size_t nVisible = batch.cull(settings, 1);
+    CHECK(nVisible > 0);
+    CHECK(nVisible < labelset.entries.size());
+    const std::vector<unsigned int> visible = batch.visibleLabels();
+    const std::vector<LabelBatch::Vertex> vertices = batch.vertices();
+
+    CHECK(batch.cull(settings, 4) == nVisible);
+    CHECK(batch.visibleLabels() == visible);
+    REQUIRE(batch.vertices().size() == vertices.size());
+    for (size_t i = 0; i < vertices.size(); i++) {
+        CHECK(batch.vertices()[i].position == vertices[i].position);
+    }
+}
+
+TEST_CASE("LabelBatch: Benchmark", "[.benchmark][labelbatch]") {
+    const dataloader::Labelset labelset = createLabels(100000);
+    const glm::dvec3 camera = glm::dvec3(300.0, 50.0, 0.0);
+    const LabelBatch::CullSettings settings = cameraSettings(camera);
+
+    BENCHMARK("Layout") {
+        LabelBatch batch;
+        batch.layout(labelset, glm::dmat4(1.0), 1.0, LineHeight, glyph);
+        return batch.nGlyphs();
+    };
+
+    LabelBatch batch;
+    batch.layout(labelset, glm::dmat4(1.0), 1.0, LineHeight, glyph);
+
+    BENCHMARK("Cull") {
+        return batch.cull(settings);
+    };
+
+    BENCHMARK("Cull single thread") {
+        return batch.cull(settings, 1);
+    };
+
+    LabelBatch::CullSettings normal = settings;
+    normal.orientation = LabelBatch::Orientation::PositionNormal;
+    BENCHMARK("Cull position normal") {
+        return batch.cull(normal);
+    };
+}
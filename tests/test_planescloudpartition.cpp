@@ -0,0 +1,232 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_DIGITALUNIVERSE_ENABLED
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <modules/digitaluniverse/rendering/planescloudpartition.h>
+#include <ghoul/glm.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace openspace;
+
+namespace {
+    constexpr unsigned int PlanesPerBatch = 32;
+    constexpr int NTextures = 12;
+    constexpr double FieldOfView = 0.8;
+    constexpr double ScreenHeight = 1080.0;
+
+    // Planes with random sizes and textures, similar to the galaxy images of the Tully
+    // dataset
+    std::vector<PlanesCloudPartition::Plane> createPlanes(size_t n) {
+        std::mt19937 generator(1337);
+        std::normal_distribution<float> position(0.f, 100.f);
+        std::uniform_real_distribution<float> radius(0.1f, 2.f);
+        std::uniform_int_distribution<int> texture(0, NTextures - 1);
+        std::vector<PlanesCloudPartition::Plane> planes(n);
+        for (PlanesCloudPartition::Plane& p : planes) {
+            p.center = glm::vec3(
+                position(generator),
+                position(generator),
+                position(generator)
+            );
+            p.radius = radius(generator);
+            p.textureIndex = texture(generator);
+        }
+        return planes;
+    }
+
+    glm::dmat4 viewProjection(const glm::dvec3& position, const glm::dvec3& target) {
+        return glm::perspective(FieldOfView, 16.0 / 9.0, 0.1, 1e6) *
+            glm::lookAt(position, target, glm::dvec3(0.0, 0.0, 1.0));
+    }
+
+    double pixelsPerRadian() {
+        return 0.5 * ScreenHeight / std::tan(0.5 * FieldOfView);
+    }
+
+    std::vector<bool> selectedPlanes(const PlanesCloudPartition::Selection& selection,
+                                     size_t nPlanes)
+    {
+        std::vector<bool> isSelected(nPlanes, false);
+        for (const PlanesCloudPartition::Range& range : selection.ranges) {
+            for (uint32_t i = range.firstPlane; i < range.firstPlane + range.nPlanes; i++)
+            {
+                isSelected[i] = true;
+            }
+        }
+        return isSelected;
+    }
+} // namespace
+
+TEST_CASE("PlanesCloudPartition: Structure", "[planescloudpartition]") {
+    const std::vector<PlanesCloudPartition::Plane> planes = createPlanes(10000);
+    const PlanesCloudPartition partition(planes, PlanesPerBatch);
+
+    // Every plane is stored exactly once
+    std::vector<uint32_t> order = partition.order();
+    std::sort(order.begin(), order.end());
+    std::vector<uint32_t> expected(planes.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(order == expected);
+
+    // The batches cover all planes in order, their planes are inside their bounding
+    // spheres, and their ranges cover the batch with one range per texture
+    uint32_t nextPlane = 0;
+    for (const PlanesCloudPartition::Batch& batch : partition.batches()) {
+        CHECK(batch.firstPlane == nextPlane);
+        CHECK(batch.nPlanes > 0);
+        CHECK(batch.nPlanes <= PlanesPerBatch);
+        nextPlane += batch.nPlanes;
+
+        for (uint32_t i = batch.firstPlane; i < batch.firstPlane + batch.nPlanes; i++) {
+            const PlanesCloudPartition::Plane& p = planes[partition.order()[i]];
+            const float d = glm::length(p.center - batch.center) + p.radius;
+            CHECK(d <= batch.radius * 1.0001f);
+            CHECK(p.radius <= batch.maxPlaneRadius);
+        }
+
+        uint32_t nextRangePlane = batch.firstPlane;
+        int previousTexture = -1;
+        for (uint32_t r = batch.firstRange; r < batch.firstRange + batch.nRanges; r++) {
+            const PlanesCloudPartition::Range& range = partition.ranges()[r];
+            CHECK(range.firstPlane == nextRangePlane);
+            CHECK(range.textureIndex > previousTexture);
+            previousTexture = range.textureIndex;
+            nextRangePlane += range.nPlanes;
+            for (uint32_t i = range.firstPlane; i < range.firstPlane + range.nPlanes; i++)
+            {
+                CHECK(planes[partition.order()[i]].textureIndex == range.textureIndex);
+            }
+        }
+        CHECK(nextRangePlane == batch.firstPlane + batch.nPlanes);
+    }
+    CHECK(nextPlane == planes.size());
+}
+
+TEST_CASE("PlanesCloudPartition: Selection", "[planescloudpartition]") {
+    const std::vector<PlanesCloudPartition::Plane> planes = createPlanes(10000);
+    const PlanesCloudPartition partition(planes, PlanesPerBatch);
+    const glm::dmat4 identity = glm::dmat4(1.0);
+    PlanesCloudPartition::Selection selection;
+
+    SECTION("Everything") {
+        const glm::dvec3 camera = glm::dvec3(2000.0, 0.0, 0.0);
+        partition.select(
+            identity,
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            0.0,
+            selection
+        );
+        CHECK(selection.nPlanes == planes.size());
+        CHECK(selection.batches.size() == partition.batches().size());
+
+        // The ranges are sorted by texture, and adjacent ranges have been merged
+        for (size_t i = 1; i < selection.ranges.size(); i++) {
+            const PlanesCloudPartition::Range& prev = selection.ranges[i - 1];
+            const PlanesCloudPartition::Range& curr = selection.ranges[i];
+            CHECK(prev.textureIndex <= curr.textureIndex);
+            if (prev.textureIndex == curr.textureIndex) {
+                CHECK(prev.firstPlane + prev.nPlanes < curr.firstPlane);
+            }
+        }
+    }
+
+    SECTION("Looking away") {
+        const glm::dvec3 camera = glm::dvec3(2000.0, 0.0, 0.0);
+        partition.select(
+            identity,
+            viewProjection(camera, glm::dvec3(3000.0, 0.0, 0.0)),
+            camera,
+            pixelsPerRadian(),
+            0.0,
+            selection
+        );
+        CHECK(selection.nPlanes == 0);
+        CHECK(selection.ranges.empty());
+    }
+
+    SECTION("Too small") {
+        // From far away all planes are smaller than a pixel
+        const glm::dvec3 camera = glm::dvec3(1e5, 0.0, 0.0);
+        partition.select(
+            identity,
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            1.0,
+            selection
+        );
+        CHECK(selection.nPlanes == 0);
+
+        partition.select(
+            identity,
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            0.0,
+            selection
+        );
+        CHECK(selection.nPlanes == planes.size());
+    }
+
+    SECTION("Inside") {
+        // All planes that are inside the view frustum and larger than the minimum size
+        // have to be selected
+        const glm::dvec3 camera = glm::dvec3(50.0, 20.0, 0.0);
+        const glm::dmat4 vp = viewProjection(camera, glm::dvec3(0.0));
+        constexpr double MinPixelSize = 4.0;
+        partition.select(
+            identity,
+            vp,
+            camera,
+            pixelsPerRadian(),
+            MinPixelSize,
+            selection
+        );
+        CHECK(selection.nPlanes < planes.size());
+
+        const std::vector<bool> isSelected = selectedPlanes(selection, planes.size());
+        for (size_t i = 0; i < planes.size(); i++) {
+            const PlanesCloudPartition::Plane& p = planes[partition.order()[i]];
+            const glm::dvec4 clip = vp * glm::dvec4(glm::dvec3(p.center), 1.0);
+            const bool isInside = std::abs(clip.x) < clip.w &&
+                std::abs(clip.y) < clip.w && std::abs(clip.z) < clip.w;
+            const double distance = glm::length(glm::dvec3(p.center) - camera);
+            const double size = 2.0 * p.radius / distance * pixelsPerRadian();
+            if (isInside && size >= MinPixelSize) {
+                CHECK(isSelected[i]);
+            }
+        }
+    }
+}
+
+#endif // OPENSPACE_MODULE_DIGITALUNIVERSE_ENABLED
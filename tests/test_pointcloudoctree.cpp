@@ -0,0 +1,246 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#ifdef OPENSPACE_MODULE_BASE_ENABLED
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <modules/base/rendering/pointcloud/pointcloudoctree.h>
+#include <ghoul/glm.h>
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace openspace;
+
+namespace {
+    constexpr unsigned int PointsPerNode = 64;
+    constexpr double FieldOfView = 0.8;
+    constexpr double ScreenHeight = 1080.0;
+
+    // A cloud of points whose density falls off with the distance to the center, which
+    // is similar to the distribution of stars or galaxies in many datasets
+    std::vector<glm::vec3> createPoints(size_t n) {
+        std::mt19937 generator(1337);
+        std::normal_distribution<float> distribution(0.f, 100.f);
+        std::vector<glm::vec3> points(n);
+        for (glm::vec3& p : points) {
+            p = glm::vec3(
+                distribution(generator),
+                distribution(generator),
+                distribution(generator)
+            );
+        }
+        return points;
+    }
+
+    glm::dmat4 viewProjection(const glm::dvec3& position, const glm::dvec3& target) {
+        return glm::perspective(FieldOfView, 16.0 / 9.0, 0.1, 1e6) *
+            glm::lookAt(position, target, glm::dvec3(0.0, 0.0, 1.0));
+    }
+
+    double pixelsPerRadian() {
+        return 0.5 * ScreenHeight / std::tan(0.5 * FieldOfView);
+    }
+} // namespace
+
+TEST_CASE("PointCloudOctree: Structure", "[pointcloudoctree]") {
+    const std::vector<glm::vec3> points = createPoints(20000);
+    const PointCloudOctree octree(points, PointsPerNode);
+
+    // Every point is stored exactly once
+    std::vector<uint32_t> order = octree.order();
+    std::sort(order.begin(), order.end());
+    std::vector<uint32_t> expected(points.size());
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(order == expected);
+
+    // The nodes cover all points without overlapping, and their points are inside them
+    std::vector<int> nOccurrences(points.size(), 0);
+    for (const PointCloudOctree::Node& node : octree.nodes()) {
+        CHECK(node.nPoints <= PointsPerNode);
+        for (uint32_t i = node.firstPoint; i < node.firstPoint + node.nPoints; i++) {
+            nOccurrences[i]++;
+            const glm::vec3 p = points[octree.order()[i]];
+            const glm::vec3 d = glm::abs(p - node.center);
+            CHECK(std::max({ d.x, d.y, d.z }) <= node.halfSize * 1.0001f);
+        }
+        if (node.nChildren > 0) {
+            // The points of the children follow directly after those of the parent
+            const PointCloudOctree::Node& child = octree.nodes()[node.firstChild];
+            CHECK(child.firstPoint == node.firstPoint + node.nPoints);
+        }
+    }
+    CHECK(std::all_of(
+        nOccurrences.begin(),
+        nOccurrences.end(),
+        [](int n) { return n == 1; }
+    ));
+}
+
+TEST_CASE("PointCloudOctree: Selection", "[pointcloudoctree]") {
+    const std::vector<glm::vec3> points = createPoints(20000);
+    const PointCloudOctree octree(points, PointsPerNode);
+    const glm::dmat4 identity = glm::dmat4(1.0);
+    PointCloudOctree::Selection selection;
+
+    SECTION("Everything") {
+        const glm::dvec3 camera = glm::dvec3(2000.0, 0.0, 0.0);
+        octree.select(
+            identity,
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            0.0,
+            selection
+        );
+        CHECK(selection.nPoints == points.size());
+        REQUIRE(selection.firsts.size() == 1);
+        CHECK(selection.firsts[0] == 0);
+        CHECK(selection.counts[0] == static_cast<int>(points.size()));
+    }
+
+    SECTION("Far away") {
+        const glm::dvec3 camera = glm::dvec3(1e5, 0.0, 0.0);
+        octree.select(
+            identity,
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            100.0,
+            selection
+        );
+        CHECK(selection.nPoints == PointsPerNode);
+        CHECK(selection.firsts.size() == 1);
+    }
+
+    SECTION("Looking away") {
+        const glm::dvec3 camera = glm::dvec3(2000.0, 0.0, 0.0);
+        octree.select(
+            identity,
+            viewProjection(camera, glm::dvec3(3000.0, 0.0, 0.0)),
+            camera,
+            pixelsPerRadian(),
+            0.0,
+            selection
+        );
+        CHECK(selection.nPoints == 0);
+        CHECK(selection.firsts.empty());
+    }
+
+    SECTION("Inside") {
+        // All points that are inside the view frustum have to be selected when the nodes
+        // are always refined
+        const glm::dvec3 camera = glm::dvec3(50.0, 20.0, 0.0);
+        const glm::dmat4 vp = viewProjection(camera, glm::dvec3(0.0));
+        octree.select(identity, vp, camera, pixelsPerRadian(), 0.0, selection);
+        CHECK(selection.nPoints < points.size());
+
+        std::vector<bool> isSelected(points.size(), false);
+        for (size_t i = 0; i < selection.firsts.size(); i++) {
+            for (int j = 0; j < selection.counts[i]; j++) {
+                isSelected[selection.firsts[i] + j] = true;
+            }
+        }
+        for (size_t i = 0; i < points.size(); i++) {
+            const glm::dvec3 p = glm::dvec3(points[octree.order()[i]]);
+            const glm::dvec4 clip = vp * glm::dvec4(p, 1.0);
+            const bool isInside = std::abs(clip.x) < clip.w &&
+                std::abs(clip.y) < clip.w && std::abs(clip.z) < clip.w;
+            if (isInside) {
+                CHECK(isSelected[i]);
+            }
+        }
+    }
+}
+
+TEST_CASE("PointCloudOctree: Cache", "[pointcloudoctree]") {
+    const std::vector<glm::vec3> points = createPoints(5000);
+    const PointCloudOctree octree(points, PointsPerNode);
+
+    const std::filesystem::path file =
+        std::filesystem::temp_directory_path() / "test_pointcloudoctree.cache";
+    octree.saveCachedFile(file);
+
+    std::optional<PointCloudOctree> cached =
+        PointCloudOctree::loadCachedFile(file, points.size(), PointsPerNode);
+    REQUIRE(cached.has_value());
+    CHECK(cached->order() == octree.order());
+    REQUIRE(cached->nodes().size() == octree.nodes().size());
+    for (size_t i = 0; i < octree.nodes().size(); i++) {
+        CHECK(cached->nodes()[i].firstPoint == octree.nodes()[i].firstPoint);
+        CHECK(cached->nodes()[i].nPoints == octree.nodes()[i].nPoints);
+        CHECK(cached->nodes()[i].firstChild == octree.nodes()[i].firstChild);
+        CHECK(cached->nodes()[i].nChildren == octree.nodes()[i].nChildren);
+    }
+
+    // A cache for a different dataset or node size is not used
+    CHECK(!PointCloudOctree::loadCachedFile(file, points.size() + 1, PointsPerNode));
+    CHECK(!PointCloudOctree::loadCachedFile(file, points.size(), PointsPerNode * 2));
+
+    std::filesystem::remove(file);
+}
+
+TEST_CASE("PointCloudOctree: Benchmark", "[.benchmark][pointcloudoctree]") {
+    const std::vector<glm::vec3> points = createPoints(2000000);
+
+    BENCHMARK("Build") {
+        return PointCloudOctree(points).nodes().size();
+    };
+
+    const PointCloudOctree octree(points);
+    PointCloudOctree::Selection selection;
+
+    BENCHMARK("Select overview") {
+        const glm::dvec3 camera = glm::dvec3(2000.0, 0.0, 0.0);
+        octree.select(
+            glm::dmat4(1.0),
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            256.0,
+            selection
+        );
+        return selection.nPoints;
+    };
+
+    BENCHMARK("Select inside") {
+        const glm::dvec3 camera = glm::dvec3(50.0, 20.0, 0.0);
+        octree.select(
+            glm::dmat4(1.0),
+            viewProjection(camera, glm::dvec3(0.0)),
+            camera,
+            pixelsPerRadian(),
+            256.0,
+            selection
+        );
+        return selection.nPoints;
+    };
+}
+
+#endif // OPENSPACE_MODULE_BASE_ENABLED
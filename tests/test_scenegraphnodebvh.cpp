@@ -0,0 +1,168 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/scene/scenegraphnodebvh.h>
+#include <ghoul/glm.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace openspace;
+
+namespace {
+    // Spheres of very different sizes spread over a large volume, similar to the nodes
+    // of a solar system with moons and spacecraft
+    std::vector<SceneGraphNodeBvh::Entry> createEntries(size_t n, unsigned int seed) {
+        std::mt19937 generator(seed);
+        std::normal_distribution<double> position(0.0, 1000.0);
+        std::uniform_real_distribution<double> radius(-2.0, 1.0);
+        std::vector<SceneGraphNodeBvh::Entry> entries(n);
+        for (SceneGraphNodeBvh::Entry& e : entries) {
+            e.center = glm::dvec3(
+                position(generator),
+                position(generator),
+                position(generator)
+            );
+            e.radius = std::pow(10.0, radius(generator));
+        }
+        return entries;
+    }
+
+    double distanceToLine(const glm::dvec3& p, const glm::dvec3& d, double tMax,
+                          const glm::dvec3& c)
+    {
+        const double t = std::clamp(glm::dot(c - p, d) / glm::dot(d, d), 0.0, tMax);
+        return glm::length(p + t * d - c);
+    }
+} // namespace
+
+TEST_CASE("SceneGraphNodeBvh: Empty", "[scenegraphnodebvh]") {
+    SceneGraphNodeBvh bvh;
+    bvh.update({});
+
+    std::vector<uint32_t> result;
+    bvh.querySphere(glm::dvec3(0.0), 1.0, result);
+    bvh.querySegment(glm::dvec3(0.0), glm::dvec3(1.0), result);
+    bvh.queryRay(glm::dvec3(0.0), glm::dvec3(1.0), result);
+    bvh.queryNearest(glm::dvec3(0.0), 4, result);
+    CHECK(result.empty());
+}
+
+TEST_CASE("SceneGraphNodeBvh: Queries", "[scenegraphnodebvh]") {
+    const std::vector<SceneGraphNodeBvh::Entry> entries = createEntries(2000, 1337);
+    SceneGraphNodeBvh bvh;
+    bvh.update(entries);
+    REQUIRE(bvh.entries().size() == entries.size());
+
+    std::vector<uint32_t> result;
+    std::vector<uint32_t> expected;
+
+    SECTION("Sphere") {
+        const glm::dvec3 center = glm::dvec3(200.0, -100.0, 50.0);
+        bvh.querySphere(center, 300.0, result, 2.0);
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            const double d = glm::distance(entries[i].center, center);
+            if (d <= 2.0 * entries[i].radius + 300.0) {
+                expected.push_back(i);
+            }
+        }
+        CHECK(!expected.empty());
+        CHECK(result == expected);
+    }
+
+    SECTION("Segment") {
+        const glm::dvec3 start = glm::dvec3(-2000.0, 10.0, 0.0);
+        const glm::dvec3 end = glm::dvec3(2000.0, -10.0, 20.0);
+        bvh.querySegment(start, end, result, 20.0);
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            const double d = distanceToLine(start, end - start, 1.0, entries[i].center);
+            if (d <= 20.0 * entries[i].radius) {
+                expected.push_back(i);
+            }
+        }
+        CHECK(!expected.empty());
+        CHECK(result == expected);
+    }
+
+    SECTION("Ray") {
+        const glm::dvec3 origin = glm::dvec3(0.0, 0.0, -100.0);
+        const glm::dvec3 direction = glm::normalize(glm::dvec3(0.1, 0.2, 1.0));
+        bvh.queryRay(origin, direction, result, 10.0);
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            const double d = distanceToLine(origin, direction, 1e12, entries[i].center);
+            if (d <= 10.0 * entries[i].radius) {
+                expected.push_back(i);
+            }
+        }
+        CHECK(!expected.empty());
+        CHECK(result == expected);
+    }
+
+    SECTION("Nearest") {
+        const glm::dvec3 point = glm::dvec3(100.0, 100.0, 100.0);
+        bvh.queryNearest(point, 10, result);
+        std::vector<uint32_t> all(entries.size());
+        for (uint32_t i = 0; i < entries.size(); i++) {
+            all[i] = i;
+        }
+        std::sort(
+            all.begin(), all.end(),
+            [&](uint32_t lhs, uint32_t rhs) {
+                return glm::distance(entries[lhs].center, point) <
+                       glm::distance(entries[rhs].center, point);
+            }
+        );
+        expected.assign(all.begin(), all.begin() + 10);
+        CHECK(result == expected);
+    }
+}
+
+TEST_CASE("SceneGraphNodeBvh: Refit", "[scenegraphnodebvh]") {
+    std::vector<SceneGraphNodeBvh::Entry> entries = createEntries(500, 1337);
+    SceneGraphNodeBvh bvh;
+    bvh.update(entries);
+
+    // Moving the spheres refits the existing tree, which still has to give the same
+    // results as checking every sphere
+    const std::vector<SceneGraphNodeBvh::Entry> moved = createEntries(500, 42);
+    for (size_t i = 0; i < entries.size(); i++) {
+        entries[i].center = moved[i].center;
+    }
+    bvh.update(entries);
+
+    const glm::dvec3 center = glm::dvec3(-300.0, 0.0, 300.0);
+    std::vector<uint32_t> result;
+    bvh.querySphere(center, 500.0, result);
+    std::vector<uint32_t> expected;
+    for (uint32_t i = 0; i < entries.size(); i++) {
+        if (glm::distance(entries[i].center, center) <= entries[i].radius + 500.0) {
+            expected.push_back(i);
+        }
+    }
+    CHECK(!expected.empty());
+    CHECK(result == expected);
+}
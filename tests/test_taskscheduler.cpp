@@ -0,0 +1,251 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <openspace/util/task.h>
+#include <openspace/util/taskscheduler.h>
+#include <ghoul/misc/exception.h>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace {
+    struct ExecutionLog {
+        std::mutex mutex;
+        std::vector<std::string> order;
+    };
+
+    class TestTask : public openspace::Task {
+    public:
+        TestTask(std::string name, ExecutionLog& log,
+                 std::vector<std::filesystem::path> inputs,
+                 std::vector<std::filesystem::path> outputs, bool shouldFail = false)
+            : _name(std::move(name))
+            , _log(log)
+            , _inputs(std::move(inputs))
+            , _outputs(std::move(outputs))
+            , _shouldFail(shouldFail)
+        {}
+
+        void perform(const ProgressCallback& onProgress) override {
+            {
+                std::lock_guard lock(_log.mutex);
+                _log.order.push_back(_name);
+            }
+            if (_shouldFail) {
+                throw ghoul::RuntimeError("Failing on purpose", _name);
+            }
+            onProgress(1.f);
+        }
+
+        std::string description() override { return _name; }
+
+        std::vector<std::filesystem::path> inputs() const override { return _inputs; }
+        std::vector<std::filesystem::path> outputs() const override { return _outputs; }
+
+    private:
+        std::string _name;
+        ExecutionLog& _log;
+        std::vector<std::filesystem::path> _inputs;
+        std::vector<std::filesystem::path> _outputs;
+        bool _shouldFail;
+    };
+
+    openspace::TaskScheduler::Settings parallelSettings() {
+        openspace::TaskScheduler::Settings settings;
+        settings.nThreads = 4;
+        return settings;
+    }
+} // namespace
+
+TEST_CASE("TaskScheduler: Implicit Dependency", "[taskscheduler]") {
+    using namespace openspace;
+
+    ExecutionLog log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<TestTask>(
+        "b", log, std::vector<std::filesystem::path>{ "test-task-a.dat" },
+        std::vector<std::filesystem::path>{ "test-task-b.dat" }
+    ));
+    tasks.push_back(std::make_unique<TestTask>(
+        "a", log, std::vector<std::filesystem::path>(),
+        std::vector<std::filesystem::path>{ "test-task-a.dat" }
+    ));
+
+    TaskScheduler scheduler(parallelSettings());
+    std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+
+    REQUIRE(results.size() == 2);
+    CHECK(results[0].status == TaskScheduler::Status::Performed);
+    CHECK(results[1].status == TaskScheduler::Status::Performed);
+    REQUIRE(log.order.size() == 2);
+    CHECK(log.order[0] == "a");
+    CHECK(log.order[1] == "b");
+}
+
+TEST_CASE("TaskScheduler: Failed Dependency", "[taskscheduler]") {
+    using namespace openspace;
+
+    ExecutionLog log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<TestTask>(
+        "a", log, std::vector<std::filesystem::path>(),
+        std::vector<std::filesystem::path>{ "test-task-a.dat" }, true
+    ));
+    tasks.push_back(std::make_unique<TestTask>(
+        "b", log, std::vector<std::filesystem::path>{ "test-task-a.dat" },
+        std::vector<std::filesystem::path>{ "test-task-b.dat" }
+    ));
+    tasks.push_back(std::make_unique<TestTask>(
+        "c", log, std::vector<std::filesystem::path>(),
+        std::vector<std::filesystem::path>{ "test-task-c.dat" }
+    ));
+
+    TaskScheduler scheduler(parallelSettings());
+    std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+
+    REQUIRE(results.size() == 3);
+    CHECK(results[0].status == TaskScheduler::Status::Failed);
+    CHECK(results[1].status == TaskScheduler::Status::DependencyFailed);
+    CHECK(results[2].status == TaskScheduler::Status::Performed);
+}
+
+TEST_CASE("TaskScheduler: Cyclic Dependency", "[taskscheduler]") {
+    using namespace openspace;
+
+    ExecutionLog log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<TestTask>(
+        "a", log, std::vector<std::filesystem::path>{ "test-task-b.dat" },
+        std::vector<std::filesystem::path>{ "test-task-a.dat" }
+    ));
+    tasks.push_back(std::make_unique<TestTask>(
+        "b", log, std::vector<std::filesystem::path>{ "test-task-a.dat" },
+        std::vector<std::filesystem::path>{ "test-task-b.dat" }
+    ));
+
+    TaskScheduler scheduler(parallelSettings());
+    std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+
+    REQUIRE(results.size() == 2);
+    CHECK(results[0].status == TaskScheduler::Status::DependencyFailed);
+    CHECK(results[1].status == TaskScheduler::Status::DependencyFailed);
+    CHECK(log.order.empty());
+}
+
+TEST_CASE("TaskScheduler: Up To Date", "[taskscheduler]") {
+    using namespace openspace;
+
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "openspace-test-taskscheduler";
+    std::filesystem::create_directories(dir);
+    const std::filesystem::path input = dir / "input.txt";
+    const std::filesystem::path output = dir / "output.txt";
+    std::ofstream(input) << "input";
+    std::ofstream(output) << "output";
+
+    // Make sure that the output is newer than the input
+    std::filesystem::last_write_time(
+        input,
+        std::filesystem::last_write_time(output) - std::chrono::hours(1)
+    );
+
+    ExecutionLog log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<TestTask>(
+        "a", log, std::vector<std::filesystem::path>{ input },
+        std::vector<std::filesystem::path>{ output }
+    ));
+
+    {
+        TaskScheduler scheduler(parallelSettings());
+        std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].status == TaskScheduler::Status::UpToDate);
+        CHECK(log.order.empty());
+    }
+
+    {
+        TaskScheduler::Settings settings = parallelSettings();
+        settings.forceRun = true;
+        TaskScheduler scheduler(settings);
+        std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+        REQUIRE(results.size() == 1);
+        CHECK(results[0].status == TaskScheduler::Status::Performed);
+        CHECK(log.order.size() == 1);
+    }
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("TaskScheduler: Performed Dependency", "[taskscheduler]") {
+    using namespace openspace;
+
+    const std::filesystem::path dir =
+        std::filesystem::temp_directory_path() / "openspace-test-taskscheduler";
+    std::filesystem::create_directories(dir);
+    const std::filesystem::path input = dir / "input.txt";
+    const std::filesystem::path intermediate = dir / "intermediate.txt";
+    const std::filesystem::path output = dir / "output.txt";
+    const std::filesystem::path other = dir / "other.txt";
+    std::ofstream(input) << "input";
+    std::ofstream(intermediate) << "intermediate";
+    std::ofstream(output) << "output";
+    std::ofstream(other) << "other";
+
+    // Only the first task is out of date
+    const std::filesystem::file_time_type now = std::filesystem::last_write_time(input);
+    std::filesystem::last_write_time(intermediate, now - std::chrono::hours(3));
+    std::filesystem::last_write_time(output, now - std::chrono::hours(2));
+    std::filesystem::last_write_time(other, now - std::chrono::hours(1));
+
+    ExecutionLog log;
+    std::vector<std::unique_ptr<Task>> tasks;
+    tasks.push_back(std::make_unique<TestTask>(
+        "a", log, std::vector<std::filesystem::path>{ input },
+        std::vector<std::filesystem::path>{ intermediate }
+    ));
+    tasks.push_back(std::make_unique<TestTask>(
+        "b", log, std::vector<std::filesystem::path>{ intermediate },
+        std::vector<std::filesystem::path>{ output }
+    ));
+    tasks.push_back(std::make_unique<TestTask>(
+        "c", log, std::vector<std::filesystem::path>(),
+        std::vector<std::filesystem::path>{ other }
+    ));
+
+    // The first task does not touch its output, so the second task is only performed
+    // because its dependency was, while the independent third task is still skipped
+    TaskScheduler scheduler(parallelSettings());
+    std::vector<TaskScheduler::Result> results = scheduler.performTasks(tasks);
+    REQUIRE(results.size() == 3);
+    CHECK(results[0].status == TaskScheduler::Status::Performed);
+    CHECK(results[1].status == TaskScheduler::Status::Performed);
+    CHECK(results[2].status == TaskScheduler::Status::UpToDate);
+
+    std::filesystem::remove_all(dir);
+}
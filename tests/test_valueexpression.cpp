@@ -0,0 +1,82 @@
+/*****************************************************************************************
+ *                                                                                       *
+ * OpenSpace                                                                             *
+ *                                                                                       *
+ * Copyright (c) 2014-2023                                                               *
+ *                                                                                       *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this  *
+ * software and associated documentation files (the "Software"), to deal in the Software *
+ * without restriction, including without limitation the rights to use, copy, modify,    *
+ * merge, publish, distribute, sublicense, and/or sell copies of the Software, and to    *
+ * permit persons to whom the Software is furnished to do so, subject to the following   *
+ * conditions:                                                                           *
+ *                                                                                       *
+ * The above copyright notice and this permission notice shall be included in all copies *
+ * or substantial portions of the Software.                                              *
+ *                                                                                       *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED,   *
+ * INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A         *
+ * PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT    *
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF  *
+ * CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE  *
+ * OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                                         *
+ ****************************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+#include <modules/volume/valueexpression.h>
+#include <cmath>
+
+using namespace openspace::volume;
+
+TEST_CASE("ValueExpression: Arithmetic", "[valueexpression]") {
+    std::optional<ValueExpression> e = ValueExpression::compile(
+        "return function(x, y, z) return x + 2 * y - z / 4 end"
+    );
+    REQUIRE(e.has_value());
+    CHECK_THAT(e->evaluate(1.0, 2.0, 8.0), Catch::Matchers::WithinAbs(3.0, 1e-12));
+}
+
+TEST_CASE("ValueExpression: Lua Precedence", "[valueexpression]") {
+    // In Lua, the power operator binds tighter than unary minus and is right associative
+    std::optional<ValueExpression> e = ValueExpression::compile(
+        "return function(a, b, c) return -a ^ 2 + 2 ^ 3 ^ 2 end"
+    );
+    REQUIRE(e.has_value());
+    CHECK_THAT(e->evaluate(3.0, 0.0, 0.0), Catch::Matchers::WithinAbs(503.0, 1e-9));
+}
+
+TEST_CASE("ValueExpression: Floored Modulo", "[valueexpression]") {
+    std::optional<ValueExpression> e = ValueExpression::compile(
+        "return function(x, y, z) return x % y end"
+    );
+    REQUIRE(e.has_value());
+    CHECK_THAT(e->evaluate(-1.0, 3.0, 0.0), Catch::Matchers::WithinAbs(2.0, 1e-12));
+    CHECK_THAT(e->evaluate(1.0, -3.0, 0.0), Catch::Matchers::WithinAbs(-2.0, 1e-12));
+}
+
+TEST_CASE("ValueExpression: Math Functions", "[valueexpression]") {
+    std::optional<ValueExpression> e = ValueExpression::compile(
+        "return function(x, y, z) "
+        "return math.sqrt(x*x + y*y + z*z) + math.max(x, y, z) * math.sin(math.pi / 2) "
+        "end"
+    );
+    REQUIRE(e.has_value());
+    CHECK_THAT(e->evaluate(2.0, 3.0, 6.0), Catch::Matchers::WithinAbs(13.0, 1e-9));
+}
+
+TEST_CASE("ValueExpression: Unsupported", "[valueexpression]") {
+    CHECK_FALSE(ValueExpression::compile(
+        "return function(x, y, z) if x > 0 then return 1 else return 0 end end"
+    ).has_value());
+    CHECK_FALSE(ValueExpression::compile(
+        "return function(x, y, z) return x --y\nend"
+    ).has_value());
+    CHECK_FALSE(ValueExpression::compile(
+        "return function(x, y, z) return math.random() end"
+    ).has_value());
+    CHECK_FALSE(ValueExpression::compile(
+        "return function(x, y, z) return w end"
+    ).has_value());
+}